@@ -1331,6 +1331,12 @@ static const GUI::ListData weaponsRulesList
 		" Zelda games where the players own bombs can hurt them. This used to affect player-placed bombs,"
 		" but that functionality has since been moved to the bomb item in the item editor. This rule now"
 		" only determines if script-created player bombs can hurt the player."},
+	{ "Table-Based Angular Movement and Script Trig", qr_LOOKUP_TRIG,
+		"If enabled, angular weapons, enemies and particles, and the script functions"
+		" Sin(), Cos(), Tan(), RadianSin(), RadianCos(), RadianTan() and ArcTan() use"
+		" lookup tables instead of the floating point math library. This is faster with"
+		" many angular weapons onscreen, and gives the same results on every computer,"
+		" but results can differ from the old math by 0.0001."},
 	
 	//should maybe keep this last as well? -Deedee
 	{ "Weapons Move Offscreen (Buggy, use at own risk)", qr_WEAPONSMOVEOFFSCREEN,
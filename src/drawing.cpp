@@ -116,13 +116,72 @@ void ditherblit(BITMAP* dest, BITMAP* src, int32_t color, byte dType, byte dArg,
 	bmp_unwrite_line(dest);
 }
 
+void lightblit(BITMAP* dest, BITMAP* src, int32_t xoffs, int32_t yoffs)
+{
+	int32_t x1 = zc_max(0, xoffs), x2 = zc_min(dest->w, src->w+xoffs);
+	int32_t y1 = zc_max(0, yoffs), y2 = zc_min(dest->h, src->h+yoffs);
+	for(int32_t ty = y1; ty < y2; ++ty)
+	{
+		uintptr_t read_addr = bmp_read_line(src, ty-yoffs)-xoffs;
+		uintptr_t write_addr = bmp_write_line(dest, ty);
+		for(int32_t tx = x1; tx < x2; ++tx)
+		{
+			if(!bmp_read8(read_addr+tx))
+			{
+				bmp_write8(write_addr+tx, 0);
+			}
+		}
+	}
+	bmp_unwrite_line(src);
+	bmp_unwrite_line(dest);
+}
+
+//Filled circle masks, by radius; a light only needs to scan its own bounding box
+#define MAX_CIRCLE_STAMP 256
+static BITMAP* circle_stamps[MAX_CIRCLE_STAMP+1] = {NULL};
+static BITMAP* get_circle_stamp(int32_t rad)
+{
+	if(!circle_stamps[rad])
+	{
+		BITMAP* stamp = create_bitmap_ex(8, rad*2+1, rad*2+1);
+		clear_bitmap(stamp);
+		circlefill(stamp, rad, rad, rad, 1);
+		circle_stamps[rad] = stamp;
+	}
+	return circle_stamps[rad];
+}
+
 void dithercircfill(BITMAP* dest, int32_t x, int32_t y, int32_t rad, int32_t color, byte ditherType, byte ditherArg, int32_t xoffs, int32_t yoffs)
 {
-	BITMAP* tmp = create_bitmap_ex(8, dest->w, dest->h);
-	clear_bitmap(tmp);
-	circlefill(tmp, x, y, rad, 1);
-	ditherblit(dest, tmp, color, ditherType, ditherArg, xoffs, yoffs);
-	destroy_bitmap(tmp);
+	if(unsigned(rad) > MAX_CIRCLE_STAMP)
+	{
+		BITMAP* tmp = create_bitmap_ex(8, dest->w, dest->h);
+		clear_bitmap(tmp);
+		circlefill(tmp, x, y, rad, 1);
+		ditherblit(dest, tmp, color, ditherType, ditherArg, xoffs, yoffs);
+		destroy_bitmap(tmp);
+		return;
+	}
+	BITMAP* stamp = get_circle_stamp(rad);
+	int32_t wid = dest->w;
+	int32_t hei = dest->h;
+	int32_t sx = x-rad, sy = y-rad;
+	int32_t x1 = zc_max(0, sx), x2 = zc_min(wid, x+rad+1);
+	int32_t y1 = zc_max(0, sy), y2 = zc_min(hei, y+rad+1);
+	for(int32_t ty = y1; ty < y2; ++ty)
+	{
+		uintptr_t read_addr = bmp_read_line(stamp, ty-sy)-sx;
+		uintptr_t write_addr = bmp_write_line(dest, ty);
+		for(int32_t tx = x1; tx < x2; ++tx)
+		{
+			if(bmp_read8(read_addr+tx) && dithercheck(ditherType,ditherArg,tx+xoffs,ty+yoffs,wid,hei))
+			{
+				bmp_write8(write_addr+tx, color);
+			}
+		}
+	}
+	bmp_unwrite_line(stamp);
+	bmp_unwrite_line(dest);
 }
 
 void lampcone(BITMAP* dest, int32_t sx, int32_t sy, int32_t range, int32_t dir, int32_t color)
@@ -21,6 +21,8 @@ enum dithType
 };
 void maskblit(BITMAP* dest, BITMAP* src, int32_t color);
 void ditherblit(BITMAP* dest, BITMAP* src, int32_t color, byte dType, byte dArg, int32_t xoffs=0, int32_t yoffs=0);
+//Clears every pixel of 'dest' that is 0 in the darkness mask 'src', offset by (xoffs,yoffs)
+void lightblit(BITMAP* dest, BITMAP* src, int32_t xoffs=0, int32_t yoffs=0);
 void dithercircfill(BITMAP* dest, int32_t x, int32_t y, int32_t rad, int32_t color, byte ditherType, byte ditherArg, int32_t xoffs=0, int32_t yoffs=0);
 
 void lampcone(BITMAP* dest, int32_t sx, int32_t sy, int32_t range, int32_t dir, int32_t color);
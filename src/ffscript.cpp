@@ -10,6 +10,7 @@
 #include <sstream>
 #include <math.h>
 #include <cstdio>
+#include <chrono>
 //
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -23,6 +24,7 @@
 extern byte use_dwm_flush;
 uint8_t using_SRAM = 0;
 #include "zc_math.h"
+#include "zc_trig.h"
 #include "zc_array.h"
 #include "ffscript.h"
 #include "zc_subscr.h"
@@ -33,6 +35,7 @@ uint8_t using_SRAM = 0;
 #include "ending.h"
 #include "zc_malloc.h"
 #include "module.h"
+#include "frametimer.h"
 using namespace util;
 #include <sstream>
 using std::ostringstream;
@@ -572,6 +575,79 @@ void pop_ri()
 
 static int32_t numInstructions; // Used to detect hangs
 static bool scriptCanSave = true;
+
+typedef std::chrono::steady_clock budget_clock;
+struct script_budget
+{
+	int32_t instructions; //per run, 0 for unlimited
+	int32_t microseconds; //per run, 0 for unlimited
+	dword throttled; //runs cut short this game
+};
+static script_budget script_budgets[SCRIPT_GENERIC_FROZEN+1];
+
+//Only scripts that are resumed every frame can be suspended; init, exit, and
+//frozen scripts are expected to finish before the engine moves on.
+static script_budget* get_script_budget(const byte type, const word script)
+{
+	switch(type)
+	{
+		case SCRIPT_GLOBAL:
+			if(script != GLOBAL_SCRIPT_GAME) return NULL;
+			break;
+		case SCRIPT_PLAYER:
+			if(script != SCRIPT_PLAYER_ACTIVE) return NULL;
+			break;
+		case SCRIPT_FFC: case SCRIPT_SCREEN: case SCRIPT_NPC: case SCRIPT_LWPN:
+		case SCRIPT_EWPN: case SCRIPT_ITEMSPRITE: case SCRIPT_DMAP:
+		case SCRIPT_PASSIVESUBSCREEN: case SCRIPT_COMBO:
+			break;
+		default:
+			return NULL;
+	}
+	script_budget* budget = &script_budgets[type];
+	return (budget->instructions || budget->microseconds) ? budget : NULL;
+}
+
+static bool over_script_budget(script_budget const* budget, int32_t count, budget_clock::time_point start)
+{
+	if(budget->instructions && count >= budget->instructions)
+		return true;
+	//Reading the clock costs more than most instructions, so only look every so often
+	if(budget->microseconds && !(count&0xFF))
+		return std::chrono::duration_cast<std::chrono::microseconds>(budget_clock::now()-start).count() >= budget->microseconds;
+	return false;
+}
+
+void load_script_budgets()
+{
+	static const char* budget_names[SCRIPT_GENERIC_FROZEN+1] =
+	{
+		NULL, "Global", "FFC", "Screen", "Hero", NULL, "LWeapon", "NPC", NULL,
+		"EWeapon", "DMap", "ItemSprite", NULL, "PassiveSubscreen", "Combo", NULL,
+		NULL, NULL
+	};
+	char key[64];
+	for(int32_t q = 0; q <= SCRIPT_GENERIC_FROZEN; ++q)
+	{
+		script_budgets[q].instructions = script_budgets[q].microseconds = 0;
+		script_budgets[q].throttled = 0;
+		if(!budget_names[q]) continue;
+		sprintf(key, "ZASM_Budget_%s", budget_names[q]);
+		script_budgets[q].instructions = zc_max(0, zc_get_config("ZSCRIPT",key,0));
+		sprintf(key, "ZASM_BudgetUS_%s", budget_names[q]);
+		script_budgets[q].microseconds = zc_max(0, zc_get_config("ZSCRIPT",key,0));
+	}
+}
+
+void report_script_throttles()
+{
+	for(int32_t q = 0; q <= SCRIPT_GENERIC_FROZEN; ++q)
+	{
+		if(script_budgets[q].throttled)
+			al_trace("%s scripts were suspended for exceeding their frame budget %u times\n", script_types[q], script_budgets[q].throttled);
+		script_budgets[q].throttled = 0;
+	}
+}
 byte curScriptType;
 word curScriptNum;
 
@@ -21272,6 +21348,18 @@ void do_mod(const bool v)
 
 void do_trig(const bool v, const byte type)
 {
+	if(get_bit(quest_rules, qr_LOOKUP_TRIG))
+	{
+		int32_t deg = SH::get_arg(sarg2, v);
+		switch(type)
+		{
+			case 0: set_register(sarg1, zc::trig::SinDeg(deg)); break;
+			case 1: set_register(sarg1, zc::trig::CosDeg(deg)); break;
+			case 2: set_register(sarg1, zc::trig::TanDeg(deg)); break;
+		}
+		return;
+	}
+	
 	double rangle = (SH::get_arg(sarg2, v) / 10000.0) * PI / 180.0;
 	
 	switch(type)
@@ -21333,6 +21421,12 @@ void do_acos(const bool v)
 
 void do_arctan()
 {
+	if(get_bit(quest_rules, qr_LOOKUP_TRIG))
+	{
+		set_register(sarg1, zc::trig::ArcTan(ri->d[rINDEX2], ri->d[rINDEX]));
+		return;
+	}
+	
 	double xpos = ri->d[rINDEX] / 10000.0;
 	double ypos = ri->d[rINDEX2] / 10000.0;
 	
@@ -25688,110 +25782,87 @@ int32_t run_script(const byte type, const word script, const int32_t i)
 		break;
 		case SCRIPT_NPC:
 		{
-			int32_t npc_index = GuyH::getNPCIndex(i);
-			enemy *w = (enemy*)guys.spr(npc_index);
+			//Resolve the sprite once; an index scan per access is quadratic on busy screens
+			enemy *wa = (enemy*)guys.getByUID(i);
 			
-			ri = &(guys.spr(GuyH::getNPCIndex(i))->scrmem->scriptData);
-			
-			curscript = guyscripts[guys.spr(GuyH::getNPCIndex(i))->script];
-			
-			stack = &(guys.spr(GuyH::getNPCIndex(i))->scrmem->stack);
-			
-			enemy *wa = (enemy*)guys.spr(GuyH::getNPCIndex(i));
+			ri = &(wa->scrmem->scriptData);
+			curscript = guyscripts[wa->script];
+			stack = &(wa->scrmem->stack);
 			ri->guyref = wa->getUID();
 			
-			if (!(guys.spr(GuyH::getNPCIndex(i))->initialised))
+			if (!(wa->initialised))
 			{
-				al_trace("(guys.spr(GuyH::getNPCIndex(i))->initialised) is %d\n",(guys.spr(GuyH::getNPCIndex(i))->initialised));
+				al_trace("(wa->initialised) is %d\n",(wa->initialised));
 				
 				for ( int32_t q = 0; q < 8; q++ ) 
 				{
 					ri->d[q] = wa->initD[q];
 				}
-				guys.spr(GuyH::getNPCIndex(i))->initialised = 1;
+				wa->initialised = 1;
 			}
 		}
 		break;
 		
 		case SCRIPT_LWPN:
 		{
-			int32_t lwpn_index = LwpnH::getLWeaponIndex(i);
-			weapon *w = (weapon*)Lwpns.spr(lwpn_index);
-			ri = &(Lwpns.spr(LwpnH::getLWeaponIndex(i))->scrmem->scriptData);
-			
-			curscript = lwpnscripts[Lwpns.spr(LwpnH::getLWeaponIndex(i))->weaponscript];
-		
-			stack = &(Lwpns.spr(LwpnH::getLWeaponIndex(i))->scrmem->stack);
+			weapon *wa = (weapon*)Lwpns.getByUID(i);
 			
-			weapon *wa = (weapon*)Lwpns.spr(LwpnH::getLWeaponIndex(i));
+			ri = &(wa->scrmem->scriptData);
+			curscript = lwpnscripts[wa->weaponscript];
+			stack = &(wa->scrmem->stack);
 			ri->lwpn = wa->getUID();
 			
-			if (!(Lwpns.spr(LwpnH::getLWeaponIndex(i))->initialised))
+			if (!(wa->initialised))
 			{
-				al_trace("(Lwpns.spr(LwpnH::getLWeaponIndex(i))->initialised) is %d\n",(Lwpns.spr(LwpnH::getLWeaponIndex(i))->initialised));
+				al_trace("(wa->initialised) is %d\n",(wa->initialised));
 				for ( int32_t q = 0; q < 8; q++ ) 
 				{
-	
-					ri->d[q] = Lwpns.spr(LwpnH::getLWeaponIndex(i))->weap_initd[q]; //w->initiald[q];
+					ri->d[q] = wa->weap_initd[q]; //w->initiald[q];
 				}
-				Lwpns.spr(LwpnH::getLWeaponIndex(i))->initialised = 1;
+				wa->initialised = 1;
 			}
-			
 		}
 		break;
 		
 		case SCRIPT_EWPN:
 		{
-			int32_t ewpn_index = EwpnH::getEWeaponIndex(i);
-
-			weapon *w = (weapon*)Ewpns.spr(ewpn_index);
-			ri = &(Ewpns.spr(EwpnH::getEWeaponIndex(i))->scrmem->scriptData);
-			
-			curscript = ewpnscripts[Ewpns.spr(EwpnH::getEWeaponIndex(i))->weaponscript];
-			
+			weapon *wa = (weapon*)Ewpns.getByUID(i);
 			
-			stack = &(Ewpns.spr(EwpnH::getEWeaponIndex(i))->scrmem->stack);
-			
-			weapon *wa = (weapon*)Ewpns.spr(EwpnH::getEWeaponIndex(i));
+			ri = &(wa->scrmem->scriptData);
+			curscript = ewpnscripts[wa->weaponscript];
+			stack = &(wa->scrmem->stack);
 			ri->ewpn = wa->getUID();
-			if (!(Ewpns.spr(EwpnH::getEWeaponIndex(i))->initialised))
+			
+			if (!(wa->initialised))
 			{
-				al_trace("(Ewpns.spr(EwpnH::getEWeaponIndex(i))->initialised) is %d\n",(Ewpns.spr(EwpnH::getEWeaponIndex(i))->initialised));
+				al_trace("(wa->initialised) is %d\n",(wa->initialised));
 				for ( int32_t q = 0; q < 8; q++ ) 
 				{
-					
-					ri->d[q] = Ewpns.spr(EwpnH::getEWeaponIndex(i))->weap_initd[q]; //w->initiald[q];
+					ri->d[q] = wa->weap_initd[q]; //w->initiald[q];
 				}
-				Ewpns.spr(EwpnH::getEWeaponIndex(i))->initialised = 1;
+				wa->initialised = 1;
 			}
-			
 		}
 		break;
 		
 		case SCRIPT_ITEMSPRITE:
 		{
-			int32_t the_index = ItemH::getItemIndex(i);
+			item *wa = (item*)items.getByUID(i);
 			
-			item *w = (item*)items.spr(the_index);
-			ri = &(items.spr(ItemH::getItemIndex(i))->scrmem->scriptData);
-		
-			curscript = itemspritescripts[items.spr(ItemH::getItemIndex(i))->script]; //Set the editor sprite script field to 'script'
-				
-			stack = &(items.spr(ItemH::getItemIndex(i))->scrmem->stack);
-			
-			item *wa = (item*)items.spr(ItemH::getItemIndex(i));
+			ri = &(wa->scrmem->scriptData);
+			curscript = itemspritescripts[wa->script]; //Set the editor sprite script field to 'script'
+			stack = &(wa->scrmem->stack);
 			ri->itemref = wa->getUID();
-			if (!(items.spr(ItemH::getItemIndex(i))->initialised))
+			
+			if (!(wa->initialised))
 			{
-				al_trace("(items.spr(ItemH::getItemIndex(i))->initialised) is %d\n",(items.spr(ItemH::getItemIndex(i))->initialised));
+				al_trace("(wa->initialised) is %d\n",(wa->initialised));
 				for ( int32_t q = 0; q < 8; q++ ) 
 				{
-					
-					ri->d[q] = items.spr(ItemH::getItemIndex(i))->initD[q]; //w->initiald[q];
+					ri->d[q] = wa->initD[q]; //w->initiald[q];
 				}
-				items.spr(ItemH::getItemIndex(i))->initialised = 1;
+				wa->initialised = 1;
 			}
-			
 		}
 		break;
 		
@@ -26017,6 +26088,12 @@ int32_t run_script(const byte type, const word script, const int32_t i)
 	
 	bool increment = true;
 	
+	script_budget* budget = get_script_budget(type, script);
+	budget_clock::time_point budget_start;
+	int32_t budget_count = 0;
+	bool throttled = false;
+	if(budget) budget_start = budget_clock::now();
+	
 	if( FFCore.zasm_break_mode == ZASM_BREAK_ADVANCE_SCRIPT || FFCore.zasm_break_mode == ZASM_BREAK_SKIP_SCRIPT )
 	{
 		if( zasm_debugger )
@@ -29416,6 +29493,18 @@ int32_t run_script(const byte type, const word script, const int32_t i)
 					break;
 			}
 		}
+		
+		//Suspend at an instruction boundary, leaving pc on the next instruction
+		if(budget && scommand != 0xFFFF && scommand != WAITFRAME && scommand != WAITDRAW
+			&& scommand == curscript->zasm[ri->pc].command
+			&& over_script_budget(budget, ++budget_count, budget_start))
+		{
+			throttled = true;
+			if(++ri->throttled == 1)
+				al_trace("%s script %d exceeded its frame budget, resuming next frame\n", script_types[type], script);
+			++budget->throttled;
+			break;
+		}
 	}
 	
 	if(!scriptCanSave)
@@ -29503,26 +29592,24 @@ int32_t run_script(const byte type, const word script, const int32_t i)
 			
 			case SCRIPT_NPC:
 			{
-				//enemy *wp = (enemy*)guys.spr(i);
-				//wp->waitdraw = 1;
-				guys.spr(GuyH::getNPCIndex(i))->waitdraw = 1;
+				if(sprite* s = guys.getByUID(i)) s->waitdraw = 1;
 				break;
 			}
 			case SCRIPT_LWPN:
 			{
-				Lwpns.spr(LwpnH::getLWeaponIndex(i))->waitdraw = 1;
+				if(sprite* s = Lwpns.getByUID(i)) s->waitdraw = 1;
 				break;
 			}
 			
 			case SCRIPT_EWPN:
 			{
 			
-				Ewpns.spr(EwpnH::getEWeaponIndex(i))->waitdraw = 1;
+				if(sprite* s = Ewpns.getByUID(i)) s->waitdraw = 1;
 				break;
 			}
 			case SCRIPT_ITEMSPRITE:
 			{
-				items.spr(ItemH::getItemIndex(i))->waitdraw = 1;
+				if(sprite* s = items.getByUID(i)) s->waitdraw = 1;
 				break;
 			}
 			
@@ -29650,18 +29737,24 @@ int32_t run_script(const byte type, const word script, const int32_t i)
 		}
 		case SCRIPT_NPC:
 		{
-			guys.spr(GuyH::getNPCIndex(i))->doscript = 0;
-			guys.spr(GuyH::getNPCIndex(i))->weaponscript = 0;
-			guys.spr(GuyH::getNPCIndex(i))->initialised = 0;
+			if(sprite* s = guys.getByUID(i))
+			{
+				s->doscript = 0;
+				s->weaponscript = 0;
+				s->initialised = 0;
+			}
 			FFScript::deallocateAllArrays(type, i);
 
 			break;
 		}
 		case SCRIPT_LWPN:
 		{
-			Lwpns.spr(LwpnH::getLWeaponIndex(i))->doscript = 0;
-			Lwpns.spr(LwpnH::getLWeaponIndex(i))->weaponscript = 0;
-			Lwpns.spr(LwpnH::getLWeaponIndex(i))->initialised = 0;
+			if(sprite* s = Lwpns.getByUID(i))
+			{
+				s->doscript = 0;
+				s->weaponscript = 0;
+				s->initialised = 0;
+			}
 			FFScript::deallocateAllArrays(type, i);
 			
 			break;
@@ -29669,9 +29762,12 @@ int32_t run_script(const byte type, const word script, const int32_t i)
 		case SCRIPT_EWPN:
 		{
 		
-			Ewpns.spr(EwpnH::getEWeaponIndex(i))->doscript = 0;
-			Ewpns.spr(EwpnH::getEWeaponIndex(i))->weaponscript = 0;
-			Ewpns.spr(EwpnH::getEWeaponIndex(i))->initialised = 0;
+			if(sprite* s = Ewpns.getByUID(i))
+			{
+				s->doscript = 0;
+				s->weaponscript = 0;
+				s->initialised = 0;
+			}
 			FFScript::deallocateAllArrays(type, i);
 			
 			break;
@@ -29679,9 +29775,12 @@ int32_t run_script(const byte type, const word script, const int32_t i)
 		case SCRIPT_ITEMSPRITE:
 		{
 		
-			items.spr(ItemH::getItemIndex(i))->doscript = 0;
-			items.spr(ItemH::getItemIndex(i))->script = 0;
-			items.spr(ItemH::getItemIndex(i))->initialised = 0;
+			if(sprite* s = items.getByUID(i))
+			{
+				s->doscript = 0;
+				s->script = 0;
+				s->initialised = 0;
+			}
 			FFScript::deallocateAllArrays(type, i);
 			
 			break;
@@ -29708,7 +29807,7 @@ int32_t run_script(const byte type, const word script, const int32_t i)
 		
 		}
 	}
-	else
+	else if(!throttled)
 		ri->pc++;
 		
 	//ri->pc = pc; //Put it back where we got it from
@@ -29734,6 +29833,7 @@ int32_t ffscript_engine(const bool preload)
 {
 	if (!FFCore.system_suspend[susptFFCSCRIPTS])
 	{
+		frame_phase_scope ffc_timer(fpFFC_SCRIPTS);
 		//run screen script, first
 		//zprint("Screen Script Preload? %s \n", ( tmpscr->preloadscript ? "true" : "false"));
 		if(( preload && tmpscr->preloadscript) || !preload )
@@ -2080,6 +2080,9 @@ extern PALETTE tempblackpal;
 
 int32_t get_register(const int32_t arg);
 int32_t run_script(const byte type, const word script, const int32_t i = -1); //Global scripts don't need 'i'
+//Optional per-frame budgets ([ZSCRIPT] in zc.cfg); a script over budget resumes next frame.
+void load_script_budgets();
+void report_script_throttles();
 int32_t ffscript_engine(const bool preload);
 
 void clear_ffc_stack(const byte i);
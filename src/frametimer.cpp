@@ -0,0 +1,164 @@
+#include "frametimer.h"
+#include "zdefs.h"
+#include <stdio.h>
+#include <chrono>
+
+typedef std::chrono::steady_clock frame_clock;
+
+bool ShowFrameTiming = false;
+
+static char const* phase_names[fpMAX] =
+{
+	"Other", "Combos", "Global scripts", "FFC scripts", "Item scripts",
+	"NPC scripts", "LWeapon scripts", "EWeapon scripts",
+	"Items", "Enemies", "Weapons", "Hero", "Collisions",
+	"Draw", "Script draws", "Subscreen", "Blit", "Audio", "Idle"
+};
+static int32_t phase_colors[fpMAX] =
+{
+	vc(8), vc(6), vc(1), vc(9), vc(3),
+	dvc(4), vc(11), dvc(11),
+	vc(2), vc(4), vc(12), vc(10), vc(5),
+	vc(14), vc(13), vc(7), vc(15), vc(0), dvc(8)
+};
+
+//Averages are published every this many frames
+#define FRAME_TIMING_WINDOW 30
+
+static frame_phase cur_phase = fpOTHER;
+static frame_clock::time_point phase_start, frame_start;
+static bool timer_started = false;
+static double frame_times[fpMAX]; //microseconds this window
+static double shown_times[fpMAX]; //average per frame, last window
+static int32_t window_frames = 0;
+
+static FILE* trace_file = NULL;
+static frame_clock::time_point trace_start;
+
+static double elapsed_us(frame_clock::time_point from, frame_clock::time_point to)
+{
+	return std::chrono::duration<double, std::micro>(to-from).count();
+}
+
+static void trace_event(char const* name, int32_t tid, frame_clock::time_point from, frame_clock::time_point to)
+{
+	fprintf(trace_file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+		name, tid, elapsed_us(trace_start, from), elapsed_us(from, to));
+}
+
+frame_phase frame_timer_phase(frame_phase phase)
+{
+	frame_phase prev = cur_phase;
+	if(!ShowFrameTiming && !trace_file)
+	{
+		cur_phase = phase;
+		return prev;
+	}
+
+	frame_clock::time_point now = frame_clock::now();
+	if(!timer_started)
+	{
+		timer_started = true;
+		frame_start = now;
+	}
+	else if(phase != prev)
+	{
+		frame_times[prev] += elapsed_us(phase_start, now);
+		if(trace_file)
+			trace_event(phase_names[prev], 0, phase_start, now);
+	}
+	else return prev;
+
+	phase_start = now;
+	cur_phase = phase;
+	return prev;
+}
+
+void frame_timer_end_frame()
+{
+	if(!ShowFrameTiming && !trace_file)
+	{
+		timer_started = false;
+		return;
+	}
+
+	frame_clock::time_point now = frame_clock::now();
+	if(timer_started)
+	{
+		frame_times[cur_phase] += elapsed_us(phase_start, now);
+		if(trace_file)
+		{
+			trace_event(phase_names[cur_phase], 0, phase_start, now);
+			trace_event("Frame", 1, frame_start, now);
+		}
+	}
+	timer_started = true;
+	phase_start = frame_start = now;
+
+	if(++window_frames >= FRAME_TIMING_WINDOW)
+	{
+		for(int32_t q = 0; q < fpMAX; ++q)
+		{
+			shown_times[q] = frame_times[q] / window_frames;
+			frame_times[q] = 0;
+		}
+		window_frames = 0;
+	}
+}
+
+bool frame_trace_open(char const* path)
+{
+	frame_trace_close();
+	if(!path || !path[0])
+		return false;
+
+	trace_file = fopen(path, "w");
+	if(!trace_file)
+	{
+		al_trace("Could not open frame trace file '%s'\n", path);
+		return false;
+	}
+
+	trace_start = frame_clock::now();
+	timer_started = false;
+	fprintf(trace_file, "{\"traceEvents\":[\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Phases\"}}");
+	fprintf(trace_file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,\"args\":{\"name\":\"Frames\"}}");
+	return true;
+}
+
+void frame_trace_close()
+{
+	if(!trace_file)
+		return;
+
+	fprintf(trace_file, "\n]}\n");
+	fclose(trace_file);
+	trace_file = NULL;
+}
+
+void show_frame_timing(BITMAP *target, int32_t x, int32_t y)
+{
+	//10 pixels per millisecond; a full 60fps frame is ~167 pixels
+	double total = 0;
+	int32_t bx = x;
+	rectfill(target, x-1, y-1, x+256, y+8, BLACK);
+	for(int32_t q = 0; q < fpMAX; ++q)
+	{
+		total += shown_times[q];
+		int32_t ex = x + int32_t(total/100);
+		if(ex > bx)
+			rectfill(target, bx, y, zc_min(ex, x+255)-1, y+7, phase_colors[q]);
+		bx = zc_max(bx, ex);
+	}
+	vline(target, x+167, y-1, y+8, WHITE);
+
+	int32_t ly = y+10;
+	for(int32_t q = 0; q < fpMAX; ++q)
+	{
+		if(shown_times[q] < 50) continue; //Hide anything under 0.05ms
+		rectfill(target, x, ly, x+6, ly+6, phase_colors[q]);
+		textprintf_ex(target, font, x+10, ly, WHITE, BLACK, "%-15s%6.2f ms", phase_names[q], shown_times[q]/1000);
+		ly += 8;
+	}
+	textprintf_ex(target, font, x+10, ly, WHITE, BLACK, "%-15s%6.2f ms", "Total", total/1000);
+}
@@ -0,0 +1,41 @@
+/**
+ * Per-frame phase timing for the player.
+ * Time is charged to the current phase until the next phase begins, so
+ * marking the start of each part of the game loop accounts for the whole frame.
+ */
+#ifndef _FRAMETIMER_H_
+#define _FRAMETIMER_H_
+
+#include "zc_alleg.h"
+
+enum frame_phase
+{
+	fpOTHER, fpCOMBOS, fpGLOBAL_SCRIPTS, fpFFC_SCRIPTS, fpITEM_SCRIPTS,
+	fpNPC_SCRIPTS, fpLWEAPON_SCRIPTS, fpEWEAPON_SCRIPTS,
+	fpITEMS, fpNPCS, fpWEAPONS, fpHERO, fpCOLLISIONS,
+	fpDRAW, fpSCRIPT_DRAWS, fpSUBSCREEN, fpBLIT, fpAUDIO, fpIDLE,
+	fpMAX
+};
+
+extern bool ShowFrameTiming;
+
+//Starts charging time to 'phase'; returns the phase that was running.
+frame_phase frame_timer_phase(frame_phase phase);
+//Closes out the frame: updates the averages shown on screen, and the trace.
+void frame_timer_end_frame();
+
+//Writes every phase of every frame to 'path' as Chrome trace-event JSON.
+bool frame_trace_open(char const* path);
+void frame_trace_close();
+
+void show_frame_timing(BITMAP *target, int32_t x, int32_t y);
+
+//Charges the enclosing scope to 'phase', then goes back to whatever was running.
+struct frame_phase_scope
+{
+	frame_phase prev;
+	frame_phase_scope(frame_phase phase) : prev(frame_timer_phase(phase)) {}
+	~frame_phase_scope() { frame_timer_phase(prev); }
+};
+
+#endif
@@ -25,6 +25,7 @@
 #include "mem_debug.h"
 #include "zscriptversion.h"
 #include "particles.h"
+#include "frametimer.h"
 extern particle_list particles;
 
 extern FFScript FFCore;
@@ -9857,6 +9858,7 @@ int32_t enemy::run_script(int32_t mode)
 	if(switch_hooked && !get_bit(quest_rules, qr_SWITCHOBJ_RUN_SCRIPT)) return RUNSCRIPT_OK;
 	if (script <= 0 || !doscript || FFCore.getQuestHeaderInfo(vZelda) < 0x255 || FFCore.system_suspend[susptNPCSCRIPTS])
 		return RUNSCRIPT_OK;
+	frame_phase_scope script_timer(fpNPC_SCRIPTS);
 	int32_t ret = RUNSCRIPT_OK;
 	alloc_scriptmem();
 	switch(mode)
@@ -92,6 +92,7 @@ extern byte epilepsyFlashReduction;
 extern int32_t script_hero_cset;
 
 void playLevelMusic();
+void prefetch_DmapMusic(int32_t dmap);
 
 extern particle_list particles;
 
@@ -8843,6 +8844,7 @@ bool HeroClass::animate(int32_t)
 	}
 	
 	// check lots of other things
+	prefetch_edge_screen();
 	checkscroll();
 	
 	if(action!=inwind && action!=drowning && action != sidedrowning && action!=lavadrowning)
@@ -18891,7 +18893,44 @@ int32_t grabComboFromPos(int32_t pos, int32_t type)
 }
 
 static int32_t typeMap[176];
+static byte lightBlock[176];
 static int32_t istrig[176];
+//Everything a frame of spotlights depends on; if it matches the last
+//	traced frame, 'istrig' and 'lightbeam_bmp' are still correct as-is.
+struct spotlight_beam
+{
+	int32_t id, pos;
+	byte dir, set;
+	bool operator==(spotlight_beam const& other) const
+	{
+		return id == other.id && pos == other.pos
+			&& dir == other.dir && set == other.set;
+	}
+};
+struct spotlight_state
+{
+	int32_t types[176];
+	byte lightblock[176];
+	std::vector<spotlight_beam> beams;
+	int32_t heropos, herodir;
+	bool refl, block;
+	bool operator==(spotlight_state const& other) const
+	{
+		return heropos == other.heropos && herodir == other.herodir
+			&& refl == other.refl && block == other.block
+			&& !memcmp(types, other.types, sizeof(types))
+			&& !memcmp(lightblock, other.lightblock, sizeof(lightblock))
+			&& beams == other.beams;
+	}
+};
+static spotlight_state spot_cur, spot_last;
+static bool spot_last_valid = false;
+//Beam grids, 176 cells per distinct beam id; reused between traces
+static std::vector<byte> spot_grids;
+void invalidate_spotlights()
+{
+	spot_last_valid = false;
+}
 static const int32_t SPTYPE_SOLID = -1;
 #define SP_VISITED 0x1
 #define SPFLAG(dir) (0x2<<dir)
@@ -18963,7 +19002,7 @@ void HeroClass::handleBeam(byte* grid, size_t age, byte spotdir, int32_t curpos,
 		else switch(typeMap[curpos])
 		{
 			case cLIGHTTARGET:
-				if(combobuf[grabComboFromPos(curpos, cLIGHTTARGET)].usrflags&cflag3) //Blocks light
+				if(lightBlock[curpos]) //Blocks light
 					return;
 			case cMIRROR:
 				spotdir = oppositeDir[spotdir];
@@ -19014,18 +19053,15 @@ void HeroClass::handleBeam(byte* grid, size_t age, byte spotdir, int32_t curpos,
 void HeroClass::handleSpotlights()
 {
 	typedef byte spot_t;
-	//Store each different tile/color as grids
-	std::map<int32_t, spot_t*> maps;
 	int32_t shieldid = getCurrentShield();
 	bool refl = shieldid > -1 && (itemsbuf[shieldid].misc2 & shLIGHTBEAM);
 	bool block = !refl && shieldid > -1 && (itemsbuf[shieldid].misc1 & shLIGHTBEAM);
 	int32_t heropos = COMBOPOS(x.getInt()+8,y.getInt()+8);
-	memset(istrig, 0, sizeof(istrig));
-	clear_bitmap(lightbeam_bmp);
 	
 	for(size_t pos = 0; pos < 176; ++pos)
 	{
 		typeMap[pos] = 0;
+		lightBlock[pos] = 0;
 		for(int32_t lyr = 6; lyr > -1; --lyr)
 		{
 			newcombo const* cmb = &combobuf[FFCore.tempScreens[lyr]->data[pos]];
@@ -19035,6 +19071,8 @@ void HeroClass::handleSpotlights()
 				case cMAGICPRISM: case cMAGICPRISM4:
 				case cBLOCKALL: case cLIGHTTARGET:
 					typeMap[pos] = cmb->type;
+					if(cmb->type == cLIGHTTARGET && (cmb->usrflags&cflag3))
+						lightBlock[pos] = 1;
 					break;
 				case cGLASS:
 					typeMap[pos] = 0;
@@ -19051,15 +19089,9 @@ void HeroClass::handleSpotlights()
 			break; //hit a combo type
 		}
 	}
-	if(unsigned(heropos) < 176)
-	{
-		switch(typeMap[heropos])
-		{
-			case SPTYPE_SOLID: case cBLOCKALL:
-				heropos = -1; //Blocked from hitting player
-		}
-	}
 	
+	//Gather every beam source on the screen
+	spot_cur.beams.clear();
 	for(size_t layer = 0; layer < 7; ++layer)
 	{
 		mapscr* curlayer = FFCore.tempScreens[layer];
@@ -19074,38 +19106,73 @@ void HeroClass::handleSpotlights()
 					? std::max(0,cmb.attributes[0]/10000)|(cmb.attribytes[1]%12)<<24
 					: -((cmb.attribytes[3]<<16)|(cmb.attribytes[2]<<8)|(cmb.attribytes[1]));
 				if(!id) continue;
-				// zprint2("ID = %ld\n", id);
-				//Get the grid array for this tile/color
-				spot_t* grid;
-				if(maps[id])
-					grid = maps[id];
-				else
-				{
-					grid = new spot_t[176];
-					memset(grid, 0, sizeof(spot_t)*176);
-					maps[id] = grid;
-				}
-				byte spotdir = cmb.attribytes[0];
-				int32_t curpos = pos;
-				if(spotdir > 3)
-				{
-					grid[curpos] |= SP_VISITED;
-					istrig[curpos] |= cmb.attribytes[4] ? (1 << (cmb.attribytes[4]-1)) : ~0;
-				}
-				if(refl && curpos == heropos)
-				{
-					spotdir = dir;
-				}
-				handleBeam(grid, 0, spotdir, curpos, cmb.attribytes[4], block, refl);
+				spot_cur.beams.push_back({id, int32_t(pos), cmb.attribytes[0], cmb.attribytes[4]});
 			}
 		}
 	}
 	
+	//The hero only affects beams while holding a reflecting/blocking shield
+	memcpy(spot_cur.types, typeMap, sizeof(typeMap));
+	memcpy(spot_cur.lightblock, lightBlock, sizeof(lightBlock));
+	spot_cur.refl = refl;
+	spot_cur.block = block;
+	spot_cur.heropos = (refl || block) ? heropos : -1;
+	spot_cur.herodir = (refl || block) ? dir : -1;
+	if(spot_last_valid && spot_cur == spot_last)
+	{
+		//Nothing that feeds the beams changed; last frame's results stand
+		checkLightTargets();
+		return;
+	}
+	std::swap(spot_cur, spot_last);
+	spot_last_valid = true;
+	
+	memset(istrig, 0, sizeof(istrig));
+	clear_bitmap(lightbeam_bmp);
+	if(unsigned(heropos) < 176)
+	{
+		switch(typeMap[heropos])
+		{
+			case SPTYPE_SOLID: case cBLOCKALL:
+				heropos = -1; //Blocked from hitting player
+		}
+	}
+	
+	//Store each different tile/color as grids
+	std::map<int32_t, size_t> maps;
+	for(spotlight_beam const& beam : spot_last.beams)
+	{
+		if(maps.find(beam.id) == maps.end())
+		{
+			size_t ind = maps.size();
+			maps[beam.id] = ind;
+		}
+	}
+	spot_grids.assign(maps.size()*176, 0);
+	
+	for(spotlight_beam const& beam : spot_last.beams)
+	{
+		//Get the grid array for this tile/color
+		spot_t* grid = &spot_grids[maps[beam.id]*176];
+		byte spotdir = beam.dir;
+		int32_t curpos = beam.pos;
+		if(spotdir > 3)
+		{
+			grid[curpos] |= SP_VISITED;
+			istrig[curpos] |= beam.set ? (1 << (beam.set-1)) : ~0;
+		}
+		if(refl && curpos == heropos)
+		{
+			spotdir = dir;
+		}
+		handleBeam(grid, 0, spotdir, curpos, beam.set, block, refl);
+	}
+	
 	//Draw visuals
-	for(auto it = maps.begin(); it != maps.end();)
+	for(auto it = maps.begin(); it != maps.end(); ++it)
 	{
 		int32_t id = it->first;
-		spot_t* grid = it->second;
+		spot_t* grid = &spot_grids[it->second*176];
 		//
 		enum {t_gr, t_up, t_down, t_left, t_right, t_uleft, t_uright, t_dleft, t_dright, t_vert, t_horz, t_notup, t_notdown, t_notleft, t_notright, t_all, t_max };
 		int32_t tile = (id&0xFFFFFF);
@@ -19308,9 +19375,12 @@ void HeroClass::handleSpotlights()
 		}
 		//
 		if(cbmp) destroy_bitmap(cbmp);
-		delete[] it->second;
-		it = maps.erase(it);
 	}
+	checkLightTargets();
+}
+
+void HeroClass::checkLightTargets()
+{
 	//Check triggers
 	bool hastrigs = false, istrigged = true;
 	bool alltrig = getmapflag(mLIGHTBEAM);
@@ -21527,6 +21597,9 @@ bool HeroClass::dowarp(int32_t type, int32_t index, int32_t warpsfx)
 	int32_t olddmap = currdmap;
 	rehydratelake(type!=wtSCROLL);
 	
+	if(!intradmap)
+		prefetch_DmapMusic(wdmap);
+	
 	switch(wtype)
 	{
 	case wtCAVE:
@@ -23467,6 +23540,48 @@ bool HeroClass::nextcombo_solid(int32_t d2)
 	return false;
 }
 
+//Stage the screen Hero is about to scroll or side warp to, a piece per
+//	frame, while Hero walks up to the edge; loadscr then takes the staged
+//	copies instead of copying the screen and its layers all at once.
+void HeroClass::prefetch_edge_screen()
+{
+	if(currscr >= 128 || action == scrolling || action == inwind)
+		return;
+	
+	int32_t edge = -1;
+	switch(dir)
+	{
+		case up:
+			if(y < 16) edge = up;
+			break;
+		case down:
+			if(y > 144) edge = down;
+			break;
+		case left:
+			if(x < 16) edge = left;
+			break;
+		case right:
+			if(x > 224) edge = right;
+			break;
+	}
+	if(edge < 0)
+		return;
+	
+	if(tmpscr->flags2&(1<<edge))
+	{
+		int32_t index = (tmpscr->sidewarpindex>>(2*edge))&3;
+		int32_t wdmap = tmpscr->sidewarpdmap[index];
+		prefetch_screen(DMaps[wdmap].map, tmpscr->sidewarpscr[index] + DMaps[wdmap].xoff);
+		return;
+	}
+	
+	if((tmpscr->flags&fMAZE) || edge_of_dmap(edge))
+		return;
+	
+	static const int32_t step[4] = { -16, 16, -1, 1 };
+	prefetch_screen(currmap, currscr + step[edge]);
+}
+
 void HeroClass::checkscroll()
 {
     //DO NOT scroll if Hero is vibrating due to Farore's Wind effect -DD
@@ -24200,6 +24315,9 @@ void HeroClass::scrollscr(int32_t scrolldir, int32_t destscr, int32_t destdmap)
 	if(maze_enabled_sizewarp(scrolldir))  // dowarp() was called
 		return;
 		
+	if(destdmap != -1 && destdmap != currdmap)
+		prefetch_DmapMusic(destdmap);
+		
 	kill_enemy_sfx();
 	stop_sfx(QMisc.miscsfx[sfxLOWHEART]);
 	screenscrolling = true;
@@ -24242,9 +24360,9 @@ void HeroClass::scrollscr(int32_t scrolldir, int32_t destscr, int32_t destdmap)
 	for(int32_t i = 0; i < 6; i++)
 	{
 		tmpscr3[i] = tmpscr2[i];
-		tmpscr3[1].data.resize(_mapsSize, 0);
-		tmpscr3[1].sflag.resize(_mapsSize, 0);
-		tmpscr3[1].cset.resize(_mapsSize, 0);
+		tmpscr3[i].data.resize(_mapsSize, 0);
+		tmpscr3[i].sflag.resize(_mapsSize, 0);
+		tmpscr3[i].cset.resize(_mapsSize, 0);
 	}
 	
 	conveyclk = 2;
@@ -345,6 +345,7 @@ public:
 	void checkhit();
 	bool checkdamagecombos(int32_t dx, int32_t dy);
 	bool checkdamagecombos(int32_t dx1, int32_t dx2, int32_t dy1, int32_t dy2, int32_t layer = -1, bool solid = false, bool do_health_check = true);
+	void prefetch_edge_screen();
 	void checkscroll();
 	void checkspecial();
 	void checkspecial2(int32_t *ls);
@@ -384,6 +385,7 @@ public:
 private:
 	void handleBeam(byte* grid, size_t age, byte spotdir, int32_t curpos, byte set, bool block, bool refl);
 	void handleSpotlights();
+	void checkLightTargets();
 	void walkdown(bool opening);
 	void walkup(bool opening);
 	void walkdown2(bool opening);
@@ -578,6 +580,7 @@ public:
 
 bool usingActiveShield(int32_t itmid = -1);
 int32_t getCurrentShield(bool requireActive = true);
+void invalidate_spotlights();
 bool isRaftFlag(int32_t flag);
 void do_lens();
 void do_210_lens();
@@ -36,6 +36,7 @@ using std::set;
 #include "guys.h"
 #include "ffscript.h"
 #include "drawing.h"
+#include "frametimer.h"
 extern word combo_doscript[176];
 extern refInfo screenScriptData;
 extern FFScript FFCore;
@@ -3305,6 +3306,57 @@ void doTorchCircle(BITMAP* bmp, int32_t pos, newcombo const& cmb, int32_t xoffs
 	doDarkroomCircle(COMBOX(pos)+8+xoffs, COMBOY(pos)+8+yoffs, cmb.attribytes[0], bmp);
 }
 
+//Torch combos on the current screen only change when the combos do, so their
+//	light is kept in its own mask and composited in rather than redrawn per frame.
+struct static_light
+{
+	int32_t pos;
+	byte rad;
+	bool operator==(static_light const& other) const
+	{
+		return pos == other.pos && rad == other.rad;
+	}
+};
+static std::vector<static_light> static_lights, static_lights_cached;
+static int32_t static_light_settings[4] = {-1,-1,-1,-1};
+static BITMAP *static_light_bmp = NULL, *static_light_bmp_trans = NULL;
+
+static void add_static_light(newcombo const& cmb, int32_t pos)
+{
+	if(cmb.type == cTORCH && cmb.attribytes[0])
+		static_lights.push_back({pos, cmb.attribytes[0]});
+}
+
+static void update_static_lights()
+{
+	static_lights.clear();
+	for(int32_t q = 0; q < 176; ++q)
+		add_static_light(combobuf[tmpscr->data[q]], q);
+	for(int32_t lyr = 0; lyr < 6; ++lyr)
+	{
+		if(!tmpscr2[lyr].valid) continue; //invalid layer
+		for(int32_t q = 0; q < 176; ++q)
+			add_static_light(combobuf[tmpscr2[lyr].data[q]], q);
+	}
+	int32_t settings[4] = {game->get_dither_type(), game->get_dither_arg(),
+		game->get_dither_perc(), game->get_transdark_perc()};
+	if(static_light_bmp && static_lights == static_lights_cached
+		&& !memcmp(settings, static_light_settings, sizeof(settings)))
+		return;
+	if(!static_light_bmp)
+	{
+		static_light_bmp = create_bitmap_ex(8, darkscr_bmp_curscr->w, darkscr_bmp_curscr->h);
+		static_light_bmp_trans = create_bitmap_ex(8, darkscr_bmp_curscr->w, darkscr_bmp_curscr->h);
+	}
+	//Anything nonzero is dark; lightblit() only copies the lit pixels
+	clear_to_color(static_light_bmp, 1);
+	clear_to_color(static_light_bmp_trans, 1);
+	for(static_light const& light : static_lights)
+		doDarkroomCircle(COMBOX(light.pos)+8, COMBOY(light.pos)+8, light.rad, static_light_bmp, static_light_bmp_trans);
+	static_lights_cached = static_lights;
+	memcpy(static_light_settings, settings, sizeof(settings));
+}
+
 void calc_darkroom_combos(bool scrolling)
 {
 	int32_t scrolldir = get_bit(quest_rules, qr_NEWDARK_SCROLLEDGE) ? FFCore.ScrollingData[SCROLLDATA_DIR] : -1;
@@ -3324,28 +3376,16 @@ void calc_darkroom_combos(bool scrolling)
 			scrollxoffs = 256;
 			break;
 	}
-	for(int32_t q = 0; q < 176; ++q)
+	update_static_lights();
+	if(!static_lights.empty())
 	{
-		newcombo const& cmb = combobuf[tmpscr->data[q]];
-		if(cmb.type == cTORCH)
+		lightblit(darkscr_bmp_curscr, static_light_bmp);
+		lightblit(darkscr_bmp_curscr_trans, static_light_bmp_trans);
+		//Only the edges of these lights spill onto the other screen, past the mask
+		if(scrolldir > -1)
 		{
-			doTorchCircle(darkscr_bmp_curscr, q, cmb);
-			if(scrolldir > -1)
-				doTorchCircle(darkscr_bmp_scrollscr, q, cmb, scrollxoffs, scrollyoffs);
-		}
-	}
-	for(int32_t lyr = 0; lyr < 6; ++lyr)
-	{
-		if(!tmpscr2[lyr].valid) continue; //invalid layer
-		for(int32_t q = 0; q < 176; ++q)
-		{
-			newcombo const& cmb = combobuf[tmpscr2[lyr].data[q]];
-			if(cmb.type == cTORCH)
-			{
-				doTorchCircle(darkscr_bmp_curscr, q, cmb);
-				if(scrolldir > -1)
-					doTorchCircle(darkscr_bmp_scrollscr, q, cmb, scrollxoffs, scrollyoffs);
-			}
+			for(static_light const& light : static_lights)
+				doDarkroomCircle(COMBOX(light.pos)+8+scrollxoffs, COMBOY(light.pos)+8+scrollyoffs, light.rad, darkscr_bmp_scrollscr);
 		}
 	}
 	for(int q = 0; q < 32; ++q)
@@ -3772,6 +3812,7 @@ void draw_screen(mapscr* this_screen, bool showhero, bool runGeneric)
 	//6b. Draw the subscreen, without clipping
 	if(!get_bit(quest_rules,qr_SUBSCREENOVERSPRITES))
 	{
+		frame_phase_scope subscreen_timer(fpSUBSCREEN);
 		set_clip_rect(framebuf,draw_screen_clip_rect_x1,draw_screen_clip_rect_y1,draw_screen_clip_rect_x2,draw_screen_clip_rect_y2);
 		put_passive_subscr(framebuf, &QMisc, 0, passive_subscreen_offset, false, sspUP);
 	}
@@ -3908,6 +3949,7 @@ void draw_screen(mapscr* this_screen, bool showhero, bool runGeneric)
 	//13. Draw the subscreen, without clipping
 	if(get_bit(quest_rules,qr_SUBSCREENOVERSPRITES))
 	{
+		frame_phase_scope subscreen_timer(fpSUBSCREEN);
 		put_passive_subscr(framebuf, &QMisc, 0, passive_subscreen_offset, false, sspUP);
 		
 		// Draw primitives over subscren
@@ -4423,6 +4465,121 @@ void openshutters()
 	sfx(WAV_DOOR,128);
 }
 
+//Copies of the screen Hero is expected to move to next and of its layer
+//screens, taken from TheMaps one per frame while Hero walks up to the edge
+//(see HeroClass::prefetch_edge_screen). Slot 0 is the screen itself and
+//slots 1-6 its layers; loadscr takes a slot instead of copying TheMaps if
+//the copy still matches.
+static int32_t prefetch_map = -1, prefetch_scr = -1;
+static int32_t prefetch_stage = 0;
+static int32_t prefetch_src[7] = {-1,-1,-1,-1,-1,-1,-1};
+static mapscr prefetch_copy[7];
+
+template<typename T>
+static bool same_field(T const& a, T const& b)
+{
+	return memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+//Whether two screens hold the same data, field for field
+static bool same_screen(mapscr const& a, mapscr const& b)
+{
+#define SAME(f) same_field(a.f, b.f)
+	return SAME(valid) && SAME(guy) && SAME(str) && SAME(room) && SAME(item)
+		&& SAME(hasitem) && SAME(tilewarptype) && SAME(tilewarpoverlayflags)
+		&& SAME(door_combo_set) && SAME(warpreturnx) && SAME(warpreturny)
+		&& SAME(warpreturnc) && SAME(stairx) && SAME(stairy) && SAME(itemx)
+		&& SAME(itemy) && SAME(color) && SAME(enemyflags) && SAME(door)
+		&& SAME(tilewarpdmap) && SAME(tilewarpscr) && SAME(exitdir) && SAME(enemy)
+		&& SAME(pattern) && SAME(sidewarptype) && SAME(sidewarpoverlayflags)
+		&& SAME(warparrivalx) && SAME(warparrivaly) && SAME(path) && SAME(sidewarpscr)
+		&& SAME(sidewarpdmap) && SAME(sidewarpindex) && SAME(undercombo)
+		&& SAME(undercset) && SAME(catchall) && SAME(flags) && SAME(flags2)
+		&& SAME(flags3) && SAME(flags4) && SAME(flags5) && SAME(flags6)
+		&& SAME(flags7) && SAME(flags8) && SAME(flags9) && SAME(flags10)
+		&& SAME(csensitive) && SAME(noreset) && SAME(nocarry) && SAME(layermap)
+		&& SAME(layerscreen) && SAME(layeropacity) && SAME(timedwarptics)
+		&& SAME(nextmap) && SAME(nextscr) && SAME(secretcombo) && SAME(secretcset)
+		&& SAME(secretflag) && a.data == b.data && a.sflag == b.sflag
+		&& a.cset == b.cset && SAME(viewX) && SAME(viewY) && SAME(scrWidth)
+		&& SAME(scrHeight) && SAME(entry_x) && SAME(entry_y) && SAME(numff)
+		&& SAME(ffdata) && SAME(ffcset) && SAME(ffdelay) && SAME(ffx) && SAME(ffy)
+		&& SAME(ffxdelta) && SAME(ffydelta) && SAME(ffxdelta2) && SAME(ffydelta2)
+		&& SAME(ffflags) && SAME(ffwidth) && SAME(ffheight) && SAME(fflink)
+		&& SAME(ffscript) && SAME(initd) && SAME(inita) && SAME(initialized)
+		&& SAME(script_entry) && SAME(script_occupancy) && SAME(script_exit)
+		&& SAME(oceansfx) && SAME(bosssfx) && SAME(secretsfx) && SAME(holdupsfx)
+		&& SAME(old_cpage) && SAME(screen_midi) && SAME(lens_layer)
+		&& SAME(npcstrings) && SAME(new_items) && SAME(new_item_x)
+		&& SAME(new_item_y) && SAME(script) && SAME(screeninitd)
+		&& SAME(screen_waitdraw) && SAME(preloadscript) && SAME(ffcswaitdraw)
+		&& SAME(screendatascriptInitialised) && SAME(hidelayers)
+		&& SAME(hidescriptlayers) && SAME(doscript);
+#undef SAME
+}
+
+void clear_screen_prefetch()
+{
+	prefetch_map = prefetch_scr = -1;
+	prefetch_stage = 0;
+	for(int32_t i = 0; i < 7; ++i)
+		prefetch_src[i] = -1;
+}
+
+void prefetch_screen(int32_t map, int32_t scr)
+{
+	if(map < 0 || map >= map_count || scr < 0 || scr >= MAPSCRS)
+		return;
+	
+	if(map != prefetch_map || scr != prefetch_scr)
+	{
+		clear_screen_prefetch();
+		prefetch_map = map;
+		prefetch_scr = scr;
+	}
+
+	if(prefetch_stage >= 7)
+		return;
+
+	int32_t i = prefetch_stage++;
+	int32_t index = map*MAPSCRS+scr;
+
+	if(i > 0)
+	{
+		//Layers come from the staged copy of the screen, as loadscr would
+		//find them in tmpscr.
+		mapscr const& s = prefetch_copy[0];
+		int32_t lm = s.layermap[i-1];
+		if(prefetch_src[0] < 0 || lm <= 0 || ZCMaps[lm-1].tileWidth != ZCMaps[map].tileWidth
+				|| ZCMaps[lm-1].tileHeight != ZCMaps[map].tileHeight)
+			return;
+		index = (lm-1)*MAPSCRS+s.layerscreen[i-1];
+	}
+
+	prefetch_copy[i] = TheMaps[index];
+	prefetch_src[i] = index;
+}
+
+//Moves the staged copy of TheMaps[index] into dest, if one was taken and
+//TheMaps[index] hasn't changed since.
+static bool take_prefetched_screen(int32_t index, mapscr &dest)
+{
+	for(int32_t i = 0; i < 7; ++i)
+	{
+		if(prefetch_src[i] != index)
+			continue;
+
+		prefetch_src[i] = -1;
+		if(!same_screen(prefetch_copy[i], TheMaps[index]))
+			return false;
+
+		dest = std::move(prefetch_copy[i]);
+		return true;
+	}
+
+	return false;
+}
+
 void loadscr(int32_t tmp,int32_t destdmap, int32_t scr,int32_t ldir,bool overlay=false)
 {
 	if(!tmp)
@@ -4456,14 +4613,13 @@ void loadscr(int32_t tmp,int32_t destdmap, int32_t scr,int32_t ldir,bool overlay
 	reset_combo_animations2();
 	
 	
-	mapscr ffscr = tmpscr[tmp];
-	tmpscr[tmp] = TheMaps[currmap*MAPSCRS+scr];
+	//The old screen is replaced below; move it out rather than copying it
+	mapscr ffscr = std::move(tmpscr[tmp]);
+	if(!take_prefetched_screen(currmap*MAPSCRS+scr, tmpscr[tmp]))
+		tmpscr[tmp] = TheMaps[currmap*MAPSCRS+scr];
 	
 	const int32_t _mapsSize = ZCMaps[currmap].tileHeight*ZCMaps[currmap].tileWidth;
 	tmpscr[tmp].valid |= mVALID; //layer 0 is always valid
-	tmpscr[tmp].data = TheMaps[currmap*MAPSCRS+scr].data;
-	tmpscr[tmp].sflag = TheMaps[currmap*MAPSCRS+scr].sflag;
-	tmpscr[tmp].cset = TheMaps[currmap*MAPSCRS+scr].cset;
 	
 	//screen / screendata script
 	FFCore.clear_screen_stack();
@@ -4518,7 +4674,8 @@ void loadscr(int32_t tmp,int32_t destdmap, int32_t scr,int32_t ldir,bool overlay
 				int32_t lm = (tmpscr[tmp].layermap[i]-1)*MAPSCRS+tmpscr[tmp].layerscreen[i];
 				int32_t fm = (ffscr.layermap[i]-1)*MAPSCRS+ffscr.layerscreen[i];
 				
-				if(!TheMaps[lm].data.empty() && !TheMaps[fm].data.empty())
+				//an empty layer screen is all zeroes, and gets storage on write
+				if(!TheMaps[fm].data.empty())
 				{
 					for(int32_t c=0; c< ZCMaps[currmap].tileHeight*ZCMaps[currmap].tileWidth; ++c)
 					{
@@ -4608,7 +4765,7 @@ void loadscr(int32_t tmp,int32_t destdmap, int32_t scr,int32_t ldir,bool overlay
 	{
 		for(int32_t i=0; i<6; i++)
 		{
-			mapscr layerscr = tmpscr2[i];
+			mapscr layerscr = std::move(tmpscr2[i]);
 			
 			// Don't delete the old tmpscr2's data yet!
 			if(tmpscr[tmp].layermap[i]>0 && (ZCMaps[tmpscr[tmp].layermap[i]-1].tileWidth==ZCMaps[currmap].tileWidth)
@@ -4616,7 +4773,9 @@ void loadscr(int32_t tmp,int32_t destdmap, int32_t scr,int32_t ldir,bool overlay
 			{
 				// const int32_t _mapsSize = (ZCMaps[currmap].tileWidth)*(ZCMaps[currmap].tileHeight);
 				
-				tmpscr2[i]=TheMaps[(tmpscr[tmp].layermap[i]-1)*MAPSCRS+tmpscr[tmp].layerscreen[i]];
+				int32_t lindex = (tmpscr[tmp].layermap[i]-1)*MAPSCRS+tmpscr[tmp].layerscreen[i];
+				if(!take_prefetched_screen(lindex, tmpscr2[i]))
+					tmpscr2[i]=TheMaps[lindex];
 				
 				tmpscr2[i].data.resize(_mapsSize, 0);
 				tmpscr2[i].sflag.resize(_mapsSize, 0);
@@ -5851,8 +6010,204 @@ bool displayOnMap(int32_t x, int32_t y)
         return true;
 }
 
-void ViewMap()
+// Full size render of the current map, shared by the map viewer and the
+// map picture (F5). The viewer only redraws it when the map, its visited
+// and secret state, the DMap, the screens it shows, or the combos and tiles
+// those screens use change; combo animation frames do not count. The map
+// picture always redraws it.
+static BITMAP *map_render = NULL;
+static uint64_t map_render_key = 0;
+
+static void map_render_mix(uint64_t &h, const void *src, size_t n)
+{
+	const byte *p = (const byte*)src;
+	
+	for(; n; --n, ++p)
+	{
+		h = (h ^ *p) * 0x100000001B3ULL;
+	}
+}
+
+static void map_render_mix_screen(uint64_t &h, mapscr const& scr)
+{
+	map_render_mix(h, &scr.valid, sizeof(scr.valid));
+	map_render_mix(h, &scr.flags7, sizeof(scr.flags7));
+	map_render_mix(h, scr.layermap, sizeof(scr.layermap));
+	map_render_mix(h, scr.layerscreen, sizeof(scr.layerscreen));
+	map_render_mix(h, scr.door, sizeof(scr.door));
+	map_render_mix(h, &scr.door_combo_set, sizeof(scr.door_combo_set));
+	map_render_mix(h, scr.ffdata, sizeof(scr.ffdata));
+	map_render_mix(h, scr.ffcset, sizeof(scr.ffcset));
+	map_render_mix(h, scr.ffx, sizeof(scr.ffx));
+	map_render_mix(h, scr.ffy, sizeof(scr.ffy));
+	map_render_mix(h, scr.ffflags, sizeof(scr.ffflags));
+	
+	for(size_t i=0; i<scr.data.size(); ++i)
+	{
+		word d = scr.data[i];
+		byte c[2] = { scr.cset[i], scr.sflag[i] };
+		map_render_mix(h, &d, sizeof(d));
+		map_render_mix(h, c, 2);
+	}
+}
+
+//A combo as it is drawn, apart from its animation state, and the tiles its
+//animation and a tw x th block of it can reach
+static void map_render_mix_combo(uint64_t &h, int32_t cid, int32_t tw = 1, int32_t th = 1)
 {
+	newcombo c = combobuf[cid];
+	int32_t last = c.o_tile;
+	
+	for(int32_t q = 1; q < c.frames; ++q)
+	{
+		int32_t prev = last;
+		last += 1+c.skipanim;
+		
+		if(TILEROW(last) != TILEROW(prev))
+			last += c.skipanimy*TILES_PER_ROW;
+	}
+	
+	last += (th-1)*TILES_PER_ROW + tw-1;
+	c.tile = c.o_tile;
+	c.cur_frame = 0;
+	c.aclk = 0;
+	map_render_mix(h, &c, sizeof(c));
+	
+	for(int32_t t = zc_max(c.o_tile, 0); t <= last && t < NEWMAXTILES; ++t)
+	{
+		map_render_mix(h, &newtilebuf[t].format, sizeof(newtilebuf[t].format));
+		
+		if(newtilebuf[t].data)
+			map_render_mix(h, newtilebuf[t].data, tilesize(newtilebuf[t].format));
+	}
+}
+
+static void map_render_use_combos(std::vector<bool> &used, word const *cids, size_t n)
+{
+	for(size_t i=0; i<n; ++i)
+	{
+		if(cids[i] < MAXCOMBOS)
+			used[cids[i]] = true;
+	}
+}
+
+static void map_render_use_screen(std::vector<bool> &used, mapscr const& scr)
+{
+	for(size_t i=0; i<scr.data.size(); ++i)
+	{
+		if(scr.data[i] < MAXCOMBOS)
+			used[scr.data[i]] = true;
+	}
+}
+
+static uint64_t map_render_hash()
+{
+	uint64_t h = 0xCBF29CE484222325ULL;
+	map_render_mix(h, &currmap, sizeof(currmap));
+	map_render_mix(h, &currdmap, sizeof(currdmap));
+	map_render_mix(h, &DMaps[currdmap].flags, sizeof(DMaps[currdmap].flags));
+	map_render_mix(h, &DMaps[currdmap].type, sizeof(DMaps[currdmap].type));
+	map_render_mix(h, &DMaps[currdmap].xoff, sizeof(DMaps[currdmap].xoff));
+	map_render_mix(h, DMaps[currdmap].grid, sizeof(DMaps[currdmap].grid));
+	map_render_mix(h, &game->maps[currmap*MAPSCRSNORMAL], MAPSCRSNORMAL*sizeof(word));
+	byte rules[2] = { byte(get_bit(quest_rules, qr_PUSHBLOCK_LAYER_1_2)), byte(get_bit(quest_rules, qr_OVERHEAD_COMBOS_L1_L2)) };
+	map_render_mix(h, rules, 2);
+	
+	std::vector<bool> used(MAXCOMBOS, false);
+	std::vector<bool> used_doors(MAXDOORCOMBOSETS, false);
+	
+	for(int32_t s=0; s<MAPSCRSNORMAL; ++s)
+	{
+		if(!displayOnMap(s&15, s>>4))
+			continue;
+			
+		mapscr const& scr = TheMaps[currmap*MAPSCRS+s];
+		map_render_mix_screen(h, scr);
+		map_render_use_screen(used, scr);
+		
+		if(scr.door_combo_set < MAXDOORCOMBOSETS)
+			used_doors[scr.door_combo_set] = true;
+			
+		for(int32_t i=0; i<MAXFFCS; ++i)
+		{
+			if(scr.ffdata[i] && scr.ffdata[i] < MAXCOMBOS)
+				map_render_mix_combo(h, scr.ffdata[i], scr.ffTileWidth(i), scr.ffTileHeight(i));
+		}
+		
+		for(int32_t i=0; i<6; ++i)
+		{
+			if(scr.layermap[i]>0)
+			{
+				mapscr const& layer = TheMaps[(scr.layermap[i]-1)*MAPSCRS+scr.layerscreen[i]];
+				map_render_mix_screen(h, layer);
+				map_render_use_screen(used, layer);
+			}
+		}
+	}
+	
+	for(int32_t i=0; i<MAXDOORCOMBOSETS; ++i)
+	{
+		if(!used_doors[i])
+			continue;
+			
+		DoorComboSet const& d = DoorComboSets[i];
+		map_render_mix(h, &d, sizeof(d));
+		map_render_use_combos(used, &d.doorcombo_u[0][0], 9*4);
+		map_render_use_combos(used, &d.doorcombo_d[0][0], 9*4);
+		map_render_use_combos(used, &d.doorcombo_l[0][0], 9*6);
+		map_render_use_combos(used, &d.doorcombo_r[0][0], 9*6);
+		map_render_use_combos(used, d.bombdoorcombo_u, 2);
+		map_render_use_combos(used, d.bombdoorcombo_d, 2);
+		map_render_use_combos(used, d.bombdoorcombo_l, 3);
+		map_render_use_combos(used, d.bombdoorcombo_r, 3);
+	}
+	
+	for(int32_t i=0; i<MAXCOMBOS; ++i)
+	{
+		if(used[i])
+			map_render_mix_combo(h, i);
+	}
+	
+	return h;
+}
+
+void clear_map_render()
+{
+	if(map_render)
+	{
+		destroy_bitmap(map_render);
+		map_render = NULL;
+	}
+}
+
+BITMAP *render_current_map(bool redraw)
+{
+	uint64_t key = map_render_hash();
+	
+	if(map_render && key == map_render_key && !redraw)
+	{
+		return map_render;
+	}
+	
+	if(!map_render)
+	{
+		map_render = create_bitmap_ex(8,256*16,176*8);
+	}
+	
+	//its own buffer, as the map picture can be taken mid-scroll
+	BITMAP *drawbuf = create_bitmap_ex(8,512,224);
+	
+	if(!map_render || !drawbuf)
+	{
+		if(drawbuf)
+			destroy_bitmap(drawbuf);
+			
+		clear_map_render();
+		return NULL;
+	}
+	
+	map_render_key = key;
+	
 	mapscr tmpscr_b[2];
 	mapscr tmpscr_c[6];
 	
@@ -5870,39 +6225,14 @@ void ViewMap()
 		tmpscr[i].zero_memory();
 	}
 	
-	BITMAP* mappic = NULL;
-	static double scales[17] =
-	{
-		0.03125, 0.04419, 0.0625, 0.08839, 0.125, 0.177, 0.25, 0.3535,
-		0.50, 0.707, 1.0, 1.414, 2.0, 2.828, 4.0, 5.657, 8.0
-	};
-	
-	int32_t px = ((8-(currscr&15)) << 9)  - 256;
-	int32_t py = ((4-(currscr>>4)) * 352) - 176;
-	int32_t lx = ((currscr&15)<<8)  + HeroX()+8;
-	int32_t ly = ((currscr>>4)*176) + HeroY()+8;
-	int32_t sc = 6;
-	
-	bool done=false, redraw=true;
-	
-	mappic = create_bitmap_ex(8,(256*16)>>mapres,(176*8)>>mapres);
-	
-	if(!mappic)
-	{
-		system_pal();
-		jwin_alert("View Map","Not enough memory.",NULL,NULL,"OK",NULL,13,27,lfont);
-		game_pal();
-		return;
-	}
-	
 	// draw the map
-	set_clip_rect(scrollbuf, 0, 0, scrollbuf->w, scrollbuf->h);
+	set_clip_rect(drawbuf, 0, 0, drawbuf->w, drawbuf->h);
 	
 	for(int32_t y=0; y<8; y++)
 	{
 		for(int32_t x=0; x<16; x++)
 		{
-			rectfill(scrollbuf, 256, 0, 511, 223, WHITE);
+			rectfill(drawbuf, 256, 0, 511, 223, WHITE);
 			if(displayOnMap(x, y))
 			{
 				int32_t s = (y<<4) + x;
@@ -5931,39 +6261,39 @@ void ViewMap()
 						}
 					}
 					
-					if(XOR((tmpscr)->flags7&fLAYER2BG, DMaps[currdmap].flags&dmfLAYER2BG)) do_layer(scrollbuf, 0, 2, tmpscr, -256, playing_field_offset, 2);
+					if(XOR((tmpscr)->flags7&fLAYER2BG, DMaps[currdmap].flags&dmfLAYER2BG)) do_layer(drawbuf, 0, 2, tmpscr, -256, playing_field_offset, 2);
 					
-					if(XOR((tmpscr)->flags7&fLAYER3BG, DMaps[currdmap].flags&dmfLAYER3BG)) do_layer(scrollbuf, 0, 3, tmpscr, -256, playing_field_offset, 2);
+					if(XOR((tmpscr)->flags7&fLAYER3BG, DMaps[currdmap].flags&dmfLAYER3BG)) do_layer(drawbuf, 0, 3, tmpscr, -256, playing_field_offset, 2);
 					
-					putscr(scrollbuf,256,0,tmpscr);
-					do_layer(scrollbuf, 0, 1, tmpscr, -256, playing_field_offset, 2);
+					putscr(drawbuf,256,0,tmpscr);
+					do_layer(drawbuf, 0, 1, tmpscr, -256, playing_field_offset, 2);
 					
-					if(!XOR(((tmpscr)->flags7&fLAYER2BG), DMaps[currdmap].flags&dmfLAYER2BG)) do_layer(scrollbuf, 0, 2, tmpscr, -256, playing_field_offset, 2);
+					if(!XOR(((tmpscr)->flags7&fLAYER2BG), DMaps[currdmap].flags&dmfLAYER2BG)) do_layer(drawbuf, 0, 2, tmpscr, -256, playing_field_offset, 2);
 					
-					putscrdoors(scrollbuf,256,0,tmpscr);
-					do_layer(scrollbuf,-2, 0, tmpscr, -256, playing_field_offset, 2);
+					putscrdoors(drawbuf,256,0,tmpscr);
+					do_layer(drawbuf,-2, 0, tmpscr, -256, playing_field_offset, 2);
 					if(get_bit(quest_rules, qr_PUSHBLOCK_LAYER_1_2))
 					{
-						do_layer(scrollbuf,-2, 1, tmpscr, -256, playing_field_offset, 2);
-						do_layer(scrollbuf,-2, 2, tmpscr, -256, playing_field_offset, 2);
+						do_layer(drawbuf,-2, 1, tmpscr, -256, playing_field_offset, 2);
+						do_layer(drawbuf,-2, 2, tmpscr, -256, playing_field_offset, 2);
 					}
-					do_layer(scrollbuf,-3, 0, tmpscr, -256, playing_field_offset, 2); // Freeform combos!
+					do_layer(drawbuf,-3, 0, tmpscr, -256, playing_field_offset, 2); // Freeform combos!
 					
-					if(!XOR(((tmpscr)->flags7&fLAYER3BG), DMaps[currdmap].flags&dmfLAYER3BG)) do_layer(scrollbuf, 0, 3, tmpscr, -256, playing_field_offset, 2);
+					if(!XOR(((tmpscr)->flags7&fLAYER3BG), DMaps[currdmap].flags&dmfLAYER3BG)) do_layer(drawbuf, 0, 3, tmpscr, -256, playing_field_offset, 2);
 					
-					do_layer(scrollbuf, 0, 4, tmpscr, -256, playing_field_offset, 2);
-					do_layer(scrollbuf,-1, 0, tmpscr, -256, playing_field_offset, 2);
+					do_layer(drawbuf, 0, 4, tmpscr, -256, playing_field_offset, 2);
+					do_layer(drawbuf,-1, 0, tmpscr, -256, playing_field_offset, 2);
 					if(get_bit(quest_rules, qr_OVERHEAD_COMBOS_L1_L2))
 					{
-						do_layer(scrollbuf,-1, 1, tmpscr, -256, playing_field_offset, 2);
-						do_layer(scrollbuf,-1, 2, tmpscr, -256, playing_field_offset, 2);
+						do_layer(drawbuf,-1, 1, tmpscr, -256, playing_field_offset, 2);
+						do_layer(drawbuf,-1, 2, tmpscr, -256, playing_field_offset, 2);
 					}
-					do_layer(scrollbuf, 0, 5, tmpscr, -256, playing_field_offset, 2);
-					do_layer(scrollbuf, 0, 6, tmpscr, -256, playing_field_offset, 2);
+					do_layer(drawbuf, 0, 5, tmpscr, -256, playing_field_offset, 2);
+					do_layer(drawbuf, 0, 6, tmpscr, -256, playing_field_offset, 2);
 				}
 			}
 			
-			stretch_blit(scrollbuf, mappic, 256, 0, 256, 176, x<<(8-mapres), (y*176)>>mapres, 256>>mapres, 176>>mapres);
+			blit(drawbuf, map_render, 256, 0, x<<8, y*176, 256, 176);
 		}
 	}
 	
@@ -5979,6 +6309,42 @@ void ViewMap()
 		tmpscr[i]=tmpscr_b[i];
 	}
 	
+	destroy_bitmap(drawbuf);
+	return map_render;
+}
+
+void ViewMap()
+{
+	BITMAP* mappic = NULL;
+	static double scales[17] =
+	{
+		0.03125, 0.04419, 0.0625, 0.08839, 0.125, 0.177, 0.25, 0.3535,
+		0.50, 0.707, 1.0, 1.414, 2.0, 2.828, 4.0, 5.657, 8.0
+	};
+	
+	int32_t px = ((8-(currscr&15)) << 9)  - 256;
+	int32_t py = ((4-(currscr>>4)) * 352) - 176;
+	int32_t lx = ((currscr&15)<<8)  + HeroX()+8;
+	int32_t ly = ((currscr>>4)*176) + HeroY()+8;
+	int32_t sc = 6;
+	
+	bool done=false, redraw=true;
+	
+	BITMAP* full = render_current_map();
+	mappic = full ? create_bitmap_ex(8,(256*16)>>mapres,(176*8)>>mapres) : NULL;
+	
+	if(!mappic)
+	{
+		system_pal();
+		jwin_alert("View Map","Not enough memory.",NULL,NULL,"OK",NULL,13,27,lfont);
+		game_pal();
+		return;
+	}
+	
+	if(mapres==0)
+		blit(full, mappic, 0, 0, 0, 0, full->w, full->h);
+	else
+		stretch_blit(full, mappic, 0, 0, full->w, full->h, 0, 0, mappic->w, mappic->h);
 	
 	clear_keybuf();
 	pause_all_sfx();
@@ -125,6 +125,8 @@ void over_door(BITMAP *dest,int32_t t, int32_t pos,int32_t side);
 void putdoor(BITMAP *dest,int32_t t,int32_t side,int32_t door,bool redraw=true,bool even_walls=false);
 void showbombeddoor(BITMAP *dest, int32_t side);
 void openshutters();
+void clear_screen_prefetch();
+void prefetch_screen(int32_t map, int32_t scr);
 void loadscr2(int32_t tmp,int32_t scr,int32_t);
 void loadscr(int32_t tmp,int32_t destdmap,int32_t scr,int32_t ldir,bool overlay);
 void putscr(BITMAP* dest,int32_t x,int32_t y,mapscr* screen);
@@ -150,6 +152,8 @@ void doDarkroomCone(int32_t sx, int32_t sy, byte glowRad, int32_t dir, BITMAP* d
 /****  View Map  ****/
 extern int32_t mapres;
 bool displayOnMap(int32_t x, int32_t y);
+BITMAP *render_current_map(bool redraw = false);
+void clear_map_render();
 void ViewMap();
 int32_t onViewMap();
 
@@ -5,6 +5,10 @@
 #include "precompiled.h" //always first
 
 #include "particles.h"
+#include "zsys.h"
+#include "zc_trig.h"
+
+extern byte quest_rules[QUESTRULES_NEW_SIZE];
 
 particle::~particle()
 {
@@ -34,14 +38,33 @@ particle::particle(zfix X,zfix Y,int32_t L,int32_t CS,int32_t C)
 	yofs = 54;
 	dir = 0;
 	step = 0;
+	angular = false;
+	angle = 0;
+	trig_angle = 0;
+	trig_cos = 1;
+	trig_sin = 0;
 }
 
 void particle::move(zfix s)
 {
     if(angular)
     {
-        x += cos(angle)*s;
-        y += sin(angle)*s;
+		if(get_bit(quest_rules,qr_LOOKUP_TRIG))
+		{
+			uint32_t phase = zc::trig::PhaseRad(angle);
+			x += zslongToFix(zc::trig::CosPhase(phase))*s;
+			y += zslongToFix(zc::trig::SinPhase(phase))*s;
+			return;
+		}
+		if(angle != trig_angle)
+		{
+			trig_angle = angle;
+			trig_cos = cos(angle);
+			trig_sin = sin(angle);
+		}
+		
+        x += trig_cos*s;
+        y += trig_sin*s;
 		return;
     }
 	
@@ -139,10 +162,17 @@ bool pTwilight::animate(int32_t)
 }
 
 // Particle List
-particle_list::particle_list() : count(0), active_iterator(0), max_particles(255) {}
+particle_list::particle_list() : count(0), active_iterator(0), max_particles(255), uidsDirtyFrom(PARTLIST_MAX), layersDirty(true) {}
 void particle_list::clear()
 {
-	while(count>0) del(0);
+	for(int32_t i=0; i<count; i++)
+		delete particles[i];
+		
+	count=0;
+	active_iterator=-1;
+	containedUIDs.clear();
+	uidsDirtyFrom=PARTLIST_MAX;
+	layersDirty=true;
 	lastUIDRequested=0;
 	lastRequested=0;
 }
@@ -165,6 +195,7 @@ bool particle_list::swap(int32_t a,int32_t b)
 	particles[b] = c;
 	containedUIDs[particles[a]->getUID()] = a;
 	containedUIDs[particles[b]->getUID()] = b;
+	layersDirty=true;
 	return true;
 }
 
@@ -178,6 +209,7 @@ bool particle_list::add(particle *p)
 	
 	containedUIDs[p->getUID()] = count;
 	particles[count++]=p;
+	layersDirty=true;
 	//checkConsistency();
 	return true;
 }
@@ -185,17 +217,7 @@ bool particle_list::add(particle *p)
 bool particle_list::remove(particle *p)
 // removes pointer from list but doesn't delete it
 {
-	if(p==lastRequested)
-	{
-		lastUIDRequested=0;
-		lastRequested=0;
-	}
-	
-	map<int32_t, int32_t>::iterator it = containedUIDs.find(p->getUID());
-	
-	if(it != containedUIDs.end())
-		containedUIDs.erase(it);
-		
+	forget(p);
 	int32_t j=0;
 	
 	for(; j<count; j++)
@@ -206,13 +228,7 @@ bool particle_list::remove(particle *p)
 	
 gotit:
 
-	for(int32_t i=j; i<count-1; i++)
-	{
-		particles[i]=particles[i+1];
-		containedUIDs[particles[i]->getUID()] = i;
-	}
-	
-	--count;
+	removeAt(j);
 	//checkConsistency();
 	return true;
 }
@@ -242,33 +258,90 @@ bool particle_list::del(int32_t j)
 	if(j<0||j>=count)
 		return false;
 		
-	map<int32_t, int32_t>::iterator it = containedUIDs.find(particles[j]->getUID());
+	forget(particles[j]);
+	delete particles[j];
+	removeAt(j);
+	if(j<=active_iterator) --active_iterator;
+	//checkConsistency();
+	return true;
+}
+
+// Drops p from the UID index and the request cache.
+void particle_list::forget(particle *p)
+{
+	map<int32_t, int32_t>::iterator it = containedUIDs.find(p->getUID());
 	
 	if(it != containedUIDs.end())
 		containedUIDs.erase(it);
-	
-	if(particles[j]==lastRequested)
+		
+	if(p==lastRequested)
 	{
 		lastUIDRequested=0;
 		lastRequested=0;
 	}
+}
+
+// Closes the gap at j, keeping list order. Indices of the shifted
+// particles are fixed up by the next syncUIDs().
+void particle_list::removeAt(int32_t j)
+{
+	memmove(particles+j, particles+j+1, (count-j-1)*sizeof(particle*));
+	--count;
+	layersDirty=true;
 	
-	delete particles[j];
-	
-	for(int32_t i=j; i<count-1; i++)
-	{
-		particles[i]=particles[i+1];
+	if(j<uidsDirtyFrom)
+		uidsDirtyFrom=j;
+}
+
+void particle_list::syncUIDs()
+{
+	for(int32_t i=uidsDirtyFrom; i<count; i++)
 		containedUIDs[particles[i]->getUID()] = i;
-	}
-	
-	--count;
-	if(j<=active_iterator) --active_iterator;
-	//checkConsistency();
-	return true;
+		
+	uidsDirtyFrom=PARTLIST_MAX;
+}
+
+void particle_list::buildLayers()
+{
+	for(map<int32_t, std::vector<particle*> >::iterator it = layerBuckets.begin(); it != layerBuckets.end(); ++it)
+		it->second.clear();
+		
+	for(int32_t i=0; i<count; i++)
+		layerBuckets[particles[i]->layer].push_back(particles[i]);
+		
+	layersDirty=false;
 }
 
 void particle_list::draw(BITMAP* dest,bool lowfirst,int32_t lyr)
 {
+	// The screen is drawn one layer at a time, so sort particles into
+	// layers once instead of scanning the whole list for every layer.
+	if(lyr>-999)
+	{
+		if(layersDirty)
+			buildLayers();
+			
+		map<int32_t, std::vector<particle*> >::iterator it = layerBuckets.find(lyr);
+		
+		if(it == layerBuckets.end())
+			return;
+			
+		std::vector<particle*> &bucket = it->second;
+		
+		if(lowfirst)
+		{
+			for(size_t i=0; i<bucket.size(); i++)
+				bucket[i]->draw(dest);
+		}
+		else
+		{
+			for(size_t i=bucket.size(); i>0; i--)
+				bucket[i-1]->draw(dest);
+		}
+		
+		return;
+	}
+	
 	if(lowfirst)
 	{
 		for(int32_t i=0; i<count; i++)
@@ -291,17 +364,34 @@ void particle_list::draw(BITMAP* dest,bool lowfirst,int32_t lyr)
 
 void particle_list::animate()
 {
-	active_iterator = 0;
+	// Particles never look at each other while animating, so the dead
+	// ones are dropped and the survivors packed down in a single pass.
+	int32_t live = 0;
 	
-	while(active_iterator<count)
+	for(active_iterator = 0; active_iterator<count; ++active_iterator)
 	{
-		if(particles[active_iterator]->animate(active_iterator))
+		particle *p = particles[active_iterator];
+		
+		if(p->animate(live))
 		{
-			del(active_iterator);
+			forget(p);
+			delete p;
+			continue;
 		}
 		
-		++active_iterator;
+		if(live != active_iterator)
+		{
+			particles[live] = p;
+			
+			if(live<uidsDirtyFrom)
+				uidsDirtyFrom=live;
+		}
+		
+		++live;
 	}
+	
+	count = live;
+	layersDirty = true;
 	active_iterator = -1;
 }
 
@@ -320,6 +410,7 @@ particle * particle_list::getByUID(int32_t uid)
 	if(uid==lastUIDRequested)
 		return lastRequested;
 	
+	syncUIDs();
 	map<int32_t, int32_t>::iterator it = containedUIDs.find(uid);
 	
 	if(it != containedUIDs.end())
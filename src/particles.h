@@ -4,6 +4,7 @@
 #include "zdefs.h"
 #include "zfix.h"
 #include <map>
+#include <vector>
 
 using std::map;
 
@@ -29,6 +30,10 @@ public:
 	virtual bool animate(int32_t index);
 	virtual void draw(BITMAP *dest);
 	virtual void move(zfix s);
+	
+private:
+	// cos/sin of 'angle', recomputed only when it changes
+	double trig_angle, trig_cos, trig_sin;
 };
 
 class pFaroresWindDust : public particle
@@ -59,9 +64,20 @@ class particle_list
 	int32_t active_iterator;
 	int32_t max_particles;
 	map<int32_t, int32_t> containedUIDs;
+	// containedUIDs indices from here on may be stale; see syncUIDs()
+	int32_t uidsDirtyFrom;
+	// Particles grouped by layer, in list order, for draw(); rebuilt when
+	// the list changes
+	map<int32_t, std::vector<particle*> > layerBuckets;
+	bool layersDirty;
 	// Cache requests from scripts
 	mutable int32_t lastUIDRequested;
 	mutable particle* lastRequested;
+	
+	void forget(particle *p);
+	void removeAt(int32_t j);
+	void syncUIDs();
+	void buildLayers();
 public:
 	particle_list();
 	particle *getByUID(int32_t uid);
@@ -16256,32 +16256,22 @@ int32_t readmapscreen(PACKFILE *f, zquestheader *Header, mapscr *temp_mapscr, zc
     }
     else
     {
-        for(int32_t k=0; k<128; k++)
+        if(!p_igetw_array(temp_mapscr->secretcombo,128,f))
         {
-            if(!p_igetw(&(temp_mapscr->secretcombo[k]),f,true))
-            {
-                return qe_invalid;
-            }
-            
+            return qe_invalid;
         }
     }
     
     if((Header->zelda_version > 0x192)||((Header->zelda_version == 0x192)&&(Header->build>153)))
     {
-        for(int32_t k=0; k<128; k++)
+        if(!pfread(temp_mapscr->secretcset,128,f,true))
         {
-            if(!p_getc(&(temp_mapscr->secretcset[k]),f,true))
-            {
-                return qe_invalid;
-            }
+            return qe_invalid;
         }
         
-        for(int32_t k=0; k<128; k++)
+        if(!pfread(temp_mapscr->secretflag,128,f,true))
         {
-            if(!p_getc(&(temp_mapscr->secretflag[k]),f,true))
-            {
-                return qe_invalid;
-            }
+            return qe_invalid;
         }
     }
     
@@ -16299,12 +16289,9 @@ int32_t readmapscreen(PACKFILE *f, zquestheader *Header, mapscr *temp_mapscr, zc
     temp_mapscr->sflag.resize(_mapsSize, 0);
     temp_mapscr->cset.resize(_mapsSize, 0);
     
-    for(int32_t k=0; k<(temp_map->tileWidth*temp_map->tileHeight); k++)
+    if(!p_igetw_array(temp_mapscr->data.data(),_mapsSize,f))
     {
-        if(!p_igetw(&(temp_mapscr->data[k]),f,true))
-        {
-            return qe_invalid;
-        }
+        return qe_invalid;
     }
     
     if((Header->zelda_version == 0x192)&&(Header->build>20)&&(Header->build<24))
@@ -16320,7 +16307,14 @@ int32_t readmapscreen(PACKFILE *f, zquestheader *Header, mapscr *temp_mapscr, zc
         }
     }
     
-    if((Header->zelda_version > 0x192)||((Header->zelda_version == 0x192)&&(Header->build>20)))
+    if((Header->zelda_version > 0x192)||((Header->zelda_version == 0x192)&&(Header->build>=24)))
+    {
+        if(!pfread(temp_mapscr->sflag.data(),_mapsSize,f,true))
+        {
+            return qe_invalid;
+        }
+    }
+    else if((Header->zelda_version == 0x192)&&(Header->build>20))
     {
         for(int32_t k=0; k<(temp_map->tileWidth*temp_map->tileHeight); k++)
         {
@@ -16329,35 +16323,19 @@ int32_t readmapscreen(PACKFILE *f, zquestheader *Header, mapscr *temp_mapscr, zc
                 return qe_invalid;
             }
             
-            if((Header->zelda_version == 0x192)&&(Header->build<24))
+            // 3 bytes of padding after each flag
+            if(!pfread(NULL,3,f,false))
             {
-                if(!p_getc(&tempbyte,f,true))
-                {
-                    return qe_invalid;
-                }
-                
-                if(!p_getc(&tempbyte,f,true))
-                {
-                    return qe_invalid;
-                }
-                
-                if(!p_getc(&tempbyte,f,true))
-                {
-                    return qe_invalid;
-                }
+                return qe_invalid;
             }
         }
     }
     
     if((Header->zelda_version > 0x192)||((Header->zelda_version == 0x192)&&(Header->build>97)))
     {
-        for(int32_t k=0; k<(temp_map->tileWidth*temp_map->tileHeight); k++)
+        if(!pfread(temp_mapscr->cset.data(),_mapsSize,f,true))
         {
-        
-            if(!p_getc(&(temp_mapscr->cset[k]),f,true))
-            {
-                return qe_invalid;
-            }
+            return qe_invalid;
         }
     }
     
@@ -16976,7 +16954,7 @@ int32_t readmaps(PACKFILE *f, zquestheader *Header, bool keepdata)
             
 //		delete_theMaps_data( scr );
                 TheMaps[scr] = temp_mapscr;
-                
+                TheMaps[scr].release_empty_combos();
             }
         }
         
@@ -17038,9 +17016,49 @@ int32_t readmaps(PACKFILE *f, zquestheader *Header, bool keepdata)
     }
     
     clear_screen(&temp_mapscr);
+    if(keepdata)
+        report_map_memory();
     return 0;
 }
 
+void report_map_memory()
+{
+    long total = 0, total_empty = 0;
+    int32_t total_released = 0;
+    
+    for(int32_t i=0; i<map_count && (i+1)*MAPSCRS<=int32_t(TheMaps.size()); i++)
+    {
+        long bytes = 0, empty = 0;
+        int32_t valid = 0, released = 0;
+        
+        for(int32_t j=0; j<MAPSCRS; j++)
+        {
+            mapscr const& scr = TheMaps[i*MAPSCRS+j];
+            long scrbytes = long(sizeof(mapscr)
+                + scr.data.capacity()*sizeof(word)
+                + scr.sflag.capacity()*sizeof(byte)
+                + scr.cset.capacity()*sizeof(byte));
+            bytes += scrbytes;
+            
+            if(scr.valid&mVALID)
+                ++valid;
+            else empty += scrbytes;
+            
+            if(scr.data.empty())
+                ++released;
+        }
+        
+        al_trace("Map %d: %d/%d screens valid, %d without combo storage, %ld KB (%ld KB in unused screens)\n",
+            i+1, valid, MAPSCRS, released, bytes/1024, empty/1024);
+        total += bytes;
+        total_empty += empty;
+        total_released += released;
+    }
+    
+    al_trace("Map storage: %ld KB (%ld KB in unused screens), %d screens without combo storage\n",
+        total/1024, total_empty/1024, total_released);
+}
+
 
 int32_t readcombos(PACKFILE *f, zquestheader *Header, word version, word build, word start_combo, word max_combos, bool keepdata)
 {
@@ -17242,12 +17260,9 @@ int32_t readcombos(PACKFILE *f, zquestheader *Header, word version, word build,
 		
 		if(section_version>=8) //combo Attributes[4] and userflags.
 		{
-			for ( int32_t q = 0; q < NUM_COMBO_ATTRIBUTES; q++ )
+			if(!p_igetl_array(temp_combo.attributes,NUM_COMBO_ATTRIBUTES,f))
 			{
-				if(!p_igetl(&temp_combo.attributes[q],f,true))
-				{
-					return qe_invalid;
-				}
+				return qe_invalid;
 			}
 			if(!p_igetl(&temp_combo.usrflags,f,true))
 			{
@@ -17294,22 +17309,16 @@ int32_t readcombos(PACKFILE *f, zquestheader *Header, word version, word build,
 		}
 		if(section_version>=10) //combo trigger flags
 		{
-			for ( int32_t q = 0; q < 3; q++ )
+			if(!p_igetl_array(temp_combo.triggerflags,3,f))
 			{
-				if(!p_igetl(&temp_combo.triggerflags[q],f,true))
-				{
-					return qe_invalid;
-				}
+				return qe_invalid;
 			}
 		}
 		else if(section_version==9) //combo trigger flags, V9 only had two indices of triggerflags[]
 		{
-			for ( int32_t q = 0; q < 2; q++ )
+			if(!p_igetl_array(temp_combo.triggerflags,2,f))
 			{
-				if(!p_igetl(&temp_combo.triggerflags[q],f,true))
-				{
-					return qe_invalid;
-				}
+				return qe_invalid;
 			}
 		}
 		if(section_version >= 9)
@@ -17329,12 +17338,9 @@ int32_t readcombos(PACKFILE *f, zquestheader *Header, word version, word build,
 		
 		if(section_version>=12) //combo label
 		{
-			for ( int32_t q = 0; q < 11; q++ )
+			if(!pfread(temp_combo.label,11,f,true))
 			{
-				if(!p_getc(&temp_combo.label[q],f,true))
-				{
 				return qe_invalid;
-				}
 			}
 		}
 		if(section_version<12) //combo label
@@ -17347,12 +17353,9 @@ int32_t readcombos(PACKFILE *f, zquestheader *Header, word version, word build,
 		//al_trace("Read combo label\n");
 		if(section_version>=13) //attribytes[4]
 		{
-			for ( int32_t q = 0; q < 4; q++ ) //Bad Zoria, don't mix constants with hardcodes
+			if(!pfread(temp_combo.attribytes,4,f,true))
 			{
-				if(!p_getc(&temp_combo.attribytes[q],f,true))
-				{
 				return qe_invalid;
-				}
 			}
 			
 		}
@@ -17378,12 +17381,9 @@ int32_t readcombos(PACKFILE *f, zquestheader *Header, word version, word build,
 		if(section_version>=14) 
 		{
 			if(!p_igetw(&temp_combo.script,f,true)) return qe_invalid;
-			for ( int32_t q = 0; q < 2; q++ )
+			if(!p_igetl_array(temp_combo.initd,2,f))
 			{
-				if(!p_igetl(&temp_combo.initd[q],f,true))
-				{
 				return qe_invalid;
-				}
 			}
 			
 		}
@@ -17411,19 +17411,13 @@ int32_t readcombos(PACKFILE *f, zquestheader *Header, word version, word build,
 		}
 		if(section_version>=17) //attribytes[4]
 		{
-			for ( int32_t q = 4; q < 8; q++ ) //bump up attribytes...
+			if(!pfread(&temp_combo.attribytes[4],4,f,true)) //bump up attribytes...
 			{
-				if(!p_getc(&temp_combo.attribytes[q],f,true))
-				{
 				return qe_invalid;
-				}
 			}
-			for ( int32_t q = 0; q < 8; q++ ) //...and add attrishorts
+			if(!p_igetw_array(temp_combo.attrishorts,8,f)) //...and add attrishorts
 			{
-				if(!p_igetw(&temp_combo.attrishorts[q],f,true))
-				{
 				return qe_invalid;
-				}
 			}
 			
 		}
@@ -20404,6 +20398,10 @@ int32_t _lq_int(const char *filename, zquestheader *Header, miscQdata *Misc, zct
     
     if(!f)
         return open_error;
+        
+    // Unpack the whole quest into memory up front; the loaders below read
+    // it a few bytes at a time.
+    f=pack_fopen_buffered(f);
 	char zinfofilename[2048];
 	replace_extension(zinfofilename, filename, "zinfo", 2047);
     int32_t ret=0;
@@ -239,6 +239,7 @@ int32_t readweapons(PACKFILE *f, zquestheader *Header, bool keepdata);
 int32_t readguys(PACKFILE *f, zquestheader *Header, bool keepdata);
 int32_t readmapscreen(PACKFILE *f, zquestheader *Header, mapscr *temp_mapscr, zcmap *temp_map, word version);
 int32_t readmaps(PACKFILE *f, zquestheader *Header, bool keepdata);
+void report_map_memory();
 int32_t readcombos(PACKFILE *f, zquestheader *Header, word version, word build, word start_combo, word max_combos, bool keepdata);
 int32_t readcomboaliases(PACKFILE *f, zquestheader *Header, word version, word build, bool keepdata);
 int32_t readcolordata(PACKFILE *f, miscQdata *Misc, word version, word build, word start_cset, word max_csets, bool keepdata);
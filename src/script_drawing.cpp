@@ -21,6 +21,7 @@
 #include "util.h"
 #include "subscr.h"
 #include "drawing.h"
+#include "frametimer.h"
 using namespace util;
 extern FFScript FFCore;
 extern ZModule zcm;
@@ -10910,6 +10911,7 @@ void do_primitives(BITMAP *targetBitmap, int32_t type, mapscr* theScreen, int32_
 		return;
 	if(theScreen->hidescriptlayers & (1<<type))
 		return; //Script draws hidden for this layer
+	frame_phase_scope script_draw_timer(fpSCRIPT_DRAWS);
 	//--script_drawing_commands[][] reference--
 	//[][0]: type
 	//[][1-16]: defined by type
@@ -42,6 +42,7 @@ extern bool show_hitboxes;
 extern bool is_zquest();
 extern void debugging_box(int32_t x1, int32_t y1, int32_t x2, int32_t y2);
 #include "ffscript.h"
+#include "zc_trig.h"
 extern FFScript FFCore;
 
 #define degtoFix(d)     ((d)*0.7111111111111)
@@ -100,6 +101,9 @@ sprite::sprite()
     lasthitclk=0;
     lasthit=0;
     angle=0;
+    trig_angle=0;
+    trig_cos=1;
+    trig_sin=0;
     misc=0;
     pit_pulldir = -1;
 	pit_pullclk = 0;
@@ -263,6 +267,9 @@ can_flicker(other.can_flicker)
 {
     uid = getNextUID();
 	isspawning = other.isspawning;
+	trig_angle = 0;
+	trig_cos = 1;
+	trig_sin = 0;
     
     for(int32_t i=0; i<10; ++i)
     {
@@ -1017,8 +1024,22 @@ void sprite::move(zfix s)
 {
     if(angular)
     {
-        x += cos(angle)*s;
-        y += sin(angle)*s;
+		if(get_bit(quest_rules,qr_LOOKUP_TRIG))
+		{
+			uint32_t phase = zc::trig::PhaseRad(angle);
+			x += zslongToFix(zc::trig::CosPhase(phase))*s;
+			y += zslongToFix(zc::trig::SinPhase(phase))*s;
+			return;
+		}
+		if(angle != trig_angle)
+		{
+			trig_angle = angle;
+			trig_cos = cos(angle);
+			trig_sin = sin(angle);
+		}
+		
+        x += trig_cos*s;
+        y += trig_sin*s;
 		return;
     }
     
@@ -2072,7 +2093,7 @@ int32_t sprite::run_script(int32_t mode)
 
 //class enemy;
 
-sprite_list::sprite_list() : count(0), active_iterator(0), max_sprites(255) {}
+sprite_list::sprite_list() : count(0), active_iterator(0), max_sprites(255), uidsDirtyFrom(SLMAX) {}
 void sprite_list::clear()
 {
     while(count>0) del(0);
@@ -2140,13 +2161,7 @@ bool sprite_list::remove(sprite *s)
     
 gotit:
 
-    for(int32_t i=j; i<count-1; i++)
-    {
-        sprites[i]=sprites[i+1];
-        containedUIDs[sprites[i]->getUID()] = i;
-    }
-    
-    --count;
+    removeAt(j);
     //checkConsistency();
     return true;
 }
@@ -2208,19 +2223,33 @@ bool sprite_list::del(int32_t j)
     }
     
     delete sprites[j];
-    
-    for(int32_t i=j; i<count-1; i++)
-    {
-        sprites[i]=sprites[i+1];
-        containedUIDs[sprites[i]->getUID()] = i;
-    }
-    
-    --count;
+    removeAt(j);
 	if(j<=active_iterator) --active_iterator;
     //checkConsistency();
     return true;
 }
 
+// Closes the gap left at j, keeping draw order. The UID indices of the
+// shifted sprites are fixed up lazily by syncUIDs(), so a burst of
+// deletions (a bomb clearing the screen, a bullet pattern expiring)
+// costs one index pass instead of one per deletion.
+void sprite_list::removeAt(int32_t j)
+{
+    memmove(sprites+j, sprites+j+1, (count-j-1)*sizeof(sprite*));
+    --count;
+    
+    if(j<uidsDirtyFrom)
+        uidsDirtyFrom=j;
+}
+
+void sprite_list::syncUIDs()
+{
+    for(int32_t i=uidsDirtyFrom; i<count; i++)
+        containedUIDs[sprites[i]->getUID()] = i;
+        
+    uidsDirtyFrom=SLMAX;
+}
+
 void sprite_list::draw(BITMAP* dest,bool lowfirst)
 {
     switch(lowfirst)
@@ -2460,6 +2489,7 @@ sprite * sprite_list::getByUID(int32_t uid)
     if(uid==lastUIDRequested)
         return lastSpriteRequested;
     
+    syncUIDs();
     map<int32_t, int32_t>::iterator it = containedUIDs.find(uid);
     
     if(it != containedUIDs.end())
@@ -2475,6 +2505,7 @@ sprite * sprite_list::getByUID(int32_t uid)
 
 void sprite_list::checkConsistency()
 {
+    syncUIDs();
     assert((int32_t)containedUIDs.size() == count);
     assert(lastUIDRequested==0 || containedUIDs.find(lastUIDRequested)!=containedUIDs.end());
     
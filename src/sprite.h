@@ -80,6 +80,7 @@ public:
     int32_t id,dir;
     bool angular,canfreeze;
     double angle;
+    double trig_angle, trig_cos, trig_sin; //cos/sin of 'angle', recomputed only when it changes
     int32_t lasthit, lasthitclk;
     int32_t dummy_int[10];
     zfix dummy_fix[10];
@@ -196,6 +197,9 @@ class sprite_list
 	int32_t active_iterator;
 	int32_t max_sprites;
     map<int32_t, int32_t> containedUIDs;
+    // containedUIDs indices from here on may be stale after a removal;
+    // they are brought up to date in one pass on the next UID lookup.
+    int32_t uidsDirtyFrom;
     // Cache requests from scripts
     mutable int32_t lastUIDRequested;
     mutable sprite* lastSpriteRequested;
@@ -247,6 +251,8 @@ public:
     
 private:
 
+    void removeAt(int32_t j);
+    void syncUIDs();
     void checkConsistency(); //for debugging
 };
 
@@ -3699,7 +3699,7 @@ void animate_selectors()
     sel_b->animate(0);
 }
 
-void show_custom_subscreen(BITMAP *dest, miscQdata *misc, subscreen_group *css, int32_t xofs, int32_t yofs, bool showtime, int32_t pos2)
+void show_custom_subscreen(BITMAP *dest, miscQdata *misc, subscreen_group *css, int32_t xofs, int32_t yofs, bool showtime, int32_t pos2, int32_t first, int32_t last)
 {
 	//this is not a good place to be clearing the bitmap
 	//other stuff might already have been drawn on it that needs to be kept
@@ -3724,7 +3724,7 @@ void show_custom_subscreen(BITMAP *dest, miscQdata *misc, subscreen_group *css,
 	if(!sel_a || !sel_b)
 		animate_selectors();
 		
-	for(int32_t i=0; i<MAXSUBSCREENITEMS&&css->objects[i].type>ssoNULL; ++i)
+	for(int32_t i=first; i<last&&i<MAXSUBSCREENITEMS&&css->objects[i].type>ssoNULL; ++i)
 	{
 		if((css->objects[i].pos & pos2) != 0)
 		{
@@ -4711,23 +4711,200 @@ void minimaptitle(BITMAP *dest, int32_t x, int32_t y, FONT *tempfont, int32_t co
     }
 }
 
+// A passive subscreen usually opens with an ssoCLEAR followed by
+// background rectangles, lines and text. Everything up to the first
+// object that depends on game state (or on tiles, the palette's
+// translucency table, or the random subscreen colour) is the same every
+// frame and doesn't depend on what lay under the subscreen, so it is
+// drawn once into passive_cache and blitted after that.
+static BITMAP *passive_cache = NULL;
+static subscreen_group *passive_cache_css = NULL;
+static int32_t passive_cache_pos2 = 0;
+static int32_t passive_cache_height = 0;
+static int32_t passive_cache_len = 0;
+static subscreen_object passive_cache_objects[MAXSUBSCREENITEMS];
+static char passive_cache_text[MAXSUBSCREENITEMS][256];
+static zcolors passive_cache_colors;
+
+static bool static_subscreen_color(int32_t c1, int32_t c2)
+{
+    //unknown misc colours are random
+    return c1!=ssctMISC || (c2>=ssctTEXT && c2<=ssctHERODOT);
+}
+
+static bool static_subscreen_object(subscreen_object const& obj)
+{
+    switch(obj.type)
+    {
+    case ssoCLEAR:
+        return static_subscreen_color(obj.colortype1, obj.color1);
+        
+    case ssoLINE:
+        return !obj.d4 && static_subscreen_color(obj.colortype1, obj.color1);
+        
+    case ssoRECT:
+        return !obj.d2 && static_subscreen_color(obj.colortype1, obj.color1)
+               && static_subscreen_color(obj.colortype2, obj.color2);
+               
+    case ssoTEXT:
+        return obj.dp1 && strlen((char*)obj.dp1)<256
+               && static_subscreen_color(obj.colortype1, obj.color1)
+               && static_subscreen_color(obj.colortype2, obj.color2)
+               && static_subscreen_color(obj.colortype3, obj.color3);
+    }
+    
+    return false;
+}
+
+// Number of leading objects that can come from passive_cache; 0 if the
+// subscreen doesn't start by clearing itself.
+static int32_t static_subscreen_prefix(subscreen_group *css, int32_t pos2)
+{
+    int32_t i=0;
+    bool cleared=false;
+    
+    for(; i<MAXSUBSCREENITEMS&&css->objects[i].type>ssoNULL; ++i)
+    {
+        if((css->objects[i].pos & pos2) == 0)
+            continue;
+            
+        if(!cleared && css->objects[i].type!=ssoCLEAR)
+            return 0;
+            
+        if(!static_subscreen_object(css->objects[i]))
+            break;
+            
+        cleared=true;
+    }
+    
+    return cleared ? i : 0;
+}
+
+static bool passive_cache_valid(miscQdata *misc, subscreen_group *css, int32_t pos2, int32_t len)
+{
+    if(!passive_cache || css!=passive_cache_css || pos2!=passive_cache_pos2
+       || passive_subscreen_height!=passive_cache_height || len!=passive_cache_len
+       || memcmp(&misc->colors, &passive_cache_colors, sizeof(zcolors)))
+        return false;
+        
+    for(int32_t i=0; i<len; ++i)
+    {
+        if(memcmp(&css->objects[i], &passive_cache_objects[i], sizeof(subscreen_object)))
+            return false;
+            
+        if(css->objects[i].type==ssoTEXT && strcmp((char*)css->objects[i].dp1, passive_cache_text[i]))
+            return false;
+    }
+    
+    return true;
+}
+
+static void build_passive_cache(miscQdata *misc, subscreen_group *css, int32_t pos2, int32_t len, bool showtime)
+{
+    if(passive_cache && passive_cache->h!=passive_subscreen_height)
+    {
+        destroy_bitmap(passive_cache);
+        passive_cache=NULL;
+    }
+    
+    if(!passive_cache)
+        passive_cache = create_bitmap_ex(8,256,passive_subscreen_height);
+        
+    show_custom_subscreen(passive_cache, misc, css, 0, 0, showtime, pos2, 0, len);
+    
+    passive_cache_css=css;
+    passive_cache_pos2=pos2;
+    passive_cache_height=passive_subscreen_height;
+    passive_cache_len=len;
+    memcpy(&passive_cache_colors, &misc->colors, sizeof(zcolors));
+    
+    for(int32_t i=0; i<len; ++i)
+    {
+        memcpy(&passive_cache_objects[i], &css->objects[i], sizeof(subscreen_object));
+        
+        if(css->objects[i].type==ssoTEXT)
+            strcpy(passive_cache_text[i], (char*)css->objects[i].dp1);
+    }
+}
+
+// The passive subscreen is drawn through a sub-bitmap of the same spot of
+// framebuf nearly every frame, so it is kept rather than made each time.
+// It is checked against the parent's rows, as a parent freed and allocated
+// again may come back at the same address.
+static BITMAP *passive_subscr = NULL;
+static BITMAP *passive_subscr_parent = NULL;
+
+static BITMAP *passive_subscr_bitmap(BITMAP *dest, int32_t x, int32_t y)
+{
+    if(passive_subscr)
+    {
+        int32_t xofs = x*((bitmap_color_depth(dest)+7)/8);
+        
+        if(passive_subscr_parent!=dest || passive_subscr->h!=passive_subscreen_height
+           || y<0 || y+passive_subscr->h>dest->h || x+passive_subscr->w>dest->w
+           || passive_subscr->line[0]!=dest->line[y]+xofs
+           || passive_subscr->line[passive_subscr->h-1]!=dest->line[y+passive_subscr->h-1]+xofs)
+        {
+            destroy_bitmap(passive_subscr);
+            passive_subscr=NULL;
+        }
+    }
+    
+    if(!passive_subscr)
+    {
+        passive_subscr = create_sub_bitmap(dest,x,y,256,passive_subscreen_height);
+        passive_subscr_parent = dest;
+    }
+    
+    set_clip_state(passive_subscr,1);
+    set_clip_rect(passive_subscr,0,0,passive_subscr->w-1,passive_subscr->h-1);
+    return passive_subscr;
+}
+
+void clear_passive_subscr_cache()
+{
+    if(passive_subscr)
+    {
+        destroy_bitmap(passive_subscr);
+        passive_subscr=NULL;
+    }
+    
+    passive_subscr_parent=NULL;
+    
+    if(passive_cache)
+    {
+        destroy_bitmap(passive_cache);
+        passive_cache=NULL;
+    }
+    
+    passive_cache_css=NULL;
+}
+
 void put_passive_subscr(BITMAP *dest,miscQdata *misc,int32_t x,int32_t y,bool showtime,int32_t pos2)
 {
     // uncomment this?
     //  load_Sitems();
     Sitems.animate();
     update_subscr_items();
-    BITMAP *subscr = create_sub_bitmap(dest,x,y,256,passive_subscreen_height);
+    BITMAP *subscr = passive_subscr_bitmap(dest,x,y);
     
     if(no_subscreen())
     {
         clear_to_color(subscr,0);
-        destroy_bitmap(subscr);
         return;
     }
     
-    show_custom_subscreen(subscr, misc, current_subscreen_passive, 0, 0, showtime, pos2);
-    destroy_bitmap(subscr);
+    int32_t first = static_subscreen_prefix(current_subscreen_passive, pos2);
+    
+    if(first>0)
+    {
+        if(!passive_cache_valid(misc, current_subscreen_passive, pos2, first))
+            build_passive_cache(misc, current_subscreen_passive, pos2, first, showtime);
+            
+        blit(passive_cache, subscr, 0, 0, 0, 0, 256, passive_subscreen_height);
+    }
+    
+    show_custom_subscreen(subscr, misc, current_subscreen_passive, 0, 0, showtime, pos2, first);
 }
 
 /*
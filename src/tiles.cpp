@@ -615,12 +615,34 @@ bool write_tile(tiledata *buf, BITMAP* src, int32_t dest, int32_t x, int32_t y,
 }
 
 
+// unpacks a tile's data into 256 one-byte pixels, unflipped
+// (the 4-bit case is written so the compiler can vectorize it)
+static bool unpack_tiledata(byte *dest, byte const *src, byte format)
+{
+    switch(format)
+    {
+    case tf4Bit:
+        for(int32_t i=0; i<128; ++i)
+        {
+            dest[i*2] = src[i] & 15;
+            dest[i*2+1] = src[i] >> 4;
+        }
+        
+        return true;
+        
+    case tf8Bit:
+        memcpy(dest, src, 256);
+        return true;
+    }
+    
+    return false;
+}
+
 // unpacks from tilebuf to unpackbuf
 void unpack_tile(tiledata *buf, int32_t tile, int32_t flip, bool force)
 {
-    static byte *si, *di;
     static byte *oldnewtilebuf=buf[tile].data;
-    static int32_t i, j, oldtile=-5, oldflip=-5;
+    static int32_t oldtile=-5, oldflip=-5;
     
     if(tile==oldtile&&(flip&5)==(oldflip&5)&&oldnewtilebuf==buf[tile].data&&!force)
     {
@@ -631,179 +653,54 @@ void unpack_tile(tiledata *buf, int32_t tile, int32_t flip, bool force)
     oldflip=flip;
     oldnewtilebuf=buf[tile].data;
     
+    if((flip&5)==0)
+    {
+        unpack_tiledata(unpackbuf, buf[tile].data, buf[tile].format);
+        return;
+    }
+    
+    byte src[256];
+    
+    if(!unpack_tiledata(src, buf[tile].data, buf[tile].format))
+    {
+        return;
+    }
+    
+    byte *di = unpackbuf;
+    
     switch(flip&5)
     {
     case 1:  //horizontal
-        si = buf[tile].data+tilesize(buf[tile].format);
-        
-        for(i=15; i>=0; --i)
+        for(int32_t y=0; y<16; ++y)
         {
-            switch(buf[tile].format)
+            for(int32_t x=0; x<16; ++x)
             {
-            case tf4Bit:
-                di=unpackbuf + (i<<4) - 1;
-                
-                for(j=7; j>=0; --j)
-                {
-                    (*(++di)) = (*(--si)) >> 4;
-                    (*(++di)) = (*si) & 15;
-                }
-                
-                break;
-                
-            case tf8Bit:
-                di=unpackbuf + (i<<4) - 1;
-                
-                for(j=1; j>=0; --j)
-                {
-                    (*(++di)) = (*(--si));
-                    (*(++di)) = (*(--si));
-                    (*(++di)) = (*(--si));
-                    (*(++di)) = (*(--si));
-                    (*(++di)) = (*(--si));
-                    (*(++di)) = (*(--si));
-                    (*(++di)) = (*(--si));
-                    (*(++di)) = (*(--si));
-                }
-                
-                break;
+                *(di++) = src[(y<<4) + 15 - x];
             }
         }
         
         break;
         
     case 4:  //rotated
-        si = buf[tile].data+tilesize(buf[tile].format);
-        
-        for(i=15; i>=0; --i)
+        for(int32_t y=0; y<16; ++y)
         {
-            switch(buf[tile].format)
+            for(int32_t x=0; x<16; ++x)
             {
-            case tf4Bit:
-                di=unpackbuf + 271 - i; //256 + 15 - i
-                
-                for(j=7; j>=0; --j)
-                {
-                    di-=16;
-                    *di = (*(--si)) >> 4;
-                    di-=16;
-                    *di = (*si) & 15;
-                }
-                
-                break;
-                
-            case tf8Bit:
-                di=unpackbuf + 271 - i; //256 + 15 - i
-                
-                for(j=1; j>=0; --j)
-                {
-                    di-=16;
-                    *di = (*(--si));
-                    di-=16;
-                    *di = (*(--si));
-                    di-=16;
-                    *di = (*(--si));
-                    di-=16;
-                    *di = (*(--si));
-                    di-=16;
-                    *di = (*(--si));
-                    di-=16;
-                    *di = (*(--si));
-                    di-=16;
-                    *di = (*(--si));
-                    di-=16;
-                    *di = (*(--si));
-                }
-                
-                break;
+                *(di++) = src[((15-x)<<4) + y];
             }
         }
         
         break;
         
     case 5:  //rotated and horizontal
-        si = buf[tile].data+tilesize(buf[tile].format);
-        
-        for(i=15; i>=0; --i)
+        for(int32_t y=0; y<16; ++y)
         {
-            switch(buf[tile].format)
+            for(int32_t x=0; x<16; ++x)
             {
-            case tf4Bit:
-                di=unpackbuf + 256 + i;
-                
-                for(j=7; j>=0; --j)
-                {
-                    di-=16;
-                    *di = (*(--si)) >> 4;
-                    di-=16;
-                    *di = (*si) & 15;
-                }
-                
-                break;
-                
-            case tf8Bit:
-                di=unpackbuf + 256 + i;
-                
-                for(j=1; j>=0; --j)
-                {
-                    di-=16;
-                    *di = (*(--si));
-                    di-=16;
-                    *di = (*(--si));
-                    di-=16;
-                    *di = (*(--si));
-                    di-=16;
-                    *di = (*(--si));
-                    di-=16;
-                    *di = (*(--si));
-                    di-=16;
-                    *di = (*(--si));
-                    di-=16;
-                    *di = (*(--si));
-                    di-=16;
-                    *di = (*(--si));
-                }
-                
-                break;
+                *(di++) = src[(x<<4) + y];
             }
         }
         
-        break;
-        
-    default: //none or invalid
-        switch(buf[tile].format)
-        {
-        case tf4Bit:
-            si = buf[tile].data+tilesize(buf[tile].format);
-            di = unpackbuf + 256;
-            
-            for(i=127; i>=0; --i)
-            {
-                (*(--di)) = (*(--si)) >> 4;
-                (*(--di)) = (*si) & 15;
-            }
-            
-            break;
-            
-        case tf8Bit:
-            si = buf[tile].data+tilesize(buf[tile].format);
-            di = unpackbuf + 256;
-            
-            for(i=31; i>=0; --i)
-            {
-                (*(--di)) = (*(--si));
-                (*(--di)) = (*(--si));
-                (*(--di)) = (*(--si));
-                (*(--di)) = (*(--si));
-                (*(--di)) = (*(--si));
-                (*(--di)) = (*(--si));
-                (*(--di)) = (*(--si));
-                (*(--di)) = (*(--si));
-            }
-            
-            break;
-        }
-        
         break;
     }
 }
@@ -830,26 +727,7 @@ void pack_tiledata(byte *dest, byte *src, byte format)
         break;
         
     case tf8Bit:
-        for(int32_t si=0; si<32; si+=1)
-        {
-            *di = src[si*8];
-            ++di;
-            *di = src[si*8+1];
-            ++di;
-            *di = src[si*8+2];
-            ++di;
-            *di = src[si*8+3];
-            ++di;
-            *di = src[si*8+4];
-            ++di;
-            *di = src[si*8+5];
-            ++di;
-            *di = src[si*8+6];
-            ++di;
-            *di = src[si*8+7];
-            ++di;
-        }
-        
+        memcpy(di, src, 256);
         break;
     }
 }
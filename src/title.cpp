@@ -2691,15 +2691,16 @@ int32_t save_savedgames()
 		}
 	}
 	
-	char tmpfilename[32];
-	temp_name(tmpfilename);
+	// Encoded straight into a file beside the save, which replaces the old
+	// save only once it has been written out completely.
+	char tmpfilename[2048];
+	replace_extension(tmpfilename, SAVE_FILE, "tmp", 2047);
 	
-	PACKFILE *f = pack_fopen_password(tmpfilename, F_WRITE_PACKED, "");
+	PACKFILE *f = pack_fopen_encoded_007(tmpfilename, 0x413F0000 + (frame&0xffff), SAVE_HEADER, ENC_METHOD_MAX-1, true, "");
 	
 	if(!f)
 	{
-		delete_file(tmpfilename);
-		return 2;
+		return 102;
 	}
 	
 	if(writesaves(saves, f)!=0)
@@ -2709,14 +2710,22 @@ int32_t save_savedgames()
 		return 4;
 	}
 	
-	pack_fclose(f);
-	int32_t ret = encode_file_007(tmpfilename, SAVE_FILE, 0x413F0000 + (frame&0xffff), SAVE_HEADER, ENC_METHOD_MAX-1);
+	int32_t ret = 0;
+	
+	if(pack_fclose(f)!=0)
+		ret = 102;
+	else
+	{
+		if(exists(SAVE_FILE))
+			delete_file(SAVE_FILE);
+			
+		if(rename(tmpfilename, SAVE_FILE)!=0)
+			ret = 102;
+	}
 	
 	if(ret)
-		ret += 100;
+		delete_file(tmpfilename);
 		
-	delete_file(tmpfilename);
-	
 	FILE *f2=NULL;
 	char *iname = (char *)zc_malloc(2048);
 	strcpy(iname, SAVE_FILE);
@@ -32,6 +32,7 @@
 #include "ffscript.h"
 #include "decorations.h"
 #include "drawing.h"
+#include "frametimer.h"
 
 extern HeroClass Hero;
 extern zinitdata zinit;
@@ -8486,6 +8487,7 @@ int32_t weapon::run_script(int32_t mode)
 	if(switch_hooked && !get_bit(quest_rules, qr_SWITCHOBJ_RUN_SCRIPT)) return RUNSCRIPT_OK;
 	if (weaponscript <= 0 || !doscript || FFCore.getQuestHeaderInfo(vZelda) < 0x255 || FFCore.system_suspend[isLWeapon ? susptLWEAPONSCRIPTS : susptEWEAPONSCRIPTS])
 		return RUNSCRIPT_OK;
+	frame_phase_scope script_timer(isLWeapon ? fpLWEAPON_SCRIPTS : fpEWEAPON_SCRIPTS);
 	int32_t ret = RUNSCRIPT_OK;
 	alloc_scriptmem();
 	switch(mode)
@@ -56,6 +56,7 @@
 #include "mem_debug.h"
 #include "zconsole.h"
 #include "ffscript.h"
+#include "frametimer.h"
 extern FFScript FFCore;
 extern bool Playing;
 int32_t sfx_voice[WAV_COUNT];
@@ -339,6 +340,7 @@ void load_game_configs()
     SnapshotFormat = zc_get_config(cfg_sect,"snapshot_format",3);
     NameEntryMode = zc_get_config(cfg_sect,"name_entry_mode",0);
     ShowFPS = zc_get_config(cfg_sect,"showfps",0)!=0;
+    ShowFrameTiming = zc_get_config(cfg_sect,"showframetiming",0)!=0;
     NESquit = zc_get_config(cfg_sect,"fastquit",0)!=0;
     ClickToFreeze = zc_get_config(cfg_sect,"clicktofreeze",1)!=0;
     title_version = zc_get_config(cfg_sect,"title",2);
@@ -512,6 +514,7 @@ void save_game_configs()
     set_config_int(cfg_sect,"snapshot_format",SnapshotFormat);
     set_config_int(cfg_sect,"name_entry_mode",NameEntryMode);
     set_config_int(cfg_sect,"showfps",(int32_t)ShowFPS);
+    set_config_int(cfg_sect,"showframetiming",(int32_t)ShowFrameTiming);
     set_config_int(cfg_sect,"fastquit",(int32_t)NESquit);
     set_config_int(cfg_sect,"clicktofreeze", (int32_t)ClickToFreeze);
     set_config_int(cfg_sect,"title",title_version);
@@ -3935,6 +3938,9 @@ void updatescr(bool allowwavy)
     if(ShowFPS)// &&(frame&1))
         show_fps(target);
         
+    if(ShowFrameTiming)
+        show_frame_timing(target, scrx+40, scry+16);
+        
     if(Paused)
         show_paused(target);
         
@@ -4091,28 +4097,8 @@ int32_t onSnapshot()
 
 int32_t onSaveMapPic()
 {
-	int32_t mapres2 = 0;
 	char buf[200];
 	int32_t num=0;
-	mapscr tmpscr_b[2];
-	mapscr tmpscr_c[6];
-	BITMAP* _screen_draw_buffer = NULL;
-	_screen_draw_buffer = create_bitmap_ex(8,256,224);
-	set_clip_state(_screen_draw_buffer,1);
-	
-	for(int32_t i=0; i<6; ++i)
-	{
-		tmpscr_c[i] = tmpscr2[i];
-		tmpscr2[i].zero_memory();
-		
-		if(i>=2)
-		{
-			continue;
-		}
-		
-		tmpscr_b[i] = tmpscr[i];
-		tmpscr[i].zero_memory();
-	}
 	
 	do
 	{
@@ -4124,106 +4110,31 @@ int32_t onSaveMapPic()
 	}
 	while(num<99999 && exists(buf));
 	
-	BITMAP* mappic = NULL;
-	
-	
-	bool done=false, redraw=true;
+	// drawn fresh, so the picture matches the current frame exactly
+	BITMAP* mappic = render_current_map(true);
 	
-	mappic = create_bitmap_ex(8,(256*16)>>mapres,(176*8)>>mapres);
+	if(mappic && mapres)
+	{
+		BITMAP* full = mappic;
+		mappic = create_bitmap_ex(8,full->w>>mapres,full->h>>mapres);
+		
+		if(mappic)
+			stretch_blit(full, mappic, 0, 0, full->w, full->h, 0, 0, mappic->w, mappic->h);
+	}
 	
 	if(!mappic)
 	{
 		system_pal();
 		jwin_alert("View Map","Not enough memory.",NULL,NULL,"OK",NULL,13,27,lfont);
 		game_pal();
-		return D_O_K;;
+		return D_O_K;
 	}
 	
-	// draw the map
-	set_clip_rect(_screen_draw_buffer, 0, 0, _screen_draw_buffer->w, _screen_draw_buffer->h);
-	
-	for(int32_t y=0; y<8; y++)
-	{
-		for(int32_t x=0; x<16; x++)
-		{
-			if(!displayOnMap(x, y))
-			{
-				rectfill(_screen_draw_buffer, 0, 0, 255, 223, WHITE);
-			}
-			else
-			{
-				int32_t s = (y<<4) + x;
-				loadscr2(1,s,-1);
-				
-				for(int32_t i=0; i<6; i++)
-				{
-					if(tmpscr[1].layermap[i]<=0)
-						continue;
-					
-					if((ZCMaps[tmpscr[1].layermap[i]-1].tileWidth==ZCMaps[currmap].tileWidth) &&
-					   (ZCMaps[tmpscr[1].layermap[i]-1].tileHeight==ZCMaps[currmap].tileHeight))
-					{
-						const int32_t _mapsSize = (ZCMaps[currmap].tileWidth)*(ZCMaps[currmap].tileHeight);
-						
-						tmpscr2[i]=TheMaps[(tmpscr[1].layermap[i]-1)*MAPSCRS+tmpscr[1].layerscreen[i]];
-						
-						tmpscr2[i].data.resize(_mapsSize, 0);
-						tmpscr2[i].sflag.resize(_mapsSize, 0);
-						tmpscr2[i].cset.resize(_mapsSize, 0);
-					}
-				}
-				
-				if(XOR((tmpscr+1)->flags7&fLAYER2BG, DMaps[currdmap].flags&dmfLAYER2BG)) do_layer(_screen_draw_buffer, 0, 2, tmpscr+1, -256, playing_field_offset, 2);
-				
-				if(XOR((tmpscr+1)->flags7&fLAYER3BG, DMaps[currdmap].flags&dmfLAYER3BG)) do_layer(_screen_draw_buffer, 0, 3, tmpscr+1, -256, playing_field_offset, 2);
-				
-				putscr(_screen_draw_buffer,256,0,tmpscr+1);
-				do_layer(_screen_draw_buffer, 0, 1, tmpscr+1, -256, playing_field_offset, 2);
-				
-				if(!XOR((tmpscr+1)->flags7&fLAYER2BG, DMaps[currdmap].flags&dmfLAYER2BG)) do_layer(_screen_draw_buffer, 0, 2, tmpscr+1, -256, playing_field_offset, 2);
-				
-				putscrdoors(_screen_draw_buffer,256,0,tmpscr+1);
-				do_layer(_screen_draw_buffer, -2, 0, tmpscr+1, -256, playing_field_offset, 2);
-				if(get_bit(quest_rules, qr_PUSHBLOCK_LAYER_1_2))
-				{
-					do_layer(_screen_draw_buffer, -2, 1, tmpscr+1, -256, playing_field_offset, 2);
-					do_layer(_screen_draw_buffer, -2, 2, tmpscr+1, -256, playing_field_offset, 2);
-				}
-				do_layer(_screen_draw_buffer, -3, 0, tmpscr+1, -256, playing_field_offset, 2); // Freeform combos!
-				
-				if(!XOR((tmpscr+1)->flags7&fLAYER3BG, DMaps[currdmap].flags&dmfLAYER3BG)) do_layer(_screen_draw_buffer, 0, 3, tmpscr+1, -256, playing_field_offset, 2);
-				
-				do_layer(_screen_draw_buffer, 0, 4, tmpscr+1, -256, playing_field_offset, 2);
-				do_layer(_screen_draw_buffer, -1, 0, tmpscr+1, -256, playing_field_offset, 2);
-				if(get_bit(quest_rules, qr_OVERHEAD_COMBOS_L1_L2))
-				{
-					do_layer(_screen_draw_buffer, -1, 1, tmpscr+1, -256, playing_field_offset, 2);
-					do_layer(_screen_draw_buffer, -1, 2, tmpscr+1, -256, playing_field_offset, 2);
-				}
-				do_layer(_screen_draw_buffer, 0, 5, tmpscr+1, -256, playing_field_offset, 2);
-				do_layer(_screen_draw_buffer, 0, 6, tmpscr+1, -256, playing_field_offset, 2);
-				
-			}
-			
-			stretch_blit(_screen_draw_buffer, mappic, 256, 0, 256, 176, x<<(8-mapres), (y*176)>>mapres, 256>>mapres, 176>>mapres);
-		}
-	}
+	save_bitmap(buf,mappic,RAMpal);
 	
-	for(int32_t i=0; i<6; ++i)
-	{
-		tmpscr2[i]=tmpscr_c[i];
-		
-		if(i>=2)
-		{
-			continue;
-		}
+	if(mapres)
+		destroy_bitmap(mappic);
 		
-		tmpscr[i]=tmpscr_b[i];
-	}
-	
-	save_bitmap(buf,mappic,RAMpal);
-	destroy_bitmap(mappic);
-	destroy_bitmap(_screen_draw_buffer);
 	return D_O_K;
 }
 
@@ -4656,7 +4567,12 @@ void syskeys()
     
     if(zc_readkey(KEY_CLOSEBRACE))    if(frame_rest_suggest <= 2) frame_rest_suggest++;
     
-    if(zc_readkey(KEY_F2))    ShowFPS=!ShowFPS;
+    if(zc_readkey(KEY_F2))
+    {
+        if(zc_getkey(KEY_LSHIFT, true) || zc_getkey(KEY_RSHIFT, true))
+            ShowFrameTiming=!ShowFrameTiming;
+        else ShowFPS=!ShowFPS;
+    }
     
     if(zc_readrawkey(KEY_F3) && Playing)    Paused=!Paused;
     
@@ -4959,6 +4875,7 @@ bool CheatModifierKeys()
 
 void advanceframe(bool allowwavy, bool sfxcleanup, bool allowF6Script)
 {
+    frame_timer_phase(fpAUDIO);
     if(zcmusic!=NULL)
     {
         zcmusic_poll();
@@ -4973,7 +4890,9 @@ void advanceframe(bool allowwavy, bool sfxcleanup, bool allowF6Script)
 			FFCore.runF6Engine();
 		}
         // to keep fps constant
+        frame_timer_phase(fpBLIT);
         updatescr(allowwavy);
+        frame_timer_phase(fpIDLE);
         throttleFPS();
         
 #ifdef _WIN32
@@ -4985,7 +4904,10 @@ void advanceframe(bool allowwavy, bool sfxcleanup, bool allowF6Script)
         
 #endif
         
+        frame_timer_end_frame();
+        
         // to keep music playing
+        frame_timer_phase(fpAUDIO);
         if(zcmusic!=NULL)
         {
             zcmusic_poll();
@@ -5008,7 +4930,9 @@ void advanceframe(bool allowwavy, bool sfxcleanup, bool allowF6Script)
 		FFCore.runF6Engine();
 	}
     // Someday... maybe install a Turbo button here?
+    frame_timer_phase(fpBLIT);
     updatescr(allowwavy);
+    frame_timer_phase(fpIDLE);
     throttleFPS();
     
 #ifdef _WIN32
@@ -5021,8 +4945,11 @@ void advanceframe(bool allowwavy, bool sfxcleanup, bool allowF6Script)
 #endif
     
     //textprintf_ex(screen,font,0,72,254,BLACK,"%d %d", lastentrance, lastentrance_dmap);
+    frame_timer_phase(fpAUDIO);
     if(sfxcleanup)
         sfx_cleanup();
+        
+    frame_timer_end_frame();
 }
 
 void zapout()
@@ -9247,12 +9174,9 @@ void play_DmapMusic()
            strcmp(zcmusic->filename,DMaps[currdmap].tmusic)!=0 ||
            (zcmusic->type==ZCMF_GME && zcmusic->track != DMaps[currdmap].tmusictrack))
         {
-            if(zcmusic != NULL)
-            {
-                zcmusic_stop(zcmusic);
-                zcmusic_unload_file(zcmusic);
-                zcmusic = NULL;
-            }
+            // Load the new track before stopping the old one, so the
+            // old music plays right up until the new one can start.
+            ZCMUSIC *newzcmusic = NULL;
             
             // Try the ZC directory first
             {
@@ -9260,17 +9184,26 @@ void play_DmapMusic()
                 char musicpath[2048];
                 get_executable_name(exepath, 2048);
                 replace_filename(musicpath, exepath, DMaps[currdmap].tmusic, 2048);
-                zcmusic=(ZCMUSIC*)zcmusic_load_file(musicpath);
+                newzcmusic=(ZCMUSIC*)zcmusic_load_file(musicpath);
             }
             
             // Not in ZC directory, try the quest directory
-            if(zcmusic==NULL)
+            if(newzcmusic==NULL)
             {
                 char musicpath[2048];
                 replace_filename(musicpath, qstpath, DMaps[currdmap].tmusic, 2048);
-                zcmusic=(ZCMUSIC*)zcmusic_load_file(musicpath);
+                newzcmusic=(ZCMUSIC*)zcmusic_load_file(musicpath);
             }
             
+            if(zcmusic != NULL)
+            {
+                zcmusic_stop(zcmusic);
+                zcmusic_unload_file(zcmusic);
+                zcmusic = NULL;
+            }
+            
+            zcmusic = newzcmusic;
+            
             if(zcmusic!=NULL)
             {
                 stop_midi();
@@ -9321,6 +9254,29 @@ void play_DmapMusic()
     }
 }
 
+// Starts reading the enhanced music of 'dmap' into the music cache, so
+// play_DmapMusic() doesn't stall on the disk once the warp lands there.
+void prefetch_DmapMusic(int32_t dmap)
+{
+    if(dmap<0 || dmap>=MAXDMAPS || DMaps[dmap].tmusic[0]==0)
+        return;
+        
+    if(zcmusic!=NULL && strcmp(zcmusic->filename,DMaps[dmap].tmusic)==0)
+        return;
+        
+    // Same search order as play_DmapMusic()
+    char exepath[2048];
+    char musicpath[2048];
+    get_executable_name(exepath, 2048);
+    replace_filename(musicpath, exepath, DMaps[dmap].tmusic, 2048);
+    
+    if(!zcmusic_prefetch(musicpath))
+    {
+        replace_filename(musicpath, qstpath, DMaps[dmap].tmusic, 2048);
+        zcmusic_prefetch(musicpath);
+    }
+}
+
 void playLevelMusic()
 {
     int32_t m=tmpscr->screen_midi;
@@ -215,6 +215,7 @@ void set_zcmusicspeed(int32_t speed);
 void jukebox(int32_t index);
 void jukebox(int32_t index,int32_t loop);
 void play_DmapMusic();
+void prefetch_DmapMusic(int32_t dmap);
 void music_pause();
 void music_resume();
 void music_stop();
@@ -0,0 +1,173 @@
+#ifndef __zc_trig_h_
+#define __zc_trig_h_
+
+#include <math.h>
+#include <stdint.h>
+
+//Table-driven trig in zfix units (1/10000ths). Every result is computed
+//with integer math from constant tables, so results do not depend on the
+//platform's libm or FPU mode. Used when qr_LOOKUP_TRIG is on; quests without
+//the rule keep the exact libm results they were built with.
+
+namespace zc
+{
+
+
+namespace trig
+{
+
+//A full turn is 2^32 phase units, so angles wrap for free in uint32_t.
+constexpr int32_t SinTableBits = 12;
+constexpr int32_t SinTableSize = 1<<SinTableBits;
+constexpr int32_t SinFracBits = 32-SinTableBits;
+constexpr int32_t TableOne = 1<<30; //table scale, Q30
+constexpr int32_t AtanTableBits = 10;
+constexpr int32_t AtanTableSize = 1<<AtanTableBits;
+constexpr double TwoPi = 6.28318530717958647692;
+
+//The tables are filled once at startup with integer math only, so they are
+//the same on every compiler and platform. Generating them at compile time
+//takes more constexpr steps than compilers allow by default.
+namespace detail
+{
+	//sin(x) for x in [0, pi/2], both Q30, by its Taylor series in Horner form
+	inline int64_t SinQ30(int64_t x)
+	{
+		int64_t x2 = (x*x) >> 30;
+		int64_t t = TableOne;
+		for(int64_t k = 16; k >= 2; k -= 2)
+			t = TableOne - (x2 * t) / (k*(k+1)) / TableOne;
+		return (x*t) >> 30;
+	}
+	
+	template<int32_t N>
+	struct table
+	{
+		int32_t v[N+1];
+		constexpr int32_t operator[](int32_t i) const { return v[i]; }
+	};
+	
+	inline table<SinTableSize> MakeSinTable()
+	{
+		//2pi*2^48, so that q * it fits in 64 bits
+		const int64_t two_pi_q48 = 1768559438007110LL;
+		const int32_t quarter = SinTableSize/4;
+		table<SinTableSize> t = {};
+		for(int32_t q = 0; q <= quarter; ++q)
+			t.v[q] = int32_t(SinQ30(((two_pi_q48 >> SinTableBits) * q + (1LL<<17)) >> 18));
+		for(int32_t q = quarter+1; q <= 2*quarter; ++q)
+			t.v[q] = t.v[2*quarter-q];
+		for(int32_t q = 2*quarter+1; q <= SinTableSize; ++q)
+			t.v[q] = -t.v[q-2*quarter];
+		return t;
+	}
+	
+	//atan(q/AtanTableSize) in 1/10000 radians, by Euler's series
+	//atan(x) = x/(1+x^2) * sum (2n)!!/(2n+1)!! * (x^2/(1+x^2))^n
+	inline table<AtanTableSize> MakeAtanTable()
+	{
+		table<AtanTableSize> t = {};
+		for(int64_t q = 0; q <= AtanTableSize; ++q)
+		{
+			int64_t den = int64_t(TableOne) + ((q*q) << (30-2*AtanTableBits)); //1+x^2
+			int64_t y = ((q*q) << (60-2*AtanTableBits)) / den; //x^2/(1+x^2)
+			int64_t term = TableOne, sum = 0;
+			for(int64_t n = 1; term; ++n)
+			{
+				sum += term;
+				term = ((term * y) >> 30) * (2*n) / (2*n+1);
+			}
+			int64_t scale = (q << (60-AtanTableBits)) / den; //x/(1+x^2)
+			int64_t a = (scale * sum) >> 30;
+			t.v[q] = int32_t((a * 10000 + (TableOne>>1)) >> 30);
+		}
+		return t;
+	}
+}
+
+inline const detail::table<SinTableSize> SinTable = detail::MakeSinTable();
+inline const detail::table<AtanTableSize> AtanTable = detail::MakeAtanTable();
+
+//Phase of an angle in 1/10000 degrees
+inline uint32_t PhaseDeg(int32_t deg)
+{
+	int64_t d = deg % 3600000;
+	if(d < 0) d += 3600000;
+	return uint32_t((d << 32) / 3600000);
+}
+
+//Phase of an angle in radians
+inline uint32_t PhaseRad(double rad)
+{
+	double turns = rad * (1.0 / TwoPi);
+	turns -= floor(turns);
+	return uint32_t(int64_t(turns * 4294967296.0));
+}
+
+//Sine of a phase, at table scale
+inline int64_t SinPhaseRaw(uint32_t phase)
+{
+	uint32_t ind = phase >> SinFracBits;
+	int64_t frac = phase & ((1<<SinFracBits)-1);
+	return SinTable[ind] + (((SinTable[ind+1] - int64_t(SinTable[ind])) * frac) >> SinFracBits);
+}
+
+//Sine of a phase, in zfix units
+inline int32_t SinPhase(uint32_t phase)
+{
+	return int32_t((SinPhaseRaw(phase) * 10000 + (TableOne>>1)) >> 30);
+}
+
+inline int32_t CosPhase(uint32_t phase)
+{
+	return SinPhase(phase + (1u<<30));
+}
+
+inline int32_t SinDeg(int32_t deg) { return SinPhase(PhaseDeg(deg)); }
+inline int32_t CosDeg(int32_t deg) { return CosPhase(PhaseDeg(deg)); }
+inline int32_t SinRad(double rad)  { return SinPhase(PhaseRad(rad)); }
+inline int32_t CosRad(double rad)  { return CosPhase(PhaseRad(rad)); }
+
+//Tangent in zfix units; saturates where it is undefined
+inline int32_t TanDeg(int32_t deg)
+{
+	uint32_t phase = PhaseDeg(deg);
+	int64_t s = SinPhaseRaw(phase), c = SinPhaseRaw(phase + (1u<<30));
+	if(c == 0)
+		return s < 0 ? -INT32_MAX : INT32_MAX;
+	int64_t t = s * 10000 / c;
+	return int32_t(t > INT32_MAX ? INT32_MAX : (t < -INT32_MAX ? -INT32_MAX : t));
+}
+
+//atan2(y,x) in 1/10000 radians; inputs in any matching units
+inline int32_t ArcTan(int32_t y, int32_t x)
+{
+	if(x == 0 && y == 0)
+		return 0;
+	int64_t ax = x < 0 ? -int64_t(x) : x;
+	int64_t ay = y < 0 ? -int64_t(y) : y;
+	bool steep = ay > ax;
+	int64_t num = steep ? ax : ay, den = steep ? ay : ax;
+
+	//num/den is in [0,1]; interpolate the table in AtanTableBits+16 bit fixed point
+	int64_t ratio = (num << (AtanTableBits+16)) / den;
+	int32_t ind = int32_t(ratio >> 16);
+	int64_t frac = ratio & 0xFFFF;
+	int64_t a = AtanTable[ind];
+	if(ind < AtanTableSize)
+		a += ((AtanTable[ind+1] - a) * frac + 0x8000) >> 16;
+
+	//Unfold the octant
+	const int32_t half_pi = 15708, pi = 31416;
+	if(steep) a = half_pi - a;
+	if(x < 0) a = pi - a;
+	if(y < 0) a = -a;
+	return int32_t(a);
+}
+
+} //namespace trig
+
+
+} //namespace zc
+
+#endif
@@ -94,9 +94,286 @@ typedef struct GMEFILE : public ZCMUSICBASE
 #define __GTHREAD_HIDE_WIN32API 1
 #endif                            //prevent indirectly including windows.h
 #include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <memory>
+#include <list>
+#include <string>
 static std::vector<ZCMUSIC*> playlist;                      //yeah, I'm too lazy to do it myself
 static int32_t libflags = 0;
 
+// Streams are decoded on their own thread, which keeps each stream's audio
+// buffer topped up independently of the game's frame rate. The game thread
+// only issues play/pause/stop/volume calls, which take playlistmutex.
+#define ZCM_DECODE_MSEC   5                                 // how often the decode thread refills buffers
+#define ZCM_TICK_PASSES   5                                 // decode passes per position tick (25 ms, as the old timer)
+static std::thread decode_thread;
+static std::atomic<bool> decode_thread_quit(false);
+static std::atomic<int32_t> pending_ticks(0);              // game-thread polls not yet applied to 'position'
+
+// OGG and MP3 files are kept in memory once read, so going back to a
+// DMap's music (or looping it, which reopens the file) never touches the
+// disk again. Files are read into the cache by the decode thread; a file
+// that is not cached yet, or is too big to cache, is streamed from disk as
+// before. Entries are keyed on path, size and modification time, so a file
+// replaced on disk is read again. The least recently used files are dropped
+// once the cache outgrows ZCM_CACHE_BYTES; a stream that is still playing
+// keeps its bytes.
+#define ZCM_CACHE_BYTES   (64*1024*1024)
+typedef std::shared_ptr<std::vector<char> > music_bytes;
+
+typedef struct MUSICCACHEENTRY
+{
+    std::string path;
+    uint64_t size;
+    time_t mtime;
+    music_bytes data;
+} MUSICCACHEENTRY;
+
+static std::list<MUSICCACHEENTRY> music_cache;              // most recently used first
+static size_t music_cache_size = 0;
+static std::vector<std::string> prefetch_queue;
+static std::mutex music_cache_mutex;
+
+// Finds 'filename' in the cache. Must hold music_cache_mutex.
+static std::list<MUSICCACHEENTRY>::iterator find_cached_music(const char *filename, uint64_t size, time_t mtime)
+{
+    for(std::list<MUSICCACHEENTRY>::iterator it = music_cache.begin(); it != music_cache.end(); ++it)
+    {
+        if(it->path == filename)
+        {
+            if(it->size == size && it->mtime == mtime)
+                return it;
+                
+            // the file changed on disk
+            music_cache_size -= it->data->size();
+            music_cache.erase(it);
+            break;
+        }
+    }
+    
+    return music_cache.end();
+}
+
+// Returns the cached bytes of 'filename', or nothing on a miss.
+static music_bytes get_cached_music(const char *filename)
+{
+    uint64_t size = file_size_ex(filename);
+    time_t mtime = file_time(filename);
+    std::lock_guard<std::mutex> lock(music_cache_mutex);
+    std::list<MUSICCACHEENTRY>::iterator it = find_cached_music(filename, size, mtime);
+    
+    if(it == music_cache.end())
+        return music_bytes();
+        
+    music_cache.splice(music_cache.begin(), music_cache, it);
+    return it->data;
+}
+
+// Reads 'filename' into the cache, unless it is already there or is too
+// big to keep.
+static void cache_music_file(const char *filename)
+{
+    uint64_t size = file_size_ex(filename);
+    time_t mtime = file_time(filename);
+    
+    if(size == 0 || size > ZCM_CACHE_BYTES)
+        return;
+        
+    {
+        std::lock_guard<std::mutex> lock(music_cache_mutex);
+        
+        if(find_cached_music(filename, size, mtime) != music_cache.end())
+            return;
+    }
+    
+    FILE *f = fopen(filename, "rb");
+    
+    if(!f)
+        return;
+        
+    music_bytes data = std::make_shared<std::vector<char> >((size_t)size);
+    size_t len = fread(data->data(), 1, (size_t)size, f);
+    fclose(f);
+    
+    if(len != size)
+        return;
+        
+    std::lock_guard<std::mutex> lock(music_cache_mutex);
+    
+    if(find_cached_music(filename, size, mtime) != music_cache.end())
+        return;
+        
+    MUSICCACHEENTRY entry;
+    entry.path = filename;
+    entry.size = size;
+    entry.mtime = mtime;
+    entry.data = data;
+    music_cache.push_front(entry);
+    music_cache_size += data->size();
+    
+    while(music_cache_size > ZCM_CACHE_BYTES)
+    {
+        music_cache_size -= music_cache.back().data->size();
+        music_cache.pop_back();
+    }
+}
+
+// Queues 'filename' for the decode thread to cache. Must hold
+// music_cache_mutex.
+static void queue_music_prefetch(const char *filename)
+{
+    for(size_t i = 0; i < prefetch_queue.size(); ++i)
+    {
+        if(prefetch_queue[i] == filename)
+            return;
+    }
+    
+    prefetch_queue.push_back(filename);
+}
+
+// Reads one queued prefetch into the cache. Called from the decode thread,
+// outside playlistmutex.
+static void service_prefetch()
+{
+    std::string path;
+    
+    {
+        std::lock_guard<std::mutex> lock(music_cache_mutex);
+        
+        if(prefetch_queue.empty())
+            return;
+            
+        path = prefetch_queue.front();
+        prefetch_queue.erase(prefetch_queue.begin());
+    }
+    
+    cache_music_file(path.c_str());
+}
+
+// A read-only PACKFILE over cached music bytes.
+typedef struct MEMMUSICFILE
+{
+    music_bytes data;
+    size_t pos;
+} MEMMUSICFILE;
+
+static int mem_music_fclose(void *userdata)
+{
+    delete (MEMMUSICFILE *)userdata;
+    return 0;
+}
+
+static int mem_music_getc(void *userdata)
+{
+    MEMMUSICFILE *m = (MEMMUSICFILE *)userdata;
+    
+    if(m->pos >= m->data->size())
+        return EOF;
+        
+    return (unsigned char)(*m->data)[m->pos++];
+}
+
+static int mem_music_ungetc(int c, void *userdata)
+{
+    MEMMUSICFILE *m = (MEMMUSICFILE *)userdata;
+    
+    if(m->pos == 0)
+        return EOF;
+        
+    --m->pos;
+    return c;
+}
+
+static long mem_music_fread(void *p, long n, void *userdata)
+{
+    MEMMUSICFILE *m = (MEMMUSICFILE *)userdata;
+    size_t left = m->data->size() - m->pos;
+    
+    if((size_t)n > left)
+        n = (long)left;
+        
+    memcpy(p, m->data->data() + m->pos, n);
+    m->pos += n;
+    return n;
+}
+
+static int mem_music_putc(int, void *)
+{
+    return EOF;
+}
+
+static long mem_music_fwrite(const void *, long, void *)
+{
+    return 0;
+}
+
+static int mem_music_fseek(void *userdata, int offset)
+{
+    MEMMUSICFILE *m = (MEMMUSICFILE *)userdata;
+    
+    if(offset < 0 || m->pos + offset > m->data->size())
+        return -1;
+        
+    m->pos += offset;
+    return 0;
+}
+
+static int mem_music_feof(void *userdata)
+{
+    MEMMUSICFILE *m = (MEMMUSICFILE *)userdata;
+    return m->pos >= m->data->size();
+}
+
+static int mem_music_ferror(void *)
+{
+    return 0;
+}
+
+static PACKFILE_VTABLE mem_music_vtable =
+{
+    mem_music_fclose, mem_music_getc, mem_music_ungetc, mem_music_fread, mem_music_putc,
+    mem_music_fwrite, mem_music_fseek, mem_music_feof, mem_music_ferror
+};
+
+static PACKFILE *open_music_file(const char *filename)
+{
+    music_bytes data = get_cached_music(filename);
+    
+    if(!data)
+    {
+        // stream it this time, and have it cached for the next
+        if(decode_thread.joinable())
+        {
+            std::lock_guard<std::mutex> lock(music_cache_mutex);
+            queue_music_prefetch(filename);
+        }
+        
+        return pack_fopen_password(filename, F_READ, "");
+    }
+        
+    MEMMUSICFILE *m = new MEMMUSICFILE;
+    m->data = data;
+    m->pos = 0;
+    PACKFILE *f = pack_fopen_vtable(&mem_music_vtable, m);
+    
+    if(!f)
+        delete m;
+        
+    return f;
+}
+
+// Scratch space for the first block of a stream; loads happen on both the
+// game thread and (when a stream loops) the decode thread.
+static char *music_load_buffer()
+{
+    static thread_local std::vector<char> buf;
+    buf.resize(zcmusic_bufsz_private*512);
+    return buf.data();
+}
+
 // forward declarations
 OGGFILE *load_ogg_file(char *filename);
 int32_t poll_ogg_file(OGGFILE *ogg);
@@ -131,6 +408,98 @@ int32_t unload_gme_file(GMEFILE* gme);
 int32_t gme_play(GMEFILE *gme, int32_t vol);
 
 
+// Walks the playlist, removing stopped streams. 'decode' refills the
+// buffers of playing streams; 'ticks' is added to their position counter.
+// Must be called with playlistmutex held.
+static void update_playlist(int32_t flags, bool decode, int32_t ticks)
+{
+    std::vector<ZCMUSIC*>::iterator b = playlist.begin();
+    
+    while(b != playlist.end())
+    {
+        switch((*b)->playing)
+        {
+        case ZCM_STOPPED:
+            // if it has stopped, remove it from playlist;
+            b = playlist.erase(b);
+            break;
+            
+        case ZCM_PLAYING:
+            (*b)->position += ticks;
+            
+            if(decode)
+            {
+                switch((*b)->type & flags & libflags)             // only poll those specified by 'flags'
+                {
+                case ZCMF_DUH:
+                    if(((DUHFILE*)*b)->p)
+                        al_poll_duh(((DUHFILE*)*b)->p);
+                        
+                    break;
+                    
+                case ZCMF_OGG:
+                    poll_ogg_file((OGGFILE*)*b);
+                    break;
+                    
+                case ZCMF_MP3:
+                    poll_mp3_file((MP3FILE*)*b);
+                    break;
+                    
+                case ZCMF_GME:
+                    if(((GMEFILE*)*b)->emu)
+                        poll_gme_file((GMEFILE*)*b);
+                        
+                    break;
+                    
+                case ZCMF_OGGEX:
+                    poll_ogg_ex_file((OGGEXFILE*)*b);
+                    break;
+                }
+            }
+            
+            [[fallthrough]];
+            
+        case ZCM_PAUSED:
+            b++;
+        }
+    }
+}
+
+static void zcmusic_decode_loop()
+{
+    int32_t passes = 0;
+    
+    while(!decode_thread_quit)
+    {
+        int32_t ticks = pending_ticks.exchange(0);
+        
+        if(++passes >= ZCM_TICK_PASSES)
+        {
+            passes = 0;
+            ++ticks;
+        }
+        
+        mutex_lock(&playlistmutex);
+        update_playlist(-1, true, ticks);
+        mutex_unlock(&playlistmutex);
+        service_prefetch();
+        
+        std::this_thread::sleep_for(std::chrono::milliseconds(ZCM_DECODE_MSEC));
+    }
+}
+
+// Also registered with atexit(), so a program that never calls
+// zcmusic_exit() does not reach std::thread's destructor with the thread
+// still running. It runs before the cache and playlist are destroyed.
+static void zcmusic_stop_decode_thread()
+{
+    if(decode_thread.joinable())
+    {
+        decode_thread_quit = true;
+        decode_thread.join();
+    }
+}
+
 extern "C"
 {
 	void zcm_extract_name(char *path,char *name,int32_t type)
@@ -162,11 +531,6 @@ extern "C"
 		name[n]=0;
 	}
 
-    void zcmusic_autopoll()
-    {
-        zcmusic_poll();
-    }
-    
     bool zcmusic_init(int32_t flags)                              /* = -1 */
     {
         zcmusic_bufsz_private = zcmusic_bufsz;
@@ -198,74 +562,44 @@ extern "C"
             libflags |= ZCMF_OGGEX;
         }
         
-        mutex_init(&playlistmutex);
+        if(!decode_thread.joinable())
+        {
+            static bool registered_exit = false;
+            
+            if(!registered_exit)
+            {
+                atexit(zcmusic_stop_decode_thread);
+                registered_exit = true;
+            }
+            
+            mutex_init(&playlistmutex);
+            decode_thread_quit = false;
+            decode_thread = std::thread(zcmusic_decode_loop);
+        }
         
-        install_int_ex(zcmusic_autopoll, MSEC_TO_TIMER(25));
         return true;
     }
     
     bool zcmusic_poll(int32_t flags)                              /* = -1 */
     {
-        //lock mutex
-        mutex_lock(&playlistmutex);
-        //do all kinds of gymnastics to get around Allegro stupidity
-//	char *oldpwd = getCurPackfilePassword();
-//	setPackfilePassword(NULL);
-        std::vector<ZCMUSIC*>::iterator b = playlist.begin();
-        
-        while(b != playlist.end())
+        // decoding happens on the decode thread, so the game thread only
+        // leaves it a position tick and never waits on the playlist.
+        if(decode_thread.joinable())
         {
-            switch((*b)->playing)
-            {
-            case ZCM_STOPPED:
-                // if it has stopped, remove it from playlist;
-                b = playlist.erase(b);
-                break;
-                
-            case ZCM_PLAYING:
-                (*b)->position++;
-                
-                switch((*b)->type & flags & libflags)             // only poll those specified by 'flags'
-                {
-                case ZCMF_DUH:
-                    if(((DUHFILE*)*b)->p)
-                        al_poll_duh(((DUHFILE*)*b)->p);
-                        
-                    break;
-                    
-                case ZCMF_OGG:
-                    poll_ogg_file((OGGFILE*)*b);
-                    break;
-                    
-                case ZCMF_MP3:
-                    poll_mp3_file((MP3FILE*)*b);
-                    break;
-                    
-                case ZCMF_GME:
-                    if(((GMEFILE*)*b)->emu)
-                        poll_gme_file((GMEFILE*)*b);
-                        
-                    break;
-		    
-		case ZCMF_OGGEX:
-                    poll_ogg_ex_file((OGGEXFILE*)*b);
-                    break;
-                }
-                [[fallthrough]];
-            case ZCM_PAUSED:
-                b++;
-            }
+            ++pending_ticks;
+            return true;
         }
         
+        mutex_lock(&playlistmutex);
+        update_playlist(flags, true, 1);
         mutex_unlock(&playlistmutex);
-//	setPackfilePassword(oldpwd);
-//	if(oldpwd != NULL)
-//		delete[] oldpwd;
         return true;
     }
     
     void zcmusic_exit()
     {
+        zcmusic_stop_decode_thread();
+        
         //lock mutex
         mutex_lock(&playlistmutex);
         std::vector<ZCMUSIC*>::iterator b = playlist.begin();
@@ -279,6 +613,13 @@ extern "C"
         playlist.clear();
         mutex_unlock(&playlistmutex);
         
+        {
+            std::lock_guard<std::mutex> lock(music_cache_mutex);
+            music_cache.clear();
+            music_cache_size = 0;
+            prefetch_queue.clear();
+        }
+        
         if(libflags & ZCMF_DUH)
         {
             dumb_exit();
@@ -512,6 +853,29 @@ error:
         return NULL;
     }
     
+    bool zcmusic_prefetch(char *filename)
+    {
+        // queues 'filename' to be read into the music cache by the decode
+        // thread, so a later zcmusic_load_file() need not wait on the disk.
+        if(filename == NULL || !exists(filename))
+            return false;
+            
+        char *ext=get_extension(filename);
+        
+        if(!((stricmp(ext,"ogg")==0 && (libflags & ZCMF_OGG)) || (stricmp(ext,"mp3")==0 && (libflags & ZCMF_MP3))))
+            return false;
+            
+        if(!decode_thread.joinable())
+        {
+            cache_music_file(filename);
+            return true;
+        }
+        
+        std::lock_guard<std::mutex> lock(music_cache_mutex);
+        queue_music_prefetch(filename);
+        return true;
+    }
+    
     bool zcmusic_play(ZCMUSIC* zcm, int32_t vol) /* = FALSE */
     {
         // the libraries require polling
@@ -530,6 +894,8 @@ error:
         
         if(zcm->playing != ZCM_STOPPED)                         // adjust volume
         {
+            mutex_lock(&playlistmutex);
+            
             switch(zcm->type & libflags)
             {
             case ZCMF_DUH:
@@ -573,6 +939,8 @@ error:
                 break;
                 
             }
+            
+            mutex_unlock(&playlistmutex);
         }
         else
         {
@@ -993,13 +1361,13 @@ MP3FILE *load_mp3_file(char *filename)
     MP3FILE *p = NULL;
     PACKFILE *f = NULL;
     ALMP3_MP3STREAM *s = NULL;
-    char *data = new char[(zcmusic_bufsz_private*512)];
+    char *data = music_load_buffer();
     int32_t len;
     
     if((p = (MP3FILE *)zc_malloc(sizeof(MP3FILE)))==NULL)
         goto error;
         
-    if((f = pack_fopen_password(filename, F_READ,""))==NULL)
+    if((f = open_music_file(filename))==NULL)
         goto error;
     
     // ID3 tags sometimes cause problems with almp3, so try to skip them
@@ -1038,7 +1406,6 @@ MP3FILE *load_mp3_file(char *filename)
     
     p->f = f;
     p->s = s;
-    delete[] data;
     return p;
     
 error:
@@ -1049,7 +1416,6 @@ error:
     if(p)
         zc_free(p);
         
-    delete[] data;
     return NULL;
 }
 
@@ -1208,7 +1574,7 @@ OGGFILE *load_ogg_file(char *filename)
     OGGFILE *p = NULL;
     PACKFILE *f = NULL;
     ALOGG_OGGSTREAM *s = NULL;
-    char *data = new char[(zcmusic_bufsz_private*512)];
+    char *data = music_load_buffer();
     int32_t len;
     
     if((p = (OGGFILE *)zc_malloc(sizeof(OGGFILE)))==NULL)
@@ -1216,7 +1582,7 @@ OGGFILE *load_ogg_file(char *filename)
         goto error;
     }
     
-    if((f = pack_fopen_password(filename, F_READ,""))==NULL)
+    if((f = open_music_file(filename))==NULL)
     {
         goto error;
     }
@@ -1243,7 +1609,6 @@ OGGFILE *load_ogg_file(char *filename)
     
     p->f = f;
     p->s = s;
-    delete[] data;
     return p;
     
 error:
@@ -1254,7 +1619,6 @@ error:
     if(p)
         zc_free(p);
         
-    delete[] data;
     return NULL;
 }
 
@@ -52,6 +52,7 @@ typedef struct ZCMUSICBASE
 
 ZCM_EXTERN ZCMUSIC const * zcmusic_load_file(char *filename);
 ZCM_EXTERN ZCMUSIC const * zcmusic_load_file_ex(char *filename);
+ZCM_EXTERN bool zcmusic_prefetch(char *filename);
 ZCM_EXTERN bool zcmusic_play(ZCMUSIC* zcm, int32_t vol);
 ZCM_EXTERN bool zcmusic_pause(ZCMUSIC* zcm, int32_t pause);
 ZCM_EXTERN bool zcmusic_stop(ZCMUSIC* zcm);
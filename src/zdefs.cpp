@@ -9,6 +9,155 @@ const char months[13][13] =
 	"Nonetober", "January", "February", "March", "April", "May", "June", "July", "August", "September", "October", "November", "December"
 };
 
+std::vector<byte> *section_write_buffer = NULL;
+
+section_writer::section_writer(PACKFILE *f) : dest(f), prev_buffer(section_write_buffer), active(true)
+{
+	section_write_buffer = &data;
+}
+
+section_writer::~section_writer()
+{
+	if(active)
+		section_write_buffer = prev_buffer;
+}
+
+bool section_writer::commit()
+{
+	if(!active) return false;
+	section_write_buffer = prev_buffer;
+	active = false;
+	
+	if(!p_iputl(size(),dest))
+		return false;
+	return data.empty() || pfwrite(data.data(),size(),dest);
+}
+
+void section_writer::release(std::vector<byte>& out)
+{
+	if(active)
+	{
+		section_write_buffer = prev_buffer;
+		active = false;
+	}
+	out.swap(data);
+	data.clear();
+}
+
+static int32_t packfile_memory_fclose(void *userdata)
+{
+	delete (packfile_memory *)userdata;
+	return 0;
+}
+
+static int32_t packfile_memory_getc(void *userdata)
+{
+	packfile_memory *m = (packfile_memory *)userdata;
+	
+	if(m->pos >= m->data.size())
+		return EOF;
+		
+	return m->data[m->pos++];
+}
+
+static int32_t packfile_memory_ungetc(int32_t c, void *userdata)
+{
+	packfile_memory *m = (packfile_memory *)userdata;
+	
+	if(m->pos == 0 || m->data[m->pos-1] != (byte)c)
+		return EOF;
+		
+	--m->pos;
+	return c;
+}
+
+static long packfile_memory_fread(void *p, long n, void *userdata)
+{
+	packfile_memory *m = (packfile_memory *)userdata;
+	size_t count = zc_min(size_t(n), m->data.size()-m->pos);
+	memcpy(p, m->data.data()+m->pos, count);
+	m->pos += count;
+	return long(count);
+}
+
+static int32_t packfile_memory_putc(int32_t, void *)
+{
+	return EOF;
+}
+
+static long packfile_memory_fwrite(AL_CONST void *, long, void *)
+{
+	return 0;
+}
+
+static int32_t packfile_memory_fseek(void *userdata, int32_t offset)
+{
+	packfile_memory *m = (packfile_memory *)userdata;
+	
+	if(offset < 0 || m->data.size()-m->pos < size_t(offset))
+	{
+		m->pos = m->data.size();
+		return -1;
+	}
+	
+	m->pos += offset;
+	return 0;
+}
+
+static int32_t packfile_memory_feof(void *userdata)
+{
+	packfile_memory *m = (packfile_memory *)userdata;
+	return m->pos >= m->data.size();
+}
+
+static int32_t packfile_memory_ferror(void *userdata)
+{
+	packfile_memory *m = (packfile_memory *)userdata;
+	return m->error && m->pos >= m->data.size();
+}
+
+PACKFILE_VTABLE packfile_memory_vtable =
+{
+	packfile_memory_fclose, packfile_memory_getc, packfile_memory_ungetc,
+	packfile_memory_fread, packfile_memory_putc, packfile_memory_fwrite,
+	packfile_memory_fseek, packfile_memory_feof, packfile_memory_ferror
+};
+
+PACKFILE *pack_fopen_buffered(PACKFILE *f)
+{
+	if(!f || packfile_buffer(f))
+		return f;
+		
+	packfile_memory *m = new packfile_memory;
+	m->pos = 0;
+	m->error = false;
+	PACKFILE *buffered = pack_fopen_vtable(&packfile_memory_vtable, m);
+	
+	if(!buffered)
+	{
+		delete m;
+		return f;
+	}
+	
+	//Grow in large steps; a packed file doesn't know its unpacked size
+	const size_t chunk = 1<<20;
+	
+	for(;;)
+	{
+		size_t used = m->data.size();
+		m->data.resize(used+chunk);
+		long count = pack_fread(m->data.data()+used, chunk, f);
+		m->data.resize(used+zc_max(count, 0L));
+		
+		if(count < long(chunk))
+			break;
+	}
+	
+	m->error = pack_ferror(f)!=0;
+	pack_fclose(f);
+	return buffered;
+}
+
 char *VerStr(int32_t version)
 {
     static char ver_str[12];
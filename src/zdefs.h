@@ -366,7 +366,7 @@ typedef uint32_t dword; //0-4,294,967,295  (32 bits)
 typedef uint64_t qword; //0-18,446,744,073,709,551,616  (64 bits)
 
 extern int32_t readsize, writesize;
-extern bool fake_pack_writing;
+extern std::vector<byte> *section_write_buffer;
 
 // system colors
 #define lc1(x) ((x)+192)                                    // offset to 'level bg color' x (row 12)
@@ -1094,7 +1094,7 @@ enum
 	qr_MANHANDLA_BLOCK_SFX, qr_GRASS_SENSITIVE, qr_BETTER_RAFT, qr_BETTER_RAFT_2,
 	qr_RAFT_SOUND, qr_WARPS_RESTART_DMAPSCRIPT, qr_DMAP_0_CONTINUE_BUG, qr_SCRIPT_WARPS_DMAP_SCRIPT_TOGGLE,
 	//43
-	qr_OLD_SCRIPTED_KNOCKBACK, qr_OLD_KEESE_Z_AXIS, qr_POLVIRE_NO_SHADOW,
+	qr_OLD_SCRIPTED_KNOCKBACK, qr_OLD_KEESE_Z_AXIS, qr_POLVIRE_NO_SHADOW, qr_LOOKUP_TRIG,
 	
 	//50
 	
@@ -2276,6 +2276,7 @@ public:
 	//byte ewpnclass, lwpnclass, guyclass; //Not implemented
 	
 	int32_t switchkey; //used for switch statements
+	dword throttled; //frames this script was suspended for running over its budget
 	
 	void Clear()
 	{
@@ -2292,6 +2293,7 @@ public:
 		memset(d, 0, 8 * sizeof(int32_t));
 		a[0] = a[1] = 0;
 		switchkey = 0;
+		throttled = 0;
 	}
 	
 	refInfo()
@@ -2322,11 +2324,63 @@ public:
 		memcpy(d, rhs.d, 8 * sizeof(int32_t));
 		memcpy(a, rhs.a, 2 * sizeof(int32_t));
 		switchkey = rhs.switchkey;
+		throttled = rhs.throttled;
 		return *this;
 	}
 };
 
 
+//Combo storage of a screen. Invalid screens with nothing on them keep it
+//empty (see readmaps); it is allocated, zeroed, on the first non-const
+//access, so drawing on such a screen or setting its combos from a script
+//needs no special handling. Const access to empty storage reads as zeroes.
+template<typename T>
+class screen_array
+{
+public:
+	screen_array() {}
+	
+	T& operator[](size_t i)					{ materialize(); return vec[i]; }
+	T const& operator[](size_t i) const		{ return vec.empty() ? zero() : vec[i]; }
+	T& at(size_t i)							{ materialize(); return vec.at(i); }
+	T const& at(size_t i) const				{ return vec.empty() ? zero() : vec.at(i); }
+	T& front()								{ materialize(); return vec.front(); }
+	T* data()								{ materialize(); return vec.data(); }
+	
+	size_t size() const						{ return vec.size(); }
+	size_t capacity() const					{ return vec.capacity(); }
+	bool empty() const						{ return vec.empty(); }
+	void resize(size_t n, T const& v = T())	{ vec.resize(n, v); }
+	void assign(size_t n, T const& v)		{ vec.assign(n, v); }
+	
+	//Frees the storage; the next non-const access allocates it again.
+	void release()							{ std::vector<T>().swap(vec); }
+	
+	bool is_zero() const
+	{
+		for(size_t i = 0; i < vec.size(); ++i)
+			if(vec[i] != T()) return false;
+		return true;
+	}
+	
+	bool operator==(screen_array const& other) const	{ return vec == other.vec; }
+	bool operator!=(screen_array const& other) const	{ return vec != other.vec; }
+	
+private:
+	std::vector<T> vec;
+	
+	void materialize()
+	{
+		if(vec.empty()) vec.resize(176, T());
+	}
+	
+	static T const& zero()
+	{
+		static const T z = T();
+		return z;
+	}
+};
+
 struct mapscr
 {
 	byte valid;
@@ -2393,9 +2447,9 @@ struct mapscr
 	byte secretcset[128]; //should be available to zscript.-Z
 	byte secretflag[128]; //should be available to zscript.-Z
 	// you're listening to ptr radio, the sounds of insane. ;)
-	std::vector<word> data;
-	std::vector<byte> sflag;
-	std::vector<byte> cset;
+	screen_array<word> data;
+	screen_array<byte> sflag;
+	screen_array<byte> cset;
 	word viewX;
 	word viewY;
 	byte scrWidth; //ooooh. Can we make this a variable set by script? -Z
@@ -2697,6 +2751,17 @@ struct mapscr
 		//cset.assign(cset.size(),0);
 	}
 	
+	//An invalid screen with no combos on it gives up its combo storage.
+	void release_empty_combos()
+	{
+		if(!(valid&mVALID) && data.is_zero() && sflag.is_zero() && cset.is_zero())
+		{
+			data.release();
+			sflag.release();
+			cset.release();
+		}
+	}
+	
 	mapscr()
 	{
 		data.resize(176,0);
@@ -4865,11 +4930,62 @@ static INLINE bool is_between(T a, T b, T c, bool inclusive)
 
 #define NEWALLEGRO
 
+//A file read into memory by pack_fopen_buffered()
+struct packfile_memory
+{
+    std::vector<byte> data;
+    size_t pos;
+    bool error;
+};
+
+extern PACKFILE_VTABLE packfile_memory_vtable;
+
+//Reads the rest of 'f' into memory and closes it, returning a PACKFILE that
+//reads from the copy instead. The p_* readers below take bytes from it
+//directly rather than through the vtable one character at a time.
+//Returns 'f' itself if the copy can't be made.
+PACKFILE *pack_fopen_buffered(PACKFILE *f);
+
+INLINE packfile_memory *packfile_buffer(PACKFILE *f)
+{
+    return (f->vtable==&packfile_memory_vtable) ? (packfile_memory *)f->userdata : NULL;
+}
+
+//Takes the next 'n' bytes of a buffered file, failing if fewer are left
+INLINE bool packfile_buffer_read(packfile_memory *m,void *p,int32_t n,bool keepdata)
+{
+    if(n<0 || m->data.size()-m->pos < size_t(n))
+    {
+        m->pos=m->data.size();
+        return false;
+    }
+    
+    if(keepdata)
+    {
+        memcpy(p,m->data.data()+m->pos,n);
+    }
+    
+    m->pos+=n;
+    readsize+=n;
+    return true;
+}
+
+//Appends raw bytes to the section being buffered by a section_writer
+INLINE void section_buffer_write(void const *p,int32_t n)
+{
+    byte const *bp = (byte const *)p;
+    section_write_buffer->insert(section_write_buffer->end(), bp, bp+n);
+}
+
 INLINE bool pfwrite(void *p,int32_t n,PACKFILE *f)
 {
     bool success=true;
     
-    if(!fake_pack_writing)
+    if(section_write_buffer)
+    {
+        section_buffer_write(p,n);
+    }
+    else
     {
         success=(pack_fwrite(p,n,f)==n);
     }
@@ -4886,6 +5002,11 @@ INLINE bool pfread(void *p,int32_t n,PACKFILE *f,bool keepdata)
 {
     bool success;
     
+    if(packfile_memory *m = packfile_buffer(f))
+    {
+        return packfile_buffer_read(m,p,n,keepdata);
+    }
+    
     if(keepdata==true)
     {
         success=(pack_fread(p,n,f)==n);
@@ -4910,6 +5031,44 @@ INLINE bool pfread(void *p,int32_t n,PACKFILE *f,bool keepdata)
     }
 }
 
+//Reads 'n' consecutive little-endian words in one block, for fixed-size
+//arrays that were written with a p_iputw loop
+INLINE bool p_igetw_array(void *p,int32_t n,PACKFILE *f)
+{
+    if(!pfread(p,n*2,f,true))
+        return false;
+        
+#ifdef ALLEGRO_BIG_ENDIAN
+    byte *bp = (byte *)p;
+    
+    for(int32_t i=0; i<n; ++i, bp+=2)
+    {
+        zc_swap(bp[0],bp[1]);
+    }
+    
+#endif
+    return true;
+}
+
+//As above, for little-endian dwords written with a p_iputl loop
+INLINE bool p_igetl_array(void *p,int32_t n,PACKFILE *f)
+{
+    if(!pfread(p,n*4,f,true))
+        return false;
+        
+#ifdef ALLEGRO_BIG_ENDIAN
+    byte *bp = (byte *)p;
+    
+    for(int32_t i=0; i<n; ++i, bp+=4)
+    {
+        zc_swap(bp[0],bp[3]);
+        zc_swap(bp[1],bp[2]);
+    }
+    
+#endif
+    return true;
+}
+
 INLINE bool p_getc(void *p,PACKFILE *f,bool keepdata)
 {
     uint8_t *cp = (uint8_t *)p;
@@ -4917,9 +5076,14 @@ INLINE bool p_getc(void *p,PACKFILE *f,bool keepdata)
     
     if(!f) return false;
     
+    if(packfile_memory *m = packfile_buffer(f))
+    {
+        return packfile_buffer_read(m,p,1,keepdata);
+    }
+    
 #ifdef NEWALLEGRO
     
-    if(f->normal.flags&PACKFILE_FLAG_WRITE) return false;     //must not be writing to file
+    if(f->is_normal_packfile && (f->normal.flags&PACKFILE_FLAG_WRITE)) return false;     //must not be writing to file
     
 #else
     
@@ -4952,13 +5116,18 @@ INLINE bool p_putc(int32_t c,PACKFILE *f)
 {
     bool success=true;
     
-    if(!fake_pack_writing)
+    if(section_write_buffer)
+    {
+        byte b = byte(c);
+        section_buffer_write(&b,1);
+    }
+    else
     {
         if(!f) return false;
         
 #ifdef NEWALLEGRO
         
-        if(!(f->normal.flags&PACKFILE_FLAG_WRITE)) return false;  //must be writing to file
+        if(f->is_normal_packfile && !(f->normal.flags&PACKFILE_FLAG_WRITE)) return false;  //must be writing to file
         
 #else
         
@@ -4985,9 +5154,24 @@ INLINE bool p_igetw(void *p,PACKFILE *f,bool keepdata)
     
     if(!f) return false;
     
+    if(packfile_memory *m = packfile_buffer(f))
+    {
+        byte b[2];
+        
+        if(!packfile_buffer_read(m,b,2,true))
+            return false;
+            
+        if(keepdata==true)
+        {
+            *cp = int16_t(b[0] | (b[1]<<8));
+        }
+        
+        return true;
+    }
+    
 #ifdef NEWALLEGRO
     
-    if(f->normal.flags&PACKFILE_FLAG_WRITE) return false;     //must not be writing to file
+    if(f->is_normal_packfile && (f->normal.flags&PACKFILE_FLAG_WRITE)) return false;     //must not be writing to file
     
 #else
     
@@ -5020,13 +5204,18 @@ INLINE bool p_iputw(int32_t c,PACKFILE *f)
 {
     bool success=true;
     
-    if(!fake_pack_writing)
+    if(section_write_buffer)
+    {
+        byte b[2] = { byte(c), byte(c>>8) };
+        section_buffer_write(b,2);
+    }
+    else
     {
         if(!f) return false;
         
 #ifdef NEWALLEGRO
         
-        if(!(f->normal.flags&PACKFILE_FLAG_WRITE)) return false;  //must be writing to file
+        if(f->is_normal_packfile && !(f->normal.flags&PACKFILE_FLAG_WRITE)) return false;  //must be writing to file
         
 #else
         
@@ -5053,9 +5242,24 @@ INLINE bool p_igetl(void *p,PACKFILE *f,bool keepdata)
     
     if(!f) return false;
     
+    if(packfile_memory *m = packfile_buffer(f))
+    {
+        byte b[4];
+        
+        if(!packfile_buffer_read(m,b,4,true))
+            return false;
+            
+        if(keepdata==true)
+        {
+            *cp = dword(b[0]) | (dword(b[1])<<8) | (dword(b[2])<<16) | (dword(b[3])<<24);
+        }
+        
+        return true;
+    }
+    
 #ifdef NEWALLEGRO
     
-    if(f->normal.flags&PACKFILE_FLAG_WRITE) return false;     //must not be writing to file
+    if(f->is_normal_packfile && (f->normal.flags&PACKFILE_FLAG_WRITE)) return false;     //must not be writing to file
     
 #else
     
@@ -5098,7 +5302,7 @@ INLINE bool p_igetf(void *p,PACKFILE *f,bool keepdata)
     
 #ifdef NEWALLEGRO
     
-    if(f->normal.flags&PACKFILE_FLAG_WRITE) return false;     //must not be writing to file
+    if(f->is_normal_packfile && (f->normal.flags&PACKFILE_FLAG_WRITE)) return false;     //must not be writing to file
     
 #else
     
@@ -5144,13 +5348,18 @@ INLINE bool p_iputl(int32_t c,PACKFILE *f)
 {
     bool success=true;
     
-    if(!fake_pack_writing)
+    if(section_write_buffer)
+    {
+        byte b[4] = { byte(c), byte(c>>8), byte(c>>16), byte(c>>24) };
+        section_buffer_write(b,4);
+    }
+    else
     {
         if(!f) return false;
         
 #ifdef NEWALLEGRO
         
-        if(!(f->normal.flags&PACKFILE_FLAG_WRITE)) return false;  //must be writing to file
+        if(f->is_normal_packfile && !(f->normal.flags&PACKFILE_FLAG_WRITE)) return false;  //must be writing to file
         
 #else
         
@@ -5177,9 +5386,24 @@ INLINE bool p_mgetw(void *p,PACKFILE *f,bool keepdata)
     
     if(!f) return false;
     
+    if(packfile_memory *m = packfile_buffer(f))
+    {
+        byte b[2];
+        
+        if(!packfile_buffer_read(m,b,2,true))
+            return false;
+            
+        if(keepdata==true)
+        {
+            *cp = int16_t((b[0]<<8) | b[1]);
+        }
+        
+        return true;
+    }
+    
 #ifdef NEWALLEGRO
     
-    if(f->normal.flags&PACKFILE_FLAG_WRITE) return false;     //must not be writing to file
+    if(f->is_normal_packfile && (f->normal.flags&PACKFILE_FLAG_WRITE)) return false;     //must not be writing to file
     
 #else
     
@@ -5212,13 +5436,18 @@ INLINE bool p_mputw(int32_t c,PACKFILE *f)
 {
     bool success=true;
     
-    if(!fake_pack_writing)
+    if(section_write_buffer)
+    {
+        byte b[2] = { byte(c>>8), byte(c) };
+        section_buffer_write(b,2);
+    }
+    else
     {
         if(!f) return false;
         
 #ifdef NEWALLEGRO
         
-        if(!(f->normal.flags&PACKFILE_FLAG_WRITE)) return false;  //must be writing to file
+        if(f->is_normal_packfile && !(f->normal.flags&PACKFILE_FLAG_WRITE)) return false;  //must be writing to file
         
 #else
         
@@ -5245,9 +5474,24 @@ INLINE bool p_mgetl(void *p,PACKFILE *f,bool keepdata)
     
     if(!f) return false;
     
+    if(packfile_memory *m = packfile_buffer(f))
+    {
+        byte b[4];
+        
+        if(!packfile_buffer_read(m,b,4,true))
+            return false;
+            
+        if(keepdata==true)
+        {
+            *cp = (dword(b[0])<<24) | (dword(b[1])<<16) | (dword(b[2])<<8) | dword(b[3]);
+        }
+        
+        return true;
+    }
+    
 #ifdef NEWALLEGRO
     
-    if(f->normal.flags&PACKFILE_FLAG_WRITE) return false;     //must not be writing to file
+    if(f->is_normal_packfile && (f->normal.flags&PACKFILE_FLAG_WRITE)) return false;     //must not be writing to file
     
 #else
     
@@ -5280,13 +5524,18 @@ INLINE bool p_mputl(int32_t c,PACKFILE *f)
 {
     bool success=true;
     
-    if(!fake_pack_writing)
+    if(section_write_buffer)
+    {
+        byte b[4] = { byte(c>>24), byte(c>>16), byte(c>>8), byte(c) };
+        section_buffer_write(b,4);
+    }
+    else
     {
         if(!f) return false;
         
 #ifdef NEWALLEGRO
         
-        if(!(f->normal.flags&PACKFILE_FLAG_WRITE)) return false;  //must be writing to file
+        if(f->is_normal_packfile && !(f->normal.flags&PACKFILE_FLAG_WRITE)) return false;  //must be writing to file
         
 #else
         
@@ -5318,7 +5567,39 @@ INLINE void SCRFIX()
 
 // ack no, inline doesn't work this way -DD
 //INLINE int32_t new_return(int32_t x) { fake_pack_writing=false; return x; }
-#define new_return(x) {assert(x == 0); fake_pack_writing = false; return x; }
+#define new_return(x) {assert(x == 0); return x; }
+
+//Redirects every p_* / pfwrite write into memory while in scope, so a quest
+//section is serialized exactly once. commit() then writes the section size
+//followed by the buffered payload to the real file. If the writer goes out of
+//scope without committing (an error return), the payload is discarded.
+class section_writer
+{
+public:
+    explicit section_writer(PACKFILE *f);
+    ~section_writer();
+    
+    bool commit();
+    //Hands the buffered payload to the caller instead of writing it out
+    void release(std::vector<byte>& out);
+    dword size() const
+    {
+        return dword(data.size());
+    }
+    std::vector<byte> const& bytes() const
+    {
+        return data;
+    }
+    
+private:
+    PACKFILE *dest;
+    std::vector<byte> data;
+    std::vector<byte> *prev_buffer;
+    bool active;
+    
+    section_writer(section_writer const&);
+    section_writer& operator=(section_writer const&);
+};
 
 //some methods for dealing with items
 int32_t getItemFamily(itemdata *items, int32_t item);
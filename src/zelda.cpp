@@ -348,7 +348,6 @@ PALETTE tempbombpal;
 bool usebombpal = false;
 
 int32_t readsize = 0, writesize = 0;
-bool fake_pack_writing=false;
 combo_alias combo_aliases[MAXCOMBOALIASES];  //Temporarily here so ZC can compile. All memory from this is freed after loading the quest file.
 
 SAMPLE customsfxdata[WAV_COUNT] = {0};
@@ -1315,6 +1314,7 @@ HeroClass   Hero;
 #include "ending.h"
 
 #include "zc_sys.h"
+#include "frametimer.h"
 //extern MENU the_player_menu;
 //extern MENU the_player_menu2;
 //extern byte refresh_select_screen;
@@ -1851,6 +1851,7 @@ int32_t init_game()
 	Hero.unfreeze();
 	Hero.reset_hookshot();
 	Hero.reset_ladder();
+	clear_screen_prefetch();
 	linkedmsgclk=0;
 	blockmoving=false;
 	add_asparkle=0;
@@ -3367,6 +3368,7 @@ void game_loop()
 	{
 		GameFlags &= ~GAMEFLAG_RESET_GAME_LOOP;
 		genscript_timing = SCR_TIMING_START_FRAME;
+		frame_timer_phase(fpOTHER);
 		if((pause_in_background && callback_switchin && midi_patch_fix))
 		{
 			if(currmidi!=0)
@@ -3473,6 +3475,7 @@ void game_loop()
 				}
 			}
 		}
+		frame_timer_phase(fpCOMBOS);
 		#if LOGGAMELOOP > 0
 		al_trace("game_loop is calling: %s\n", "animate_combos()\n");
 		#endif
@@ -3491,6 +3494,7 @@ void game_loop()
 		}
 		
 		FFCore.runGenericPassiveEngine(SCR_TIMING_POST_FFCS);
+		frame_timer_phase(fpGLOBAL_SCRIPTS);
 		// Arbitrary Rule 637: neither 'freeze' nor 'freezeff' freeze the global script.
 		if(!FFCore.system_suspend[susptGLOBALGAME] && !freezemsg && (g_doscript & (1<<GLOBAL_SCRIPT_GAME)))
 		{
@@ -3512,6 +3516,7 @@ void game_loop()
 			ZScriptVersion::RunScript(SCRIPT_PASSIVESUBSCREEN, DMaps[currdmap].passive_sub_script,currdmap);
 		}
 		FFCore.runGenericPassiveEngine(SCR_TIMING_POST_DMAPDATA_PASSIVESUBSCREEN);
+		frame_timer_phase(fpFFC_SCRIPTS);
 		if ( !FFCore.system_suspend[susptCOMBOSCRIPTS] && !freezemsg && FFCore.getQuestHeaderInfo(vZelda) >= 0x255 )
 		{
 			FFCore.combo_script_engine(false);    
@@ -3521,6 +3526,7 @@ void game_loop()
 		
 		if(!freeze && !freezemsg)
 		{
+			frame_timer_phase(fpITEMS);
 			#if LOGGAMELOOP > 0
 			al_trace("game_loop is calling: %s\n", "mblock2.animate()\n");
 			#endif
@@ -3529,8 +3535,10 @@ void game_loop()
 			#if LOGGAMELOOP > 0
 			al_trace("game_loop is calling: %s\n", "items.animate()\n");
 			#endif
+			frame_timer_phase(fpITEM_SCRIPTS);
 			if ( !FFCore.system_suspend[susptITEMSPRITESCRIPTS] )  FFCore.itemSpriteScriptEngine();
 			FFCore.runGenericPassiveEngine(SCR_TIMING_POST_ITEMSPRITE_SCRIPT);
+			frame_timer_phase(fpITEMS);
 			if ( !FFCore.system_suspend[susptITEMS] ) items.animate();
 		
 			//Can't be called in items.animate(), as ZQuest also uses this function.
@@ -3539,11 +3547,13 @@ void game_loop()
 			#endif
 			if ( !FFCore.system_suspend[susptCONVEYORSITEMS] ) items.check_conveyor();
 			FFCore.runGenericPassiveEngine(SCR_TIMING_POST_ITEMSPRITE_ANIMATE);
+			frame_timer_phase(fpNPCS);
 			#if LOGGAMELOOP > 0
 			al_trace("game_loop is calling: %s\n", "guys.animate()\n");
 			#endif
 			if ( !FFCore.system_suspend[susptGUYS] ) guys.animate();
 			FFCore.runGenericPassiveEngine(SCR_TIMING_POST_NPC_ANIMATE);
+			frame_timer_phase(fpITEMS);
 			#if LOGGAMELOOP > 0
 			al_trace("game_loop is calling: %s\n", "roaming_item()\n");
 			#endif
@@ -3552,11 +3562,13 @@ void game_loop()
 			al_trace("game_loop is calling: %s\n", "dragging_item()\n");
 			#endif
 			if ( !FFCore.system_suspend[susptDRAGGINGITEM] ) dragging_item();
+			frame_timer_phase(fpWEAPONS);
 			#if LOGGAMELOOP > 0
 			al_trace("game_loop is calling: %s\n", "Ewpns.animate()\n");
 			#endif
 			if ( !FFCore.system_suspend[susptEWEAPONS] ) Ewpns.animate();
 			FFCore.runGenericPassiveEngine(SCR_TIMING_POST_EWPN_ANIMATE);
+			frame_timer_phase(fpEWEAPON_SCRIPTS);
 			if ( !FFCore.system_suspend[susptEWEAPONSCRIPTS] ) FFCore.eweaponScriptEngine();
 			FFCore.runGenericPassiveEngine(SCR_TIMING_POST_EWPN_SCRIPT);
 			#if LOGGAMELOOP > 0
@@ -3569,9 +3581,11 @@ void game_loop()
 			
 			if ( !FFCore.system_suspend[susptONEFRAMECONDS] )  clear_script_one_frame_conditions(); //clears npc->HitBy[] for this frame: the timing on this may need adjustment. 
 			
+			frame_timer_phase(fpITEM_SCRIPTS);
 			if ( get_bit(quest_rules, qr_OLD_ITEMDATA_SCRIPT_TIMING) && !FFCore.system_suspend[susptITEMSCRIPTENGINE] )
 				FFCore.itemScriptEngine(); //run before lweapon scripts
 			FFCore.runGenericPassiveEngine(SCR_TIMING_POST_OLD_ITEMDATA_SCRIPT);
+			frame_timer_phase(fpHERO);
 			if ( !FFCore.system_suspend[susptHERO] )
 			{
 				for(int32_t i = 0; i < (gofast ? 8 : 1); i++)
@@ -3595,6 +3609,7 @@ void game_loop()
 				if(GameFlags & GAMEFLAG_RESET_GAME_LOOP) continue; //continue the game_loop while(true)
 			}
 			FFCore.runGenericPassiveEngine(SCR_TIMING_POST_PLAYER_ANIMATE);
+			frame_timer_phase(fpITEM_SCRIPTS);
 			if ( !get_bit(quest_rules, qr_OLD_ITEMDATA_SCRIPT_TIMING) && !FFCore.system_suspend[susptITEMSCRIPTENGINE] )
 				FFCore.itemScriptEngine(); //run before lweapon scripts
 			FFCore.runGenericPassiveEngine(SCR_TIMING_POST_NEW_ITEMDATA_SCRIPT);
@@ -3603,12 +3618,14 @@ void game_loop()
 			#if LOGGAMELOOP > 0
 			al_trace("game_loop is calling: %s\n", "do_magic_casting()\n");
 			#endif
+			frame_timer_phase(fpHERO);
 			Hero.cleanupByrna(); //Prevent sfx glitches with Cane of Byrna if it fails to initialise; ported from 2.53. -Z
 			if ( !FFCore.system_suspend[susptMAGICCAST] ) do_magic_casting();
 			FFCore.runGenericPassiveEngine(SCR_TIMING_POST_CASTING);
 			#if LOGGAMELOOP > 0
 			al_trace("game_loop is calling: %s\n", "Lwpns.animate()\n");
 			#endif
+			frame_timer_phase(fpWEAPONS);
 			//perhaps add sprite.waitdraw, and call sprite script here too?
 			//FFCore.lweaponScriptEngine();
 			if ( !FFCore.system_suspend[susptLWEAPONS] ) Lwpns.animate();
@@ -3619,6 +3636,7 @@ void game_loop()
 			al_trace("game_loop is calling: %s\n", "FFCore.itemScriptEngine())\n");
 			#endif
 			
+			frame_timer_phase(fpOTHER);
 			#if LOGGAMELOOP > 0
 			al_trace("game_loop is calling: %s\n", "decorations.animate()\n");
 			#endif
@@ -3628,6 +3646,7 @@ void game_loop()
 			#endif
 			if ( !FFCore.system_suspend[susptPARTICLES] ) particles.animate();
 			FFCore.runGenericPassiveEngine(SCR_TIMING_POST_DECOPARTICLE_ANIMATE);
+			frame_timer_phase(fpWEAPONS);
 			#if LOGGAMELOOP > 0
 			al_trace("game_loop is calling: %s\n", "update_hookshot()\n");
 			#endif
@@ -3639,10 +3658,12 @@ void game_loop()
 			}
 			
 			--conveyclk;
+			frame_timer_phase(fpCOLLISIONS);
 			#if LOGGAMELOOP > 0
 			al_trace("game_loop is calling: %s\n", "check_collisions()\n");
 			#endif
 			if ( !FFCore.system_suspend[susptCOLLISIONS] ) check_collisions();
+			frame_timer_phase(fpOTHER);
 			#if LOGGAMELOOP > 0
 			al_trace("game_loop is calling: %s\n", "dryuplake()\n");
 			#endif
@@ -3655,6 +3676,7 @@ void game_loop()
 		}
 		else if(freezemsg)
 		{
+			frame_timer_phase(fpNPCS);
 			FFCore.runGenericPassiveEngine(SCR_TIMING_POST_ITEMSPRITE_ANIMATE);
 			for(int32_t i=0; i<guys.Count(); i++)
 			{
@@ -3665,6 +3687,7 @@ void game_loop()
 			}
 			FFCore.runGenericPassiveEngine(SCR_TIMING_POST_NPC_ANIMATE);
 		}
+		frame_timer_phase(fpGLOBAL_SCRIPTS);
 		#if LOGGAMELOOP > 0
 		al_trace("game_loop at: %s\n", "if(global_wait)\n");
 		#endif
@@ -3702,6 +3725,7 @@ void game_loop()
 		}
 		FFCore.runGenericPassiveEngine(SCR_TIMING_POST_SCREEN_WAITDRAW);
 		
+		frame_timer_phase(fpFFC_SCRIPTS);
 		for ( int32_t q = 0; q < 32; ++q )
 		{
 			//Z_scripterrlog("tmpscr->ffcswaitdraw is: %d\n", tmpscr->ffcswaitdraw);
@@ -3723,17 +3747,22 @@ void game_loop()
 		}
 		FFCore.runGenericPassiveEngine(SCR_TIMING_POST_COMBO_WAITDRAW);
 		
+		frame_timer_phase(fpITEM_SCRIPTS);
 		//Waitdraw for item scripts. 
 		if ( !FFCore.system_suspend[susptITEMSCRIPTENGINE] ) FFCore.itemScriptEngineOnWaitdraw();
 		FFCore.runGenericPassiveEngine(SCR_TIMING_POST_ITEM_WAITDRAW);
 		
 		//Sprite scripts on Waitdraw in order of : npc, ewpn, lwpn, itemsprite
+		frame_timer_phase(fpNPC_SCRIPTS);
 		if ( !FFCore.system_suspend[susptNPCSCRIPTS] ) FFCore.npcScriptEngineOnWaitdraw();
 		FFCore.runGenericPassiveEngine(SCR_TIMING_POST_NPC_WAITDRAW);
+		frame_timer_phase(fpEWEAPON_SCRIPTS);
 		if ( !FFCore.system_suspend[susptEWEAPONSCRIPTS] ) FFCore.eweaponScriptEngineOnWaitdraw();
 		FFCore.runGenericPassiveEngine(SCR_TIMING_POST_EWPN_WAITDRAW);
+		frame_timer_phase(fpLWEAPON_SCRIPTS);
 		if ( !FFCore.system_suspend[susptLWEAPONSCRIPTS] ) FFCore.lweaponScriptEngineOnWaitdraw();
 		FFCore.runGenericPassiveEngine(SCR_TIMING_POST_LWPN_WAITDRAW);
+		frame_timer_phase(fpITEM_SCRIPTS);
 		if ( !FFCore.system_suspend[susptITEMSPRITESCRIPTS] ) FFCore.itemSpriteScriptEngineOnWaitdraw();
 		FFCore.runGenericPassiveEngine(SCR_TIMING_POST_ITEMSPRITE_WAITDRAW);
 		
@@ -3741,12 +3770,14 @@ void game_loop()
 		
 		
 		
+		frame_timer_phase(fpDRAW);
 		#if LOGGAMELOOP > 0
 		al_trace("game_loop is calling: %s\n", "draw_screen()\n");
 		#endif
 		if ( !FFCore.system_suspend[susptSCREENDRAW] ) draw_screen(tmpscr,true,true);
 		else FFCore.runGenericPassiveEngine(SCR_TIMING_POST_DRAW);
 		
+		frame_timer_phase(fpOTHER);
 		//clear Hero's last hits 
 		//for ( int32_t q = 0; q < 4; q++ ) Hero.sethitHeroUID(q, 0); //Clearing these here makes checking them fail both before and after waitdraw. 
 		#if LOGGAMELOOP > 0
@@ -4586,6 +4617,7 @@ int32_t main(int32_t argc, char* argv[])
 		load_game_configs();
 		save_game_configs();
 	}
+	frame_trace_open(zc_get_config("zeldadx","frametrace",""));
 	
 #ifndef ALLEGRO_MACOSX // Should be done on Mac, too, but I haven't gotten that working
 	if(!is_only_instance("zc.lck"))
@@ -5464,6 +5496,7 @@ int32_t main(int32_t argc, char* argv[])
 	game->Clear();
 	
 	hangcount = zc_get_config("ZSCRIPT","ZASM_Hangcount",1000);
+	load_script_budgets();
 	
 #ifdef _WIN32
 	
@@ -5514,6 +5547,7 @@ int32_t main(int32_t argc, char* argv[])
 		setup_combo_animations2();
 		
 		clear_bitmap(lightbeam_bmp);
+		invalidate_spotlights();
 		while(Quit<=0)
 		{
 #ifdef _WIN32
@@ -5539,6 +5573,7 @@ int32_t main(int32_t argc, char* argv[])
 		
 		tmpscr->flags3=0;
 		Playing=Paused=false;
+		report_script_throttles();
 		//Clear active script array ownership
 		FFCore.deallocateAllArrays(SCRIPT_GLOBAL, GLOBAL_SCRIPT_GAME);
 		FFCore.deallocateAllArrays(SCRIPT_PLAYER, SCRIPT_PLAYER_ACTIVE);
@@ -5668,6 +5703,8 @@ int32_t main(int32_t argc, char* argv[])
 		}
 		//Deallocate ALL ZScript arrays on ANY exit.
 		FFCore.deallocateAllArrays();
+		clear_passive_subscr_cache();
+		clear_map_render();
 		GameFlags = 0; //Clear game flags on ANY exit
 		kill_sfx();
 		music_stop();
@@ -5751,6 +5788,7 @@ void delete_everything_else() //blarg.
 void quit_game()
 {
 	script_drawing_commands.Dispose(); //for allegro bitmaps
+	frame_trace_close();
 	
 	remove_installed_timers();
 	delete_everything_else();
@@ -5770,6 +5808,8 @@ void quit_game()
 	//    destroy_bitmap(mappic);
 	
 	al_trace("Bitmaps... \n");
+	clear_map_render();
+	clear_passive_subscr_cache();
 	destroy_bitmap(framebuf);
 	destroy_bitmap(scrollbuf);
 	destroy_bitmap(tmp_scr);
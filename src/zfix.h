@@ -15,21 +15,12 @@ typedef int32_t ZLong;
 typedef int64_t zint64;
 
 class zfix;
-inline zfix zslongToFix(ZLong val);
-inline ZLong toZLong(float val);
-inline ZLong toZLong(double val);
-inline ZLong toZLong(int32_t val);
-inline ZLong toZLong(int32_t val);
-inline zfix floor(zfix fx);
-inline zfix abs(zfix fx);
-
-static int32_t zfixvbound(ZLong x, int32_t low, int32_t high)
-{
-	assert(low <= high);
-	if(x<low) return low;
-	if(x>high) return high;
-	return x;
-}
+constexpr inline zfix zslongToFix(ZLong val);
+constexpr inline ZLong toZLong(float val);
+constexpr inline ZLong toZLong(double val);
+constexpr inline ZLong toZLong(int32_t val);
+constexpr inline zfix floor(zfix fx);
+constexpr inline zfix abs(zfix fx);
 //inline int32_t vbound(int32_t x,int32_t low,int32_t high);
 //inline float vbound(float x,float low,float high);
 
@@ -40,234 +31,233 @@ class zfix
 public:
 	ZLong val;
 
-	int32_t getInt() const
+	constexpr int32_t getInt() const
 	{
-		return val/10000L + zfixvbound((val%10000L)/5000L, (val < 0 ? -1 : 0),(val<0 ? 0 : 1));
+		//|val%10000| < 10000, so this is already -1, 0 or 1 (rounds half away from zero)
+		return val/10000L + (val%10000L)/5000L;
 	}
-	double getFloat() const
+	constexpr double getFloat() const
 	{
 		return val/10000.0;
 	}
-	ZLong getZLong() const
+	constexpr ZLong getZLong() const
 	{
 		return val;
 	}
-	int32_t getDPart() const
+	constexpr int32_t getDPart() const
 	{
 		return val%10000;
 	}
 	
 	
 	
-	zfix& doFloor()
+	constexpr zfix& doFloor()
 	{
 		val = (val / 10000) * 10000;
 		return *this;
 	}
-	int32_t getFloor() const
+	constexpr int32_t getFloor() const
 	{
 		return val / 10000L;
 	}
 	
-	zfix& doRound()
+	constexpr zfix& doRound()
 	{
 		if ((val % 10000) >= 5000) val = ((val / 10000)+1) * 10000;
 		else val = (val / 10000) * 10000;
 		return *this;
 	}
-	int32_t getRound() const
+	constexpr int32_t getRound() const
 	{
 		if ((val % 10000) >= 5000) return ((val / 10000)+1);
 		else return (val / 10000);
 	}
 	
-	zfix& doAbs()
+	constexpr zfix& doAbs()
 	{
-		val = abs(val);
+		if(val < 0) val = -val;
 		return *this;
 	}
 	
-	zfix& doTrunc()
+	constexpr zfix& doTrunc()
 	{
 		val /= 10000;
 		val *= 10000;
 		return *this;
 	}
-	int32_t getTrunc() const
+	constexpr int32_t getTrunc() const
 	{
 		return val/10000;
 	}
 public:
 	
-	zfix() : val(0)											{}
-	zfix(const zfix &v) : val(v.val)						{}
-	zfix(const int32_t v) : val(v*10000L)				{}
-	zfix(const uint32_t v) : val(v*10000L)		{}
-	zfix(const float v) : val(v*10000L)			{}
-	zfix(const double v) : val(v*10000L)			{}
-	explicit zfix(const int32_t ip, const int32_t dp)
-	{
-		val = ip*10000L + dp;
-	}
+	//Trivial copies let zfix be passed and returned in registers
+	constexpr zfix() : val(0)											{}
+	constexpr zfix(const zfix &v) = default;
+	constexpr zfix(const int32_t v) : val(v*10000L)				{}
+	constexpr zfix(const uint32_t v) : val(v*10000L)		{}
+	constexpr zfix(const float v) : val(v*10000L)			{}
+	constexpr zfix(const double v) : val(v*10000L)			{}
+	constexpr explicit zfix(const int32_t ip, const int32_t dp) : val(ip*10000L + dp) {}
 	
-	zfix copy() const							{ zfix t; t.val = val; return t; }
+	constexpr zfix copy() const							{ zfix t; t.val = val; return t; }
 	
-	operator int32_t() const						{ return getInt(); }
-	operator uint32_t() const				{ return getInt(); }
-	operator float() const						{ return getFloat(); }
-	operator double() const						{ return getFloat(); }
-	operator bool() const						{ return val!=0; }
+	constexpr operator int32_t() const						{ return getInt(); }
+	constexpr operator uint32_t() const				{ return getInt(); }
+	constexpr operator float() const						{ return getFloat(); }
+	constexpr operator double() const						{ return getFloat(); }
+	constexpr operator bool() const						{ return val!=0; }
 	
-	zfix& operator = (const zfix &fx)			{ val = fx.val; return *this; }
-	zfix& operator = (const int32_t v)				{ val = v*10000L; return *this; }
-	zfix& operator = (const uint32_t v)		{ val = v*10000L; return *this; }
-	zfix& operator = (const float v)			{ val = v*10000L; return *this; }
-	zfix& operator = (const double v)			{ val = v*10000L; return *this; }
+	constexpr zfix& operator = (const zfix &fx) = default;
+	constexpr zfix& operator = (const int32_t v)				{ val = v*10000L; return *this; }
+	constexpr zfix& operator = (const uint32_t v)		{ val = v*10000L; return *this; }
+	constexpr zfix& operator = (const float v)			{ val = v*10000L; return *this; }
+	constexpr zfix& operator = (const double v)			{ val = v*10000L; return *this; }
 	
-	zfix& operator +=  (const zfix fx)	{ val += fx.val; return *this; }
-	zfix& operator +=  (const int32_t v)	{ val += v*10000L; return *this; }
-	zfix& operator +=  (const float v)	{ val += v*10000L; return *this; }
-	zfix& operator +=  (const double v)	{ val += v*10000L; return *this; }
+	constexpr zfix& operator +=  (const zfix fx)	{ val += fx.val; return *this; }
+	constexpr zfix& operator +=  (const int32_t v)	{ val += v*10000L; return *this; }
+	constexpr zfix& operator +=  (const float v)	{ val += v*10000L; return *this; }
+	constexpr zfix& operator +=  (const double v)	{ val += v*10000L; return *this; }
 	
-	zfix& operator -=  (const zfix fx)	{ val -= fx.val; return *this; }
-	zfix& operator -=  (const int32_t v)	{ val -= v*10000L; return *this; }
-	zfix& operator -=  (const float v)	{ val -= v*10000L; return *this; }
-	zfix& operator -=  (const double v)	{ val -= v*10000L; return *this; }
+	constexpr zfix& operator -=  (const zfix fx)	{ val -= fx.val; return *this; }
+	constexpr zfix& operator -=  (const int32_t v)	{ val -= v*10000L; return *this; }
+	constexpr zfix& operator -=  (const float v)	{ val -= v*10000L; return *this; }
+	constexpr zfix& operator -=  (const double v)	{ val -= v*10000L; return *this; }
 	
-	static int32_t longMul(int32_t a, int32_t b)	{ zint64 c = int64_t(a)*b; return (int32_t)(c/10000L);}
-	zfix& operator *=  (const zfix fx)	{ val = longMul(val, fx.val); return *this; }
-	zfix& operator *=  (const int32_t v)	{ val *= v; return *this; }
-	zfix& operator *=  (const float v)	{ val = longMul(val, toZLong(v)); return *this; }
-	zfix& operator *=  (const double v)	{ val = longMul(val, toZLong(v)); return *this; }
+	constexpr static int32_t longMul(int32_t a, int32_t b)	{ zint64 c = int64_t(a)*b; return (int32_t)(c/10000L);}
+	constexpr zfix& operator *=  (const zfix fx)	{ val = longMul(val, fx.val); return *this; }
+	constexpr zfix& operator *=  (const int32_t v)	{ val *= v; return *this; }
+	constexpr zfix& operator *=  (const float v)	{ val = longMul(val, toZLong(v)); return *this; }
+	constexpr zfix& operator *=  (const double v)	{ val = longMul(val, toZLong(v)); return *this; }
 	
-	static int32_t longDiv(int32_t a, int32_t b)	{ zint64 c = int64_t(a)*10000L; return (int32_t)(c/b); }
-	zfix& operator /=  (const zfix fx)	{
+	constexpr static int32_t longDiv(int32_t a, int32_t b)	{ zint64 c = int64_t(a)*10000L; return (int32_t)(c/b); }
+	constexpr zfix& operator /=  (const zfix fx)	{
 		if(fx.val == 0) val = toZLong(FIX_NAN);
 		else val = longDiv(val, fx.val); return *this; }
-	zfix& operator /=  (const int32_t v)	{
+	constexpr zfix& operator /=  (const int32_t v)	{
 		if(v == 0) val = toZLong(FIX_NAN);
 		else val /= v; return *this; }
-	zfix& operator /=  (const float v)	{
+	constexpr zfix& operator /=  (const float v)	{
 		if(toZLong(v) == 0) val = toZLong(FIX_NAN);
 		else val = longDiv(val, toZLong(v)); return *this; }
-	zfix& operator /=  (const double v)	{
+	constexpr zfix& operator /=  (const double v)	{
 		if(toZLong(v) == 0) val = toZLong(FIX_NAN);
 		else val = longDiv(val, toZLong(v)); return *this; }
 	
-	zfix& operator <<= (const int32_t v)	{ val <<= v; return *this; }
-	zfix& operator >>= (const int32_t v)	{ val >>= v; return *this; }
+	constexpr zfix& operator <<= (const int32_t v)	{ val <<= v; return *this; }
+	constexpr zfix& operator >>= (const int32_t v)	{ val >>= v; return *this; }
 	
-	zfix& operator ++ ()				{ val += 10000; return *this; }
-	zfix& operator -- ()				{ val -= 10000; return *this; }
-	bool operator ! ()				    { return !val; }
+	constexpr zfix& operator ++ ()				{ val += 10000; return *this; }
+	constexpr zfix& operator -- ()				{ val -= 10000; return *this; }
+	constexpr bool operator ! () const			    { return !val; }
 	
-	zfix operator ++ (int32_t)				{ zfix t = copy(); val += 10000; return t; }
-	zfix operator -- (int32_t)				{ zfix t = copy(); val -= 10000; return t; }
+	constexpr zfix operator ++ (int32_t)				{ zfix t = copy(); val += 10000; return t; }
+	constexpr zfix operator -- (int32_t)				{ zfix t = copy(); val -= 10000; return t; }
 	
-	zfix operator - () const			{ zfix t; t.val = -val; return t; }
+	constexpr zfix operator - () const			{ zfix t; t.val = -val; return t; }
 	
-	inline friend zfix operator +  (const zfix fx, const zfix fx2);
-	inline friend zfix operator +  (const zfix fx, const int32_t v);
-	inline friend zfix operator +  (const int32_t v, const zfix fy);
-	inline friend zfix operator +  (const zfix fx, const int32_t v);
-	inline friend zfix operator +  (const int32_t v, const zfix fy);
-	inline friend zfix operator +  (const zfix fx, const float v);
-	inline friend zfix operator +  (const float v, const zfix fy);
-	inline friend zfix operator +  (const zfix fx, const double v);
-	inline friend zfix operator +  (const double v, const zfix fy);
+	constexpr inline friend zfix operator +  (const zfix fx, const zfix fx2);
+	constexpr inline friend zfix operator +  (const zfix fx, const int32_t v);
+	constexpr inline friend zfix operator +  (const int32_t v, const zfix fy);
+	constexpr inline friend zfix operator +  (const zfix fx, const int32_t v);
+	constexpr inline friend zfix operator +  (const int32_t v, const zfix fy);
+	constexpr inline friend zfix operator +  (const zfix fx, const float v);
+	constexpr inline friend zfix operator +  (const float v, const zfix fy);
+	constexpr inline friend zfix operator +  (const zfix fx, const double v);
+	constexpr inline friend zfix operator +  (const double v, const zfix fy);
 	
-	inline friend zfix operator -  (const zfix fx, const zfix fx2);
-	inline friend zfix operator -  (const zfix fx, const int32_t v);
-	inline friend zfix operator -  (const int32_t v, const zfix fx);
-	inline friend zfix operator -  (const zfix fx, const int32_t v);
-	inline friend zfix operator -  (const int32_t v, const zfix fx);
-	inline friend zfix operator -  (const zfix fx, const float v);
-	inline friend zfix operator -  (const float v, const zfix fx);
-	inline friend zfix operator -  (const zfix fx, const double v);
-	inline friend zfix operator -  (const double v, const zfix fx);
+	constexpr inline friend zfix operator -  (const zfix fx, const zfix fx2);
+	constexpr inline friend zfix operator -  (const zfix fx, const int32_t v);
+	constexpr inline friend zfix operator -  (const int32_t v, const zfix fx);
+	constexpr inline friend zfix operator -  (const zfix fx, const int32_t v);
+	constexpr inline friend zfix operator -  (const int32_t v, const zfix fx);
+	constexpr inline friend zfix operator -  (const zfix fx, const float v);
+	constexpr inline friend zfix operator -  (const float v, const zfix fx);
+	constexpr inline friend zfix operator -  (const zfix fx, const double v);
+	constexpr inline friend zfix operator -  (const double v, const zfix fx);
 	
-	inline friend zfix operator *  (const zfix fx, const zfix fx2);
-	inline friend zfix operator *  (const zfix fx, const int32_t v);
-	inline friend zfix operator *  (const int32_t v, const zfix fx);
-	inline friend zfix operator *  (const zfix fx, const int32_t v);
-	inline friend zfix operator *  (const int32_t v, const zfix fx);
-	inline friend zfix operator *  (const zfix fx, const float v);
-	inline friend zfix operator *  (const float v, const zfix fx);
-	inline friend zfix operator *  (const zfix fx, const double v);
-	inline friend zfix operator *  (const double v, const zfix fx);
+	constexpr inline friend zfix operator *  (const zfix fx, const zfix fx2);
+	constexpr inline friend zfix operator *  (const zfix fx, const int32_t v);
+	constexpr inline friend zfix operator *  (const int32_t v, const zfix fx);
+	constexpr inline friend zfix operator *  (const zfix fx, const int32_t v);
+	constexpr inline friend zfix operator *  (const int32_t v, const zfix fx);
+	constexpr inline friend zfix operator *  (const zfix fx, const float v);
+	constexpr inline friend zfix operator *  (const float v, const zfix fx);
+	constexpr inline friend zfix operator *  (const zfix fx, const double v);
+	constexpr inline friend zfix operator *  (const double v, const zfix fx);
 	
-	inline friend zfix operator /  (const zfix fx, const zfix fx2);
-	inline friend zfix operator /  (const zfix fx, const int32_t v);
-	inline friend zfix operator /  (const int32_t v, const zfix fx);
-	inline friend zfix operator /  (const zfix fx, const int32_t v);
-	inline friend zfix operator /  (const int32_t v, const zfix fx);
-	inline friend zfix operator /  (const zfix fx, const float v);
-	inline friend zfix operator /  (const float v, const zfix fx);
-	inline friend zfix operator /  (const zfix fx, const double v);
-	inline friend zfix operator /  (const double v, const zfix fx);
+	constexpr inline friend zfix operator /  (const zfix fx, const zfix fx2);
+	constexpr inline friend zfix operator /  (const zfix fx, const int32_t v);
+	constexpr inline friend zfix operator /  (const int32_t v, const zfix fx);
+	constexpr inline friend zfix operator /  (const zfix fx, const int32_t v);
+	constexpr inline friend zfix operator /  (const int32_t v, const zfix fx);
+	constexpr inline friend zfix operator /  (const zfix fx, const float v);
+	constexpr inline friend zfix operator /  (const float v, const zfix fx);
+	constexpr inline friend zfix operator /  (const zfix fx, const double v);
+	constexpr inline friend zfix operator /  (const double v, const zfix fx);
 	
-	inline friend zfix operator << (const zfix fx, const int32_t v);
-	inline friend zfix operator >> (const zfix fx, const int32_t v);
+	constexpr inline friend zfix operator << (const zfix fx, const int32_t v);
+	constexpr inline friend zfix operator >> (const zfix fx, const int32_t v);
 	
-	inline friend int32_t operator == (const zfix fx, const zfix fx2);
-	inline friend int32_t operator == (const zfix fx, const int32_t v);
-	inline friend int32_t operator == (const int32_t v, const zfix fx);
-	inline friend int32_t operator == (const zfix fx, const int32_t v);
-	inline friend int32_t operator == (const int32_t v, const zfix fx);
-	inline friend int32_t operator == (const zfix fx, const float v);
-	inline friend int32_t operator == (const float v, const zfix fx);
-	inline friend int32_t operator == (const zfix fx, const double v);
-	inline friend int32_t operator == (const double v, const zfix fx);
+	constexpr inline friend int32_t operator == (const zfix fx, const zfix fx2);
+	constexpr inline friend int32_t operator == (const zfix fx, const int32_t v);
+	constexpr inline friend int32_t operator == (const int32_t v, const zfix fx);
+	constexpr inline friend int32_t operator == (const zfix fx, const int32_t v);
+	constexpr inline friend int32_t operator == (const int32_t v, const zfix fx);
+	constexpr inline friend int32_t operator == (const zfix fx, const float v);
+	constexpr inline friend int32_t operator == (const float v, const zfix fx);
+	constexpr inline friend int32_t operator == (const zfix fx, const double v);
+	constexpr inline friend int32_t operator == (const double v, const zfix fx);
 	
-	inline friend int32_t operator != (const zfix fx, const zfix fx2);
-	inline friend int32_t operator != (const zfix fx, const int32_t v);
-	inline friend int32_t operator != (const int32_t v, const zfix fx);
-	inline friend int32_t operator != (const zfix fx, const int32_t v);
-	inline friend int32_t operator != (const int32_t v, const zfix fx);
-	inline friend int32_t operator != (const zfix fx, const float v);
-	inline friend int32_t operator != (const float v, const zfix fx);
-	inline friend int32_t operator != (const zfix fx, const double v);
-	inline friend int32_t operator != (const double v, const zfix fx);
+	constexpr inline friend int32_t operator != (const zfix fx, const zfix fx2);
+	constexpr inline friend int32_t operator != (const zfix fx, const int32_t v);
+	constexpr inline friend int32_t operator != (const int32_t v, const zfix fx);
+	constexpr inline friend int32_t operator != (const zfix fx, const int32_t v);
+	constexpr inline friend int32_t operator != (const int32_t v, const zfix fx);
+	constexpr inline friend int32_t operator != (const zfix fx, const float v);
+	constexpr inline friend int32_t operator != (const float v, const zfix fx);
+	constexpr inline friend int32_t operator != (const zfix fx, const double v);
+	constexpr inline friend int32_t operator != (const double v, const zfix fx);
 	
-	inline friend int32_t operator <  (const zfix fx, const zfix fx2);
-	inline friend int32_t operator <  (const zfix fx, const int32_t v);
-	inline friend int32_t operator <  (const int32_t v, const zfix fx);
-	inline friend int32_t operator <  (const zfix fx, const int32_t v);
-	inline friend int32_t operator <  (const int32_t v, const zfix fx);
-	inline friend int32_t operator <  (const zfix fx, const float v);
-	inline friend int32_t operator <  (const float v, const zfix fx);
-	inline friend int32_t operator <  (const zfix fx, const double v);
-	inline friend int32_t operator <  (const double v, const zfix fx);
+	constexpr inline friend int32_t operator <  (const zfix fx, const zfix fx2);
+	constexpr inline friend int32_t operator <  (const zfix fx, const int32_t v);
+	constexpr inline friend int32_t operator <  (const int32_t v, const zfix fx);
+	constexpr inline friend int32_t operator <  (const zfix fx, const int32_t v);
+	constexpr inline friend int32_t operator <  (const int32_t v, const zfix fx);
+	constexpr inline friend int32_t operator <  (const zfix fx, const float v);
+	constexpr inline friend int32_t operator <  (const float v, const zfix fx);
+	constexpr inline friend int32_t operator <  (const zfix fx, const double v);
+	constexpr inline friend int32_t operator <  (const double v, const zfix fx);
 	
-	inline friend int32_t operator >  (const zfix fx, const zfix fx2);
-	inline friend int32_t operator >  (const zfix fx, const int32_t v);
-	inline friend int32_t operator >  (const int32_t v, const zfix fx);
-	inline friend int32_t operator >  (const zfix fx, const int32_t v);
-	inline friend int32_t operator >  (const int32_t v, const zfix fx);
-	inline friend int32_t operator >  (const zfix fx, const float v);
-	inline friend int32_t operator >  (const float v, const zfix fx);
-	inline friend int32_t operator >  (const zfix fx, const double v);
-	inline friend int32_t operator >  (const double v, const zfix fx);
+	constexpr inline friend int32_t operator >  (const zfix fx, const zfix fx2);
+	constexpr inline friend int32_t operator >  (const zfix fx, const int32_t v);
+	constexpr inline friend int32_t operator >  (const int32_t v, const zfix fx);
+	constexpr inline friend int32_t operator >  (const zfix fx, const int32_t v);
+	constexpr inline friend int32_t operator >  (const int32_t v, const zfix fx);
+	constexpr inline friend int32_t operator >  (const zfix fx, const float v);
+	constexpr inline friend int32_t operator >  (const float v, const zfix fx);
+	constexpr inline friend int32_t operator >  (const zfix fx, const double v);
+	constexpr inline friend int32_t operator >  (const double v, const zfix fx);
 	
-	inline friend int32_t operator <= (const zfix fx, const zfix fx2);
-	inline friend int32_t operator <= (const zfix fx, const int32_t v);
-	inline friend int32_t operator <= (const int32_t v, const zfix fx);
-	inline friend int32_t operator <= (const zfix fx, const int32_t v);
-	inline friend int32_t operator <= (const int32_t v, const zfix fx);
-	inline friend int32_t operator <= (const zfix fx, const float v);
-	inline friend int32_t operator <= (const float v, const zfix fx);
-	inline friend int32_t operator <= (const zfix fx, const double v);
-	inline friend int32_t operator <= (const double v, const zfix fx);
+	constexpr inline friend int32_t operator <= (const zfix fx, const zfix fx2);
+	constexpr inline friend int32_t operator <= (const zfix fx, const int32_t v);
+	constexpr inline friend int32_t operator <= (const int32_t v, const zfix fx);
+	constexpr inline friend int32_t operator <= (const zfix fx, const int32_t v);
+	constexpr inline friend int32_t operator <= (const int32_t v, const zfix fx);
+	constexpr inline friend int32_t operator <= (const zfix fx, const float v);
+	constexpr inline friend int32_t operator <= (const float v, const zfix fx);
+	constexpr inline friend int32_t operator <= (const zfix fx, const double v);
+	constexpr inline friend int32_t operator <= (const double v, const zfix fx);
 	
-	inline friend int32_t operator >= (const zfix fx, const zfix fx2);
-	inline friend int32_t operator >= (const zfix fx, const int32_t v);
-	inline friend int32_t operator >= (const int32_t v, const zfix fx);
-	inline friend int32_t operator >= (const zfix fx, const int32_t v);
-	inline friend int32_t operator >= (const int32_t v, const zfix fx);
-	inline friend int32_t operator >= (const zfix fx, const float v);
-	inline friend int32_t operator >= (const float v, const zfix fx);
-	inline friend int32_t operator >= (const zfix fx, const double v);
-	inline friend int32_t operator >= (const double v, const zfix fx);
+	constexpr inline friend int32_t operator >= (const zfix fx, const zfix fx2);
+	constexpr inline friend int32_t operator >= (const zfix fx, const int32_t v);
+	constexpr inline friend int32_t operator >= (const int32_t v, const zfix fx);
+	constexpr inline friend int32_t operator >= (const zfix fx, const int32_t v);
+	constexpr inline friend int32_t operator >= (const int32_t v, const zfix fx);
+	constexpr inline friend int32_t operator >= (const zfix fx, const float v);
+	constexpr inline friend int32_t operator >= (const float v, const zfix fx);
+	constexpr inline friend int32_t operator >= (const zfix fx, const double v);
+	constexpr inline friend int32_t operator >= (const double v, const zfix fx);
 };
 
 
@@ -6,405 +6,405 @@
 #ifndef ZFIX_INL
 #define ZFIX_INL
 
-inline ZLong toZLong(float val)
+constexpr inline ZLong toZLong(float val)
 {
 	return ZLong(val * 10000);
 }
-inline ZLong toZLong(double val)
+constexpr inline ZLong toZLong(double val)
 {
 	return ZLong(val * 10000);
 }
-inline ZLong toZLong(int32_t val)
+constexpr inline ZLong toZLong(int32_t val)
 {
 	return ZLong(val * 10000);
 }
-inline zfix zslongToFix(ZLong val)
+constexpr inline zfix zslongToFix(ZLong val)
 {
 	zfix t;
 	t.val = val;
 	return t;
 }
-inline zfix floor(zfix fx)
+constexpr inline zfix floor(zfix fx)
 {
 	zfix t(fx);
 	t.doFloor();
 	return t;
 }
-inline zfix abs(zfix fx)
+constexpr inline zfix abs(zfix fx)
 {
 	zfix t(fx);
 	t.doAbs();
 	return t;
 }
 
-inline zfix operator +  (const zfix fx, const zfix fx2)
+constexpr inline zfix operator +  (const zfix fx, const zfix fx2)
 {
 	zfix t = fx.copy();
 	t += fx2;
 	return t;
 }
-inline zfix operator +  (const zfix fx, const int32_t v)
+constexpr inline zfix operator +  (const zfix fx, const int32_t v)
 {
 	zfix t = fx.copy();
 	t += v;
 	return t;
 }
-inline zfix operator +  (const int32_t v, const zfix fx)
+constexpr inline zfix operator +  (const int32_t v, const zfix fx)
 {
 	zfix t = fx.copy();
 	t += v;
 	return t;
 }
-inline zfix operator +  (const zfix fx, const float v)
+constexpr inline zfix operator +  (const zfix fx, const float v)
 {
 	zfix t = fx.copy();
 	t += v;
 	return t;
 }
-inline zfix operator +  (const float v, const zfix fx)
+constexpr inline zfix operator +  (const float v, const zfix fx)
 {
 	zfix t = fx.copy();
 	t += v;
 	return t;
 }
-inline zfix operator +  (const zfix fx, const double v)
+constexpr inline zfix operator +  (const zfix fx, const double v)
 {
 	zfix t = fx.copy();
 	t += v;
 	return t;
 }
-inline zfix operator +  (const double v, const zfix fx)
+constexpr inline zfix operator +  (const double v, const zfix fx)
 {
 	zfix t = fx.copy();
 	t += v;
 	return t;
 }
 
-inline zfix operator -  (const zfix fx, const zfix fx2)
+constexpr inline zfix operator -  (const zfix fx, const zfix fx2)
 {
 	zfix t = fx.copy();
 	t -= fx2;
 	return t;
 }
-inline zfix operator -  (const zfix fx, const int32_t v)
+constexpr inline zfix operator -  (const zfix fx, const int32_t v)
 {
 	zfix t = fx.copy();
 	t -= v;
 	return t;
 }
-inline zfix operator -  (const int32_t v, const zfix fx)
+constexpr inline zfix operator -  (const int32_t v, const zfix fx)
 {
 	zfix t(v);
 	t -= fx;
 	return t;
 }
-inline zfix operator -  (const zfix fx, const float v)
+constexpr inline zfix operator -  (const zfix fx, const float v)
 {
 	zfix t = fx.copy();
 	t -= v;
 	return t;
 }
-inline zfix operator -  (const float v, const zfix fx)
+constexpr inline zfix operator -  (const float v, const zfix fx)
 {
 	zfix t(v);
 	t -= fx;
 	return t;
 }
-inline zfix operator -  (const zfix fx, const double v)
+constexpr inline zfix operator -  (const zfix fx, const double v)
 {
 	zfix t = fx.copy();
 	t -= v;
 	return t;
 }
-inline zfix operator -  (const double v, const zfix fx)
+constexpr inline zfix operator -  (const double v, const zfix fx)
 {
 	zfix t(v);
 	t -= fx;
 	return t;
 }
 
-inline zfix operator *  (const zfix fx, const zfix fx2)
+constexpr inline zfix operator *  (const zfix fx, const zfix fx2)
 {
 	zfix t = fx.copy();
 	t *= fx2;
 	return t;
 }
 
-inline zfix operator *  (const zfix fx, const int32_t v)
+constexpr inline zfix operator *  (const zfix fx, const int32_t v)
 {
 	zfix t = fx.copy();
 	t *= v;
 	return t;
 }
 
-inline zfix operator *  (const int32_t v, const zfix fx)
+constexpr inline zfix operator *  (const int32_t v, const zfix fx)
 {
 	zfix t = fx.copy();
 	t *= v;
 	return t;
 }
 
-inline zfix operator *  (const zfix fx, const float v)
+constexpr inline zfix operator *  (const zfix fx, const float v)
 {
 	zfix t = fx.copy();
 	t *= v;
 	return t;
 }
 
-inline zfix operator *  (const float v, const zfix fx)
+constexpr inline zfix operator *  (const float v, const zfix fx)
 {
 	zfix t = fx.copy();
 	t *= v;
 	return t;
 }
 
-inline zfix operator *  (const zfix fx, const double v)
+constexpr inline zfix operator *  (const zfix fx, const double v)
 {
 	zfix t = fx.copy();
 	t *= v;
 	return t;
 }
 
-inline zfix operator *  (const double v, const zfix fx)
+constexpr inline zfix operator *  (const double v, const zfix fx)
 {
 	zfix t = fx.copy();
 	t *= v;
 	return t;
 }
 
-inline zfix operator /  (const zfix fx, const zfix fx2)
+constexpr inline zfix operator /  (const zfix fx, const zfix fx2)
 {
 	zfix t = fx.copy();
 	t /= fx2;
 	return t;
 }
 
-inline zfix operator /  (const zfix fx, const int32_t v)
+constexpr inline zfix operator /  (const zfix fx, const int32_t v)
 {
 	zfix t = fx.copy();
 	t /= v;
 	return t;
 }
 
-inline zfix operator /  (const int32_t v, const zfix fx)
+constexpr inline zfix operator /  (const int32_t v, const zfix fx)
 {
 	zfix t(v);
 	t /= fx;
 	return t;
 }
 
-inline zfix operator /  (const zfix fx, const float v)
+constexpr inline zfix operator /  (const zfix fx, const float v)
 {
 	zfix t = fx.copy();
 	t /= v;
 	return t;
 }
 
-inline zfix operator /  (const float v, const zfix fx)
+constexpr inline zfix operator /  (const float v, const zfix fx)
 {
 	zfix t(v);
 	t /= fx;
 	return t;
 }
 
-inline zfix operator /  (const zfix fx, const double v)
+constexpr inline zfix operator /  (const zfix fx, const double v)
 {
 	zfix t = fx.copy();
 	t /= v;
 	return t;
 }
 
-inline zfix operator /  (const double v, const zfix fx)
+constexpr inline zfix operator /  (const double v, const zfix fx)
 {
 	zfix t(v);
 	t /= fx;
 	return t;
 }
 
-inline zfix operator << (const zfix fx, const int32_t v)
+constexpr inline zfix operator << (const zfix fx, const int32_t v)
 {
 	zfix t = fx.copy();
 	t <<= v;
 	return t;
 }
 
-inline zfix operator >> (const zfix fx, const int32_t v)
+constexpr inline zfix operator >> (const zfix fx, const int32_t v)
 {
 	zfix t = fx.copy();
 	t >>= v;
 	return t;
 }
 
-inline int32_t operator == (const zfix fx, const zfix fx2)
+constexpr inline int32_t operator == (const zfix fx, const zfix fx2)
 {
 	return fx.val == fx2.val;
 }
-inline int32_t operator == (const zfix fx, const int32_t v)
+constexpr inline int32_t operator == (const zfix fx, const int32_t v)
 {
 	return fx.val == toZLong(v);
 }
-inline int32_t operator == (const int32_t v, const zfix fx)
+constexpr inline int32_t operator == (const int32_t v, const zfix fx)
 {
 	return fx.val == toZLong(v);
 }
-inline int32_t operator == (const zfix fx, const float v)
+constexpr inline int32_t operator == (const zfix fx, const float v)
 {
 	return fx.val == toZLong(v);
 }
-inline int32_t operator == (const float v, const zfix fx)
+constexpr inline int32_t operator == (const float v, const zfix fx)
 {
 	return fx.val == toZLong(v);
 }
-inline int32_t operator == (const zfix fx, const double v)
+constexpr inline int32_t operator == (const zfix fx, const double v)
 {
 	return fx.val == toZLong(v);
 }
-inline int32_t operator == (const double v, const zfix fx)
+constexpr inline int32_t operator == (const double v, const zfix fx)
 {
 	return fx.val == toZLong(v);
 }
 
-inline int32_t operator != (const zfix fx, const zfix fx2)
+constexpr inline int32_t operator != (const zfix fx, const zfix fx2)
 {
 	return fx.val != fx2.val;
 }
-inline int32_t operator != (const zfix fx, const int32_t v)
+constexpr inline int32_t operator != (const zfix fx, const int32_t v)
 {
 	return fx.val != toZLong(v);
 }
-inline int32_t operator != (const int32_t v, const zfix fx)
+constexpr inline int32_t operator != (const int32_t v, const zfix fx)
 {
 	return fx.val != toZLong(v);
 }
-inline int32_t operator != (const zfix fx, const float v)
+constexpr inline int32_t operator != (const zfix fx, const float v)
 {
 	return fx.val != toZLong(v);
 }
-inline int32_t operator != (const float v, const zfix fx)
+constexpr inline int32_t operator != (const float v, const zfix fx)
 {
 	return fx.val != toZLong(v);
 }
-inline int32_t operator != (const zfix fx, const double v)
+constexpr inline int32_t operator != (const zfix fx, const double v)
 {
 	return fx.val != toZLong(v);
 }
-inline int32_t operator != (const double v, const zfix fx)
+constexpr inline int32_t operator != (const double v, const zfix fx)
 {
 	return fx.val != toZLong(v);
 }
 
-inline int32_t operator <  (const zfix fx, const zfix fx2)
+constexpr inline int32_t operator <  (const zfix fx, const zfix fx2)
 {
 	return fx.val < fx2.val;
 }
-inline int32_t operator <  (const zfix fx, const int32_t v)
+constexpr inline int32_t operator <  (const zfix fx, const int32_t v)
 {
 	return fx.val < toZLong(v);
 }
-inline int32_t operator <  (const int32_t v, const zfix fx)
+constexpr inline int32_t operator <  (const int32_t v, const zfix fx)
 {
 	return toZLong(v) < fx.val;
 }
-inline int32_t operator <  (const zfix fx, const float v)
+constexpr inline int32_t operator <  (const zfix fx, const float v)
 {
 	return fx.val < toZLong(v);
 }
-inline int32_t operator <  (const float v, const zfix fx)
+constexpr inline int32_t operator <  (const float v, const zfix fx)
 {
 	return toZLong(v) < fx.val;
 }
-inline int32_t operator <  (const zfix fx, const double v)
+constexpr inline int32_t operator <  (const zfix fx, const double v)
 {
 	return fx.val < toZLong(v);
 }
-inline int32_t operator <  (const double v, const zfix fx)
+constexpr inline int32_t operator <  (const double v, const zfix fx)
 {
 	return toZLong(v) < fx.val;
 }
 
-inline int32_t operator >  (const zfix fx, const zfix fx2)
+constexpr inline int32_t operator >  (const zfix fx, const zfix fx2)
 {
 	return fx.val > fx2.val;
 }
-inline int32_t operator >  (const zfix fx, const int32_t v)
+constexpr inline int32_t operator >  (const zfix fx, const int32_t v)
 {
 	return fx.val > toZLong(v);
 }
-inline int32_t operator >  (const int32_t v, const zfix fx)
+constexpr inline int32_t operator >  (const int32_t v, const zfix fx)
 {
 	return toZLong(v) > fx.val;
 }
-inline int32_t operator >  (const zfix fx, const float v)
+constexpr inline int32_t operator >  (const zfix fx, const float v)
 {
 	return fx.val > toZLong(v);
 }
-inline int32_t operator >  (const float v, const zfix fx)
+constexpr inline int32_t operator >  (const float v, const zfix fx)
 {
 	return toZLong(v) > fx.val;
 }
-inline int32_t operator >  (const zfix fx, const double v)
+constexpr inline int32_t operator >  (const zfix fx, const double v)
 {
 	return fx.val > toZLong(v);
 }
-inline int32_t operator >  (const double v, const zfix fx)
+constexpr inline int32_t operator >  (const double v, const zfix fx)
 {
 	return toZLong(v) > fx.val;
 }
 
-inline int32_t operator <=  (const zfix fx, const zfix fx2)
+constexpr inline int32_t operator <=  (const zfix fx, const zfix fx2)
 {
 	return fx.val <= fx2.val;
 }
-inline int32_t operator <=  (const zfix fx, const int32_t v)
+constexpr inline int32_t operator <=  (const zfix fx, const int32_t v)
 {
 	return fx.val <= toZLong(v);
 }
-inline int32_t operator <=  (const int32_t v, const zfix fx)
+constexpr inline int32_t operator <=  (const int32_t v, const zfix fx)
 {
 	return toZLong(v) <= fx.val;
 }
-inline int32_t operator <=  (const zfix fx, const float v)
+constexpr inline int32_t operator <=  (const zfix fx, const float v)
 {
 	return fx.val <= toZLong(v);
 }
-inline int32_t operator <=  (const float v, const zfix fx)
+constexpr inline int32_t operator <=  (const float v, const zfix fx)
 {
 	return toZLong(v) <= fx.val;
 }
-inline int32_t operator <=  (const zfix fx, const double v)
+constexpr inline int32_t operator <=  (const zfix fx, const double v)
 {
 	return fx.val <= toZLong(v);
 }
-inline int32_t operator <=  (const double v, const zfix fx)
+constexpr inline int32_t operator <=  (const double v, const zfix fx)
 {
 	return toZLong(v) <= fx.val;
 }
 
-inline int32_t operator >=  (const zfix fx, const zfix fx2)
+constexpr inline int32_t operator >=  (const zfix fx, const zfix fx2)
 {
 	return fx.val >= fx2.val;
 }
-inline int32_t operator >=  (const zfix fx, const int32_t v)
+constexpr inline int32_t operator >=  (const zfix fx, const int32_t v)
 {
 	return fx.val >= toZLong(v);
 }
-inline int32_t operator >=  (const int32_t v, const zfix fx)
+constexpr inline int32_t operator >=  (const int32_t v, const zfix fx)
 {
 	return toZLong(v) >= fx.val;
 }
-inline int32_t operator >=  (const zfix fx, const float v)
+constexpr inline int32_t operator >=  (const zfix fx, const float v)
 {
 	return fx.val >= toZLong(v);
 }
-inline int32_t operator >=  (const float v, const zfix fx)
+constexpr inline int32_t operator >=  (const float v, const zfix fx)
 {
 	return toZLong(v) >= fx.val;
 }
-inline int32_t operator >=  (const zfix fx, const double v)
+constexpr inline int32_t operator >=  (const zfix fx, const double v)
 {
 	return fx.val >= toZLong(v);
 }
-inline int32_t operator >=  (const double v, const zfix fx)
+constexpr inline int32_t operator >=  (const double v, const zfix fx)
 {
 	return toZLong(v) >= fx.val;
 }
@@ -536,7 +536,6 @@ int32_t writezinfo(PACKFILE *f, zinfo const& z)
 	dword section_id=ID_ZINFO;
 	dword section_version=V_ZINFO;
 	dword section_cversion=CV_ZINFO;
-	dword section_size=0;
 	
 	//section id
 	if(!p_mputl(section_id,f))
@@ -555,127 +554,110 @@ int32_t writezinfo(PACKFILE *f, zinfo const& z)
 		new_return(3);
 	}
 	
-	for(int32_t writecycle=0; writecycle<2; ++writecycle)
+	section_writer section(f);
+	
+	if(!p_iputw(itype_max,f)) //num itemtypes
 	{
-		fake_pack_writing=(writecycle==0);
+		new_return(6);
+	}
+	for(auto q = 0; q < itype_max; ++q)
+	{
+		byte namesize = (byte)(vbound(valid_str(z.ic_name[q]) ? strlen(z.ic_name[q]) : 0,0,255));
 		
-		//section size
-		if(!p_iputl(section_size,f))
+		if(!p_putc(namesize,f))
 		{
-			new_return(5);
+			new_return(7);
 		}
+		if(namesize)
+			if(!pfwrite(z.ic_name[q],namesize,f))
+				new_return(8);
 		
-		writesize=0;
+		dword htxtsz = valid_str(z.ic_help_string[q]) ? strlen(z.ic_help_string[q]) : 0;
 		
-		if(!p_iputw(itype_max,f)) //num itemtypes
+		if(!p_iputw(htxtsz,f))
 		{
-			new_return(6);
-		}
-		for(auto q = 0; q < itype_max; ++q)
-		{
-			byte namesize = (byte)(vbound(valid_str(z.ic_name[q]) ? strlen(z.ic_name[q]) : 0,0,255));
-			
-			if(!p_putc(namesize,f))
-			{
-				new_return(7);
-			}
-			if(namesize)
-				if(!pfwrite(z.ic_name[q],namesize,f))
-					new_return(8);
-			
-			dword htxtsz = valid_str(z.ic_help_string[q]) ? strlen(z.ic_help_string[q]) : 0;
-			
-			if(!p_iputw(htxtsz,f))
-			{
-				new_return(9);
-			}
-			if(htxtsz)
-				if(!pfwrite(z.ic_help_string[q],htxtsz,f))
-					new_return(10);
+			new_return(9);
 		}
+		if(htxtsz)
+			if(!pfwrite(z.ic_help_string[q],htxtsz,f))
+				new_return(10);
+	}
+	
+	if(!p_iputw(cMAX,f)) //num combotypes
+	{
+		new_return(11);
+	}
+	for(auto q = 0; q < cMAX; ++q)
+	{
+		byte namesize = (byte)(vbound(valid_str(z.ctype_name[q]) ? strlen(z.ctype_name[q]) : 0,0,255));
 		
-		if(!p_iputw(cMAX,f)) //num combotypes
+		if(!p_putc(namesize,f))
 		{
-			new_return(11);
-		}
-		for(auto q = 0; q < cMAX; ++q)
-		{
-			byte namesize = (byte)(vbound(valid_str(z.ctype_name[q]) ? strlen(z.ctype_name[q]) : 0,0,255));
-			
-			if(!p_putc(namesize,f))
-			{
-				new_return(12);
-			}
-			if(namesize)
-				if(!pfwrite(z.ctype_name[q],namesize,f))
-					new_return(13);
-			
-			dword htxtsz = valid_str(z.ctype_help_string[q]) ? strlen(z.ctype_help_string[q]) : 0;
-			
-			if(!p_iputw(htxtsz,f))
-			{
-				new_return(14);
-			}
-			if(htxtsz)
-				if(!pfwrite(z.ctype_help_string[q],htxtsz,f))
-					new_return(15);
+			new_return(12);
 		}
+		if(namesize)
+			if(!pfwrite(z.ctype_name[q],namesize,f))
+				new_return(13);
 		
-		if(!p_iputw(mfMAX,f)) //num mapflags
+		dword htxtsz = valid_str(z.ctype_help_string[q]) ? strlen(z.ctype_help_string[q]) : 0;
+		
+		if(!p_iputw(htxtsz,f))
 		{
-			new_return(16);
-		}
-		for(auto q = 0; q < mfMAX; ++q)
-		{
-			byte namesize = (byte)(vbound(valid_str(z.mf_name[q]) ? strlen(z.mf_name[q]) : 0,0,255));
-			
-			if(!p_putc(namesize,f))
-			{
-				new_return(17);
-			}
-			if(namesize)
-				if(!pfwrite(z.mf_name[q],namesize,f))
-					new_return(18);
-			
-			dword htxtsz = valid_str(z.mf_help_string[q]) ? strlen(z.mf_help_string[q]) : 0;
-			
-			if(!p_iputw(htxtsz,f))
-			{
-				new_return(19);
-			}
-			if(htxtsz)
-				if(!pfwrite(z.mf_help_string[q],htxtsz,f))
-					new_return(20);
+			new_return(14);
 		}
+		if(htxtsz)
+			if(!pfwrite(z.ctype_help_string[q],htxtsz,f))
+				new_return(15);
+	}
+	
+	if(!p_iputw(mfMAX,f)) //num mapflags
+	{
+		new_return(16);
+	}
+	for(auto q = 0; q < mfMAX; ++q)
+	{
+		byte namesize = (byte)(vbound(valid_str(z.mf_name[q]) ? strlen(z.mf_name[q]) : 0,0,255));
 		
-		if(!p_iputw(MAX_COUNTERS,f)) //num counters
+		if(!p_putc(namesize,f))
 		{
-			new_return(21);
+			new_return(17);
 		}
-		for(auto q = 0; q < MAX_COUNTERS; ++q)
+		if(namesize)
+			if(!pfwrite(z.mf_name[q],namesize,f))
+				new_return(18);
+		
+		dword htxtsz = valid_str(z.mf_help_string[q]) ? strlen(z.mf_help_string[q]) : 0;
+		
+		if(!p_iputw(htxtsz,f))
 		{
-			byte namesize = (byte)(vbound(valid_str(z.ctr_name[q]) ? strlen(z.ctr_name[q]) : 0,0,255));
-			
-			if(!p_putc(namesize,f))
-			{
-				new_return(22);
-			}
-			if(namesize)
-				if(!pfwrite(z.ctr_name[q],namesize,f))
-					new_return(23);
+			new_return(19);
 		}
+		if(htxtsz)
+			if(!pfwrite(z.mf_help_string[q],htxtsz,f))
+				new_return(20);
+	}
+	
+	if(!p_iputw(MAX_COUNTERS,f)) //num counters
+	{
+		new_return(21);
+	}
+	for(auto q = 0; q < MAX_COUNTERS; ++q)
+	{
+		byte namesize = (byte)(vbound(valid_str(z.ctr_name[q]) ? strlen(z.ctr_name[q]) : 0,0,255));
 		
-		if(writecycle==0)
+		if(!p_putc(namesize,f))
 		{
-			section_size=writesize;
+			new_return(22);
 		}
+		if(namesize)
+			if(!pfwrite(z.ctr_name[q],namesize,f))
+				new_return(23);
 	}
 	
-	if(writesize!=int32_t(section_size))
+	//section size, then the buffered section data
+	if(!section.commit())
 	{
-		char ebuf[80];
-		sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-		jwin_alert("Error:  writezinfo()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+		new_return(5);
 	}
 	
 	new_return(0);
@@ -22,6 +22,8 @@
 #include <string>
 #include <stdexcept>
 #include <map>
+#include <thread>
+#include <atomic>
 
 #include "metadata/sigs/devsig.h.sig"
 #include "metadata/sigs/compilersig.h.sig"
@@ -81,7 +83,6 @@ int32_t ffprvy[32]= {-10000000,-10000000,-10000000,-10000000,-10000000,-10000000
                   -10000000,-10000000,-10000000,-10000000,-10000000,-10000000,-10000000,-10000000,-10000000,-10000000,-10000000,-10000000,-10000000,-10000000,-10000000,-10000000
                  };
 
-bool save_warn=true;
 
 int32_t COMBOPOS(int32_t x, int32_t y)
 {
@@ -5676,6 +5677,8 @@ bool save_combos(const char *path)
 
 bool load_combos(const char *path, int32_t startcombo)
 {
+    mark_section_dirty(qsCOMBOS);
+    
     dword section_id;
     PACKFILE *f = pack_fopen_password(path,F_READ, "");
     
@@ -5730,6 +5733,8 @@ bool save_tiles(const char *path)
 
 bool load_tiles(const char *path, int32_t starttile)
 {
+    mark_section_dirty(qsTILES);
+    
     dword section_id;
     PACKFILE *f = pack_fopen_password(path,F_READ, "");
     
@@ -5887,6 +5892,8 @@ bool load_combo_alias(const char *path)
 
 bool load_zgp(const char *path)
 {
+    mark_all_sections_dirty();
+    
     dword section_id;
     dword section_version;
     dword section_cversion;
@@ -6696,6 +6703,10 @@ void set_rules(byte* newrules);
 // wrapper to reinitialize everything on an error
 int32_t load_quest(const char *filename, bool compressed, bool encrypted)
 {
+	//the file being loaded may be the timed save still being written
+	finish_timed_save();
+	mark_all_sections_dirty();
+	
 	char buf[2048];
 //  if(encrypted)
 //	  setPackfilePassword(datapwd);
@@ -6812,7 +6823,6 @@ int32_t writeheader(PACKFILE *f, zquestheader *Header)
     dword section_id=ID_HEADER;
     dword section_version=V_HEADER;
     dword section_cversion=CV_HEADER;
-    dword section_size=0;
     
     //file header string
     if(!pfwrite(Header->id_str,sizeof(Header->id_str),f))
@@ -6837,630 +6847,577 @@ int32_t writeheader(PACKFILE *f, zquestheader *Header)
         new_return(4);
     }
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    section_writer section(f);
+    
+    //finally...  section data
+    if(!p_iputw(Header->zelda_version,f))
     {
-        fake_pack_writing=(writecycle==0);
-        
-        //section size
-        if(!p_iputl(section_size,f))
-        {
-            new_return(5);
-        }
-        
-        writesize=0;
-        
-        //finally...  section data
-        if(!p_iputw(Header->zelda_version,f))
-        {
-            new_return(6);
-        }
-        
-        if(!p_putc(Header->build,f))
-        {
-            new_return(7);
-        }
-        
-        if(!pfwrite(Header->pwd_hash,sizeof(Header->pwd_hash),f))
-        {
-            new_return(8);
-        }
-        
-        if(!p_iputw(Header->internal,f))
-        {
-            new_return(10);
-        }
-        
-        if(!p_putc(Header->quest_number,f))
-        {
-            new_return(11);
-        }
-        
-        if(!pfwrite(Header->version,sizeof(Header->version),f))
-        {
-            new_return(12);
-        }
-        
-        if(!pfwrite(Header->minver,sizeof(Header->minver),f))
-        {
-            new_return(13);
-        }
-        
-        if(!pfwrite(Header->title,sizeof(Header->title),f))
-        {
-            new_return(14);
-        }
-        
-        if(!pfwrite(Header->author,sizeof(Header->author),f))
-        {
-            new_return(15);
-        }
-        
-        if(!p_putc(Header->use_keyfile,f))
-        {
-            new_return(16);
-        }
-        
-        if(!pfwrite(Header->data_flags,sizeof(Header->data_flags),f))
-        {
-            new_return(17);
-        }
-        
-        if(!pfwrite(Header->templatepath,sizeof(Header->templatepath),f))
-        {
-            new_return(19);
-        }
-        
-        if(!p_putc(0,f)) //why are we doing this? 
-		//this is for map count, it seems. -Z
-        {
-            new_return(20);
-        }
-		
-		//v4
-		
-		if(!p_iputl(V_ZC_FIRST,f))
-		{
-			new_return(21);
-		}
-		if(!p_iputl(V_ZC_SECOND,f))
-		{
-			new_return(22);
-		}
-		if(!p_iputl(V_ZC_THIRD,f))
-		{
-			new_return(23);
-		}
-		if(!p_iputl(V_ZC_FOURTH,f))
-		{
-			new_return(24);
-		}
-		if(!p_iputl(V_ZC_ALPHA,f))
-		{
-			new_return(25);
-		}
-		if(!p_iputl(V_ZC_BETA,f))
-		{
-			new_return(26);
-		}
-		if(!p_iputl(V_ZC_GAMMA,f))
-		{
-			new_return(27);
-		}
-		if(!p_iputl(V_ZC_RELEASE,f))
-		{
-			new_return(28);
-		}
-		if(!p_iputw(BUILDTM_YEAR,f))
-		{
-			new_return(29);
-		}
-		if(!p_putc(BUILDTM_MONTH,f))
-		{
-			new_return(30);
-		}
-		if(!p_putc(BUILDTM_DAY,f))
-		{
-			new_return(31);
-		}
-		if(!p_putc(BUILDTM_HOUR,f))
-		{
-			new_return(32);
-		}
-		if(!p_putc(BUILDTM_MINUTE,f))
-		{
-			new_return(33);
-		}
-		
-		
-		
-		char tempsig[256];
-		memset(tempsig, 0, 256);
-		strcpy(tempsig, DEV_SIGNOFF);
-		
-		if(!pfwrite(&tempsig,256,f))
-		{
-			new_return(34);
-		}
-		
-		char tempcompilersig[256];
-		memset(tempcompilersig, 0, 256);
-		strcpy(tempcompilersig, COMPILER_NAME);
-		
-		if(!pfwrite(&tempcompilersig,256,f))
-		{
-			new_return(35);
-		}
-		
-		char tempcompilerversion[256];
-		memset(tempcompilerversion, 0, 256); 
-		#ifdef _MSC_VER
-		zc_itoa(_MSC_VER,tempcompilerversion,10);
-		#else
-		strcpy(tempcompilerversion, COMPILER_VERSION);
-		#endif
-		
-		
-		if(!pfwrite(&tempcompilerversion,256,f))
-        {
-            new_return(36);
-        }
-		
-		char tempproductname[1024];
-		memset(tempproductname, 0, 1024);
-		strcpy(tempproductname, PROJECT_NAME);
-		
-		if(!pfwrite(&tempproductname,1024,f))
-        {
-            new_return(37);
-        }
-		
-		if(!p_putc(V_ZC_COMPILERSIG,f))
-		{
-			new_return(38);
-		}
-		#ifdef _MSC_VER
-		if(!p_iputl((_MSC_VER / 100),f))
-		{
-		    new_return(39);
-		}
-		#else
-		if(!p_iputl(COMPILER_V_FIRST,f))
-		{
-		    new_return(39);
-		}
-		#endif
-		
-		
-		
-		#ifdef _MSC_VER
-		if(!p_iputl((_MSC_VER % 100),f)) 
-		{
-			new_return(41);
-		}
-		#else
-		if(!p_iputl(COMPILER_V_SECOND,f)) 
-		{
-			new_return(41);
-		}
-		#endif
-		
-		#ifdef _MSC_VER
-			# if _MSC_VER >= 1400
-			if(!p_iputl((_MSC_FULL_VER % 100000),f))
-			{
-				new_return(40);
-			}
-			# else
-			if(!p_iputl((_MSC_FULL_VER % 10000),f))
-			{
-				new_return(40);
-			}
-			#endif
-		#else	
-		if(!p_iputl(COMPILER_V_THIRD,f))
-		{
-				new_return(40);
-		}
-		#endif
-		
-		#ifdef _MSC_VER
-		if(!p_iputl((_MSC_BUILD),f))
-		{
-			new_return(42);
-		}
-		#else
-		if(!p_iputl(COMPILER_V_FOURTH,f))
-		{
-			new_return(42);
-		}
-		#endif
-		if(!p_iputw(0,f)) //was V_ZC_DEVSIG, no longer used
-		{
-			new_return(43);
-		}
-		
-		char tempmodulename[1024];
-		memset(tempmodulename, 0, 1024);
-		strcpy(tempmodulename, moduledata.module_name);
-		
-		if(!pfwrite(&tempmodulename,1024,f))
-        {
-            new_return(44);
-        }
-		
-		char tempdate[256];
-		memset(tempdate, 0, 256);
-		strcpy(tempdate, __DATE__);
-		
-		if(!pfwrite(&tempdate,256,f))
-        {
-            new_return(45);
-        }
-		char temptime[256];
-		memset(temptime, 0, 256);
-		strcpy(temptime, __TIME__);
-		
-		if(!pfwrite(&temptime,256,f))
-        {
-            new_return(46);
-        }
-		
-		
-		char temptimezone[6];
-		memset(temptimezone, 0, 6);
-		strcpy(temptimezone, __TIMEZONE__);
-		if(!pfwrite(&temptimezone,6,f))
-        {
-            new_return(47);
-        }
-		
-		if(!p_putc(Header->external_zinfo ? 1 : 0, f))
-		{
-			new_return(48);
-		}
-		
-		if(!p_putc(ZC_IS_NIGHTLY ? 1 : 0, f))
-		{
-			new_return(49);
-		}
-	
-        if(writecycle==0)
-        {
-            section_size=writesize;
-        }
+        new_return(6);
     }
     
-    if(writesize!=int32_t(section_size) && save_warn)
+    if(!p_putc(Header->build,f))
     {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writeheader()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+        new_return(7);
     }
     
-    new_return(0);
-}
-
-int32_t writerules(PACKFILE *f, zquestheader *Header)
-{
-    //these are here to bypass compiler warnings about unused arguments
-    Header=Header;
-    
-    dword section_id=ID_RULES;
-    dword section_version=V_RULES;
-    dword section_cversion=CV_RULES;
-    dword section_size=0;
-    
-    //section id
-    if(!p_mputl(section_id,f))
+    if(!pfwrite(Header->pwd_hash,sizeof(Header->pwd_hash),f))
     {
-        new_return(1);
+        new_return(8);
     }
     
-    //section version info
-    if(!p_iputw(section_version,f))
+    if(!p_iputw(Header->internal,f))
     {
-        new_return(2);
+        new_return(10);
     }
     
-    if(!p_iputw(section_cversion,f))
+    if(!p_putc(Header->quest_number,f))
     {
-        new_return(3);
+        new_return(11);
     }
-	
-	if(!p_iputl(V_COMPATRULE,f))
-	{
-		new_return(6);
-	}
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    if(!pfwrite(Header->version,sizeof(Header->version),f))
     {
-        fake_pack_writing=(writecycle==0);
-        
-        //section size
-        if(!p_iputl(section_size,f))
-        {
-            new_return(4);
-        }
-        
-        writesize=0;
-        
-        //finally...  section data
-        if(!pfwrite(quest_rules,QUESTRULES_NEW_SIZE,f))
-        {
-            new_return(5);
-        }
-        
-        if(writecycle==0)
-        {
-            section_size=writesize;
-        }
+        new_return(12);
     }
     
-    if(writesize!=int32_t(section_size) && save_warn)
+    if(!pfwrite(Header->minver,sizeof(Header->minver),f))
     {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writerules()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+        new_return(13);
     }
     
-    new_return(0);
-}
-
-
-int32_t writedoorcombosets(PACKFILE *f, zquestheader *Header)
-{
-    //these are here to bypass compiler warnings about unused arguments
-    Header=Header;
+    if(!pfwrite(Header->title,sizeof(Header->title),f))
+    {
+        new_return(14);
+    }
     
-    dword section_id=ID_DOORS;
-    dword section_version=V_DOORS;
-    dword section_cversion=CV_DOORS;
-    dword section_size=0;
+    if(!pfwrite(Header->author,sizeof(Header->author),f))
+    {
+        new_return(15);
+    }
     
-    //section id
-    if(!p_mputl(section_id,f))
+    if(!p_putc(Header->use_keyfile,f))
     {
-        new_return(1);
+        new_return(16);
     }
     
-    //section version info
-    if(!p_iputw(section_version,f))
+    if(!pfwrite(Header->data_flags,sizeof(Header->data_flags),f))
     {
-        new_return(2);
+        new_return(17);
     }
     
-    if(!p_iputw(section_cversion,f))
+    if(!pfwrite(Header->templatepath,sizeof(Header->templatepath),f))
     {
-        new_return(3);
+        new_return(19);
     }
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    if(!p_putc(0,f)) //why are we doing this? 
+	//this is for map count, it seems. -Z
     {
-        fake_pack_writing=(writecycle==0);
-        
-        //section size
-        if(!p_iputl(section_size,f))
+        new_return(20);
+    }
+	
+	//v4
+	
+	if(!p_iputl(V_ZC_FIRST,f))
+	{
+		new_return(21);
+	}
+	if(!p_iputl(V_ZC_SECOND,f))
+	{
+		new_return(22);
+	}
+	if(!p_iputl(V_ZC_THIRD,f))
+	{
+		new_return(23);
+	}
+	if(!p_iputl(V_ZC_FOURTH,f))
+	{
+		new_return(24);
+	}
+	if(!p_iputl(V_ZC_ALPHA,f))
+	{
+		new_return(25);
+	}
+	if(!p_iputl(V_ZC_BETA,f))
+	{
+		new_return(26);
+	}
+	if(!p_iputl(V_ZC_GAMMA,f))
+	{
+		new_return(27);
+	}
+	if(!p_iputl(V_ZC_RELEASE,f))
+	{
+		new_return(28);
+	}
+	if(!p_iputw(BUILDTM_YEAR,f))
+	{
+		new_return(29);
+	}
+	if(!p_putc(BUILDTM_MONTH,f))
+	{
+		new_return(30);
+	}
+	if(!p_putc(BUILDTM_DAY,f))
+	{
+		new_return(31);
+	}
+	if(!p_putc(BUILDTM_HOUR,f))
+	{
+		new_return(32);
+	}
+	if(!p_putc(BUILDTM_MINUTE,f))
+	{
+		new_return(33);
+	}
+	
+	
+	
+	char tempsig[256];
+	memset(tempsig, 0, 256);
+	strcpy(tempsig, DEV_SIGNOFF);
+	
+	if(!pfwrite(&tempsig,256,f))
+	{
+		new_return(34);
+	}
+	
+	char tempcompilersig[256];
+	memset(tempcompilersig, 0, 256);
+	strcpy(tempcompilersig, COMPILER_NAME);
+	
+	if(!pfwrite(&tempcompilersig,256,f))
+	{
+		new_return(35);
+	}
+	
+	char tempcompilerversion[256];
+	memset(tempcompilerversion, 0, 256); 
+	#ifdef _MSC_VER
+	zc_itoa(_MSC_VER,tempcompilerversion,10);
+	#else
+	strcpy(tempcompilerversion, COMPILER_VERSION);
+	#endif
+	
+	
+	if(!pfwrite(&tempcompilerversion,256,f))
+    {
+        new_return(36);
+    }
+	
+	char tempproductname[1024];
+	memset(tempproductname, 0, 1024);
+	strcpy(tempproductname, PROJECT_NAME);
+	
+	if(!pfwrite(&tempproductname,1024,f))
+    {
+        new_return(37);
+    }
+	
+	if(!p_putc(V_ZC_COMPILERSIG,f))
+	{
+		new_return(38);
+	}
+	#ifdef _MSC_VER
+	if(!p_iputl((_MSC_VER / 100),f))
+	{
+	    new_return(39);
+	}
+	#else
+	if(!p_iputl(COMPILER_V_FIRST,f))
+	{
+	    new_return(39);
+	}
+	#endif
+	
+	
+	
+	#ifdef _MSC_VER
+	if(!p_iputl((_MSC_VER % 100),f)) 
+	{
+		new_return(41);
+	}
+	#else
+	if(!p_iputl(COMPILER_V_SECOND,f)) 
+	{
+		new_return(41);
+	}
+	#endif
+	
+	#ifdef _MSC_VER
+		# if _MSC_VER >= 1400
+		if(!p_iputl((_MSC_FULL_VER % 100000),f))
+		{
+			new_return(40);
+		}
+		# else
+		if(!p_iputl((_MSC_FULL_VER % 10000),f))
+		{
+			new_return(40);
+		}
+		#endif
+	#else	
+	if(!p_iputl(COMPILER_V_THIRD,f))
+	{
+			new_return(40);
+	}
+	#endif
+	
+	#ifdef _MSC_VER
+	if(!p_iputl((_MSC_BUILD),f))
+	{
+		new_return(42);
+	}
+	#else
+	if(!p_iputl(COMPILER_V_FOURTH,f))
+	{
+		new_return(42);
+	}
+	#endif
+	if(!p_iputw(0,f)) //was V_ZC_DEVSIG, no longer used
+	{
+		new_return(43);
+	}
+	
+	char tempmodulename[1024];
+	memset(tempmodulename, 0, 1024);
+	strcpy(tempmodulename, moduledata.module_name);
+	
+	if(!pfwrite(&tempmodulename,1024,f))
+    {
+        new_return(44);
+    }
+	
+	char tempdate[256];
+	memset(tempdate, 0, 256);
+	strcpy(tempdate, __DATE__);
+	
+	if(!pfwrite(&tempdate,256,f))
+    {
+        new_return(45);
+    }
+	char temptime[256];
+	memset(temptime, 0, 256);
+	strcpy(temptime, __TIME__);
+	
+	if(!pfwrite(&temptime,256,f))
+    {
+        new_return(46);
+    }
+	
+	
+	char temptimezone[6];
+	memset(temptimezone, 0, 6);
+	strcpy(temptimezone, __TIMEZONE__);
+	if(!pfwrite(&temptimezone,6,f))
+    {
+        new_return(47);
+    }
+	
+	if(!p_putc(Header->external_zinfo ? 1 : 0, f))
+	{
+		new_return(48);
+	}
+	
+	if(!p_putc(ZC_IS_NIGHTLY ? 1 : 0, f))
+	{
+		new_return(49);
+	}
+    
+    //section size, then the buffered section data
+    if(!section.commit())
+    {
+        new_return(5);
+    }
+    
+    new_return(0);
+}
+
+int32_t writerules(PACKFILE *f, zquestheader *Header)
+{
+    //these are here to bypass compiler warnings about unused arguments
+    Header=Header;
+    
+    dword section_id=ID_RULES;
+    dword section_version=V_RULES;
+    dword section_cversion=CV_RULES;
+    
+    //section id
+    if(!p_mputl(section_id,f))
+    {
+        new_return(1);
+    }
+    
+    //section version info
+    if(!p_iputw(section_version,f))
+    {
+        new_return(2);
+    }
+    
+    if(!p_iputw(section_cversion,f))
+    {
+        new_return(3);
+    }
+	
+	if(!p_iputl(V_COMPATRULE,f))
+	{
+		new_return(6);
+	}
+    
+    section_writer section(f);
+    
+    //finally...  section data
+    if(!pfwrite(quest_rules,QUESTRULES_NEW_SIZE,f))
+    {
+        new_return(5);
+    }
+    
+    //section size, then the buffered section data
+    if(!section.commit())
+    {
+        new_return(4);
+    }
+    
+    new_return(0);
+}
+
+
+int32_t writedoorcombosets(PACKFILE *f, zquestheader *Header)
+{
+    //these are here to bypass compiler warnings about unused arguments
+    Header=Header;
+    
+    dword section_id=ID_DOORS;
+    dword section_version=V_DOORS;
+    dword section_cversion=CV_DOORS;
+    
+    //section id
+    if(!p_mputl(section_id,f))
+    {
+        new_return(1);
+    }
+    
+    //section version info
+    if(!p_iputw(section_version,f))
+    {
+        new_return(2);
+    }
+    
+    if(!p_iputw(section_cversion,f))
+    {
+        new_return(3);
+    }
+    
+    section_writer section(f);
+    
+    //finally...  section data
+    if(!p_iputw(door_combo_set_count,f))
+    {
+        new_return(5);
+    }
+    
+    for(int32_t i=0; i<door_combo_set_count; i++)
+    {
+        //name
+        if(!pfwrite(&DoorComboSets[i].name,sizeof(DoorComboSets[0].name),f))
         {
-            new_return(4);
+            new_return(6);
         }
         
-        writesize=0;
-        
-        //finally...  section data
-        if(!p_iputw(door_combo_set_count,f))
+        //up door
+        for(int32_t j=0; j<9; j++)
         {
-            new_return(5);
+            for(int32_t k=0; k<4; k++)
+            {
+                if(!p_iputw(DoorComboSets[i].doorcombo_u[j][k],f))
+                {
+                    new_return(7);
+                }
+            }
         }
         
-        for(int32_t i=0; i<door_combo_set_count; i++)
+        for(int32_t j=0; j<9; j++)
         {
-            //name
-            if(!pfwrite(&DoorComboSets[i].name,sizeof(DoorComboSets[0].name),f))
-            {
-                new_return(6);
-            }
-            
-            //up door
-            for(int32_t j=0; j<9; j++)
+            for(int32_t k=0; k<4; k++)
             {
-                for(int32_t k=0; k<4; k++)
+                if(!p_putc(DoorComboSets[i].doorcset_u[j][k],f))
                 {
-                    if(!p_iputw(DoorComboSets[i].doorcombo_u[j][k],f))
-                    {
-                        new_return(7);
-                    }
+                    new_return(8);
                 }
             }
-            
-            for(int32_t j=0; j<9; j++)
+        }
+        
+        //down door
+        for(int32_t j=0; j<9; j++)
+        {
+            for(int32_t k=0; k<4; k++)
             {
-                for(int32_t k=0; k<4; k++)
+                if(!p_iputw(DoorComboSets[i].doorcombo_d[j][k],f))
                 {
-                    if(!p_putc(DoorComboSets[i].doorcset_u[j][k],f))
-                    {
-                        new_return(8);
-                    }
+                    new_return(9);
                 }
             }
-            
-            //down door
-            for(int32_t j=0; j<9; j++)
+        }
+        
+        for(int32_t j=0; j<9; j++)
+        {
+            for(int32_t k=0; k<4; k++)
             {
-                for(int32_t k=0; k<4; k++)
+                if(!p_putc(DoorComboSets[i].doorcset_d[j][k],f))
                 {
-                    if(!p_iputw(DoorComboSets[i].doorcombo_d[j][k],f))
-                    {
-                        new_return(9);
-                    }
+                    new_return(10);
                 }
             }
-            
-            for(int32_t j=0; j<9; j++)
+        }
+        
+        
+        //left door
+        for(int32_t j=0; j<9; j++)
+        {
+            for(int32_t k=0; k<6; k++)
             {
-                for(int32_t k=0; k<4; k++)
+                if(!p_iputw(DoorComboSets[i].doorcombo_l[j][k],f))
+                
                 {
-                    if(!p_putc(DoorComboSets[i].doorcset_d[j][k],f))
-                    {
-                        new_return(10);
-                    }
+                    new_return(11);
                 }
             }
-            
-            
-            //left door
-            for(int32_t j=0; j<9; j++)
+        }
+        
+        for(int32_t j=0; j<9; j++)
+        {
+            for(int32_t k=0; k<6; k++)
             {
-                for(int32_t k=0; k<6; k++)
+                if(!p_putc(DoorComboSets[i].doorcset_l[j][k],f))
                 {
-                    if(!p_iputw(DoorComboSets[i].doorcombo_l[j][k],f))
-                    
-                    {
-                        new_return(11);
-                    }
+                    new_return(12);
                 }
             }
-            
-            for(int32_t j=0; j<9; j++)
+        }
+        
+        //right door
+        for(int32_t j=0; j<9; j++)
+        {
+            for(int32_t k=0; k<6; k++)
             {
-                for(int32_t k=0; k<6; k++)
+                if(!p_iputw(DoorComboSets[i].doorcombo_r[j][k],f))
                 {
-                    if(!p_putc(DoorComboSets[i].doorcset_l[j][k],f))
-                    {
-                        new_return(12);
-                    }
+                    new_return(13);
                 }
             }
-            
-            //right door
-            for(int32_t j=0; j<9; j++)
+        }
+        
+        for(int32_t j=0; j<9; j++)
+        {
+            for(int32_t k=0; k<6; k++)
             {
-                for(int32_t k=0; k<6; k++)
+                if(!p_putc(DoorComboSets[i].doorcset_r[j][k],f))
                 {
-                    if(!p_iputw(DoorComboSets[i].doorcombo_r[j][k],f))
-                    {
-                        new_return(13);
-                    }
+                    new_return(14);
                 }
             }
-            
-            for(int32_t j=0; j<9; j++)
-            {
-                for(int32_t k=0; k<6; k++)
-                {
-                    if(!p_putc(DoorComboSets[i].doorcset_r[j][k],f))
-                    {
-                        new_return(14);
-                    }
-                }
-            }
-            
-            
-            //up bomb rubble
-            for(int32_t j=0; j<2; j++)
-            {
-                if(!p_iputw(DoorComboSets[i].bombdoorcombo_u[j],f))
-                {
-                    new_return(15);
-                }
-            }
-            
-            for(int32_t j=0; j<2; j++)
+        }
+        
+        
+        //up bomb rubble
+        for(int32_t j=0; j<2; j++)
+        {
+            if(!p_iputw(DoorComboSets[i].bombdoorcombo_u[j],f))
             {
-                if(!p_putc(DoorComboSets[i].bombdoorcset_u[j],f))
-                {
-                    new_return(16);
-                }
+                new_return(15);
             }
-            
-            //down bomb rubble
-            for(int32_t j=0; j<2; j++)
+        }
+        
+        for(int32_t j=0; j<2; j++)
+        {
+            if(!p_putc(DoorComboSets[i].bombdoorcset_u[j],f))
             {
-                if(!p_iputw(DoorComboSets[i].bombdoorcombo_d[j],f))
-                {
-                    new_return(17);
-                }
+                new_return(16);
             }
-            
-            for(int32_t j=0; j<2; j++)
+        }
+        
+        //down bomb rubble
+        for(int32_t j=0; j<2; j++)
+        {
+            if(!p_iputw(DoorComboSets[i].bombdoorcombo_d[j],f))
             {
-                if(!p_putc(DoorComboSets[i].bombdoorcset_d[j],f))
-                {
-                    new_return(18);
-                }
+                new_return(17);
             }
-            
-            //left bomb rubble
-            for(int32_t j=0; j<3; j++)
+        }
+        
+        for(int32_t j=0; j<2; j++)
+        {
+            if(!p_putc(DoorComboSets[i].bombdoorcset_d[j],f))
             {
-                if(!p_iputw(DoorComboSets[i].bombdoorcombo_l[j],f))
-                {
-                    new_return(19);
-                }
+                new_return(18);
             }
-            
-            for(int32_t j=0; j<3; j++)
+        }
+        
+        //left bomb rubble
+        for(int32_t j=0; j<3; j++)
+        {
+            if(!p_iputw(DoorComboSets[i].bombdoorcombo_l[j],f))
             {
-                if(!p_putc(DoorComboSets[i].bombdoorcset_l[j],f))
-                {
-                    new_return(20);
-                }
+                new_return(19);
             }
-            
-            //right bomb rubble
-            for(int32_t j=0; j<3; j++)
+        }
+        
+        for(int32_t j=0; j<3; j++)
+        {
+            if(!p_putc(DoorComboSets[i].bombdoorcset_l[j],f))
             {
-                if(!p_iputw(DoorComboSets[i].bombdoorcombo_r[j],f))
-                {
-                    new_return(21);
-                }
+                new_return(20);
             }
-            
-            for(int32_t j=0; j<3; j++)
+        }
+        
+        //right bomb rubble
+        for(int32_t j=0; j<3; j++)
+        {
+            if(!p_iputw(DoorComboSets[i].bombdoorcombo_r[j],f))
             {
-                if(!p_putc(DoorComboSets[i].bombdoorcset_r[j],f))
-                {
-                    new_return(22);
-                }
+                new_return(21);
             }
-            
-            //walkthrough stuff
-            for(int32_t j=0; j<4; j++)
+        }
+        
+        for(int32_t j=0; j<3; j++)
+        {
+            if(!p_putc(DoorComboSets[i].bombdoorcset_r[j],f))
             {
-                if(!p_iputw(DoorComboSets[i].walkthroughcombo[j],f))
-                {
-                    new_return(23);
-                }
+                new_return(22);
             }
-            
-            for(int32_t j=0; j<4; j++)
+        }
+        
+        //walkthrough stuff
+        for(int32_t j=0; j<4; j++)
+        {
+            if(!p_iputw(DoorComboSets[i].walkthroughcombo[j],f))
             {
-                if(!p_putc(DoorComboSets[i].walkthroughcset[j],f))
-                {
-                    new_return(24);
-                }
+                new_return(23);
             }
-            
-            //flags
-            for(int32_t j=0; j<2; j++)
+        }
+        
+        for(int32_t j=0; j<4; j++)
+        {
+            if(!p_putc(DoorComboSets[i].walkthroughcset[j],f))
             {
-                if(!p_putc(DoorComboSets[i].flags[j],f))
-                {
-                    new_return(25);
-                }
+                new_return(24);
             }
         }
         
-        if(writecycle==0)
+        //flags
+        for(int32_t j=0; j<2; j++)
         {
-            section_size=writesize;
+            if(!p_putc(DoorComboSets[i].flags[j],f))
+            {
+                new_return(25);
+            }
         }
     }
     
-    if(writesize!=int32_t(section_size) && save_warn)
+    //section size, then the buffered section data
+    if(!section.commit())
     {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writedoorcombosets()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+        new_return(4);
     }
     
     new_return(0);
@@ -7476,7 +7433,6 @@ int32_t writedmaps(PACKFILE *f, word version, word build, word start_dmap, word
     dword section_id=ID_DMAPS;
     dword section_version=V_DMAPS;
     dword section_cversion=CV_DMAPS;
-    dword section_size=0;
     
     //section id
     if(!p_mputl(section_id,f))
@@ -7495,263 +7451,246 @@ int32_t writedmaps(PACKFILE *f, word version, word build, word start_dmap, word
         new_return(3);
     }
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    section_writer section(f);
+    
+    dmap_count=zc_min(dmap_count, max_dmaps);
+    dmap_count=zc_min(dmap_count, MAXDMAPS-start_dmap);
+    
+    //finally...  section data
+    if(!p_iputw(dmap_count,f))
+    {
+        new_return(5);
+    }
+    
+    
+    for(int32_t i=start_dmap; i<start_dmap+dmap_count; i++)
     {
-        fake_pack_writing=(writecycle==0);
+        if(!p_putc(DMaps[i].map,f))
+        {
+            new_return(6);
+        }
         
-        //section size
-        if(!p_iputl(section_size,f))
+        if(!p_iputw(DMaps[i].level,f))
         {
-            new_return(4);
+            new_return(7);
         }
         
-        writesize=0;
+        if(!p_putc(DMaps[i].xoff,f))
+        {
+            new_return(8);
+        }
         
-        dmap_count=zc_min(dmap_count, max_dmaps);
-        dmap_count=zc_min(dmap_count, MAXDMAPS-start_dmap);
+        if(!p_putc(DMaps[i].compass,f))
+        {
+            new_return(9);
+        }
         
-        //finally...  section data
-        if(!p_iputw(dmap_count,f))
+        if(!p_iputw(DMaps[i].color,f))
         {
-            new_return(5);
+            new_return(10);
         }
         
+        if(!p_putc(DMaps[i].midi,f))
+        {
+            new_return(11);
+        }
         
-        for(int32_t i=start_dmap; i<start_dmap+dmap_count; i++)
+        if(!p_putc(DMaps[i].cont,f))
         {
-            if(!p_putc(DMaps[i].map,f))
-            {
-                new_return(6);
-            }
-            
-            if(!p_iputw(DMaps[i].level,f))
-            {
-                new_return(7);
-            }
-            
-            if(!p_putc(DMaps[i].xoff,f))
-            {
-                new_return(8);
-            }
-            
-            if(!p_putc(DMaps[i].compass,f))
-            {
-                new_return(9);
-            }
-            
-            if(!p_iputw(DMaps[i].color,f))
-            {
-                new_return(10);
-            }
-            
-            if(!p_putc(DMaps[i].midi,f))
-            {
-                new_return(11);
-            }
-            
-            if(!p_putc(DMaps[i].cont,f))
-            {
-                new_return(12);
-            }
-            
-            if(!p_putc(DMaps[i].type,f))
-            {
-                new_return(13);
-            }
-            
-            for(int32_t j=0; j<8; j++)
-            {
-                if(!p_putc(DMaps[i].grid[j],f))
-                {
-                    new_return(14);
-                }
-            }
-            
-            //16
-            if(!pfwrite(&DMaps[i].name,sizeof(DMaps[0].name),f))
-            {
-                new_return(15);
-            }
-            
-            if(!pfwrite(&DMaps[i].title,sizeof(DMaps[0].title),f))
-            {
-                new_return(16);
-            }
-            
-            if(!pfwrite(&DMaps[i].intro,sizeof(DMaps[0].intro),f))
-            {
-                new_return(17);
-            }
-            
-            if(!p_iputl(DMaps[i].minimap_1_tile,f))
-            {
-                new_return(18);
-            }
-            
-            if(!p_putc(DMaps[i].minimap_1_cset,f))
-            {
-                new_return(19);
-            }
-            
-            if(!p_iputl(DMaps[i].minimap_2_tile,f))
-            {
-                new_return(20);
-            }
-            
-            if(!p_putc(DMaps[i].minimap_2_cset,f))
+            new_return(12);
+        }
+        
+        if(!p_putc(DMaps[i].type,f))
+        {
+            new_return(13);
+        }
+        
+        for(int32_t j=0; j<8; j++)
+        {
+            if(!p_putc(DMaps[i].grid[j],f))
             {
-                new_return(21);
+                new_return(14);
             }
-            
-            if(!p_iputl(DMaps[i].largemap_1_tile,f))
+        }
+        
+        //16
+        if(!pfwrite(&DMaps[i].name,sizeof(DMaps[0].name),f))
+        {
+            new_return(15);
+        }
+        
+        if(!pfwrite(&DMaps[i].title,sizeof(DMaps[0].title),f))
+        {
+            new_return(16);
+        }
+        
+        if(!pfwrite(&DMaps[i].intro,sizeof(DMaps[0].intro),f))
+        {
+            new_return(17);
+        }
+        
+        if(!p_iputl(DMaps[i].minimap_1_tile,f))
+        {
+            new_return(18);
+        }
+        
+        if(!p_putc(DMaps[i].minimap_1_cset,f))
+        {
+            new_return(19);
+        }
+        
+        if(!p_iputl(DMaps[i].minimap_2_tile,f))
+        {
+            new_return(20);
+        }
+        
+        if(!p_putc(DMaps[i].minimap_2_cset,f))
+        {
+            new_return(21);
+        }
+        
+        if(!p_iputl(DMaps[i].largemap_1_tile,f))
+        {
+            new_return(22);
+        }
+        
+        if(!p_putc(DMaps[i].largemap_1_cset,f))
+        {
+            new_return(23);
+        }
+        
+        if(!p_iputl(DMaps[i].largemap_2_tile,f))
+        {
+            new_return(24);
+        }
+        
+        if(!p_putc(DMaps[i].largemap_2_cset,f))
+        {
+            new_return(25);
+        }
+        
+        if(!pfwrite(&DMaps[i].tmusic,sizeof(DMaps[0].tmusic),f))
+        {
+            new_return(26);
+        }
+        
+        if(!p_putc(DMaps[i].tmusictrack,f))
+        {
+            new_return(25);
+        }
+        
+        if(!p_putc(DMaps[i].active_subscreen,f))
+        {
+            new_return(26);
+        }
+        
+        if(!p_putc(DMaps[i].passive_subscreen,f))
+        {
+            new_return(27);
+        }
+        
+        byte disabled[32];
+        memset(disabled,0,32);
+        
+        for(int32_t j=0; j<MAXITEMS; j++)
+        {
+            if(DMaps[i].disableditems[j])
             {
-                new_return(22);
+                disabled[j/8] |= (1 << (j%8));
             }
-            
-            if(!p_putc(DMaps[i].largemap_1_cset,f))
-            {
-                new_return(23);
-            }
-            
-            if(!p_iputl(DMaps[i].largemap_2_tile,f))
-            {
-                new_return(24);
-            }
-            
-            if(!p_putc(DMaps[i].largemap_2_cset,f))
-            {
-                new_return(25);
-            }
-            
-            if(!pfwrite(&DMaps[i].tmusic,sizeof(DMaps[0].tmusic),f))
-            {
-                new_return(26);
-            }
-            
-            if(!p_putc(DMaps[i].tmusictrack,f))
-            {
-                new_return(25);
-            }
-            
-            if(!p_putc(DMaps[i].active_subscreen,f))
-            {
-                new_return(26);
-            }
-            
-            if(!p_putc(DMaps[i].passive_subscreen,f))
-            {
-                new_return(27);
-            }
-            
-            byte disabled[32];
-            memset(disabled,0,32);
-            
-            for(int32_t j=0; j<MAXITEMS; j++)
-            {
-                if(DMaps[i].disableditems[j])
-                {
-                    disabled[j/8] |= (1 << (j%8));
-                }
-            }
-            
-            if(!pfwrite(disabled,32,f))
-            {
-                new_return(28);
-            }
-            
-            if(!p_iputl(DMaps[i].flags,f))
-            {
-                new_return(29);
-            }
-	    if(!p_putc(DMaps[i].sideview,f))
-            {
-                new_return(30);
-            }
-	    if(!p_iputw(DMaps[i].script,f))
-            {
-                new_return(31);
-            }
-	    for ( int32_t q = 0; q < 8; q++ )
+        }
+        
+        if(!pfwrite(disabled,32,f))
+        {
+            new_return(28);
+        }
+        
+        if(!p_iputl(DMaps[i].flags,f))
+        {
+            new_return(29);
+        }
+    if(!p_putc(DMaps[i].sideview,f))
+        {
+            new_return(30);
+        }
+    if(!p_iputw(DMaps[i].script,f))
+        {
+            new_return(31);
+        }
+    for ( int32_t q = 0; q < 8; q++ )
+    {
+	if(!p_iputl(DMaps[i].initD[q],f))
+        {
+		new_return(32);
+	}
+	    
+    }
+    for ( int32_t q = 0; q < 8; q++ )
+    {
+	    for ( int32_t w = 0; w < 65; w++ )
 	    {
-		if(!p_iputl(DMaps[i].initD[q],f))
-	        {
-			new_return(32);
+		if (!p_putc(DMaps[i].initD_label[q][w],f))
+		{
+			new_return(33);
 		}
-		    
-	    }
-	    for ( int32_t q = 0; q < 8; q++ )
-	    {
-		    for ( int32_t w = 0; w < 65; w++ )
-		    {
-			if (!p_putc(DMaps[i].initD_label[q][w],f))
-			{
-				new_return(33);
-			}
+	}
+    }
+		if(!p_iputw(DMaps[i].active_sub_script,f))
+		{
+			new_return(34);
 		}
-	    }
-			if(!p_iputw(DMaps[i].active_sub_script,f))
-			{
-				new_return(34);
-			}
-			if(!p_iputw(DMaps[i].passive_sub_script,f))
-			{
-				new_return(35);
-			}
-			for(int32_t q = 0; q < 8; ++q)
+		if(!p_iputw(DMaps[i].passive_sub_script,f))
+		{
+			new_return(35);
+		}
+		for(int32_t q = 0; q < 8; ++q)
+		{
+			if(!p_iputl(DMaps[i].sub_initD[q],f))
 			{
-				if(!p_iputl(DMaps[i].sub_initD[q],f))
-				{
-					new_return(36);
-				}
+				new_return(36);
 			}
-			for(int32_t q = 0; q < 8; ++q)
+		}
+		for(int32_t q = 0; q < 8; ++q)
+		{
+			for(int32_t w = 0; w < 65; ++w)
 			{
-				for(int32_t w = 0; w < 65; ++w)
+				if(!p_putc(DMaps[i].sub_initD_label[q][w],f))
 				{
-					if(!p_putc(DMaps[i].sub_initD_label[q][w],f))
-					{
-						new_return(37);
-					}
+					new_return(37);
 				}
 			}
-			if(!p_iputw(DMaps[i].onmap_script,f))
-			{
-				new_return(38);
-			}
-			for(int32_t q = 0; q < 8; ++q)
+		}
+		if(!p_iputw(DMaps[i].onmap_script,f))
+		{
+			new_return(38);
+		}
+		for(int32_t q = 0; q < 8; ++q)
+		{
+			if(!p_iputl(DMaps[i].onmap_initD[q],f))
 			{
-				if(!p_iputl(DMaps[i].onmap_initD[q],f))
-				{
-					new_return(39);
-				}
+				new_return(39);
 			}
-			for(int32_t q = 0; q < 8; ++q)
+		}
+		for(int32_t q = 0; q < 8; ++q)
+		{
+			for(int32_t w = 0; w < 65; ++w)
 			{
-				for(int32_t w = 0; w < 65; ++w)
+				if(!p_putc(DMaps[i].onmap_initD_label[q][w],f))
 				{
-					if(!p_putc(DMaps[i].onmap_initD_label[q][w],f))
-					{
-						new_return(40);
-					}
+					new_return(40);
 				}
 			}
-			if(!p_iputw(DMaps[i].mirrorDMap,f))
-			{
-				new_return(41);
-			}
-        }
-        
-        if(writecycle==0)
-        {
-            section_size=writesize;
-        }
+		}
+		if(!p_iputw(DMaps[i].mirrorDMap,f))
+		{
+			new_return(41);
+		}
     }
     
-    if(writesize!=int32_t(section_size) && save_warn)
+    //section size, then the buffered section data
+    if(!section.commit())
     {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writedmaps()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+        new_return(4);
     }
     
     new_return(0);
@@ -7765,7 +7704,6 @@ int32_t writemisccolors(PACKFILE *f, zquestheader *Header, miscQdata *Misc)
 	dword section_id=ID_COLORS;
 	dword section_version=V_COLORS;
 	dword section_cversion=CV_COLORS;
-	dword section_size = 0;
 	
 	//section id
 	if(!p_mputl(section_id,f))
@@ -7785,189 +7723,170 @@ int32_t writemisccolors(PACKFILE *f, zquestheader *Header, miscQdata *Misc)
 		new_return(3);
 	}
 	
-	for(int32_t writecycle=0; writecycle<2; ++writecycle)
+	section_writer section(f);
+	
+	if(!p_putc(Misc->colors.text,f))
 	{
-		fake_pack_writing=(writecycle==0);
-		
-		//section size
-		if(!p_iputl(section_size,f))
-		{
-			new_return(4);
-		}
-		
-		writesize=0;
-		
-		if(!p_putc(Misc->colors.text,f))
-		{
-			new_return(5);
-		}
-		
-		if(!p_putc(Misc->colors.caption,f))
-		{
-			new_return(6);
-		}
-		
-		if(!p_putc(Misc->colors.overw_bg,f))
-		{
-			new_return(7);
-		}
-		
-		if(!p_putc(Misc->colors.dngn_bg,f))
-		{
-			new_return(8);
-		}
-		
-		if(!p_putc(Misc->colors.dngn_fg,f))
-		{
-			new_return(9);
-		}
-		
-		if(!p_putc(Misc->colors.cave_fg,f))
-		{
-			new_return(10);
-		}
-		
-		if(!p_putc(Misc->colors.bs_dk,f))
-		{
-			new_return(11);
-		}
-		
-		if(!p_putc(Misc->colors.bs_goal,f))
-		{
-			new_return(12);
-		}
-		
-		if(!p_putc(Misc->colors.compass_lt,f))
-		{
-			new_return(13);
-		}
-		
-		if(!p_putc(Misc->colors.compass_dk,f))
-		{
-			new_return(14);
-		}
-		
-		if(!p_putc(Misc->colors.subscr_bg,f))
-		{
-			new_return(15);
-		}
-		
-		if(!p_putc(Misc->colors.triframe_color,f))
-		{
-			new_return(16);
-		}
-		
-		if(!p_putc(Misc->colors.hero_dot,f))
-		{
-			new_return(17);
-		}
-		
-		if(!p_putc(Misc->colors.bmap_bg,f))
-		{
-			new_return(18);
-		}
-		
-		if(!p_putc(Misc->colors.bmap_fg,f))
-		{
-			new_return(19);
-		}
-		
-		if(!p_putc(Misc->colors.triforce_cset,f))
-		{
-			new_return(20);
-		}
-		
-		if(!p_putc(Misc->colors.triframe_cset,f))
-		{
-			new_return(21);
-		}
-		
-		if(!p_putc(Misc->colors.overworld_map_cset,f))
-		{
-			new_return(22);
-		}
-		
-		if(!p_putc(Misc->colors.dungeon_map_cset,f))
-		{
-			new_return(23);
-		}
-		
-		if(!p_putc(Misc->colors.blueframe_cset,f))
-		{
-			new_return(24);
-		}
-		
-		if(!p_putc(Misc->colors.HCpieces_cset,f))
-		{
-			new_return(31);
-		}
-		
-		if(!p_putc(Misc->colors.subscr_shadow,f))
-		{
-			new_return(32);
-		}
-		
-		if(!p_putc(Misc->colors.msgtext,f))
-		{
-			new_return(33);
-		}
+		new_return(5);
+	}
 	
-		if(!p_iputl(Misc->colors.triforce_tile,f))
-		{
-			new_return(34);
-		}
-		
-		if(!p_iputl(Misc->colors.triframe_tile,f))
-		{
-			new_return(35);
-		}
-		
-		if(!p_iputl(Misc->colors.overworld_map_tile,f))
-		{
-			new_return(36);
-		}
-		
-		if(!p_iputl(Misc->colors.dungeon_map_tile,f))
-		{
-			new_return(37);
-		}
-		
-		if(!p_iputl(Misc->colors.blueframe_tile,f))
-		{
-			new_return(38);
-		}
-		
-		if(!p_iputl(Misc->colors.HCpieces_tile,f))
-		{
-			new_return(39);
-		}
-		
-		
-		if(writecycle==0)
-		{
-			section_size=writesize;
-		}
+	if(!p_putc(Misc->colors.caption,f))
+	{
+		new_return(6);
 	}
 	
-	if(writesize!=int32_t(section_size) && save_warn)
+	if(!p_putc(Misc->colors.overw_bg,f))
 	{
-		char ebuf[80];
-		sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-		jwin_alert("Error:  writemisccolors()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+		new_return(7);
 	}
 	
-	new_return(0);
-}
-
-int32_t writegameicons(PACKFILE *f, zquestheader *Header, miscQdata *Misc)
-{
-    //these are here to bypass compiler warnings about unused arguments
-    Header=Header;
-    
-    dword section_id=ID_ICONS;
-    dword section_version=V_ICONS;
+	if(!p_putc(Misc->colors.dngn_bg,f))
+	{
+		new_return(8);
+	}
+	
+	if(!p_putc(Misc->colors.dngn_fg,f))
+	{
+		new_return(9);
+	}
+	
+	if(!p_putc(Misc->colors.cave_fg,f))
+	{
+		new_return(10);
+	}
+	
+	if(!p_putc(Misc->colors.bs_dk,f))
+	{
+		new_return(11);
+	}
+	
+	if(!p_putc(Misc->colors.bs_goal,f))
+	{
+		new_return(12);
+	}
+	
+	if(!p_putc(Misc->colors.compass_lt,f))
+	{
+		new_return(13);
+	}
+	
+	if(!p_putc(Misc->colors.compass_dk,f))
+	{
+		new_return(14);
+	}
+	
+	if(!p_putc(Misc->colors.subscr_bg,f))
+	{
+		new_return(15);
+	}
+	
+	if(!p_putc(Misc->colors.triframe_color,f))
+	{
+		new_return(16);
+	}
+	
+	if(!p_putc(Misc->colors.hero_dot,f))
+	{
+		new_return(17);
+	}
+	
+	if(!p_putc(Misc->colors.bmap_bg,f))
+	{
+		new_return(18);
+	}
+	
+	if(!p_putc(Misc->colors.bmap_fg,f))
+	{
+		new_return(19);
+	}
+	
+	if(!p_putc(Misc->colors.triforce_cset,f))
+	{
+		new_return(20);
+	}
+	
+	if(!p_putc(Misc->colors.triframe_cset,f))
+	{
+		new_return(21);
+	}
+	
+	if(!p_putc(Misc->colors.overworld_map_cset,f))
+	{
+		new_return(22);
+	}
+	
+	if(!p_putc(Misc->colors.dungeon_map_cset,f))
+	{
+		new_return(23);
+	}
+	
+	if(!p_putc(Misc->colors.blueframe_cset,f))
+	{
+		new_return(24);
+	}
+	
+	if(!p_putc(Misc->colors.HCpieces_cset,f))
+	{
+		new_return(31);
+	}
+	
+	if(!p_putc(Misc->colors.subscr_shadow,f))
+	{
+		new_return(32);
+	}
+	
+	if(!p_putc(Misc->colors.msgtext,f))
+	{
+		new_return(33);
+	}
+
+	if(!p_iputl(Misc->colors.triforce_tile,f))
+	{
+		new_return(34);
+	}
+	
+	if(!p_iputl(Misc->colors.triframe_tile,f))
+	{
+		new_return(35);
+	}
+	
+	if(!p_iputl(Misc->colors.overworld_map_tile,f))
+	{
+		new_return(36);
+	}
+	
+	if(!p_iputl(Misc->colors.dungeon_map_tile,f))
+	{
+		new_return(37);
+	}
+	
+	if(!p_iputl(Misc->colors.blueframe_tile,f))
+	{
+		new_return(38);
+	}
+	
+	if(!p_iputl(Misc->colors.HCpieces_tile,f))
+	{
+		new_return(39);
+	}
+	
+	//section size, then the buffered section data
+	if(!section.commit())
+	{
+		new_return(4);
+	}
+	
+	new_return(0);
+}
+
+int32_t writegameicons(PACKFILE *f, zquestheader *Header, miscQdata *Misc)
+{
+    //these are here to bypass compiler warnings about unused arguments
+    Header=Header;
+    
+    dword section_id=ID_ICONS;
+    dword section_version=V_ICONS;
     dword section_cversion=CV_ICONS;
-    dword section_size = 0;
     
     //section id
     if(!p_mputl(section_id,f))
@@ -7986,37 +7905,20 @@ int32_t writegameicons(PACKFILE *f, zquestheader *Header, miscQdata *Misc)
         new_return(3);
     }
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    section_writer section(f);
+    
+    for(int32_t i=0; i<4; i++)
     {
-        fake_pack_writing=(writecycle==0);
-        
-        //section size
-        if(!p_iputl(section_size,f))
+        if(!p_iputl(Misc->icons[i],f))
         {
-            new_return(4);
-        }
-        
-        writesize=0;
-        
-        for(int32_t i=0; i<4; i++)
-        {
-            if(!p_iputl(Misc->icons[i],f))
-            {
-                new_return(5);
-            }
-        }
-        
-        if(writecycle==0)
-        {
-            section_size=writesize;
+            new_return(5);
         }
     }
     
-    if(writesize!=int32_t(section_size) && save_warn)
+    //section size, then the buffered section data
+    if(!section.commit())
     {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writegameicons()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+        new_return(4);
     }
     
     new_return(0);
@@ -8034,7 +7936,6 @@ int32_t writemisc(PACKFILE *f, zquestheader *Header, miscQdata *Misc)
 	word infos=count_infos(Misc);
 	word warprings=count_warprings(Misc);
 	word triforces=8;
-	dword section_size = 0;
 	
 	//section id
 	if(!p_mputl(section_id,f))
@@ -8054,237 +7955,218 @@ int32_t writemisc(PACKFILE *f, zquestheader *Header, miscQdata *Misc)
 		new_return(3);
 	}
 	
-	for(int32_t writecycle=0; writecycle<2; ++writecycle)
+	section_writer section(f);
+	
+	//shops
+	if(!p_iputw(shops,f))
 	{
-		fake_pack_writing=(writecycle==0);
-		
-		//section size
-		if(!p_iputl(section_size,f))
-		{
-			new_return(4);
-		}
-		
-		writesize=0;
-		
-		//shops
-		if(!p_iputw(shops,f))
+		new_return(5);
+	}
+	
+	for(int32_t i=0; i<shops; i++)
+	{
+		if(!pfwrite(Misc->shop[i].name,sizeof(Misc->shop[i].name),f))
 		{
-			new_return(5);
+			new_return(6);
 		}
 		
-		for(int32_t i=0; i<shops; i++)
+		for(int32_t j=0; j<3; j++)
 		{
-			if(!pfwrite(Misc->shop[i].name,sizeof(Misc->shop[i].name),f))
-			{
-				new_return(6);
-			}
-			
-			for(int32_t j=0; j<3; j++)
-			{
-				if(!p_putc(Misc->shop[i].item[j],f))
-				{
-					new_return(7);
-				}
-			}
-			
-			for(int32_t j=0; j<3; j++)
+			if(!p_putc(Misc->shop[i].item[j],f))
 			{
-				if(!p_iputw(Misc->shop[i].price[j],f))
-				{
-					new_return(8);
-				}
-			}
-			
-			for(int32_t j=0; j<3; j++)
-			{
-				if(!p_putc(Misc->shop[i].hasitem[j],f))
-				{
-					new_return(9);
-				}
+				new_return(7);
 			}
 		}
 		
-		//infos
-		if(!p_iputw(infos,f))
+		for(int32_t j=0; j<3; j++)
 		{
-			new_return(10);
+			if(!p_iputw(Misc->shop[i].price[j],f))
+			{
+				new_return(8);
+			}
 		}
 		
-		for(int32_t i=0; i<infos; i++)
+		for(int32_t j=0; j<3; j++)
 		{
-			if(!pfwrite(Misc->info[i].name,sizeof(Misc->info[i].name),f))
-			{
-				new_return(11);
-			}
-			
-			for(int32_t j=0; j<3; j++)
+			if(!p_putc(Misc->shop[i].hasitem[j],f))
 			{
-				if(!p_iputw(Misc->info[i].str[j],f))
-				{
-					new_return(12);
-				}
-			}
-			
-			for(int32_t j=0; j<3; j++)
-			{
-				if(!p_iputw(Misc->info[i].price[j],f))
-				{
-					new_return(13);
-				}
+				new_return(9);
 			}
 		}
-		
-		//warp rings
-		if(!p_iputw(warprings,f))
+	}
+	
+	//infos
+	if(!p_iputw(infos,f))
+	{
+		new_return(10);
+	}
+	
+	for(int32_t i=0; i<infos; i++)
+	{
+		if(!pfwrite(Misc->info[i].name,sizeof(Misc->info[i].name),f))
 		{
-			new_return(14);
+			new_return(11);
 		}
 		
-		for(int32_t i=0; i<warprings; i++)
+		for(int32_t j=0; j<3; j++)
 		{
-			for(int32_t j=0; j<9; j++)
-			{
-				if(!p_iputw(Misc->warp[i].dmap[j],f))
-				{
-					new_return(15);
-				}
-			}
-			
-			for(int32_t j=0; j<9; j++)
-			{
-				if(!p_putc(Misc->warp[i].scr[j],f))
-				{
-					new_return(16);
-				}
-			}
-			
-			if(!p_putc(Misc->warp[i].size,f))
+			if(!p_iputw(Misc->info[i].str[j],f))
 			{
-				new_return(17);
+				new_return(12);
 			}
 		}
 		
-		//triforce pieces
-		for(int32_t i=0; i<triforces; i++)
+		for(int32_t j=0; j<3; j++)
 		{
-			if(!p_putc(Misc->triforce[i],f))
+			if(!p_iputw(Misc->info[i].price[j],f))
 			{
-				new_return(18);
+				new_return(13);
 			}
 		}
-		
-		//end string
-		if(!p_iputw(Misc->endstring,f))
+	}
+	
+	//warp rings
+	if(!p_iputw(warprings,f))
+	{
+		new_return(14);
+	}
+	
+	for(int32_t i=0; i<warprings; i++)
+	{
+		for(int32_t j=0; j<9; j++)
 		{
-			new_return(19);
+			if(!p_iputw(Misc->warp[i].dmap[j],f))
+			{
+				new_return(15);
+			}
 		}
 		
-		//V_MISC >= 8
-		for(int32_t i=0; i<shops; i++)
+		for(int32_t j=0; j<9; j++)
 		{
-			for(int32_t j=0; j<3; j++)
+			if(!p_putc(Misc->warp[i].scr[j],f))
 			{
-				if(!p_iputw(Misc->shop[i].str[j],f))
-				{
-					new_return(20);
-				}
+				new_return(16);
 			}
 		}
-		//V_MISC >= 9
-		for ( int32_t q = 0; q < 32; q++ ) 
-		{
-			if(!p_iputl(Misc->questmisc[q],f))
-						new_return(21);
-		}
-		for ( int32_t q = 0; q < 32; q++ ) 
-		{
-			for ( int32_t j = 0; j < 128; j++ )
-			if(!p_putc(Misc->questmisc_strings[q][j],f))
-						 new_return(22);
-		}
-		//V_MISC >= 11
-		if(!p_iputl(Misc->zscript_last_compiled_version,f))
-			new_return(23);
 		
-		//V_MISC >= 12
-		for(int32_t q = 0; q < sprMAX; ++q)
+		if(!p_putc(Misc->warp[i].size,f))
 		{
-			if(!p_putc(Misc->sprites[q],f))
-				new_return(24);
+			new_return(17);
 		}
-		
-		//V_MISC >= 13
-		for(size_t q = 0; q < 64; ++q)
+	}
+	
+	//triforce pieces
+	for(int32_t i=0; i<triforces; i++)
+	{
+		if(!p_putc(Misc->triforce[i],f))
 		{
-			bottletype* bt = &(Misc->bottle_types[q]);
-            if (!pfwrite(bt->name, 32, f))
-                new_return(25);
-			for(size_t j = 0; j < 3; ++j)
-			{
-                if (!p_putc(bt->counter[j], f))
-                    new_return(25);
-                if (!p_iputw(bt->amount[j], f))
-                    new_return(25);
-			}
-            if (!p_putc(bt->flags, f))
-                new_return(25);
-            if (!p_putc(bt->next_type, f))
-                new_return(25);
+			new_return(18);
 		}
-		for(size_t q = 0; q < 256; ++q)
+	}
+	
+	//end string
+	if(!p_iputw(Misc->endstring,f))
+	{
+		new_return(19);
+	}
+	
+	//V_MISC >= 8
+	for(int32_t i=0; i<shops; i++)
+	{
+		for(int32_t j=0; j<3; j++)
 		{
-			bottleshoptype* bst = &(Misc->bottle_shop_types[q]);
-            if (!pfwrite(bst->name, 32, f))
-                new_return(26);
-			for(size_t j = 0; j < 3; ++j)
+			if(!p_iputw(Misc->shop[i].str[j],f))
 			{
-                if (!p_putc(bst->fill[j], f))
-                    new_return(26);
-                if (!p_iputw(bst->comb[j], f))
-                    new_return(26);
-                if (!p_putc(bst->cset[j], f))
-                    new_return(26);
-                if (!p_iputw(bst->price[j], f))
-                    new_return(26);
-                if (!p_iputw(bst->str[j], f))
-                    new_return(26);
+				new_return(20);
 			}
 		}
-		
-		//V_MISC >= 14
-		for(int32_t q = 0; q < sfxMAX; ++q)
-		{
-			if(!p_putc(Misc->miscsfx[q],f))
-				new_return(27);
-		}
-		
-		if(writecycle==0)
-		{
-			section_size=writesize;
-		}
 	}
+	//V_MISC >= 9
+	for ( int32_t q = 0; q < 32; q++ ) 
+	{
+		if(!p_iputl(Misc->questmisc[q],f))
+					new_return(21);
+	}
+	for ( int32_t q = 0; q < 32; q++ ) 
+	{
+		for ( int32_t j = 0; j < 128; j++ )
+		if(!p_putc(Misc->questmisc_strings[q][j],f))
+					 new_return(22);
+	}
+	//V_MISC >= 11
+	if(!p_iputl(Misc->zscript_last_compiled_version,f))
+		new_return(23);
 	
-	if(writesize!=int32_t(section_size) && save_warn)
+	//V_MISC >= 12
+	for(int32_t q = 0; q < sprMAX; ++q)
 	{
-		char ebuf[80];
-		sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-		jwin_alert("Error:  writemisc()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+		if(!p_putc(Misc->sprites[q],f))
+			new_return(24);
 	}
 	
-	new_return(0);
-}
-
-int32_t writeitems(PACKFILE *f, zquestheader *Header)
-{
-    //these are here to bypass compiler warnings about unused arguments
-    Header=Header;
-    
-    dword section_id=ID_ITEMS;
-    dword section_version=V_ITEMS;
-    dword section_cversion=CV_ITEMS;
-    //  dword section_size=0;
-    dword section_size = 0;
-    
+	//V_MISC >= 13
+	for(size_t q = 0; q < 64; ++q)
+	{
+		bottletype* bt = &(Misc->bottle_types[q]);
+        if (!pfwrite(bt->name, 32, f))
+            new_return(25);
+		for(size_t j = 0; j < 3; ++j)
+		{
+            if (!p_putc(bt->counter[j], f))
+                new_return(25);
+            if (!p_iputw(bt->amount[j], f))
+                new_return(25);
+		}
+        if (!p_putc(bt->flags, f))
+            new_return(25);
+        if (!p_putc(bt->next_type, f))
+            new_return(25);
+	}
+	for(size_t q = 0; q < 256; ++q)
+	{
+		bottleshoptype* bst = &(Misc->bottle_shop_types[q]);
+        if (!pfwrite(bst->name, 32, f))
+            new_return(26);
+		for(size_t j = 0; j < 3; ++j)
+		{
+            if (!p_putc(bst->fill[j], f))
+                new_return(26);
+            if (!p_iputw(bst->comb[j], f))
+                new_return(26);
+            if (!p_putc(bst->cset[j], f))
+                new_return(26);
+            if (!p_iputw(bst->price[j], f))
+                new_return(26);
+            if (!p_iputw(bst->str[j], f))
+                new_return(26);
+		}
+	}
+	
+	//V_MISC >= 14
+	for(int32_t q = 0; q < sfxMAX; ++q)
+	{
+		if(!p_putc(Misc->miscsfx[q],f))
+			new_return(27);
+	}
+	
+	//section size, then the buffered section data
+	if(!section.commit())
+	{
+		new_return(4);
+	}
+	
+	new_return(0);
+}
+
+int32_t writeitems(PACKFILE *f, zquestheader *Header)
+{
+    //these are here to bypass compiler warnings about unused arguments
+    Header=Header;
+    
+    dword section_id=ID_ITEMS;
+    dword section_version=V_ITEMS;
+    dword section_cversion=CV_ITEMS;
+    
     //section id
     if(!p_mputl(section_id,f))
     {
@@ -8302,490 +8184,473 @@ int32_t writeitems(PACKFILE *f, zquestheader *Header)
         new_return(3);
     }
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    section_writer section(f);
+    
+    //finally...  section data
+    if(!p_iputw(iMax,f))
+    {
+        new_return(5);
+    }
+    
+    for(int32_t i=0; i<iMax; i++)
+    {
+        if(!pfwrite(item_string[i], 64, f))
+        {
+            new_return(5);
+        }
+    }
+    
+    for(int32_t i=0; i<iMax; i++)
     {
-        fake_pack_writing=(writecycle==0);
+        if(!p_iputl(itemsbuf[i].tile,f))
+        {
+            new_return(6);
+        }
         
-        //section size
-        if(!p_iputl(section_size,f))
+        if(!p_putc(itemsbuf[i].misc_flags,f))
         {
-            new_return(4);
+            new_return(7);
         }
         
-        writesize=0;
+        if(!p_putc(itemsbuf[i].csets,f))
+        {
+            new_return(8);
+        }
         
-        //finally...  section data
-        if(!p_iputw(iMax,f))
+        if(!p_putc(itemsbuf[i].frames,f))
         {
-            new_return(5);
+            new_return(9);
         }
         
-        for(int32_t i=0; i<iMax; i++)
+        if(!p_putc(itemsbuf[i].speed,f))
         {
-            if(!pfwrite(item_string[i], 64, f))
-            {
-                new_return(5);
-            }
+            new_return(10);
         }
         
-        for(int32_t i=0; i<iMax; i++)
+        if(!p_putc(itemsbuf[i].delay,f))
         {
-            if(!p_iputl(itemsbuf[i].tile,f))
-            {
-                new_return(6);
-            }
-            
-            if(!p_putc(itemsbuf[i].misc_flags,f))
-            {
-                new_return(7);
-            }
-            
-            if(!p_putc(itemsbuf[i].csets,f))
-            {
-                new_return(8);
-            }
-            
-            if(!p_putc(itemsbuf[i].frames,f))
-            {
-                new_return(9);
-            }
-            
-            if(!p_putc(itemsbuf[i].speed,f))
-            {
-                new_return(10);
-            }
-            
-            if(!p_putc(itemsbuf[i].delay,f))
-            {
-                new_return(11);
-            }
-            
-            if(!p_iputl(itemsbuf[i].ltm,f))
-            {
-                new_return(12);
-            }
-            
-            if(!p_iputl(itemsbuf[i].family,f))
-            {
-                new_return(13);
-            }
-            
-            if(!p_putc(itemsbuf[i].fam_type,f))
-            {
-                new_return(14);
-            }
-            
-            if(!p_iputl(itemsbuf[i].power,f))
-            {
-                new_return(14);
-            }
-            
-            if(!p_iputl(itemsbuf[i].flags,f))
-            {
-                new_return(15);
-            }
-            
-            if(!p_iputw(itemsbuf[i].script,f))
-            {
-                new_return(16);
-            }
-            
-            if(!p_putc(itemsbuf[i].count,f))
-            {
-                new_return(17);
-            }
-            
-            if(!p_iputw(itemsbuf[i].amount,f))
-            {
-                new_return(18);
-            }
-            
-            if(!p_iputw(itemsbuf[i].collect_script,f))
-            {
-                new_return(19);
-            }
-            
-            if(!p_iputw(itemsbuf[i].setmax,f))
-            {
-                new_return(21);
-            }
-            
-            if(!p_iputw(itemsbuf[i].max,f))
-            {
-                new_return(22);
-            }
-            
-            if(!p_putc(itemsbuf[i].playsound,f))
-            {
-                new_return(23);
-            }
-            
-            for(int32_t j=0; j<8; j++)
-            {
-                if(!p_iputl(itemsbuf[i].initiald[j],f))
-                {
-                    new_return(24);
-                }
-            }
-            
-            for(int32_t j=0; j<2; j++)
-            {
-                if(!p_putc(itemsbuf[i].initiala[j],f))
-                {
-                    new_return(25);
-                }
-            }
-            
-            if(!p_putc(itemsbuf[i].wpn,f))
-            {
-                new_return(26);
-            }
-            
-            if(!p_putc(itemsbuf[i].wpn2,f))
-            {
-                new_return(27);
-            }
-            
-            if(!p_putc(itemsbuf[i].wpn3,f))
-            {
-                new_return(28);
-            }
-            
-            if(!p_putc(itemsbuf[i].wpn4,f))
-            {
-                new_return(29);
-            }
-            
-            if(!p_putc(itemsbuf[i].wpn5,f))
-            {
-                new_return(30);
-            }
-            
-            if(!p_putc(itemsbuf[i].wpn6,f))
-            {
-                new_return(31);
-            }
-            
-            if(!p_putc(itemsbuf[i].wpn7,f))
-            {
-                new_return(32);
-            }
-            
-            if(!p_putc(itemsbuf[i].wpn8,f))
-            {
-                new_return(33);
-            }
-            
-            if(!p_putc(itemsbuf[i].wpn9,f))
-            {
-                new_return(34);
-            }
-            
-            if(!p_putc(itemsbuf[i].wpn10,f))
-            {
-                new_return(35);
-            }
-            
-            if(!p_putc(itemsbuf[i].pickup_hearts,f))
-            {
-                new_return(36);
-            }
-            
-            if(!p_iputl(itemsbuf[i].misc1,f))
-            {
-                new_return(37);
-            }
-            
-            if(!p_iputl(itemsbuf[i].misc2,f))
-            {
-                new_return(38);
-            }
-            
-			for(auto q = 0; q < 2; ++q)
-			{
-				if(!p_iputw(itemsbuf[i].cost_amount[q],f))
-				{
-					new_return(39);
-				}
-			}
-            
-            if(!p_iputl(itemsbuf[i].misc3,f))
-            {
-                new_return(40);
-            }
-            
-            if(!p_iputl(itemsbuf[i].misc4,f))
+            new_return(11);
+        }
+        
+        if(!p_iputl(itemsbuf[i].ltm,f))
+        {
+            new_return(12);
+        }
+        
+        if(!p_iputl(itemsbuf[i].family,f))
+        {
+            new_return(13);
+        }
+        
+        if(!p_putc(itemsbuf[i].fam_type,f))
+        {
+            new_return(14);
+        }
+        
+        if(!p_iputl(itemsbuf[i].power,f))
+        {
+            new_return(14);
+        }
+        
+        if(!p_iputl(itemsbuf[i].flags,f))
+        {
+            new_return(15);
+        }
+        
+        if(!p_iputw(itemsbuf[i].script,f))
+        {
+            new_return(16);
+        }
+        
+        if(!p_putc(itemsbuf[i].count,f))
+        {
+            new_return(17);
+        }
+        
+        if(!p_iputw(itemsbuf[i].amount,f))
+        {
+            new_return(18);
+        }
+        
+        if(!p_iputw(itemsbuf[i].collect_script,f))
+        {
+            new_return(19);
+        }
+        
+        if(!p_iputw(itemsbuf[i].setmax,f))
+        {
+            new_return(21);
+        }
+        
+        if(!p_iputw(itemsbuf[i].max,f))
+        {
+            new_return(22);
+        }
+        
+        if(!p_putc(itemsbuf[i].playsound,f))
+        {
+            new_return(23);
+        }
+        
+        for(int32_t j=0; j<8; j++)
+        {
+            if(!p_iputl(itemsbuf[i].initiald[j],f))
             {
-                new_return(41);
+                new_return(24);
             }
-            
-            if(!p_iputl(itemsbuf[i].misc5,f))
+        }
+        
+        for(int32_t j=0; j<2; j++)
+        {
+            if(!p_putc(itemsbuf[i].initiala[j],f))
             {
-                new_return(42);
+                new_return(25);
             }
-            
-            if(!p_iputl(itemsbuf[i].misc6,f))
-            {
-                new_return(43);
-            }
-            
-            if(!p_iputl(itemsbuf[i].misc7,f))
-            {
-                new_return(44);
-            }
-            
-            if(!p_iputl(itemsbuf[i].misc8,f))
-            {
-                new_return(45);
-            }
-            
-            if(!p_iputl(itemsbuf[i].misc9,f))
-            {
-                new_return(46);
-            }
-            
-            if(!p_iputl(itemsbuf[i].misc10,f))
-            {
-                new_return(47);
-            }
-            
-            if(!p_putc(itemsbuf[i].usesound,f))
-            {
-                new_return(48);
-            }
-            
-            if(!p_putc(itemsbuf[i].usesound2,f))
-            {
-                new_return(48);
-            }
-	    
-	    //New itemdata vars -Z
-	    //! version 27
-	    
-	    if(!p_putc(itemsbuf[i].useweapon,f))
-            {
-                new_return(49);
-            }
-	    if(!p_putc(itemsbuf[i].usedefence,f))
-            {
-                new_return(50);
-            }
-	    if(!p_iputl(itemsbuf[i].weaprange,f))
-            {
-                new_return(51);
-            }
-	    if(!p_iputl(itemsbuf[i].weapduration,f))
-            {
-                new_return(52);
-            }
-	    for ( int32_t q = 0; q < ITEM_MOVEMENT_PATTERNS; q++ ) {
-		    if(!p_iputl(itemsbuf[i].weap_pattern[q],f))
-		    {
-			new_return(53);
-		    }
-	    }
-	    //version 28
-		if(!p_iputl(itemsbuf[i].duplicates,f))
-		{
-		    new_return(54);
-		}
-		for ( int32_t q = 0; q < INITIAL_D; q++ )
+        }
+        
+        if(!p_putc(itemsbuf[i].wpn,f))
+        {
+            new_return(26);
+        }
+        
+        if(!p_putc(itemsbuf[i].wpn2,f))
+        {
+            new_return(27);
+        }
+        
+        if(!p_putc(itemsbuf[i].wpn3,f))
+        {
+            new_return(28);
+        }
+        
+        if(!p_putc(itemsbuf[i].wpn4,f))
+        {
+            new_return(29);
+        }
+        
+        if(!p_putc(itemsbuf[i].wpn5,f))
+        {
+            new_return(30);
+        }
+        
+        if(!p_putc(itemsbuf[i].wpn6,f))
+        {
+            new_return(31);
+        }
+        
+        if(!p_putc(itemsbuf[i].wpn7,f))
+        {
+            new_return(32);
+        }
+        
+        if(!p_putc(itemsbuf[i].wpn8,f))
+        {
+            new_return(33);
+        }
+        
+        if(!p_putc(itemsbuf[i].wpn9,f))
+        {
+            new_return(34);
+        }
+        
+        if(!p_putc(itemsbuf[i].wpn10,f))
+        {
+            new_return(35);
+        }
+        
+        if(!p_putc(itemsbuf[i].pickup_hearts,f))
+        {
+            new_return(36);
+        }
+        
+        if(!p_iputl(itemsbuf[i].misc1,f))
+        {
+            new_return(37);
+        }
+        
+        if(!p_iputl(itemsbuf[i].misc2,f))
+        {
+            new_return(38);
+        }
+        
+		for(auto q = 0; q < 2; ++q)
 		{
-			if(!p_iputl(itemsbuf[i].weap_initiald[q],f))
+			if(!p_iputw(itemsbuf[i].cost_amount[q],f))
 			{
-				new_return(55);
+				new_return(39);
 			}
 		}
-		for ( int32_t q = 0; q < INITIAL_A; q++ )
+        
+        if(!p_iputl(itemsbuf[i].misc3,f))
+        {
+            new_return(40);
+        }
+        
+        if(!p_iputl(itemsbuf[i].misc4,f))
+        {
+            new_return(41);
+        }
+        
+        if(!p_iputl(itemsbuf[i].misc5,f))
+        {
+            new_return(42);
+        }
+        
+        if(!p_iputl(itemsbuf[i].misc6,f))
+        {
+            new_return(43);
+        }
+        
+        if(!p_iputl(itemsbuf[i].misc7,f))
+        {
+            new_return(44);
+        }
+        
+        if(!p_iputl(itemsbuf[i].misc8,f))
+        {
+            new_return(45);
+        }
+        
+        if(!p_iputl(itemsbuf[i].misc9,f))
+        {
+            new_return(46);
+        }
+        
+        if(!p_iputl(itemsbuf[i].misc10,f))
+        {
+            new_return(47);
+        }
+        
+        if(!p_putc(itemsbuf[i].usesound,f))
+        {
+            new_return(48);
+        }
+        
+        if(!p_putc(itemsbuf[i].usesound2,f))
+        {
+            new_return(48);
+        }
+    
+    //New itemdata vars -Z
+    //! version 27
+    
+    if(!p_putc(itemsbuf[i].useweapon,f))
+        {
+            new_return(49);
+        }
+    if(!p_putc(itemsbuf[i].usedefence,f))
+        {
+            new_return(50);
+        }
+    if(!p_iputl(itemsbuf[i].weaprange,f))
+        {
+            new_return(51);
+        }
+    if(!p_iputl(itemsbuf[i].weapduration,f))
+        {
+            new_return(52);
+        }
+    for ( int32_t q = 0; q < ITEM_MOVEMENT_PATTERNS; q++ ) {
+	    if(!p_iputl(itemsbuf[i].weap_pattern[q],f))
+	    {
+		new_return(53);
+	    }
+    }
+    //version 28
+	if(!p_iputl(itemsbuf[i].duplicates,f))
+	{
+	    new_return(54);
+	}
+	for ( int32_t q = 0; q < INITIAL_D; q++ )
+	{
+		if(!p_iputl(itemsbuf[i].weap_initiald[q],f))
 		{
-			if(!p_putc(itemsbuf[i].weap_initiala[q],f))
-			{
-				new_return(56);
-			}
+			new_return(55);
 		}
-
-		if(!p_putc(itemsbuf[i].drawlayer,f))
+	}
+	for ( int32_t q = 0; q < INITIAL_A; q++ )
+	{
+		if(!p_putc(itemsbuf[i].weap_initiala[q],f))
 		{
-		    new_return(57);
+			new_return(56);
 		}
+	}
 
+	if(!p_putc(itemsbuf[i].drawlayer,f))
+	{
+	    new_return(57);
+	}
 
-		if(!p_iputl(itemsbuf[i].hxofs,f))
-		{
-		    new_return(58);
-		}
-		if(!p_iputl(itemsbuf[i].hyofs,f))
-		{
-		    new_return(59);
-		}
-		if(!p_iputl(itemsbuf[i].hxsz,f))
-		{
-		    new_return(60);
-		}
-		if(!p_iputl(itemsbuf[i].hysz,f))
-		{
-		    new_return(61);
-		}
-		if(!p_iputl(itemsbuf[i].hzsz,f))
-		{
-		    new_return(62);
-		}
-		if(!p_iputl(itemsbuf[i].xofs,f))
-		{
-		    new_return(63);
-		}
-		if(!p_iputl(itemsbuf[i].yofs,f))
-		{
-		    new_return(64);
-		}
-		if(!p_iputl(itemsbuf[i].weap_hxofs,f))
-		{
-		    new_return(65);
-		}
-		if(!p_iputl(itemsbuf[i].weap_hyofs,f))
-		{
-		    new_return(66);
-		}
-		if(!p_iputl(itemsbuf[i].weap_hxsz,f))
-		{
-		    new_return(67);
-		}
-		if(!p_iputl(itemsbuf[i].weap_hysz,f))
-		{
-		    new_return(68);
-		}
-		if(!p_iputl(itemsbuf[i].weap_hzsz,f))
-		{
-		    new_return(69);
-		}
-		if(!p_iputl(itemsbuf[i].weap_xofs,f))
-		{
-		    new_return(70);
-		}
-		if(!p_iputl(itemsbuf[i].weap_yofs,f))
-		{
-		    new_return(71);
-		}
-		if(!p_iputw(itemsbuf[i].weaponscript,f))
+
+	if(!p_iputl(itemsbuf[i].hxofs,f))
+	{
+	    new_return(58);
+	}
+	if(!p_iputl(itemsbuf[i].hyofs,f))
+	{
+	    new_return(59);
+	}
+	if(!p_iputl(itemsbuf[i].hxsz,f))
+	{
+	    new_return(60);
+	}
+	if(!p_iputl(itemsbuf[i].hysz,f))
+	{
+	    new_return(61);
+	}
+	if(!p_iputl(itemsbuf[i].hzsz,f))
+	{
+	    new_return(62);
+	}
+	if(!p_iputl(itemsbuf[i].xofs,f))
+	{
+	    new_return(63);
+	}
+	if(!p_iputl(itemsbuf[i].yofs,f))
+	{
+	    new_return(64);
+	}
+	if(!p_iputl(itemsbuf[i].weap_hxofs,f))
+	{
+	    new_return(65);
+	}
+	if(!p_iputl(itemsbuf[i].weap_hyofs,f))
+	{
+	    new_return(66);
+	}
+	if(!p_iputl(itemsbuf[i].weap_hxsz,f))
+	{
+	    new_return(67);
+	}
+	if(!p_iputl(itemsbuf[i].weap_hysz,f))
+	{
+	    new_return(68);
+	}
+	if(!p_iputl(itemsbuf[i].weap_hzsz,f))
+	{
+	    new_return(69);
+	}
+	if(!p_iputl(itemsbuf[i].weap_xofs,f))
+	{
+	    new_return(70);
+	}
+	if(!p_iputl(itemsbuf[i].weap_yofs,f))
+	{
+	    new_return(71);
+	}
+	if(!p_iputw(itemsbuf[i].weaponscript,f))
+	{
+	    new_return(72);
+	}
+	if(!p_iputl(itemsbuf[i].wpnsprite,f))
+	{
+	    new_return(73);
+	}
+	for(auto q = 0; q < 2; ++q)
+	{
+		if(!p_iputl(itemsbuf[i].magiccosttimer[q],f))
 		{
-		    new_return(72);
+			new_return(74);
 		}
-		if(!p_iputl(itemsbuf[i].wpnsprite,f))
+	}
+	if(!p_iputl(itemsbuf[i].overrideFLAGS,f))
+	{
+	    new_return(75);
+	}
+	if(!p_iputl(itemsbuf[i].tilew,f))
+	{
+	    new_return(76);
+	}
+	if(!p_iputl(itemsbuf[i].tileh,f))
+	{
+	    new_return(77);
+	}
+	if(!p_iputl(itemsbuf[i].weapoverrideFLAGS,f))
+	{
+	    new_return(78);
+	}
+	if(!p_iputl(itemsbuf[i].weap_tilew,f))
+	{
+	    new_return(79);
+	}
+	if(!p_iputl(itemsbuf[i].weap_tileh,f))
+	{
+	    new_return(80);
+	}
+	if(!p_iputl(itemsbuf[i].pickup,f))
+	{
+	    new_return(81);
+	}
+	if(!p_iputw(itemsbuf[i].pstring,f))
+	{
+	    new_return(82);
+	}
+	if(!p_iputw(itemsbuf[i].pickup_string_flags,f))
+	{
+	    new_return(83);
+	}
+	
+	for(auto q = 0; q < 2; ++q)
+	{
+		if(!p_putc(itemsbuf[i].cost_counter[q],f))
 		{
-		    new_return(73);
+			new_return(84);
 		}
-		for(auto q = 0; q < 2; ++q)
+	}
+	
+	//InitD[] labels
+	for ( int32_t q = 0; q < 8; q++ )
+	{
+		for ( int32_t w = 0; w < 65; w++ )
 		{
-			if(!p_iputl(itemsbuf[i].magiccosttimer[q],f))
+			if(!p_putc(itemsbuf[i].initD_label[q][w],f))
 			{
-				new_return(74);
-			}
-		}
-		if(!p_iputl(itemsbuf[i].overrideFLAGS,f))
-		{
-		    new_return(75);
-		}
-		if(!p_iputl(itemsbuf[i].tilew,f))
-		{
-		    new_return(76);
-		}
-		if(!p_iputl(itemsbuf[i].tileh,f))
-		{
-		    new_return(77);
-		}
-		if(!p_iputl(itemsbuf[i].weapoverrideFLAGS,f))
-		{
-		    new_return(78);
-		}
-		if(!p_iputl(itemsbuf[i].weap_tilew,f))
-		{
-		    new_return(79);
+				new_return(85);
+			} 
 		}
-		if(!p_iputl(itemsbuf[i].weap_tileh,f))
+		for ( int32_t w = 0; w < 65; w++ )
 		{
-		    new_return(80);
+			if(!p_putc(itemsbuf[i].weapon_initD_label[q][w],f))
+			{
+				new_return(86);
+			} 
 		}
-		if(!p_iputl(itemsbuf[i].pickup,f))
+		for ( int32_t w = 0; w < 65; w++ )
 		{
-		    new_return(81);
+			if(!p_putc(itemsbuf[i].sprite_initD_label[q][w],f))
+			{
+				new_return(87);
+			} 
 		}
-		if(!p_iputw(itemsbuf[i].pstring,f))
+		if(!p_iputl(itemsbuf[i].sprite_initiald[q],f))
 		{
-		    new_return(82);
-		}
-		if(!p_iputw(itemsbuf[i].pickup_string_flags,f))
+			new_return(88);
+		} 
+	}
+	for ( int32_t q = 0; q < 2; q++ )
+	{
+		if(!p_putc(itemsbuf[i].sprite_initiala[q],f))
 		{
-		    new_return(83);
-		}
-		
-		for(auto q = 0; q < 2; ++q)
-		{
-			if(!p_putc(itemsbuf[i].cost_counter[q],f))
-			{
-				new_return(84);
-			}
-		}
-		
-		//InitD[] labels
-		for ( int32_t q = 0; q < 8; q++ )
-		{
-			for ( int32_t w = 0; w < 65; w++ )
-			{
-				if(!p_putc(itemsbuf[i].initD_label[q][w],f))
-				{
-					new_return(85);
-				} 
-			}
-			for ( int32_t w = 0; w < 65; w++ )
-			{
-				if(!p_putc(itemsbuf[i].weapon_initD_label[q][w],f))
-				{
-					new_return(86);
-				} 
-			}
-			for ( int32_t w = 0; w < 65; w++ )
-			{
-				if(!p_putc(itemsbuf[i].sprite_initD_label[q][w],f))
-				{
-					new_return(87);
-				} 
-			}
-			if(!p_iputl(itemsbuf[i].sprite_initiald[q],f))
-			{
-				new_return(88);
-			} 
-		}
-		for ( int32_t q = 0; q < 2; q++ )
-		{
-			if(!p_putc(itemsbuf[i].sprite_initiala[q],f))
-			{
-				new_return(89);
-			} 
-			
-		}
-		if(!p_iputw(itemsbuf[i].sprite_script,f))
-		{
-			new_return(90);
-		} 
-		if(!p_putc(itemsbuf[i].pickupflag,f))
-		{
-			new_return(91);
+			new_return(89);
 		} 
 		
-	    
-        }
-        
-        if(writecycle==0)
-        {
-            section_size=writesize;
-        }
+	}
+	if(!p_iputw(itemsbuf[i].sprite_script,f))
+	{
+		new_return(90);
+	} 
+	if(!p_putc(itemsbuf[i].pickupflag,f))
+	{
+		new_return(91);
+	} 
+	
+    
     }
     
-    if(writesize!=int32_t(section_size) && save_warn)
+    //section size, then the buffered section data
+    if(!section.commit())
     {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writeitems()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+        new_return(4);
     }
     
     new_return(0);
@@ -8799,7 +8664,6 @@ int32_t writeweapons(PACKFILE *f, zquestheader *Header)
     dword section_id=ID_WEAPONS;
     dword section_version=V_WEAPONS;
     dword section_cversion=CV_WEAPONS;
-    dword section_size = 0;
     
     //section id
     if(!p_mputl(section_id,f))
@@ -8818,86 +8682,69 @@ int32_t writeweapons(PACKFILE *f, zquestheader *Header)
         new_return(3);
     }
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    section_writer section(f);
+    
+    //finally...  section data
+    if(!p_iputw(wMAX,f))
     {
-        fake_pack_writing=(writecycle==0);
-        
-        //section size
-        if(!p_iputl(section_size,f))
+        new_return(5);
+    }
+    
+    for(int32_t i=0; i<wMAX; i++)
+    {
+        if(!pfwrite((char *)weapon_string[i], 64, f))
+        {
+            new_return(5);
+        }
+    }
+    
+    for(int32_t i=0; i<wMAX; i++)
+    {
+        if(!p_iputw(wpnsbuf[i].tile,f))
         {
-            new_return(4);
+            new_return(6);
         }
         
-        writesize=0;
+        if(!p_putc(wpnsbuf[i].misc,f))
+        {
+            new_return(7);
+        }
         
-        //finally...  section data
-        if(!p_iputw(wMAX,f))
+        if(!p_putc(wpnsbuf[i].csets,f))
         {
-            new_return(5);
+            new_return(8);
         }
         
-        for(int32_t i=0; i<wMAX; i++)
+        if(!p_putc(wpnsbuf[i].frames,f))
         {
-            if(!pfwrite((char *)weapon_string[i], 64, f))
-            {
-                new_return(5);
-            }
+            new_return(9);
         }
         
-        for(int32_t i=0; i<wMAX; i++)
+        if(!p_putc(wpnsbuf[i].speed,f))
         {
-            if(!p_iputw(wpnsbuf[i].tile,f))
-            {
-                new_return(6);
-            }
-            
-            if(!p_putc(wpnsbuf[i].misc,f))
-            {
-                new_return(7);
-            }
-            
-            if(!p_putc(wpnsbuf[i].csets,f))
-            {
-                new_return(8);
-            }
-            
-            if(!p_putc(wpnsbuf[i].frames,f))
-            {
-                new_return(9);
-            }
-            
-            if(!p_putc(wpnsbuf[i].speed,f))
-            {
-                new_return(10);
-            }
-            
-            if(!p_putc(wpnsbuf[i].type,f))
-            {
-                new_return(11);
-            }
-	    
-	    if(!p_iputw(wpnsbuf[i].script,f))
-            {
-                new_return(12);
-            }
-	    
-	    if(!p_iputl(wpnsbuf[i].newtile,f))
-            {
-                new_return(12);
-            }
+            new_return(10);
         }
         
-        if(writecycle==0)
+        if(!p_putc(wpnsbuf[i].type,f))
+        {
+            new_return(11);
+        }
+    
+    if(!p_iputw(wpnsbuf[i].script,f))
+        {
+            new_return(12);
+        }
+    
+    if(!p_iputl(wpnsbuf[i].newtile,f))
         {
-            section_size=writesize;
+            new_return(12);
         }
     }
     
-    if(writesize!=int32_t(section_size) && save_warn)
+    //section size, then the buffered section data
+    if(!section.commit())
     {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writeweapons()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+        new_return(4);
     }
     
     new_return(0);
@@ -8910,7 +8757,8 @@ int32_t writemapscreen(PACKFILE *f, int32_t i, int32_t j)
         return qe_invalid;
     }
     
-    mapscr& screen=TheMaps.at(i*MAPSCRS+j);
+    //const, so saving doesn't allocate storage for empty screens
+    mapscr const& screen=TheMaps.at(i*MAPSCRS+j);
     
     if(!p_putc(screen.valid,f))
     {
@@ -9518,7 +9366,6 @@ int32_t writemaps(PACKFILE *f, zquestheader *)
     dword section_id=ID_MAPS;
     dword section_version=V_MAPS;
     dword section_cversion=CV_MAPS;
-    dword section_size = 0;
     
     //section id
     if(!p_mputl(section_id,f))
@@ -9537,41 +9384,24 @@ int32_t writemaps(PACKFILE *f, zquestheader *)
         new_return(3);
     }
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    section_writer section(f);
+    
+    //finally...  section data
+    if(!p_iputw(map_count,f))
     {
-        fake_pack_writing=(writecycle==0);
-        
-        //section size
-        if(!p_iputl(section_size,f))
-        {
-            new_return(4);
-        }
-        
-        writesize=0;
-        
-        //finally...  section data
-        if(!p_iputw(map_count,f))
-        {
-            new_return(5);
-        }
-        
-        for(int32_t i=0; i<map_count && i<MAXMAPS2; i++)
-        {
-            for(int32_t j=0; j<MAPSCRS; j++)
-                writemapscreen(f,i,j);
-        }
-        
-        if(writecycle==0)
-        {
-            section_size=writesize;
-        }
+        new_return(5);
+    }
+    
+    for(int32_t i=0; i<map_count && i<MAXMAPS2; i++)
+    {
+        for(int32_t j=0; j<MAPSCRS; j++)
+            writemapscreen(f,i,j);
     }
     
-    if(writesize!=int32_t(section_size) && save_warn)
+    //section size, then the buffered section data
+    if(!section.commit())
     {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writemaps()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+        new_return(4);
     }
     
     new_return(0);
@@ -9587,11 +9417,9 @@ int32_t writecombos(PACKFILE *f, word version, word build, word start_combo, wor
     dword section_id=ID_COMBOS;
     dword section_version=V_COMBOS;
     dword section_cversion=CV_COMBOS;
-    //  dword section_size=0;
     combos_used = count_combos()-start_combo;
     combos_used = zc_min(combos_used, max_combos);
     combos_used = zc_min(combos_used, MAXCOMBOS);
-    dword section_size = 0;
     
     //section id
     if(!p_mputl(section_id,f))
@@ -9610,196 +9438,179 @@ int32_t writecombos(PACKFILE *f, word version, word build, word start_combo, wor
         new_return(3);
     }
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    section_writer section(f);
+    
+    //finally...  section data
+    combos_used=count_combos()-start_combo;
+    combos_used=zc_min(combos_used, max_combos);
+    combos_used=zc_min(combos_used, MAXCOMBOS);
+    
+    if(!p_iputw(combos_used,f))
+    {
+        new_return(5);
+    }
+    
+    for(int32_t i=start_combo; i<start_combo+combos_used; i++)
     {
-        fake_pack_writing=(writecycle==0);
+        if(!p_iputl(combobuf[i].tile,f))
+        {
+            new_return(6);
+        }
         
-        //section size
-        if(!p_iputl(section_size,f))
+        if(!p_putc(combobuf[i].flip,f))
         {
-            new_return(4);
+            new_return(7);
         }
         
-        writesize=0;
+        if(!p_putc(combobuf[i].walk,f))
+        {
+            new_return(8);
+        }
         
-        //finally...  section data
-        combos_used=count_combos()-start_combo;
-        combos_used=zc_min(combos_used, max_combos);
-        combos_used=zc_min(combos_used, MAXCOMBOS);
+        if(!p_putc(combobuf[i].type,f))
+        {
+            new_return(9);
+        }
         
-        if(!p_iputw(combos_used,f))
+        if(!p_putc(combobuf[i].csets,f))
         {
-            new_return(5);
+            new_return(10);
         }
         
-        for(int32_t i=start_combo; i<start_combo+combos_used; i++)
+        if(!p_putc(combobuf[i].frames,f))
         {
-            if(!p_iputl(combobuf[i].tile,f))
-            {
-                new_return(6);
-            }
-            
-            if(!p_putc(combobuf[i].flip,f))
-            {
-                new_return(7);
-            }
-            
-            if(!p_putc(combobuf[i].walk,f))
-            {
-                new_return(8);
-            }
-            
-            if(!p_putc(combobuf[i].type,f))
-            {
-                new_return(9);
-            }
-            
-            if(!p_putc(combobuf[i].csets,f))
-            {
-                new_return(10);
-            }
-            
-            if(!p_putc(combobuf[i].frames,f))
-            {
-                new_return(11);
-            }
-            
-            if(!p_putc(combobuf[i].speed,f))
-            {
-                new_return(12);
-            }
-            
-            if(!p_iputw(combobuf[i].nextcombo,f))
-            {
-                new_return(13);
-            }
-            
-            if(!p_putc(combobuf[i].nextcset,f))
-            {
-                new_return(14);
-            }
-            
-            if(!p_putc(combobuf[i].flag,f))
-            {
-                new_return(15);
-            }
-            
-            if(!p_putc(combobuf[i].skipanim,f))
-            {
-                new_return(16);
-            }
-            
-            if(!p_iputw(combobuf[i].nexttimer,f))
-            {
-                new_return(17);
-            }
-            
-            if(!p_putc(combobuf[i].skipanimy,f))
-            {
-                new_return(18);
-            }
-            
-            if(!p_putc(combobuf[i].animflags,f))
-            {
-                new_return(19);
-            }
-			
-			for ( int32_t q = 0; q < NUM_COMBO_ATTRIBUTES; q++ )
-			{
-				if(!p_iputl(combobuf[i].attributes[q],f))
-				{
-					new_return(20);
-				}
-			}
-			if(!p_iputl(combobuf[i].usrflags,f))
-			{
-				new_return(21);
-			}	 
-			if(!p_iputw(combobuf[i].genflags,f))
-			{
-				new_return(33);
-			}	 
-			for ( int32_t q = 0; q < 3; q++ ) 
-			{
-				if(!p_iputl(combobuf[i].triggerflags[q],f))
-				{
-					new_return(22);
-				}
-			}
-		   
-			if(!p_iputl(combobuf[i].triggerlevel,f))
-			{
-				new_return(23);
-			}	
-			if(!p_putc(combobuf[i].triggerbtn,f))
-			{
-				new_return(34);
-			}	
-			for ( int32_t q = 0; q < 11; q++ ) 
-			{
-				if(!p_putc(combobuf[i].label[q],f))
-				{
-					new_return(24);
-				}
-			}
-			for ( int32_t q = 0; q < 4; q++ ) //attribytes were sized 4 in this version, I bumped them up.
-			{
-				if(!p_putc(combobuf[i].attribytes[q],f))
-				{
-					new_return(25);
-				}
-			}
-			if(!p_iputw(combobuf[i].script,f))
-			{
-				new_return(26);
-			}
-			for ( int32_t q = 0; q < 2; q++ )
-			{
-				if(!p_iputl(combobuf[i].initd[q],f))
-				{
-					new_return(27);
-				}
-			}
-			if(!p_iputl(combobuf[i].o_tile,f))
-			{
-				new_return(28);
-			}
-			if(!p_putc(combobuf[i].cur_frame,f))
-			{
-				new_return(29);
-			}
-			if(!p_putc(combobuf[i].aclk,f))
-			{
-				new_return(30);
-			}
-			for ( int32_t q = 4; q < 8; q++ ) //I bumped up attribytes -Dimi
-			{
-				if(!p_putc(combobuf[i].attribytes[q],f))
-				{
-					new_return(31);
-				}
-			}
-			for ( int32_t q = 0; q < 8; q++ ) //I also added attrishorts -Dimi
-			{
-				if(!p_iputw(combobuf[i].attrishorts[q],f))
-				{
-					new_return(32);
-				}
-			}
+            new_return(11);
         }
         
-        if(writecycle==0)
+        if(!p_putc(combobuf[i].speed,f))
         {
-            section_size=writesize;
+            new_return(12);
         }
-    }
-    
-    if(writesize!=int32_t(section_size) && save_warn)
-    {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writecombos()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
-    }
+        
+        if(!p_iputw(combobuf[i].nextcombo,f))
+        {
+            new_return(13);
+        }
+        
+        if(!p_putc(combobuf[i].nextcset,f))
+        {
+            new_return(14);
+        }
+        
+        if(!p_putc(combobuf[i].flag,f))
+        {
+            new_return(15);
+        }
+        
+        if(!p_putc(combobuf[i].skipanim,f))
+        {
+            new_return(16);
+        }
+        
+        if(!p_iputw(combobuf[i].nexttimer,f))
+        {
+            new_return(17);
+        }
+        
+        if(!p_putc(combobuf[i].skipanimy,f))
+        {
+            new_return(18);
+        }
+        
+        if(!p_putc(combobuf[i].animflags,f))
+        {
+            new_return(19);
+        }
+		
+		for ( int32_t q = 0; q < NUM_COMBO_ATTRIBUTES; q++ )
+		{
+			if(!p_iputl(combobuf[i].attributes[q],f))
+			{
+				new_return(20);
+			}
+		}
+		if(!p_iputl(combobuf[i].usrflags,f))
+		{
+			new_return(21);
+		}	 
+		if(!p_iputw(combobuf[i].genflags,f))
+		{
+			new_return(33);
+		}	 
+		for ( int32_t q = 0; q < 3; q++ ) 
+		{
+			if(!p_iputl(combobuf[i].triggerflags[q],f))
+			{
+				new_return(22);
+			}
+		}
+	   
+		if(!p_iputl(combobuf[i].triggerlevel,f))
+		{
+			new_return(23);
+		}	
+		if(!p_putc(combobuf[i].triggerbtn,f))
+		{
+			new_return(34);
+		}	
+		for ( int32_t q = 0; q < 11; q++ ) 
+		{
+			if(!p_putc(combobuf[i].label[q],f))
+			{
+				new_return(24);
+			}
+		}
+		for ( int32_t q = 0; q < 4; q++ ) //attribytes were sized 4 in this version, I bumped them up.
+		{
+			if(!p_putc(combobuf[i].attribytes[q],f))
+			{
+				new_return(25);
+			}
+		}
+		if(!p_iputw(combobuf[i].script,f))
+		{
+			new_return(26);
+		}
+		for ( int32_t q = 0; q < 2; q++ )
+		{
+			if(!p_iputl(combobuf[i].initd[q],f))
+			{
+				new_return(27);
+			}
+		}
+		if(!p_iputl(combobuf[i].o_tile,f))
+		{
+			new_return(28);
+		}
+		if(!p_putc(combobuf[i].cur_frame,f))
+		{
+			new_return(29);
+		}
+		if(!p_putc(combobuf[i].aclk,f))
+		{
+			new_return(30);
+		}
+		for ( int32_t q = 4; q < 8; q++ ) //I bumped up attribytes -Dimi
+		{
+			if(!p_putc(combobuf[i].attribytes[q],f))
+			{
+				new_return(31);
+			}
+		}
+		for ( int32_t q = 0; q < 8; q++ ) //I also added attrishorts -Dimi
+		{
+			if(!p_iputw(combobuf[i].attrishorts[q],f))
+			{
+				new_return(32);
+			}
+		}
+    }
+    
+    //section size, then the buffered section data
+    if(!section.commit())
+    {
+        new_return(4);
+    }
     
     new_return(0);
 }
@@ -9813,7 +9624,6 @@ int32_t writecomboaliases(PACKFILE *f, word version, word build)
     dword section_id=ID_COMBOALIASES;
     dword section_version=V_COMBOALIASES;
     dword section_cversion=CV_COMBOALIASES;
-    dword section_size=0;
     
     //section id
     if(!p_mputl(section_id,f))
@@ -9832,77 +9642,59 @@ int32_t writecomboaliases(PACKFILE *f, word version, word build)
         new_return(3);
     }
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    section_writer section(f);
+    
+    //finally...  section data
+    for(int32_t j=0; j<MAXCOMBOALIASES; j++)
     {
-        fake_pack_writing=(writecycle==0);
+        if(!p_iputw(combo_aliases[j].combo,f))
+        {
+            new_return(5);
+        }
         
-        //section size
-        if(!p_iputl(section_size,f))
+        if(!p_putc(combo_aliases[j].cset,f))
         {
-            new_return(4);
+            new_return(6);
         }
         
-        writesize=0;
+        int32_t count = ((combo_aliases[j].width+1)*(combo_aliases[j].height+1))*(comboa_lmasktotal(combo_aliases[j].layermask)+1);
         
-        //finally...  section data
-        for(int32_t j=0; j<MAXCOMBOALIASES; j++)
+        if(!p_putc(combo_aliases[j].width,f))
         {
-            if(!p_iputw(combo_aliases[j].combo,f))
-            {
-                new_return(5);
-            }
-            
-            if(!p_putc(combo_aliases[j].cset,f))
-            {
-                new_return(6);
-            }
-            
-            int32_t count = ((combo_aliases[j].width+1)*(combo_aliases[j].height+1))*(comboa_lmasktotal(combo_aliases[j].layermask)+1);
-            
-            if(!p_putc(combo_aliases[j].width,f))
-            {
-                new_return(7);
-            }
-            
-            if(!p_putc(combo_aliases[j].height,f))
-            {
-                new_return(8);
-            }
-            
-            if(!p_putc(combo_aliases[j].layermask,f))
-            {
-                new_return(9);
-            }
-            
-            for(int32_t k=0; k<count; k++)
-            {
-                if(!p_iputw(combo_aliases[j].combos[k],f))
-                {
-                    new_return(10);
-                }
-            }
-            
-            for(int32_t k=0; k<count; k++)
+            new_return(7);
+        }
+        
+        if(!p_putc(combo_aliases[j].height,f))
+        {
+            new_return(8);
+        }
+        
+        if(!p_putc(combo_aliases[j].layermask,f))
+        {
+            new_return(9);
+        }
+        
+        for(int32_t k=0; k<count; k++)
+        {
+            if(!p_iputw(combo_aliases[j].combos[k],f))
             {
-                if(!p_putc(combo_aliases[j].csets[k],f))
-                {
-                    new_return(11);
-                }
+                new_return(10);
             }
         }
         
-        if(writecycle==0)
+        for(int32_t k=0; k<count; k++)
         {
-            section_size=writesize;
+            if(!p_putc(combo_aliases[j].csets[k],f))
+            {
+                new_return(11);
+            }
         }
     }
     
-    
-    if(writesize!=int32_t(section_size) && save_warn)
+    //section size, then the buffered section data
+    if(!section.commit())
     {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writecomboaliases()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+        new_return(4);
     }
     
     new_return(0);
@@ -9921,7 +9713,6 @@ int32_t writecolordata(PACKFILE *f, miscQdata *Misc, word version, word build, w
     dword section_cversion=CV_CSETS;
     int32_t palcycles = count_palcycles(Misc);
 // int32_t palcyccount = count_palcycles(Misc);
-    dword section_size = 0;
     
     //section id
     
@@ -9941,72 +9732,55 @@ int32_t writecolordata(PACKFILE *f, miscQdata *Misc, word version, word build, w
         new_return(3);
     }
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    section_writer section(f);
+    
+    //finally...  section data
+    if(!pfwrite(colordata,psTOTAL255,f))
     {
-        fake_pack_writing=(writecycle==0);
-        
-        //section size
-        if(!p_iputl(section_size,f))
-        {
-            new_return(4);
-        }
-        
-        writesize=0;
-        
-        //finally...  section data
-        if(!pfwrite(colordata,psTOTAL255,f))
-        {
-            new_return(5);
-        }
-        
-        if(!pfwrite(palnames,MAXLEVELS*PALNAMESIZE,f))
-        {
-            new_return(6);
-        }
-        
-        if(!p_iputw(palcycles,f))
+        new_return(5);
+    }
+    
+    if(!pfwrite(palnames,MAXLEVELS*PALNAMESIZE,f))
+    {
+        new_return(6);
+    }
+    
+    if(!p_iputw(palcycles,f))
+    {
+        new_return(15);
+    }
+    
+    for(int32_t i=0; i<palcycles; i++)
+    {
+        for(int32_t j=0; j<3; j++)
         {
-            new_return(15);
+            if(!p_putc(Misc->cycles[i][j].first,f))
+            {
+                new_return(16);
+            }
         }
         
-        for(int32_t i=0; i<palcycles; i++)
+        for(int32_t j=0; j<3; j++)
         {
-            for(int32_t j=0; j<3; j++)
-            {
-                if(!p_putc(Misc->cycles[i][j].first,f))
-                {
-                    new_return(16);
-                }
-            }
-            
-            for(int32_t j=0; j<3; j++)
-            {
-                if(!p_putc(Misc->cycles[i][j].count,f))
-                {
-                    new_return(17);
-                }
-            }
-            
-            for(int32_t j=0; j<3; j++)
+            if(!p_putc(Misc->cycles[i][j].count,f))
             {
-                if(!p_putc(Misc->cycles[i][j].speed,f))
-                {
-                    new_return(18);
-                }
+                new_return(17);
             }
         }
         
-        if(writecycle==0)
+        for(int32_t j=0; j<3; j++)
         {
-            section_size=writesize;
+            if(!p_putc(Misc->cycles[i][j].speed,f))
+            {
+                new_return(18);
+            }
         }
     }
     
-    if(writesize!=int32_t(section_size) && save_warn)
+    //section size, then the buffered section data
+    if(!section.commit())
     {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writecolordata()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+        new_return(4);
     }
     
     new_return(0);
@@ -10023,7 +9797,6 @@ int32_t writestrings(PACKFILE *f, word version, word build, word start_msgstr, w
     dword section_id=ID_STRINGS;
     dword section_version=V_STRINGS;
     dword section_cversion=CV_STRINGS;
-    dword section_size = 0;
     
     //section id
     if(!p_mputl(section_id,f))
@@ -10042,172 +9815,155 @@ int32_t writestrings(PACKFILE *f, word version, word build, word start_msgstr, w
         new_return(3);
     }
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    section_writer section(f);
+    
+    //finally...  section data
+    if(!p_iputw(msg_count,f))
+    {
+        return qe_invalid;
+    }
+    
+    for(int32_t i=0; i<msg_count; i++)
     {
-        fake_pack_writing=(writecycle==0);
+		int32_t sz = MsgStrings[i].s.size();
+		if(sz > 8192) sz = 8192;
+		if(!p_iputl(sz, f))
+		{
+			return qe_invalid;
+		}
+		
+        char const* tmpstr = MsgStrings[i].s.c_str();
+        if (sz > 0)
+        {
+            if (!pfwrite((void*)tmpstr,sz, f))
+            {
+                return qe_invalid;
+            }
+        }
+        
+        if(!p_iputw(MsgStrings[i].nextstring,f))
+        {
+            return qe_invalid;
+        }
+        
+        if(!p_iputl(MsgStrings[i].tile,f))
+        {
+            return qe_invalid;
+        }
+        
+        if(!p_putc(MsgStrings[i].cset,f))
+        {
+            return qe_invalid;
+        }
+        
+        if(!p_putc(MsgStrings[i].trans?1:0,f))
+        {
+            return qe_invalid;
+        }
+        
+        if(!p_putc(MsgStrings[i].font,f))
+        {
+            return qe_invalid;
+        }
+        
+        if(!p_iputw(MsgStrings[i].x,f))
+        {
+            return qe_invalid;
+        }
+        
+        if(!p_iputw(MsgStrings[i].y,f))
+        {
+            return qe_invalid;
+        }
+        
+        if(!p_iputw(MsgStrings[i].w,f))
+        {
+            return qe_invalid;
+        }
         
-        //section size
-        if(!p_iputl(section_size,f))
+        if(!p_iputw(MsgStrings[i].h,f))
         {
-            new_return(4);
+            return qe_invalid;
         }
         
-        writesize=0;
+        if(!p_putc(MsgStrings[i].hspace,f))
+        {
+            return qe_invalid;
+        }
         
-        //finally...  section data
-        if(!p_iputw(msg_count,f))
+        if(!p_putc(MsgStrings[i].vspace,f))
         {
             return qe_invalid;
         }
         
-        for(int32_t i=0; i<msg_count; i++)
+        if(!p_putc(MsgStrings[i].stringflags,f))
         {
-			int32_t sz = MsgStrings[i].s.size();
-			if(sz > 8192) sz = 8192;
-			if(!p_iputl(sz, f))
+            return qe_invalid;
+        }
+		
+		for(int32_t q = 0; q < 4; ++q)
+		{
+			if(!p_putc(MsgStrings[i].margins[q],f))
 			{
 				return qe_invalid;
 			}
-			
-            char const* tmpstr = MsgStrings[i].s.c_str();
-            if (sz > 0)
-            {
-                if (!pfwrite((void*)tmpstr,sz, f))
-                {
-                    return qe_invalid;
-                }
-            }
-            
-            if(!p_iputw(MsgStrings[i].nextstring,f))
-            {
-                return qe_invalid;
-            }
-            
-            if(!p_iputl(MsgStrings[i].tile,f))
-            {
-                return qe_invalid;
-            }
-            
-            if(!p_putc(MsgStrings[i].cset,f))
-            {
-                return qe_invalid;
-            }
-            
-            if(!p_putc(MsgStrings[i].trans?1:0,f))
-            {
-                return qe_invalid;
-            }
-            
-            if(!p_putc(MsgStrings[i].font,f))
-            {
-                return qe_invalid;
-            }
-            
-            if(!p_iputw(MsgStrings[i].x,f))
-            {
-                return qe_invalid;
-            }
-            
-            if(!p_iputw(MsgStrings[i].y,f))
-            {
-                return qe_invalid;
-            }
-            
-            if(!p_iputw(MsgStrings[i].w,f))
-            {
-                return qe_invalid;
-            }
-            
-            if(!p_iputw(MsgStrings[i].h,f))
-            {
-                return qe_invalid;
-            }
-            
-            if(!p_putc(MsgStrings[i].hspace,f))
-            {
-                return qe_invalid;
-            }
-            
-            if(!p_putc(MsgStrings[i].vspace,f))
-            {
-                return qe_invalid;
-            }
-            
-            if(!p_putc(MsgStrings[i].stringflags,f))
-            {
-                return qe_invalid;
-            }
-			
-			for(int32_t q = 0; q < 4; ++q)
-			{
-				if(!p_putc(MsgStrings[i].margins[q],f))
-				{
-					return qe_invalid;
-				}
-			}
-			
-			if(!p_iputl(MsgStrings[i].portrait_tile,f))
-			{
-				return qe_invalid;
-			}
-			
-			if(!p_putc(MsgStrings[i].portrait_cset,f))
-			{
-				return qe_invalid;
-			}
-			
-			if(!p_putc(MsgStrings[i].portrait_x,f))
-			{
-				return qe_invalid;
-			}
-			
-			if(!p_putc(MsgStrings[i].portrait_y,f))
-			{
-				return qe_invalid;
-			}
-			
-			if(!p_putc(MsgStrings[i].portrait_tw,f))
-			{
-				return qe_invalid;
-			}
-			
-			if(!p_putc(MsgStrings[i].portrait_th,f))
-			{
-				return qe_invalid;
-			}
-			
-			if(!p_putc(MsgStrings[i].shadow_type,f))
-			{
-				return qe_invalid;
-			}
-			
-			if(!p_putc(MsgStrings[i].shadow_color,f))
-			{
-				return qe_invalid;
-			}
-            
-            if(!p_putc(MsgStrings[i].sfx,f))
-            {
-                return qe_invalid;
-            }
-            
-            if(!p_iputw(MsgStrings[i].listpos,f))
-            {
-                return qe_invalid;
-            }
+		}
+		
+		if(!p_iputl(MsgStrings[i].portrait_tile,f))
+		{
+			return qe_invalid;
+		}
+		
+		if(!p_putc(MsgStrings[i].portrait_cset,f))
+		{
+			return qe_invalid;
+		}
+		
+		if(!p_putc(MsgStrings[i].portrait_x,f))
+		{
+			return qe_invalid;
+		}
+		
+		if(!p_putc(MsgStrings[i].portrait_y,f))
+		{
+			return qe_invalid;
+		}
+		
+		if(!p_putc(MsgStrings[i].portrait_tw,f))
+		{
+			return qe_invalid;
+		}
+		
+		if(!p_putc(MsgStrings[i].portrait_th,f))
+		{
+			return qe_invalid;
+		}
+		
+		if(!p_putc(MsgStrings[i].shadow_type,f))
+		{
+			return qe_invalid;
+		}
+		
+		if(!p_putc(MsgStrings[i].shadow_color,f))
+		{
+			return qe_invalid;
+		}
+        
+        if(!p_putc(MsgStrings[i].sfx,f))
+        {
+            return qe_invalid;
         }
         
-        if(writecycle==0)
+        if(!p_iputw(MsgStrings[i].listpos,f))
         {
-            section_size=writesize;
+            return qe_invalid;
         }
     }
     
-    if(writesize!=int32_t(section_size) && save_warn)
+    //section size, then the buffered section data
+    if(!section.commit())
     {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writestrings()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+        new_return(4);
     }
     
     new_return(0);
@@ -10229,41 +9985,37 @@ int32_t writestrings_text(PACKFILE *f)
         }
     }
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    char ebuf[32];
+    
+    sprintf(ebuf,"Total strings: %d\n", msg_count-1);
+    
+    if(!pfwrite(&ebuf,(int32_t)strlen(ebuf),f))
     {
-        fake_pack_writing=(writecycle==0);
-        char ebuf[32];
-        
-        sprintf(ebuf,"Total strings: %d\n", msg_count-1);
+        return qe_invalid;
+    }
+    
+    for(int32_t i=1; i<msg_count; i++)
+    {
+        int32_t str = msglistcache[i-1];
         
+        if(!str)
+            continue;
+            
+        if(MsgStrings[str].nextstring != 0)
+            sprintf(ebuf,"\n\n___%d(->%d)___\n", str,MsgStrings[str].nextstring);
+        else
+            sprintf(ebuf,"\n\n___%d___\n", str);
+            
         if(!pfwrite(&ebuf,(int32_t)strlen(ebuf),f))
         {
             return qe_invalid;
         }
         
-        for(int32_t i=1; i<msg_count; i++)
+        encode_msg_str(str);
+        
+        if(!pfwrite(&msgbuf,(int32_t)strlen(msgbuf),f))
         {
-            int32_t str = msglistcache[i-1];
-            
-            if(!str)
-                continue;
-                
-            if(MsgStrings[str].nextstring != 0)
-                sprintf(ebuf,"\n\n___%d(->%d)___\n", str,MsgStrings[str].nextstring);
-            else
-                sprintf(ebuf,"\n\n___%d___\n", str);
-                
-            if(!pfwrite(&ebuf,(int32_t)strlen(ebuf),f))
-            {
-                return qe_invalid;
-            }
-            
-            encode_msg_str(str);
-            
-            if(!pfwrite(&msgbuf,(int32_t)strlen(msgbuf),f))
-            {
-                return qe_invalid;
-            }
+            return qe_invalid;
         }
     }
     
@@ -10286,7 +10038,6 @@ int32_t writetiles(PACKFILE *f, word version, word build, int32_t start_tile, in
     tiles_used = zc_min(tiles_used, max_tiles);
     tiles_used = zc_min(tiles_used, NEWMAXTILES);
 	al_trace("writetiles counted %dtiles used.\n",tiles_used); 
-    dword section_size = 0;
     
     //section id
     if(!p_mputl(section_id,f))
@@ -10305,64 +10056,43 @@ int32_t writetiles(PACKFILE *f, word version, word build, int32_t start_tile, in
         new_return(3);
     }
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    section_writer section(f);
+    
+    //finally...  section data
+    if(!p_iputl(tiles_used,f))
+    {
+        new_return(5);
+    }
+    
+    for(int32_t i=0; i<tiles_used; ++i)
+    //for(int32_t i=0; i<NEWMAXTILES; ++i)
     {
-        fake_pack_writing=(writecycle==0);
-        
-        //section size
-        if(!p_iputl(section_size,f))
+        if(!p_putc(newtilebuf[start_tile+i].format,f))
         {
-            new_return(4);
+            new_return(6);
         }
         
-        writesize=0;
-        
-        //finally...  section data
-        tiles_used=count_tiles(newtilebuf)-start_tile;
-        tiles_used=zc_min(tiles_used, max_tiles);
-        tiles_used=zc_min(tiles_used, NEWMAXTILES);
-        
-        if(!p_iputl(tiles_used,f))
+        if(!pfwrite(newtilebuf[start_tile+i].data,tilesize(newtilebuf[start_tile+i].format),f))
         {
-            new_return(5);
+            new_return(7);
         }
-        
-        for(int32_t i=0; i<tiles_used; ++i)
-        //for(int32_t i=0; i<NEWMAXTILES; ++i)
+    /*
+        if(!p_putc(newtilebuf[start_tile+i].format,f))
         {
-            if(!p_putc(newtilebuf[start_tile+i].format,f))
-            {
-                new_return(6);
-            }
-            
-            if(!pfwrite(newtilebuf[start_tile+i].data,tilesize(newtilebuf[start_tile+i].format),f))
-            {
-                new_return(7);
-            }
-	    /*
-            if(!p_putc(newtilebuf[start_tile+i].format,f))
-            {
-                new_return(6);
-            }
-            
-            if(!pfwrite(newtilebuf[start_tile+i].data,tilesize(newtilebuf[start_tile+i].format),f))
-            {
-                new_return(7);
-            }
-	    */
+            new_return(6);
         }
         
-        if(writecycle==0)
+        if(!pfwrite(newtilebuf[start_tile+i].data,tilesize(newtilebuf[start_tile+i].format),f))
         {
-            section_size=writesize;
+            new_return(7);
         }
+    */
     }
     
-    if(writesize!=int32_t(section_size) && save_warn)
+    //section size, then the buffered section data
+    if(!section.commit())
     {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writetiles()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+        new_return(4);
     }
     
     new_return(0);
@@ -10392,7 +10122,6 @@ int32_t writemidis(PACKFILE *f)
     dword section_id=ID_MIDIS;
     dword section_version=V_MIDIS;
     dword section_cversion=CV_MIDIS;
-    dword section_size = 0;
     
     //section id
     if(!p_mputl(section_id,f))
@@ -10411,164 +10140,129 @@ int32_t writemidis(PACKFILE *f)
         new_return(3);
     }
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
-    {
-        fake_pack_writing=(writecycle==0);
-        
-        //section size
-        if(!p_iputl(section_size,f))
-        {
-            new_return(4);
-        }
-        
-        writesize=0;
-        
-        //finally...  section data
-        if(!pfwrite(midi_flags,sizeof(midi_flags),f))
-        {
-            new_return(5);
-        }
-        
-        for(int32_t i=0; i<MAXCUSTOMMIDIS; i++)
-        {
-            if(get_bit(midi_flags,i))
-            {
-                if(!pfwrite(&customtunes[i].title,sizeof(customtunes[0].title),f))
-                {
-                    new_return(6);
-                }
-                
-                if(!p_iputl(customtunes[i].start,f))
-                {
-                    new_return(7);
-                }
-                
-                if(!p_iputl(customtunes[i].loop_start,f))
-                {
-                    new_return(8);
-                }
-                
-                if(!p_iputl(customtunes[i].loop_end,f))
-                {
-                    new_return(9);
-                }
-                
-                if(!p_iputw(customtunes[i].loop,f))
-                {
-                    new_return(10);
-                }
-                
-                if(!p_iputw(customtunes[i].volume,f))
-                {
-                    new_return(11);
-                }
-                
-                if(!pfwrite(&customtunes[i].flags, sizeof(customtunes[i].flags),f))
-                {
-                    new_return(12);
-                }
-                
-                if(!pfwrite(&customtunes[i].format, sizeof(customtunes[i].format),f))
-                {
-                    new_return(13);
-                }
-                
-                switch(customtunes[i].format)
-                {
-                case MFORMAT_MIDI:
-                    if(!write_midi((MIDI*) customtunes[i].data,f)) new_return(14);
-                    
-                    break;
-                    
-                default:
-                    new_return(15);
-                    break;
-                }
-            }
-        }
-        
-        if(writecycle==0)
-        {
-            section_size=writesize;
-        }
-    }
-    
-    if(writesize!=int32_t(section_size) && save_warn)
-    {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writemidis()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
-    }
-    
-    new_return(0);
-}
-
-int32_t writecheats(PACKFILE *f, zquestheader *Header)
-{
-    dword section_id=ID_CHEATS;
-    dword section_version=V_CHEATS;
-    dword section_cversion=CV_CHEATS;
-    dword section_size = 0;
-    
-    //section id
-    if(!p_mputl(section_id,f))
-    {
-        new_return(1);
-    }
+    section_writer section(f);
     
-    //section version info
-    if(!p_iputw(section_version,f))
+    //finally...  section data
+    if(!pfwrite(midi_flags,sizeof(midi_flags),f))
     {
-        new_return(2);
+        new_return(5);
     }
     
-    if(!p_iputw(section_cversion,f))
+    for(int32_t i=0; i<MAXCUSTOMMIDIS; i++)
     {
-        new_return(3);
-    }
-    
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
-    {
-        fake_pack_writing=(writecycle==0);
-        
-        //section size
-        if(!p_iputl(section_size,f))
-        {
-            new_return(4);
-        }
-        
-        writesize=0;
-        
-        //finally...  section data
-        if(!p_putc(Header->data_flags[ZQ_CHEATS2],f))
-        {
-            new_return(5);
-        }
-        
-        if(Header->data_flags[ZQ_CHEATS2])
+        if(get_bit(midi_flags,i))
         {
-            if(!p_iputl(zcheats.flags,f))
+            if(!pfwrite(&customtunes[i].title,sizeof(customtunes[0].title),f))
             {
                 new_return(6);
             }
             
-            if(!pfwrite(&zcheats.codes, sizeof(zcheats.codes), f))
+            if(!p_iputl(customtunes[i].start,f))
             {
                 new_return(7);
             }
+            
+            if(!p_iputl(customtunes[i].loop_start,f))
+            {
+                new_return(8);
+            }
+            
+            if(!p_iputl(customtunes[i].loop_end,f))
+            {
+                new_return(9);
+            }
+            
+            if(!p_iputw(customtunes[i].loop,f))
+            {
+                new_return(10);
+            }
+            
+            if(!p_iputw(customtunes[i].volume,f))
+            {
+                new_return(11);
+            }
+            
+            if(!pfwrite(&customtunes[i].flags, sizeof(customtunes[i].flags),f))
+            {
+                new_return(12);
+            }
+            
+            if(!pfwrite(&customtunes[i].format, sizeof(customtunes[i].format),f))
+            {
+                new_return(13);
+            }
+            
+            switch(customtunes[i].format)
+            {
+            case MFORMAT_MIDI:
+                if(!write_midi((MIDI*) customtunes[i].data,f)) new_return(14);
+                
+                break;
+                
+            default:
+                new_return(15);
+                break;
+            }
+        }
+    }
+    
+    //section size, then the buffered section data
+    if(!section.commit())
+    {
+        new_return(4);
+    }
+    
+    new_return(0);
+}
+
+int32_t writecheats(PACKFILE *f, zquestheader *Header)
+{
+    dword section_id=ID_CHEATS;
+    dword section_version=V_CHEATS;
+    dword section_cversion=CV_CHEATS;
+    
+    //section id
+    if(!p_mputl(section_id,f))
+    {
+        new_return(1);
+    }
+    
+    //section version info
+    if(!p_iputw(section_version,f))
+    {
+        new_return(2);
+    }
+    
+    if(!p_iputw(section_cversion,f))
+    {
+        new_return(3);
+    }
+    
+    section_writer section(f);
+    
+    //finally...  section data
+    if(!p_putc(Header->data_flags[ZQ_CHEATS2],f))
+    {
+        new_return(5);
+    }
+    
+    if(Header->data_flags[ZQ_CHEATS2])
+    {
+        if(!p_iputl(zcheats.flags,f))
+        {
+            new_return(6);
         }
         
-        if(writecycle==0)
+        if(!pfwrite(&zcheats.codes, sizeof(zcheats.codes), f))
         {
-            section_size=writesize;
+            new_return(7);
         }
     }
     
-    if(writesize!=int32_t(section_size) && save_warn)
+    //section size, then the buffered section data
+    if(!section.commit())
     {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writecheats()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+        new_return(4);
     }
     
     new_return(0);
@@ -10582,7 +10276,6 @@ int32_t writeguys(PACKFILE *f, zquestheader *Header)
 	dword section_id=ID_GUYS;
 	dword section_version=V_GUYS;
 	dword section_cversion=CV_GUYS;
-	dword section_size=0;
 	
 	//section id
 	if(!p_mputl(section_id,f))
@@ -10601,518 +10294,501 @@ int32_t writeguys(PACKFILE *f, zquestheader *Header)
 		new_return(3);
 	}
 	
-	for(int32_t writecycle=0; writecycle<2; ++writecycle)
+	section_writer section(f);
+	
+	//finally...  section data
+	for(int32_t i=0; i<MAXGUYS; i++)
+	{
+		if(!pfwrite((char *)guy_string[i], 64, f))
+		{
+			new_return(5);
+		}
+	}
+	
+	for(int32_t i=0; i<MAXGUYS; i++)
 	{
-		fake_pack_writing=(writecycle==0);
+		if(!p_iputl(guysbuf[i].flags,f))
+		{
+			new_return(6);
+		}
+		
+		if(!p_iputl(guysbuf[i].flags2,f))
+		{
+			new_return(7);
+		}
 		
-		//section size
-		if(!p_iputl(section_size,f))
+		if(!p_iputl(guysbuf[i].tile,f))
 		{
-			new_return(4);
+			new_return(8);
 		}
 		
-		writesize=0;
+		if(!p_putc(guysbuf[i].width,f))
+		{
+			new_return(9);
+		}
 		
-		//finally...  section data
-		for(int32_t i=0; i<MAXGUYS; i++)
+		if(!p_putc(guysbuf[i].height,f))
 		{
-			if(!pfwrite((char *)guy_string[i], 64, f))
-			{
-				new_return(5);
-			}
+			new_return(10);
 		}
 		
-		for(int32_t i=0; i<MAXGUYS; i++)
+		if(!p_iputl(guysbuf[i].s_tile,f))
 		{
-			if(!p_iputl(guysbuf[i].flags,f))
-			{
-				new_return(6);
-			}
-			
-			if(!p_iputl(guysbuf[i].flags2,f))
-			{
-				new_return(7);
-			}
-			
-			if(!p_iputl(guysbuf[i].tile,f))
+			new_return(11);
+		}
+		
+		if(!p_putc(guysbuf[i].s_width,f))
+		{
+			new_return(12);
+		}
+		
+		if(!p_putc(guysbuf[i].s_height,f))
+		{
+			new_return(13);
+		}
+		
+		if(!p_iputl(guysbuf[i].e_tile,f))
+		{
+			new_return(14);
+		}
+		
+		if(!p_putc(guysbuf[i].e_width,f))
+		{
+			new_return(15);
+		}
+		
+		if(!p_putc(guysbuf[i].e_height,f))
+		{
+			new_return(16);
+		}
+		
+		if(!p_iputw(guysbuf[i].hp,f))
+		{
+			new_return(17);
+		}
+		
+		if(!p_iputw(guysbuf[i].family,f))
+		{
+			new_return(18);
+		}
+		
+		if(!p_iputw(guysbuf[i].cset,f))
+		{
+			new_return(19);
+		}
+		
+		if(!p_iputw(guysbuf[i].anim,f))
+		{
+			new_return(20);
+		}
+		
+		if(!p_iputw(guysbuf[i].e_anim,f))
+		{
+			new_return(21);
+		}
+		
+		if(!p_iputw(guysbuf[i].frate,f))
+		{
+			new_return(22);
+		}
+		
+		if(!p_iputw(guysbuf[i].e_frate,f))
+		{
+			new_return(23);
+		}
+		
+		if(!p_iputw(guysbuf[i].dp,f))
+		{
+			new_return(24);
+		}
+		
+		if(!p_iputw(guysbuf[i].wdp,f))
+		{
+			new_return(25);
+		}
+		
+		if(!p_iputw(guysbuf[i].weapon,f))
+		{
+			new_return(26);
+		}
+		
+		if(!p_iputw(guysbuf[i].rate,f))
+		{
+			new_return(27);
+		}
+		
+		if(!p_iputw(guysbuf[i].hrate,f))
+		{
+			new_return(28);
+		}
+		
+		if(!p_iputw(guysbuf[i].step,f))
+		{
+			new_return(29);
+		}
+		
+		if(!p_iputw(guysbuf[i].homing,f))
+		{
+			new_return(30);
+		}
+		
+		if(!p_iputw(guysbuf[i].grumble,f))
+		{
+			new_return(31);
+		}
+		
+		if(!p_iputw(guysbuf[i].item_set,f))
+		{
+			new_return(32);
+		}
+		
+		if(!p_iputl(guysbuf[i].misc1,f))
+		{
+			new_return(33);
+		}
+		
+		if(!p_iputl(guysbuf[i].misc2,f))
+		{
+			new_return(34);
+		}
+		
+		if(!p_iputl(guysbuf[i].misc3,f))
+		{
+			new_return(35);
+		}
+		
+		if(!p_iputl(guysbuf[i].misc4,f))
+		{
+			new_return(36);
+		}
+		
+		if(!p_iputl(guysbuf[i].misc5,f))
+		{
+			new_return(37);
+		}
+		
+		if(!p_iputl(guysbuf[i].misc6,f))
+		{
+			new_return(38);
+		}
+		
+		if(!p_iputl(guysbuf[i].misc7,f))
+		{
+			new_return(39);
+		}
+		
+		if(!p_iputl(guysbuf[i].misc8,f))
+		{
+			new_return(40);
+		}
+		
+		if(!p_iputl(guysbuf[i].misc9,f))
+		{
+			new_return(41);
+		}
+		
+		if(!p_iputl(guysbuf[i].misc10,f))
+		{
+			new_return(42);
+		}
+		
+		if(!p_iputw(guysbuf[i].bgsfx,f))
+		{
+			new_return(43);
+		}
+		
+		if(!p_iputw(guysbuf[i].bosspal,f))
+		{
+			new_return(44);
+		}
+		
+		if(!p_iputw(guysbuf[i].extend,f))
+		{
+			new_return(45);
+		}
+		
+		for(int32_t j=0; j < edefLAST; j++)
+		{
+			if(!p_putc(guysbuf[i].defense[j],f))
 			{
-				new_return(8);
+				new_return(46);
 			}
-			
-			if(!p_putc(guysbuf[i].width,f))
-			{
-				new_return(9);
-			}
-			
-			if(!p_putc(guysbuf[i].height,f))
-			{
-				new_return(10);
-			}
-			
-			if(!p_iputl(guysbuf[i].s_tile,f))
-			{
-				new_return(11);
-			}
-			
-			if(!p_putc(guysbuf[i].s_width,f))
-			{
-				new_return(12);
-			}
-			
-			if(!p_putc(guysbuf[i].s_height,f))
-			{
-				new_return(13);
-			}
-			
-			if(!p_iputl(guysbuf[i].e_tile,f))
-			{
-				new_return(14);
-			}
-			
-			if(!p_putc(guysbuf[i].e_width,f))
-			{
-				new_return(15);
-			}
-			
-			if(!p_putc(guysbuf[i].e_height,f))
-			{
-				new_return(16);
-			}
-			
-			if(!p_iputw(guysbuf[i].hp,f))
-			{
-				new_return(17);
-			}
-			
-			if(!p_iputw(guysbuf[i].family,f))
-			{
-				new_return(18);
-			}
-			
-			if(!p_iputw(guysbuf[i].cset,f))
-			{
-				new_return(19);
-			}
-			
-			if(!p_iputw(guysbuf[i].anim,f))
-			{
-				new_return(20);
-			}
-			
-			if(!p_iputw(guysbuf[i].e_anim,f))
-			{
-				new_return(21);
-			}
-			
-			if(!p_iputw(guysbuf[i].frate,f))
-			{
-				new_return(22);
-			}
-			
-			if(!p_iputw(guysbuf[i].e_frate,f))
-			{
-				new_return(23);
-			}
-			
-			if(!p_iputw(guysbuf[i].dp,f))
-			{
-				new_return(24);
-			}
-			
-			if(!p_iputw(guysbuf[i].wdp,f))
-			{
-				new_return(25);
-			}
-			
-			if(!p_iputw(guysbuf[i].weapon,f))
-			{
-				new_return(26);
-			}
-			
-			if(!p_iputw(guysbuf[i].rate,f))
-			{
-				new_return(27);
-			}
-			
-			if(!p_iputw(guysbuf[i].hrate,f))
-			{
-				new_return(28);
-			}
-			
-			if(!p_iputw(guysbuf[i].step,f))
-			{
-				new_return(29);
-			}
-			
-			if(!p_iputw(guysbuf[i].homing,f))
-			{
-				new_return(30);
-			}
-			
-			if(!p_iputw(guysbuf[i].grumble,f))
-			{
-				new_return(31);
-			}
-			
-			if(!p_iputw(guysbuf[i].item_set,f))
-			{
-				new_return(32);
-			}
-			
-			if(!p_iputl(guysbuf[i].misc1,f))
+		}
+		
+		if ( FFCore.getQuestHeaderInfo(vZelda) < 0x250 || (( FFCore.getQuestHeaderInfo(vZelda) == 0x250 ) && FFCore.getQuestHeaderInfo(vBuild) < 32 ) )
+		{
+			//If no user-set hit sound was in place, and the quest was made in a version before 2.53.0 Gamma 2:
+			if ( guysbuf[i].hitsfx == 0 ) guysbuf[i].hitsfx = WAV_EHIT; //Fix quests using the wrong hit sound when loading this. 
+			//Force SFX_HIT here. 
+		
+		}
+	
+		if(!p_putc(guysbuf[i].hitsfx,f))
+		{
+			new_return(47);
+		}
+		
+		if(!p_putc(guysbuf[i].deadsfx,f))
+		{
+			new_return(48);
+		}
+		
+		if(!p_iputl(guysbuf[i].misc11,f))
+		{
+			new_return(49);
+		}
+		
+		if(!p_iputl(guysbuf[i].misc12,f))
+		{
+			new_return(50);
+		}
+		
+		//New 2.6 defences
+		for(int32_t j=edefLAST; j < edefLAST255; j++)
+		{
+			if(!p_putc(guysbuf[i].defense[j],f))
 			{
-				new_return(33);
+				new_return(51);
 			}
-			
-			if(!p_iputl(guysbuf[i].misc2,f))
+		}
+		
+		//tilewidth, tileheight, hitwidth, hitheight, hitzheight, hitxofs, hityofs, hitzofs
+		if(!p_iputl(guysbuf[i].txsz,f))
+		{
+			new_return(52);
+		}
+		if(!p_iputl(guysbuf[i].tysz,f))
+		{
+			new_return(53);
+		}
+		if(!p_iputl(guysbuf[i].hxsz,f))
+		{
+			new_return(54);
+		}
+		if(!p_iputl(guysbuf[i].hysz,f))
+		{
+			new_return(55);
+		}
+		if(!p_iputl(guysbuf[i].hzsz,f))
+		{
+			new_return(56);
+		}
+		// These are not fixed types, but ints, so they are safe to use here. 
+		if(!p_iputl(guysbuf[i].hxofs,f))
+		{
+			new_return(57);
+		}
+		if(!p_iputl(guysbuf[i].hyofs,f))
+		{
+			new_return(58);
+		}
+		if(!p_iputl(guysbuf[i].xofs,f))
+		{
+			new_return(59);
+		}
+		if(!p_iputl(guysbuf[i].yofs,f))
+		{
+			new_return(60);
+		}
+		if(!p_iputl(guysbuf[i].zofs,f))
+		{
+			new_return(61);
+		}
+		if(!p_iputl(guysbuf[i].wpnsprite,f))
+		{
+			new_return(62);
+		}
+		if(!p_iputl(guysbuf[i].SIZEflags,f))
+		{
+			new_return(63);
+		}
+		if(!p_iputl(guysbuf[i].frozentile,f))
+		{
+			new_return(64);
+		}
+		if(!p_iputl(guysbuf[i].frozencset,f))
+		{
+			new_return(65);
+		}
+		if(!p_iputl(guysbuf[i].frozenclock,f))
+		{
+			new_return(66);
+		}
+		
+		for ( int32_t q = 0; q < 10; q++ ) 
+		{
+			if(!p_iputw(guysbuf[i].frozenmisc[q],f))
 			{
-				new_return(34);
+				new_return(67);
 			}
-			
-			if(!p_iputl(guysbuf[i].misc3,f))
+		}
+		if(!p_iputw(guysbuf[i].firesfx,f))
+		{
+			new_return(68);
+		}
+		//misc 16->31
+		if(!p_iputl(guysbuf[i].misc16,f))
+		{
+			new_return(69);
+		}
+		if(!p_iputl(guysbuf[i].misc17,f))
+		{
+			new_return(70);
+		}
+		if(!p_iputl(guysbuf[i].misc18,f))
+		{
+			new_return(71);
+		}
+		if(!p_iputl(guysbuf[i].misc19,f))
+		{
+			new_return(72);
+		}
+		if(!p_iputl(guysbuf[i].misc20,f))
+		{
+			new_return(73);
+		}
+		if(!p_iputl(guysbuf[i].misc21,f))
+		{
+			new_return(74);
+		}
+		if(!p_iputl(guysbuf[i].misc22,f))
+		{
+			new_return(75);
+		}
+		if(!p_iputl(guysbuf[i].misc23,f))
+		{
+			new_return(76);
+		}
+		if(!p_iputl(guysbuf[i].misc24,f))
+		{
+			new_return(77);
+		}
+		if(!p_iputl(guysbuf[i].misc25,f))
+		{
+			new_return(78);
+		}
+		if(!p_iputl(guysbuf[i].misc26,f))
+		{
+			new_return(79);
+		}
+		if(!p_iputl(guysbuf[i].misc27,f))
+		{
+			new_return(80);
+		}
+		if(!p_iputl(guysbuf[i].misc28,f))
+		{
+			new_return(81);
+		}
+		if(!p_iputl(guysbuf[i].misc29,f))
+		{
+			new_return(82);
+		}
+		if(!p_iputl(guysbuf[i].misc30,f))
+		{
+			new_return(83);
+		}
+		if(!p_iputl(guysbuf[i].misc31,f))
+		{
+			new_return(84);
+		}
+		if(!p_iputl(guysbuf[i].misc32,f))
+		{
+			new_return(85);
+		}
+		for ( int32_t q = 0; q < 32; q++ )
+		{
+			if(!p_iputl(guysbuf[i].movement[q],f))
 			{
-				new_return(35);
+				new_return(86);
 			}
-			
-			if(!p_iputl(guysbuf[i].misc4,f))
+		}
+		for ( int32_t q = 0; q < 32; q++ )
+		{
+			if(!p_iputl(guysbuf[i].new_weapon[q],f))
 			{
-				new_return(36);
+				new_return(87);
 			}
-			
-			if(!p_iputl(guysbuf[i].misc5,f))
+		}
+		if(!p_iputw(guysbuf[i].script,f))
+		{
+			new_return(88);
+		}
+		for ( int32_t q = 0; q < 8; q++ )
+		{
+			if(!p_iputl(guysbuf[i].initD[q],f))
 			{
-				new_return(37);
+				new_return(89);
 			}
-			
-			if(!p_iputl(guysbuf[i].misc6,f))
+		}
+		for ( int32_t q = 0; q < 2; q++ )
+		{
+			if(!p_iputl(guysbuf[i].initA[q],f))
 			{
-				new_return(38);
+				new_return(90);
 			}
-			
-			if(!p_iputl(guysbuf[i].misc7,f))
+		}
+		if(!p_iputl(guysbuf[i].editorflags,f))
+		{
+			new_return(91);
+		}
+		//somehow forgot these in the older builds -Z
+		if(!p_iputl(guysbuf[i].misc13,f))
+		{
+			new_return(92);
+		}
+		if(!p_iputl(guysbuf[i].misc14,f))
+		{
+			new_return(93);
+		}
+		if(!p_iputl(guysbuf[i].misc15,f))
+		{
+			new_return(94);
+		}
+		
+		//Enemy Editor InitD[] labels
+		for ( int32_t q = 0; q < 8; q++ )
+		{
+			for ( int32_t w = 0; w < 65; w++ )
 			{
-				new_return(39);
+				if(!p_putc(guysbuf[i].initD_label[q][w],f))
+				{
+					new_return(95);
+				} 
 			}
-			
-			if(!p_iputl(guysbuf[i].misc8,f))
+			for ( int32_t w = 0; w < 65; w++ )
 			{
-				new_return(40);
+				if(!p_putc(guysbuf[i].weapon_initD_label[q][w],f))
+				{
+					new_return(96);
+				} 
 			}
-			
-			if(!p_iputl(guysbuf[i].misc9,f))
+		}
+		if(!p_iputw(guysbuf[i].weaponscript,f))
+		{
+			new_return(97);
+		}
+		//eweapon initD
+		for ( int32_t q = 0; q < 8; q++ )
+		{
+			if(!p_iputl(guysbuf[i].weap_initiald[q],f))
 			{
-				new_return(41);
+				new_return(98);
 			}
-			
-			if(!p_iputl(guysbuf[i].misc10,f))
-			{
-				new_return(42);
-			}
-			
-			if(!p_iputw(guysbuf[i].bgsfx,f))
-			{
-				new_return(43);
-			}
-			
-			if(!p_iputw(guysbuf[i].bosspal,f))
-			{
-				new_return(44);
-			}
-			
-			if(!p_iputw(guysbuf[i].extend,f))
-			{
-				new_return(45);
-			}
-			
-			for(int32_t j=0; j < edefLAST; j++)
-			{
-				if(!p_putc(guysbuf[i].defense[j],f))
-				{
-					new_return(46);
-				}
-			}
-			
-			if ( FFCore.getQuestHeaderInfo(vZelda) < 0x250 || (( FFCore.getQuestHeaderInfo(vZelda) == 0x250 ) && FFCore.getQuestHeaderInfo(vBuild) < 32 ) )
-			{
-				//If no user-set hit sound was in place, and the quest was made in a version before 2.53.0 Gamma 2:
-				if ( guysbuf[i].hitsfx == 0 ) guysbuf[i].hitsfx = WAV_EHIT; //Fix quests using the wrong hit sound when loading this. 
-				//Force SFX_HIT here. 
-			
-			}
-		
-			if(!p_putc(guysbuf[i].hitsfx,f))
-			{
-				new_return(47);
-			}
-			
-			if(!p_putc(guysbuf[i].deadsfx,f))
-			{
-				new_return(48);
-			}
-			
-			if(!p_iputl(guysbuf[i].misc11,f))
-			{
-				new_return(49);
-			}
-			
-			if(!p_iputl(guysbuf[i].misc12,f))
-			{
-				new_return(50);
-			}
-			
-			//New 2.6 defences
-			for(int32_t j=edefLAST; j < edefLAST255; j++)
-			{
-				if(!p_putc(guysbuf[i].defense[j],f))
-				{
-					new_return(51);
-				}
-			}
-			
-			//tilewidth, tileheight, hitwidth, hitheight, hitzheight, hitxofs, hityofs, hitzofs
-			if(!p_iputl(guysbuf[i].txsz,f))
-			{
-				new_return(52);
-			}
-			if(!p_iputl(guysbuf[i].tysz,f))
-			{
-				new_return(53);
-			}
-			if(!p_iputl(guysbuf[i].hxsz,f))
-			{
-				new_return(54);
-			}
-			if(!p_iputl(guysbuf[i].hysz,f))
-			{
-				new_return(55);
-			}
-			if(!p_iputl(guysbuf[i].hzsz,f))
-			{
-				new_return(56);
-			}
-			// These are not fixed types, but ints, so they are safe to use here. 
-			if(!p_iputl(guysbuf[i].hxofs,f))
-			{
-				new_return(57);
-			}
-			if(!p_iputl(guysbuf[i].hyofs,f))
-			{
-				new_return(58);
-			}
-			if(!p_iputl(guysbuf[i].xofs,f))
-			{
-				new_return(59);
-			}
-			if(!p_iputl(guysbuf[i].yofs,f))
-			{
-				new_return(60);
-			}
-			if(!p_iputl(guysbuf[i].zofs,f))
-			{
-				new_return(61);
-			}
-			if(!p_iputl(guysbuf[i].wpnsprite,f))
-			{
-				new_return(62);
-			}
-			if(!p_iputl(guysbuf[i].SIZEflags,f))
-			{
-				new_return(63);
-			}
-			if(!p_iputl(guysbuf[i].frozentile,f))
-			{
-				new_return(64);
-			}
-			if(!p_iputl(guysbuf[i].frozencset,f))
-			{
-				new_return(65);
-			}
-			if(!p_iputl(guysbuf[i].frozenclock,f))
-			{
-				new_return(66);
-			}
-			
-			for ( int32_t q = 0; q < 10; q++ ) 
-			{
-				if(!p_iputw(guysbuf[i].frozenmisc[q],f))
-				{
-					new_return(67);
-				}
-			}
-			if(!p_iputw(guysbuf[i].firesfx,f))
-			{
-				new_return(68);
-			}
-			//misc 16->31
-			if(!p_iputl(guysbuf[i].misc16,f))
-			{
-				new_return(69);
-			}
-			if(!p_iputl(guysbuf[i].misc17,f))
-			{
-				new_return(70);
-			}
-			if(!p_iputl(guysbuf[i].misc18,f))
-			{
-				new_return(71);
-			}
-			if(!p_iputl(guysbuf[i].misc19,f))
-			{
-				new_return(72);
-			}
-			if(!p_iputl(guysbuf[i].misc20,f))
-			{
-				new_return(73);
-			}
-			if(!p_iputl(guysbuf[i].misc21,f))
-			{
-				new_return(74);
-			}
-			if(!p_iputl(guysbuf[i].misc22,f))
-			{
-				new_return(75);
-			}
-			if(!p_iputl(guysbuf[i].misc23,f))
-			{
-				new_return(76);
-			}
-			if(!p_iputl(guysbuf[i].misc24,f))
-			{
-				new_return(77);
-			}
-			if(!p_iputl(guysbuf[i].misc25,f))
-			{
-				new_return(78);
-			}
-			if(!p_iputl(guysbuf[i].misc26,f))
-			{
-				new_return(79);
-			}
-			if(!p_iputl(guysbuf[i].misc27,f))
-			{
-				new_return(80);
-			}
-			if(!p_iputl(guysbuf[i].misc28,f))
-			{
-				new_return(81);
-			}
-			if(!p_iputl(guysbuf[i].misc29,f))
-			{
-				new_return(82);
-			}
-			if(!p_iputl(guysbuf[i].misc30,f))
-			{
-				new_return(83);
-			}
-			if(!p_iputl(guysbuf[i].misc31,f))
-			{
-				new_return(84);
-			}
-			if(!p_iputl(guysbuf[i].misc32,f))
-			{
-				new_return(85);
-			}
-			for ( int32_t q = 0; q < 32; q++ )
-			{
-				if(!p_iputl(guysbuf[i].movement[q],f))
-				{
-					new_return(86);
-				}
-			}
-			for ( int32_t q = 0; q < 32; q++ )
-			{
-				if(!p_iputl(guysbuf[i].new_weapon[q],f))
-				{
-					new_return(87);
-				}
-			}
-			if(!p_iputw(guysbuf[i].script,f))
-			{
-				new_return(88);
-			}
-			for ( int32_t q = 0; q < 8; q++ )
-			{
-				if(!p_iputl(guysbuf[i].initD[q],f))
-				{
-					new_return(89);
-				}
-			}
-			for ( int32_t q = 0; q < 2; q++ )
-			{
-				if(!p_iputl(guysbuf[i].initA[q],f))
-				{
-					new_return(90);
-				}
-			}
-			if(!p_iputl(guysbuf[i].editorflags,f))
-			{
-				new_return(91);
-			}
-			//somehow forgot these in the older builds -Z
-			if(!p_iputl(guysbuf[i].misc13,f))
-			{
-				new_return(92);
-			}
-			if(!p_iputl(guysbuf[i].misc14,f))
-			{
-				new_return(93);
-			}
-			if(!p_iputl(guysbuf[i].misc15,f))
-			{
-				new_return(94);
-			}
-			
-			//Enemy Editor InitD[] labels
-			for ( int32_t q = 0; q < 8; q++ )
-			{
-				for ( int32_t w = 0; w < 65; w++ )
-				{
-					if(!p_putc(guysbuf[i].initD_label[q][w],f))
-					{
-						new_return(95);
-					} 
-				}
-				for ( int32_t w = 0; w < 65; w++ )
-				{
-					if(!p_putc(guysbuf[i].weapon_initD_label[q][w],f))
-					{
-						new_return(96);
-					} 
-				}
-			}
-			if(!p_iputw(guysbuf[i].weaponscript,f))
-			{
-				new_return(97);
-			}
-			//eweapon initD
-			for ( int32_t q = 0; q < 8; q++ )
-			{
-				if(!p_iputl(guysbuf[i].weap_initiald[q],f))
-				{
-					new_return(98);
-				}
-			}
-			if(!p_putc(guysbuf[i].moveflags,f))
-				new_return(99);
-			if(!p_putc(guysbuf[i].spr_shadow,f))
-				new_return(100);
-			if(!p_putc(guysbuf[i].spr_death,f))
-				new_return(101);
-			if(!p_putc(guysbuf[i].spr_spawn,f))
-				new_return(102);
-		}
-		
-		if(writecycle==0)
-		{
-			section_size=writesize;
 		}
+		if(!p_putc(guysbuf[i].moveflags,f))
+			new_return(99);
+		if(!p_putc(guysbuf[i].spr_shadow,f))
+			new_return(100);
+		if(!p_putc(guysbuf[i].spr_death,f))
+			new_return(101);
+		if(!p_putc(guysbuf[i].spr_spawn,f))
+			new_return(102);
 	}
 	
-	if(writesize!=int32_t(section_size) && save_warn)
+	//section size, then the buffered section data
+	if(!section.commit())
 	{
-		char ebuf[80];
-		sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-		jwin_alert("Error:  writeguys()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+		new_return(4);
 	}
 	
 	new_return(0);
@@ -11126,7 +10802,6 @@ int32_t writeherosprites(PACKFILE *f, zquestheader *Header)
     dword section_id=ID_HEROSPRITES;
     dword section_version=V_HEROSPRITES;
     dword section_cversion=CV_HEROSPRITES;
-    dword section_size=0;
     
     //section id
     if(!p_mputl(section_id,f))
@@ -11145,858 +10820,556 @@ int32_t writeherosprites(PACKFILE *f, zquestheader *Header)
         new_return(3);
     }
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    section_writer section(f);
+    
+    //finally...  section data
+    for(int32_t i=0; i<4; i++)
     {
-        fake_pack_writing=(writecycle==0);
-        
-        //section size
-        if(!p_iputl(section_size,f))
+        if(!p_iputl(walkspr[i][spr_tile],f))
         {
-            new_return(4);
+            new_return(5);
         }
         
-        writesize=0;
-        
-        //finally...  section data
-        for(int32_t i=0; i<4; i++)
+        if(!p_putc((byte)walkspr[i][spr_flip],f))
         {
-            if(!p_iputl(walkspr[i][spr_tile],f))
-            {
-                new_return(5);
-            }
-            
-            if(!p_putc((byte)walkspr[i][spr_flip],f))
-            {
-                new_return(5);
-            }
-            
-            if(!p_putc((byte)walkspr[i][spr_extend],f))
-            {
-                new_return(5);
-            }
+            new_return(5);
         }
         
-        for(int32_t i=0; i<4; i++)
+        if(!p_putc((byte)walkspr[i][spr_extend],f))
         {
-            if(!p_iputl(stabspr[i][spr_tile],f))
-            {
-                new_return(6);
-            }
-            
-            if(!p_putc((byte)stabspr[i][spr_flip],f))
-            {
-                new_return(6);
-            }
-            
-            if(!p_putc((byte)stabspr[i][spr_extend],f))
-            {
-                new_return(6);
-            }
+            new_return(5);
         }
-        
-        for(int32_t i=0; i<4; i++)
+    }
+    
+    for(int32_t i=0; i<4; i++)
+    {
+        if(!p_iputl(stabspr[i][spr_tile],f))
         {
-            if(!p_iputl(slashspr[i][spr_tile],f))
-            {
-                new_return(7);
-            }
-            
-            if(!p_putc((byte)slashspr[i][spr_flip],f))
-            {
-                new_return(7);
-            }
-            
-            if(!p_putc((byte)slashspr[i][spr_extend],f))
-            {
-                new_return(7);
-            }
+            new_return(6);
         }
         
-        for(int32_t i=0; i<4; i++)
+        if(!p_putc((byte)stabspr[i][spr_flip],f))
         {
-            if(!p_iputl(floatspr[i][spr_tile],f))
-            {
-                new_return(8);
-            }
-            
-            if(!p_putc((byte)floatspr[i][spr_flip],f))
-            {
-                new_return(8);
-            }
-            
-            if(!p_putc((byte)floatspr[i][spr_extend],f))
-            {
-                new_return(8);
-            }
+            new_return(6);
         }
         
-        for(int32_t i=0; i<4; i++)
+        if(!p_putc((byte)stabspr[i][spr_extend],f))
         {
-            if(!p_iputl(swimspr[i][spr_tile],f))
-            {
-                new_return(8);
-            }
-            
-            if(!p_putc((byte)swimspr[i][spr_flip],f))
-            {
-                new_return(8);
-            }
-            
-            if(!p_putc((byte)swimspr[i][spr_extend],f))
-            {
-                new_return(8);
-            }
+            new_return(6);
+        }
+    }
+    
+    for(int32_t i=0; i<4; i++)
+    {
+        if(!p_iputl(slashspr[i][spr_tile],f))
+        {
+            new_return(7);
         }
         
-        for(int32_t i=0; i<4; i++)
+        if(!p_putc((byte)slashspr[i][spr_flip],f))
         {
-            if(!p_iputl(divespr[i][spr_tile],f))
-            {
-                new_return(9);
-            }
-            
-            if(!p_putc((byte)divespr[i][spr_flip],f))
-            {
-                new_return(9);
-            }
-            
-            if(!p_putc((byte)divespr[i][spr_extend],f))
-            {
-                new_return(9);
-            }
+            new_return(7);
         }
         
-        for(int32_t i=0; i<4; i++)
+        if(!p_putc((byte)slashspr[i][spr_extend],f))
         {
-            if(!p_iputl(poundspr[i][spr_tile],f))
-            {
-                new_return(10);
-            }
-            
-            if(!p_putc((byte)poundspr[i][spr_flip],f))
-            {
-                new_return(10);
-            }
-            
-            if(!p_putc((byte)poundspr[i][spr_extend],f))
-            {
-                new_return(10);
-            }
+            new_return(7);
+        }
+    }
+    
+    for(int32_t i=0; i<4; i++)
+    {
+        if(!p_iputl(floatspr[i][spr_tile],f))
+        {
+            new_return(8);
         }
         
-        if(!p_iputl(castingspr[spr_tile],f))
+        if(!p_putc((byte)floatspr[i][spr_flip],f))
         {
-            new_return(11);
+            new_return(8);
         }
         
-        if(!p_putc((byte)castingspr[spr_flip],f))
+        if(!p_putc((byte)floatspr[i][spr_extend],f))
         {
-            new_return(11);
+            new_return(8);
+        }
+    }
+    
+    for(int32_t i=0; i<4; i++)
+    {
+        if(!p_iputl(swimspr[i][spr_tile],f))
+        {
+            new_return(8);
         }
         
-        if(!p_putc((byte)castingspr[spr_extend],f))
+        if(!p_putc((byte)swimspr[i][spr_flip],f))
         {
-            new_return(11);
+            new_return(8);
         }
         
-        for(int32_t i=0; i<2; i++)
+        if(!p_putc((byte)swimspr[i][spr_extend],f))
         {
-            for(int32_t j=0; j<spr_holdmax; j++)
-            {
-                if(!p_iputl(holdspr[i][j][spr_tile],f))
-                {
-                    new_return(12);
-                }
-                
-                if(!p_putc((byte)holdspr[i][j][spr_flip],f))
-                {
-                    new_return(12);
-                }
-                
-                if(!p_putc((byte)holdspr[i][j][spr_extend],f))
-                {
-                    new_return(12);
-                }
-            }
+            new_return(8);
+        }
+    }
+    
+    for(int32_t i=0; i<4; i++)
+    {
+        if(!p_iputl(divespr[i][spr_tile],f))
+        {
+            new_return(9);
         }
         
-        for(int32_t i=0; i<4; i++)
+        if(!p_putc((byte)divespr[i][spr_flip],f))
         {
-            if(!p_iputl(jumpspr[i][spr_tile],f))
-            {
-                new_return(13);
-            }
-            
-            if(!p_putc((byte)jumpspr[i][spr_flip],f))
-            {
-                new_return(13);
-            }
-            
-            if(!p_putc((byte)jumpspr[i][spr_extend],f))
-            {
-                new_return(13);
-            }
+            new_return(9);
         }
         
-        for(int32_t i=0; i<4; i++)
+        if(!p_putc((byte)divespr[i][spr_extend],f))
+        {
+            new_return(9);
+        }
+    }
+    
+    for(int32_t i=0; i<4; i++)
+    {
+        if(!p_iputl(poundspr[i][spr_tile],f))
+        {
+            new_return(10);
+        }
+        
+        if(!p_putc((byte)poundspr[i][spr_flip],f))
+        {
+            new_return(10);
+        }
+        
+        if(!p_putc((byte)poundspr[i][spr_extend],f))
+        {
+            new_return(10);
+        }
+    }
+    
+    if(!p_iputl(castingspr[spr_tile],f))
+    {
+        new_return(11);
+    }
+    
+    if(!p_putc((byte)castingspr[spr_flip],f))
+    {
+        new_return(11);
+    }
+    
+    if(!p_putc((byte)castingspr[spr_extend],f))
+    {
+        new_return(11);
+    }
+    
+    for(int32_t i=0; i<2; i++)
+    {
+        for(int32_t j=0; j<spr_holdmax; j++)
         {
-            if(!p_iputl(chargespr[i][spr_tile],f))
+            if(!p_iputl(holdspr[i][j][spr_tile],f))
             {
-                new_return(13);
+                new_return(12);
             }
             
-            if(!p_putc((byte)chargespr[i][spr_flip],f))
+            if(!p_putc((byte)holdspr[i][j][spr_flip],f))
             {
-                new_return(13);
+                new_return(12);
             }
             
-            if(!p_putc((byte)chargespr[i][spr_extend],f))
+            if(!p_putc((byte)holdspr[i][j][spr_extend],f))
             {
-                new_return(13);
+                new_return(12);
             }
         }
+    }
+    
+    for(int32_t i=0; i<4; i++)
+    {
+        if(!p_iputl(jumpspr[i][spr_tile],f))
+        {
+            new_return(13);
+        }
         
-        if(!p_putc((byte)zinit.hero_swim_speed,f))
+        if(!p_putc((byte)jumpspr[i][spr_flip],f))
         {
-            new_return(14);
+            new_return(13);
         }
-		
-		//{ V_HEROSPRITES >= 7
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(frozenspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)frozenspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)frozenspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(frozen_waterspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)frozen_waterspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)frozen_waterspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(onfirespr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)onfirespr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)onfirespr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(onfire_waterspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)onfire_waterspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)onfire_waterspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(diggingspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)diggingspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)diggingspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(usingrodspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)usingrodspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)usingrodspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(usingcanespr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)usingcanespr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)usingcanespr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(pushingspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)pushingspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)pushingspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(liftingspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)liftingspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)liftingspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(liftingheavyspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)liftingheavyspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)liftingheavyspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(stunnedspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)stunnedspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)stunnedspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(stunned_waterspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)stunned_waterspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)stunned_waterspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(drowningspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)drowningspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)drowningspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(drowning_lavaspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)drowning_lavaspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)drowning_lavaspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(fallingspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)fallingspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)fallingspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(shockedspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)shockedspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)shockedspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(shocked_waterspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)shocked_waterspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)shocked_waterspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(pullswordspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)pullswordspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)pullswordspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(readingspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)readingspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)readingspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(slash180spr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)slash180spr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)slash180spr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(slashZ4spr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)slashZ4spr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)slashZ4spr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(dashspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)dashspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)dashspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(bonkspr[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)bonkspr[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)bonkspr[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 3; ++q) //Not directions; number of medallion sprs
-		{
-			if(!p_iputl(medallionsprs[q][spr_tile],f))
-				new_return(15);
-			if(!p_putc((byte)medallionsprs[q][spr_flip],f))
-				new_return(15);
-			if(!p_putc((byte)medallionsprs[q][spr_extend],f))
-				new_return(15);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(sideswimspr[q][spr_tile],f))
-				new_return(16);
-			if(!p_putc((byte)sideswimspr[q][spr_flip],f))
-				new_return(16);
-			if(!p_putc((byte)sideswimspr[q][spr_extend],f))
-				new_return(16);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(sideswimslashspr[q][spr_tile],f))
-				new_return(17);
-			if(!p_putc((byte)sideswimslashspr[q][spr_flip],f))
-				new_return(17);
-			if(!p_putc((byte)sideswimslashspr[q][spr_extend],f))
-				new_return(17);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(sideswimstabspr[q][spr_tile],f))
-				new_return(17);
-			if(!p_putc((byte)sideswimstabspr[q][spr_flip],f))
-				new_return(17);
-			if(!p_putc((byte)sideswimstabspr[q][spr_extend],f))
-				new_return(17);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(sideswimpoundspr[q][spr_tile],f))
-				new_return(17);
-			if(!p_putc((byte)sideswimpoundspr[q][spr_flip],f))
-				new_return(17);
-			if(!p_putc((byte)sideswimpoundspr[q][spr_extend],f))
-				new_return(17);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(sideswimchargespr[q][spr_tile],f))
-				new_return(18);
-			if(!p_putc((byte)sideswimchargespr[q][spr_flip],f))
-				new_return(18);
-			if(!p_putc((byte)sideswimchargespr[q][spr_extend],f))
-				new_return(18);
-		}
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(hammeroffsets[q],f))
-				new_return(19);
-		}
-		for(int32_t q = 0; q < 3; ++q)
-		{
-			if(!p_iputl(sideswimholdspr[q][spr_tile],f))
-				new_return(20);
-			if(!p_putc((byte)sideswimholdspr[q][spr_flip],f))
-				new_return(20);
-			if(!p_putc((byte)sideswimholdspr[q][spr_extend],f))
-				new_return(20);
-		}
-		
-		if(!p_iputl(sideswimcastingspr[spr_tile],f))
-		{
-		    new_return(21);
-		}
-		
-		if(!p_putc((byte)sideswimcastingspr[spr_flip],f))
-		{
-		    new_return(21);
-		}
-		
-		if(!p_putc((byte)sideswimcastingspr[spr_extend],f))
-		{
-		    new_return(21);
-		}
-		
-		for(int32_t q = 0; q < 4; ++q)
-		{
-			if(!p_iputl(sidedrowningspr[q][spr_tile],f))
-				new_return(22);
-			if(!p_putc((byte)sidedrowningspr[q][spr_flip],f))
-				new_return(22);
-			if(!p_putc((byte)sidedrowningspr[q][spr_extend],f))
-				new_return(22);
-		}
-		
-		for(int32_t i=0; i<4; i++)
-		{
-			if(!p_iputl(revslashspr[i][spr_tile],f))
-			{
-				new_return(23);
-			}
-		    
-			if(!p_putc((byte)revslashspr[i][spr_flip],f))
-			{
-				new_return(23);
-			}
-		    
-			if(!p_putc((byte)revslashspr[i][spr_extend],f))
-			{
-				new_return(23);
-			}
-		}
         
-		
-        for (int32_t q = 0; q < wMax; q++) // Player defense values
-        {
-            if (!p_putc(hero_defence[q], f))
-                new_return(15);
-        }
-		//}
-		
-        if(writecycle==0)
+        if(!p_putc((byte)jumpspr[i][spr_extend],f))
         {
-            section_size=writesize;
+            new_return(13);
         }
     }
     
-    //More data will come here
-    
-    if(writesize!=int32_t(section_size) && save_warn)
-    {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writeherosprites()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
-    }
-    
-    new_return(0);
-}
-
-int32_t writesubscreens(PACKFILE *f, zquestheader *Header)
-{
-    dword section_id=ID_SUBSCREEN;
-    dword section_version=V_SUBSCREEN;
-    dword section_cversion=CV_SUBSCREEN;
-    dword section_size=0;
-    
-    //section id
-    if(!p_mputl(section_id,f))
-    {
-        new_return(1);
-    }
-    
-    //section version info
-    if(!p_iputw(section_version,f))
-    {
-        new_return(2);
-    }
-    
-    if(!p_iputw(section_cversion,f))
-    {
-        new_return(3);
-    }
-    
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    for(int32_t i=0; i<4; i++)
     {
-        fake_pack_writing=(writecycle==0);
-        
-        //section size
-        if(!p_iputl(section_size,f))
+        if(!p_iputl(chargespr[i][spr_tile],f))
         {
-            new_return(4);
+            new_return(13);
         }
         
-        writesize=0;
-        
-        for(int32_t i=0; i<MAXCUSTOMSUBSCREENS; i++)
+        if(!p_putc((byte)chargespr[i][spr_flip],f))
         {
-            int32_t ret = write_one_subscreen(f, Header, i);
-            fake_pack_writing=(writecycle==0);
-            
-            if(ret!=0)
-            {
-                new_return(ret);
-            }
+            new_return(13);
         }
         
-        if(writecycle==0)
+        if(!p_putc((byte)chargespr[i][spr_extend],f))
         {
-            section_size=writesize;
+            new_return(13);
         }
     }
     
-    if(writesize!=int32_t(section_size) && save_warn)
-    {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writesubscreens()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
-    }
-    
-    new_return(0);
-}
-
-int32_t write_one_subscreen(PACKFILE *f, zquestheader *Header, int32_t i)
-{
-    //these are here to bypass compiler warnings about unused arguments
-    Header=Header;
-    
-    int32_t numsub = 0;
-    
-    if(!pfwrite(custom_subscreen[i].name, 64,f))
-    {
-        new_return(28);
-    }
-    
-    if(!p_putc(custom_subscreen[i].ss_type,f))
-    {
-        new_return(29);
-    }
-    
-    for(int32_t k=0; (k<MAXSUBSCREENITEMS&&(custom_subscreen[i].objects[k].type != ssoNULL)); k++)
-    {
-        numsub++;
-    }
-    
-    if(!p_iputw(numsub,f))
+    if(!p_putc((byte)zinit.hero_swim_speed,f))
     {
-        new_return(4);
+        new_return(14);
     }
-    
-    for(int32_t j=0; (j<MAXSUBSCREENITEMS&&j<numsub); j++)
-    {
-        if(!p_putc(custom_subscreen[i].objects[j].type, f))
-        {
-            new_return(5);
-        }
-        
-        if(!p_putc(custom_subscreen[i].objects[j].pos, f))
-        {
-            new_return(6);
-        }
-        
-        if(!p_iputw(custom_subscreen[i].objects[j].x, f))
-        {
-            new_return(7);
-        }
-        
-        if(!p_iputw(custom_subscreen[i].objects[j].y, f))
-        {
-            new_return(8);
-        }
-        
-        if(!p_iputw(custom_subscreen[i].objects[j].w, f))
-        {
-            new_return(9);
-        }
-        
-        if(!p_iputw(custom_subscreen[i].objects[j].h, f))
-        {
-            new_return(10);
-        }
-        
-        if(!p_putc(custom_subscreen[i].objects[j].colortype1, f))
-        {
-            new_return(11);
-        }
-        
-        if(!p_iputw(custom_subscreen[i].objects[j].color1, f))
-        {
-            new_return(12);
-        }
-        
-        if(!p_putc(custom_subscreen[i].objects[j].colortype2, f))
-        {
-            new_return(13);
-        }
-        
-        if(!p_iputw(custom_subscreen[i].objects[j].color2, f))
-        {
-            new_return(14);
-        }
-        
-        if(!p_putc(custom_subscreen[i].objects[j].colortype3, f))
-        {
-            new_return(15);
-        }
-        
-        if(!p_iputw(custom_subscreen[i].objects[j].color3, f))
-        {
-            new_return(16);
-        }
-        
-        if(!p_iputl(custom_subscreen[i].objects[j].d1, f))
-        {
-            new_return(17);
-        }
-        
-        if(!p_iputl(custom_subscreen[i].objects[j].d2, f))
-        {
-            new_return(18);
-        }
-        
-        if(!p_iputl(custom_subscreen[i].objects[j].d3, f))
-        {
-            new_return(19);
-        }
-        
-        if(!p_iputl(custom_subscreen[i].objects[j].d4, f))
-        {
-            new_return(20);
-        }
-        
-        if(!p_iputl(custom_subscreen[i].objects[j].d5, f))
-        {
-            new_return(21);
-        }
-        
-        if(!p_iputl(custom_subscreen[i].objects[j].d6, f))
-        {
-            new_return(22);
-        }
-        
-        if(!p_iputl(custom_subscreen[i].objects[j].d7, f))
-        {
-            new_return(23);
-        }
-        
-        if(!p_iputl(custom_subscreen[i].objects[j].d8, f))
-        {
-            new_return(24);
-        }
-        
-        if(!p_iputl(custom_subscreen[i].objects[j].d9, f))
-        {
-            new_return(25);
-        }
-        
-        if(!p_iputl(custom_subscreen[i].objects[j].d10, f))
-        {
-            new_return(26);
-        }
-        
-        if(!p_putc(custom_subscreen[i].objects[j].speed, f))
-        {
-            new_return(27);
-        }
-        
-        if(!p_putc(custom_subscreen[i].objects[j].delay, f))
-        {
-            new_return(28);
-        }
-        
-        if(!p_iputw(custom_subscreen[i].objects[j].frame, f))
-        {
-            new_return(29);
-        }
-        
-        switch(custom_subscreen[i].objects[j].type)
-        {
-        case ssoTEXT:
-        case ssoTEXTBOX:
-        case ssoCURRENTITEMTEXT:
-        case ssoCURRENTITEMCLASSTEXT:
-            if(custom_subscreen[i].objects[j].dp1 != NULL)
-            {
-                if(strlen((char*)custom_subscreen[i].objects[j].dp1))
-                {
-                    if(!p_iputw((int32_t)strlen((char*)custom_subscreen[i].objects[j].dp1), f))
-                    {
-                        new_return(27);
-                    }
-                    
-                    if(!pfwrite(custom_subscreen[i].objects[j].dp1, (int32_t)strlen((char*)custom_subscreen[i].objects[j].dp1)+1,f))
-                    {
-                        new_return(28);
-                    }
-                }
-                else
-                {
-                    if(!p_iputw(0, f))
-                    {
-                        new_return(27);
-                    }
-                }
-            }
-            else
-            {
-                if(!p_iputw(0, f))
-                {
-                    new_return(27);
-                }
-            }
-            
-            break;
-            
-        default:
-            if(!p_putc(0, f))
-            {
-                new_return(27);
-            }
-        }
+	
+	//{ V_HEROSPRITES >= 7
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(frozenspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)frozenspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)frozenspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(frozen_waterspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)frozen_waterspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)frozen_waterspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(onfirespr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)onfirespr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)onfirespr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(onfire_waterspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)onfire_waterspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)onfire_waterspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(diggingspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)diggingspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)diggingspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(usingrodspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)usingrodspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)usingrodspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(usingcanespr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)usingcanespr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)usingcanespr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(pushingspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)pushingspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)pushingspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(liftingspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)liftingspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)liftingspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(liftingheavyspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)liftingheavyspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)liftingheavyspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(stunnedspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)stunnedspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)stunnedspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(stunned_waterspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)stunned_waterspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)stunned_waterspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(drowningspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)drowningspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)drowningspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(drowning_lavaspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)drowning_lavaspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)drowning_lavaspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(fallingspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)fallingspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)fallingspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(shockedspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)shockedspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)shockedspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(shocked_waterspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)shocked_waterspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)shocked_waterspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(pullswordspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)pullswordspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)pullswordspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(readingspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)readingspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)readingspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(slash180spr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)slash180spr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)slash180spr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(slashZ4spr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)slashZ4spr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)slashZ4spr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(dashspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)dashspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)dashspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(bonkspr[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)bonkspr[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)bonkspr[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 3; ++q) //Not directions; number of medallion sprs
+	{
+		if(!p_iputl(medallionsprs[q][spr_tile],f))
+			new_return(15);
+		if(!p_putc((byte)medallionsprs[q][spr_flip],f))
+			new_return(15);
+		if(!p_putc((byte)medallionsprs[q][spr_extend],f))
+			new_return(15);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(sideswimspr[q][spr_tile],f))
+			new_return(16);
+		if(!p_putc((byte)sideswimspr[q][spr_flip],f))
+			new_return(16);
+		if(!p_putc((byte)sideswimspr[q][spr_extend],f))
+			new_return(16);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(sideswimslashspr[q][spr_tile],f))
+			new_return(17);
+		if(!p_putc((byte)sideswimslashspr[q][spr_flip],f))
+			new_return(17);
+		if(!p_putc((byte)sideswimslashspr[q][spr_extend],f))
+			new_return(17);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(sideswimstabspr[q][spr_tile],f))
+			new_return(17);
+		if(!p_putc((byte)sideswimstabspr[q][spr_flip],f))
+			new_return(17);
+		if(!p_putc((byte)sideswimstabspr[q][spr_extend],f))
+			new_return(17);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(sideswimpoundspr[q][spr_tile],f))
+			new_return(17);
+		if(!p_putc((byte)sideswimpoundspr[q][spr_flip],f))
+			new_return(17);
+		if(!p_putc((byte)sideswimpoundspr[q][spr_extend],f))
+			new_return(17);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(sideswimchargespr[q][spr_tile],f))
+			new_return(18);
+		if(!p_putc((byte)sideswimchargespr[q][spr_flip],f))
+			new_return(18);
+		if(!p_putc((byte)sideswimchargespr[q][spr_extend],f))
+			new_return(18);
+	}
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(hammeroffsets[q],f))
+			new_return(19);
+	}
+	for(int32_t q = 0; q < 3; ++q)
+	{
+		if(!p_iputl(sideswimholdspr[q][spr_tile],f))
+			new_return(20);
+		if(!p_putc((byte)sideswimholdspr[q][spr_flip],f))
+			new_return(20);
+		if(!p_putc((byte)sideswimholdspr[q][spr_extend],f))
+			new_return(20);
+	}
+	
+	if(!p_iputl(sideswimcastingspr[spr_tile],f))
+	{
+	    new_return(21);
+	}
+	
+	if(!p_putc((byte)sideswimcastingspr[spr_flip],f))
+	{
+	    new_return(21);
+	}
+	
+	if(!p_putc((byte)sideswimcastingspr[spr_extend],f))
+	{
+	    new_return(21);
+	}
+	
+	for(int32_t q = 0; q < 4; ++q)
+	{
+		if(!p_iputl(sidedrowningspr[q][spr_tile],f))
+			new_return(22);
+		if(!p_putc((byte)sidedrowningspr[q][spr_flip],f))
+			new_return(22);
+		if(!p_putc((byte)sidedrowningspr[q][spr_extend],f))
+			new_return(22);
+	}
+	
+	for(int32_t i=0; i<4; i++)
+	{
+		if(!p_iputl(revslashspr[i][spr_tile],f))
+		{
+			new_return(23);
+		}
+	    
+		if(!p_putc((byte)revslashspr[i][spr_flip],f))
+		{
+			new_return(23);
+		}
+	    
+		if(!p_putc((byte)revslashspr[i][spr_extend],f))
+		{
+			new_return(23);
+		}
+	}
+    
+	
+    for (int32_t q = 0; q < wMax; q++) // Player defense values
+    {
+        if (!p_putc(hero_defence[q], f))
+            new_return(15);
+    }
+	//}
+    
+    //section size, then the buffered section data
+    if(!section.commit())
+    {
+        new_return(4);
     }
     
+    //More data will come here
+    
     new_return(0);
 }
 
-extern script_data *ffscripts[NUMSCRIPTFFC];
-extern script_data *itemscripts[NUMSCRIPTITEM];
-extern script_data *guyscripts[NUMSCRIPTGUYS];
-extern script_data *wpnscripts[NUMSCRIPTWEAPONS];
-extern script_data *wpnscripts[NUMSCRIPTWEAPONS];
-extern script_data *lwpnscripts[NUMSCRIPTWEAPONS];
-extern script_data *ewpnscripts[NUMSCRIPTWEAPONS];
-extern script_data *globalscripts[NUMSCRIPTGLOBAL];
-extern script_data *genericscripts[NUMSCRIPTSGENERIC];
-extern script_data *playerscripts[NUMSCRIPTPLAYER];
-extern script_data *screenscripts[NUMSCRIPTSCREEN];
-extern script_data *dmapscripts[NUMSCRIPTSDMAP];
-extern script_data *itemspritescripts[NUMSCRIPTSITEMSPRITE];
-extern script_data *comboscripts[NUMSCRIPTSCOMBODATA];
-
-int32_t writeffscript(PACKFILE *f, zquestheader *Header)
+int32_t writesubscreens(PACKFILE *f, zquestheader *Header)
 {
-    dword section_id       = ID_FFSCRIPT;
-    dword section_version  = V_FFSCRIPT;
-    dword section_cversion = CV_FFSCRIPT;
-    dword section_size     = 0;
-	dword zasmmeta_version = METADATA_V;
-    byte numscripts        = 0;
-    numscripts = numscripts; //to avoid unused variables warnings
+    dword section_id=ID_SUBSCREEN;
+    dword section_version=V_SUBSCREEN;
+    dword section_cversion=CV_SUBSCREEN;
     
     //section id
     if(!p_mputl(section_id,f))
@@ -12015,1310 +11388,1508 @@ int32_t writeffscript(PACKFILE *f, zquestheader *Header)
         new_return(3);
     }
     
-    if(!p_iputw(zasmmeta_version,f))
+    section_writer section(f);
+    
+    for(int32_t i=0; i<MAXCUSTOMSUBSCREENS; i++)
+    {
+        int32_t ret = write_one_subscreen(f, Header, i);
+        
+        if(ret!=0)
+        {
+            new_return(ret);
+        }
+    }
+    
+    //section size, then the buffered section data
+    if(!section.commit())
+    {
+        new_return(4);
+    }
+    
+    new_return(0);
+}
+
+int32_t write_one_subscreen(PACKFILE *f, zquestheader *Header, int32_t i)
+{
+    //these are here to bypass compiler warnings about unused arguments
+    Header=Header;
+    
+    int32_t numsub = 0;
+    
+    if(!pfwrite(custom_subscreen[i].name, 64,f))
+    {
+        new_return(28);
+    }
+    
+    if(!p_putc(custom_subscreen[i].ss_type,f))
+    {
+        new_return(29);
+    }
+    
+    for(int32_t k=0; (k<MAXSUBSCREENITEMS&&(custom_subscreen[i].objects[k].type != ssoNULL)); k++)
+    {
+        numsub++;
+    }
+    
+    if(!p_iputw(numsub,f))
     {
         new_return(4);
     }
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    for(int32_t j=0; (j<MAXSUBSCREENITEMS&&j<numsub); j++)
     {
-        fake_pack_writing=(writecycle==0);
-        
-        //section size
-        if(!p_iputl(section_size,f))
+        if(!p_putc(custom_subscreen[i].objects[j].type, f))
         {
             new_return(5);
         }
         
-        writesize=0;
-        
-        for(int32_t i=0; i<NUMSCRIPTFFC; i++)
-        {
-            int32_t ret = write_one_ffscript(f, Header, i, &ffscripts[i]);
-            fake_pack_writing=(writecycle==0);
-            
-            if(ret!=0)
-            {
-                new_return(ret);
-            }
-        }
-        
-        for(int32_t i=0; i<NUMSCRIPTITEM; i++)
-        {
-            int32_t ret = write_one_ffscript(f, Header, i, &itemscripts[i]);
-            fake_pack_writing=(writecycle==0);
-            
-            if(ret!=0)
-            {
-                new_return(ret);
-            }
-        }
-        
-        for(int32_t i=0; i<NUMSCRIPTGUYS; i++)
+        if(!p_putc(custom_subscreen[i].objects[j].pos, f))
         {
-            int32_t ret = write_one_ffscript(f, Header, i, &guyscripts[i]);
-            fake_pack_writing=(writecycle==0);
-            
-            if(ret!=0)
-            {
-                new_return(ret);
-            }
+            new_return(6);
         }
         
-        for(int32_t i=0; i<NUMSCRIPTWEAPONS; i++)
+        if(!p_iputw(custom_subscreen[i].objects[j].x, f))
         {
-            int32_t ret = write_one_ffscript(f, Header, i, &wpnscripts[i]);
-            fake_pack_writing=(writecycle==0);
-            
-            if(ret!=0)
-            {
-                new_return(ret);
-            }
+            new_return(7);
         }
         
-        for(int32_t i=0; i<NUMSCRIPTSCREEN; i++)
+        if(!p_iputw(custom_subscreen[i].objects[j].y, f))
         {
-            int32_t ret = write_one_ffscript(f, Header, i, &screenscripts[i]);
-            fake_pack_writing=(writecycle==0);
-            
-            if(ret!=0)
-            {
-                new_return(ret);
-            }
+            new_return(8);
         }
         
-        for(int32_t i=0; i<NUMSCRIPTGLOBAL; i++)
-        {
-            int32_t ret = write_one_ffscript(f, Header, i, &globalscripts[i]);
-            fake_pack_writing=(writecycle==0);
-            
-            if(ret!=0)
-            {
-                new_return(ret);
-            }
-        }
-		
-        for(int32_t i=0; i<NUMSCRIPTPLAYER; i++)
-        {
-            int32_t ret = write_one_ffscript(f, Header, i, &playerscripts[i]);
-            fake_pack_writing=(writecycle==0);
-            
-            if(ret!=0)
-            {
-                new_return(ret);
-            }
-        }
-		
-        for(int32_t i=0; i<NUMSCRIPTWEAPONS; i++)
-        {
-            int32_t ret = write_one_ffscript(f, Header, i, &lwpnscripts[i]);
-            fake_pack_writing=(writecycle==0);
-            
-            if(ret!=0)
-            {
-                new_return(ret);
-            }
-        }
-		
-		for(int32_t i=0; i<NUMSCRIPTWEAPONS; i++)
+        if(!p_iputw(custom_subscreen[i].objects[j].w, f))
         {
-            int32_t ret = write_one_ffscript(f, Header, i, &ewpnscripts[i]);
-            fake_pack_writing=(writecycle==0);
-            
-            if(ret!=0)
-            {
-                new_return(ret);
-            }
+            new_return(9);
         }
         
-		for(int32_t i=0; i<NUMSCRIPTSDMAP; i++)
-        {
-            int32_t ret = write_one_ffscript(f, Header, i, &dmapscripts[i]);
-            fake_pack_writing=(writecycle==0);
-            
-            if(ret!=0)
-            {
-                new_return(ret);
-            }
-        }
-		
-		for(int32_t i=0; i<NUMSCRIPTSITEMSPRITE; i++)
-        {
-            int32_t ret = write_one_ffscript(f, Header, i, &itemspritescripts[i]);
-            fake_pack_writing=(writecycle==0);
-            
-            if(ret!=0)
-            {
-                new_return(ret);
-            }
-        }
-		
-		for(int32_t i=0; i<NUMSCRIPTSCOMBODATA; i++)
-        {
-            int32_t ret = write_one_ffscript(f, Header, i, &comboscripts[i]);
-            fake_pack_writing=(writecycle==0);
-            
-            if(ret!=0)
-            {
-                new_return(ret);
-            }
-        }
-		
-		if(!p_iputw(NUMSCRIPTSGENERIC,f))
-		{
-			new_return(2000);
-		}
-		for(int32_t i=0; i<NUMSCRIPTSGENERIC; i++)
+        if(!p_iputw(custom_subscreen[i].objects[j].h, f))
         {
-            int32_t ret = write_one_ffscript(f, Header, i, &genericscripts[i]);
-            fake_pack_writing=(writecycle==0);
-            
-            if(ret!=0)
-            {
-                new_return(ret);
-            }
+            new_return(10);
         }
         
-        if(!p_iputl((int32_t)zScript.size(), f))
+        if(!p_putc(custom_subscreen[i].objects[j].colortype1, f))
         {
-            new_return(2001);
+            new_return(11);
         }
         
-        if(!pfwrite((void *)zScript.c_str(), (int32_t)zScript.size(), f))
+        if(!p_iputw(custom_subscreen[i].objects[j].color1, f))
         {
-            new_return(2002);
+            new_return(12);
         }
         
-        word numffcbindings=0;
-        
-        for(std::map<int32_t, script_slot_data >::iterator it = ffcmap.begin(); it != ffcmap.end(); it++)
+        if(!p_putc(custom_subscreen[i].objects[j].colortype2, f))
         {
-            if(it->second.scriptname != "")
-            {
-                numffcbindings++;
-            }
+            new_return(13);
         }
         
-        if(!p_iputw(numffcbindings, f))
+        if(!p_iputw(custom_subscreen[i].objects[j].color2, f))
         {
-            new_return(2003);
+            new_return(14);
         }
         
-        for(std::map<int32_t, script_slot_data >::iterator it = ffcmap.begin(); it != ffcmap.end(); it++)
+        if(!p_putc(custom_subscreen[i].objects[j].colortype3, f))
         {
-            if(it->second.scriptname != "")
-            {
-                if(!p_iputw(it->first,f))
-                {
-                    new_return(2004);
-                }
-                
-                if(!p_iputl((int32_t)it->second.scriptname.size(), f))
-                {
-                    new_return(2005);
-                }
-                
-                if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
-                {
-                    new_return(2006);
-                }
-            }
+            new_return(15);
         }
         
-        word numglobalbindings=0;
-        
-        for(std::map<int32_t, script_slot_data >::iterator it = globalmap.begin(); it != globalmap.end(); it++)
+        if(!p_iputw(custom_subscreen[i].objects[j].color3, f))
         {
-            if(it->second.scriptname != "")
-            {
-                numglobalbindings++;
-            }
+            new_return(16);
         }
         
-        if(!p_iputw(numglobalbindings, f))
+        if(!p_iputl(custom_subscreen[i].objects[j].d1, f))
         {
-            new_return(2007);
+            new_return(17);
         }
         
-        for(std::map<int32_t, script_slot_data >::iterator it = globalmap.begin(); it != globalmap.end(); it++)
+        if(!p_iputl(custom_subscreen[i].objects[j].d2, f))
         {
-            if(it->second.scriptname != "")
-            {
-                if(!p_iputw(it->first,f))
-                {
-                    new_return(2008);
-                }
-                
-                if(!p_iputl((int32_t)it->second.scriptname.size(), f))
-                {
-                    new_return(2009);
-                }
-                
-                if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
-                {
-                    new_return(2010);
-                }
-            }
+            new_return(18);
         }
         
-        word numitembindings=0;
-        
-        for(std::map<int32_t, script_slot_data >::iterator it = itemmap.begin(); it != itemmap.end(); it++)
+        if(!p_iputl(custom_subscreen[i].objects[j].d3, f))
         {
-            if(it->second.scriptname != "")
-            {
-                numitembindings++;
-            }
+            new_return(19);
         }
         
-        if(!p_iputw(numitembindings, f))
+        if(!p_iputl(custom_subscreen[i].objects[j].d4, f))
         {
-            new_return(2011);
+            new_return(20);
         }
         
-        for(std::map<int32_t, script_slot_data >::iterator it = itemmap.begin(); it != itemmap.end(); it++)
+        if(!p_iputl(custom_subscreen[i].objects[j].d5, f))
         {
-            if(it->second.scriptname != "")
-            {
-                if(!p_iputw(it->first,f))
-                {
-                    new_return(2012);
-                }
-                
-                if(!p_iputl((int32_t)it->second.scriptname.size(), f))
-                {
-                    new_return(2013);
-                }
-                
-                if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
-                {
-                    new_return(2014);
-                }
-            }
+            new_return(21);
         }
         
-        //new script types
-        //npc scripts
-        word numnpcbindings=0;
-        
-        for(std::map<int32_t, script_slot_data >::iterator it = npcmap.begin(); it != npcmap.end(); it++)
+        if(!p_iputl(custom_subscreen[i].objects[j].d6, f))
         {
-            if(it->second.scriptname != "")
-            {
-                numnpcbindings++;
-            }
+            new_return(22);
         }
         
-        if(!p_iputw(numnpcbindings, f))
+        if(!p_iputl(custom_subscreen[i].objects[j].d7, f))
         {
-            new_return(2015);
+            new_return(23);
         }
         
-        for(std::map<int32_t, script_slot_data >::iterator it = npcmap.begin(); it != npcmap.end(); it++)
+        if(!p_iputl(custom_subscreen[i].objects[j].d8, f))
         {
-            if(it->second.scriptname != "")
-            {
-                if(!p_iputw(it->first,f))
-                {
-                    new_return(2016);
-                }
-                
-                if(!p_iputl((int32_t)it->second.scriptname.size(), f))
-                {
-                    new_return(2017);
-                }
-                
-                if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
-                {
-                    new_return(2018);
-                }
-            }
+            new_return(24);
         }
         
-        //lweapon
-	
-	word numlwpnbindings=0;
-        
-        for(std::map<int32_t, script_slot_data >::iterator it = lwpnmap.begin(); it != lwpnmap.end(); it++)
+        if(!p_iputl(custom_subscreen[i].objects[j].d9, f))
         {
-            if(it->second.scriptname != "")
-            {
-                numlwpnbindings++;
-            }
+            new_return(25);
         }
         
-        if(!p_iputw(numlwpnbindings, f))
+        if(!p_iputl(custom_subscreen[i].objects[j].d10, f))
         {
-            new_return(2019);
+            new_return(26);
         }
         
-        for(std::map<int32_t, script_slot_data >::iterator it = lwpnmap.begin(); it != lwpnmap.end(); it++)
+        if(!p_putc(custom_subscreen[i].objects[j].speed, f))
         {
-            if(it->second.scriptname != "")
-            {
-                if(!p_iputw(it->first,f))
-                {
-                    new_return(2020);
-                }
-                
-                if(!p_iputl((int32_t)it->second.scriptname.size(), f))
-                {
-                    new_return(2021);
-                }
-                
-                if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
-                {
-                    new_return(2022);
-                }
-            }
-        }
-	
-	//////
-	
-	//eweapon
-	
-	
-        word numewpnbindings=0;
+            new_return(27);
+        }
         
-        for(std::map<int32_t, script_slot_data >::iterator it = ewpnmap.begin(); it != ewpnmap.end(); it++)
+        if(!p_putc(custom_subscreen[i].objects[j].delay, f))
         {
-            if(it->second.scriptname != "")
-            {
-                numewpnbindings++;
-            }
+            new_return(28);
         }
         
-        if(!p_iputw(numewpnbindings, f))
+        if(!p_iputw(custom_subscreen[i].objects[j].frame, f))
         {
-            new_return(2023);
+            new_return(29);
         }
         
-        for(std::map<int32_t, script_slot_data >::iterator it = ewpnmap.begin(); it != ewpnmap.end(); it++)
+        switch(custom_subscreen[i].objects[j].type)
         {
-            if(it->second.scriptname != "")
+        case ssoTEXT:
+        case ssoTEXTBOX:
+        case ssoCURRENTITEMTEXT:
+        case ssoCURRENTITEMCLASSTEXT:
+            if(custom_subscreen[i].objects[j].dp1 != NULL)
             {
-                if(!p_iputw(it->first,f))
+                if(strlen((char*)custom_subscreen[i].objects[j].dp1))
                 {
-                    new_return(2024);
+                    if(!p_iputw((int32_t)strlen((char*)custom_subscreen[i].objects[j].dp1), f))
+                    {
+                        new_return(27);
+                    }
+                    
+                    if(!pfwrite(custom_subscreen[i].objects[j].dp1, (int32_t)strlen((char*)custom_subscreen[i].objects[j].dp1)+1,f))
+                    {
+                        new_return(28);
+                    }
                 }
-                
-                if(!p_iputl((int32_t)it->second.scriptname.size(), f))
+                else
                 {
-                    new_return(2025);
+                    if(!p_iputw(0, f))
+                    {
+                        new_return(27);
+                    }
                 }
-                
-                if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
+            }
+            else
+            {
+                if(!p_iputw(0, f))
                 {
-                    new_return(2026);
+                    new_return(27);
                 }
             }
+            
+            break;
+            
+        default:
+            if(!p_putc(0, f))
+            {
+                new_return(27);
+            }
         }
-	
-	//player scripts
-	word numherobindings=0;
+    }
+    
+    new_return(0);
+}
+
+extern script_data *ffscripts[NUMSCRIPTFFC];
+extern script_data *itemscripts[NUMSCRIPTITEM];
+extern script_data *guyscripts[NUMSCRIPTGUYS];
+extern script_data *wpnscripts[NUMSCRIPTWEAPONS];
+extern script_data *wpnscripts[NUMSCRIPTWEAPONS];
+extern script_data *lwpnscripts[NUMSCRIPTWEAPONS];
+extern script_data *ewpnscripts[NUMSCRIPTWEAPONS];
+extern script_data *globalscripts[NUMSCRIPTGLOBAL];
+extern script_data *genericscripts[NUMSCRIPTSGENERIC];
+extern script_data *playerscripts[NUMSCRIPTPLAYER];
+extern script_data *screenscripts[NUMSCRIPTSCREEN];
+extern script_data *dmapscripts[NUMSCRIPTSDMAP];
+extern script_data *itemspritescripts[NUMSCRIPTSITEMSPRITE];
+extern script_data *comboscripts[NUMSCRIPTSCOMBODATA];
+
+int32_t writeffscript(PACKFILE *f, zquestheader *Header)
+{
+    dword section_id       = ID_FFSCRIPT;
+    dword section_version  = V_FFSCRIPT;
+    dword section_cversion = CV_FFSCRIPT;
+	dword zasmmeta_version = METADATA_V;
+    byte numscripts        = 0;
+    numscripts = numscripts; //to avoid unused variables warnings
+    
+    //section id
+    if(!p_mputl(section_id,f))
+    {
+        new_return(1);
+    }
+    
+    //section version info
+    if(!p_iputw(section_version,f))
+    {
+        new_return(2);
+    }
+    
+    if(!p_iputw(section_cversion,f))
+    {
+        new_return(3);
+    }
+    
+    if(!p_iputw(zasmmeta_version,f))
+    {
+        new_return(4);
+    }
+    
+    section_writer section(f);
+    
+    for(int32_t i=0; i<NUMSCRIPTFFC; i++)
+    {
+        int32_t ret = write_one_ffscript(f, Header, i, &ffscripts[i]);
         
-        for(std::map<int32_t, script_slot_data >::iterator it = playermap.begin(); it != playermap.end(); it++)
+        if(ret!=0)
         {
-            if(it->second.scriptname != "")
-            {
-                numherobindings++;
-            }
+            new_return(ret);
         }
+    }
+    
+    for(int32_t i=0; i<NUMSCRIPTITEM; i++)
+    {
+        int32_t ret = write_one_ffscript(f, Header, i, &itemscripts[i]);
         
-        if(!p_iputw(numherobindings, f))
+        if(ret!=0)
         {
-            new_return(2027);
+            new_return(ret);
         }
+    }
+    
+    for(int32_t i=0; i<NUMSCRIPTGUYS; i++)
+    {
+        int32_t ret = write_one_ffscript(f, Header, i, &guyscripts[i]);
         
-        for(std::map<int32_t, script_slot_data >::iterator it = playermap.begin(); it != playermap.end(); it++)
+        if(ret!=0)
         {
-            if(it->second.scriptname != "")
-            {
-                if(!p_iputw(it->first,f))
-                {
-                    new_return(2028);
-                }
-                
-                if(!p_iputl((int32_t)it->second.scriptname.size(), f))
-                {
-                    new_return(2029);
-                }
-                
-                if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
-                {
-                    new_return(2030);
-                }
-            }
+            new_return(ret);
         }
-	
-	//dmap scripts
-	word numdmapbindings=0;
+    }
+    
+    for(int32_t i=0; i<NUMSCRIPTWEAPONS; i++)
+    {
+        int32_t ret = write_one_ffscript(f, Header, i, &wpnscripts[i]);
         
-        for(std::map<int32_t, script_slot_data >::iterator it = dmapmap.begin(); it != dmapmap.end(); it++)
+        if(ret!=0)
         {
-            if(it->second.scriptname != "")
-            {
-                numdmapbindings++;
-            }
+            new_return(ret);
         }
+    }
+    
+    for(int32_t i=0; i<NUMSCRIPTSCREEN; i++)
+    {
+        int32_t ret = write_one_ffscript(f, Header, i, &screenscripts[i]);
         
-        if(!p_iputw(numdmapbindings, f))
+        if(ret!=0)
         {
-            new_return(2031);
+            new_return(ret);
         }
+    }
+    
+    for(int32_t i=0; i<NUMSCRIPTGLOBAL; i++)
+    {
+        int32_t ret = write_one_ffscript(f, Header, i, &globalscripts[i]);
         
-        for(std::map<int32_t, script_slot_data >::iterator it = dmapmap.begin(); it != dmapmap.end(); it++)
+        if(ret!=0)
         {
-            if(it->second.scriptname != "")
-            {
-                if(!p_iputw(it->first,f))
-                {
-                    new_return(2032);
-                }
-                
-                if(!p_iputl((int32_t)it->second.scriptname.size(), f))
-                {
-                    new_return(2033);
-                }
-                
-                if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
-                {
-                    new_return(2034);
-                }
-            }
+            new_return(ret);
         }
+    }
 	
-	//screen scripts
-	word numscreenbindings=0;
+    for(int32_t i=0; i<NUMSCRIPTPLAYER; i++)
+    {
+        int32_t ret = write_one_ffscript(f, Header, i, &playerscripts[i]);
         
-        for(std::map<int32_t, script_slot_data >::iterator it = screenmap.begin(); it != screenmap.end(); it++)
+        if(ret!=0)
         {
-            if(it->second.scriptname != "")
-            {
-                numscreenbindings++;
-            }
+            new_return(ret);
         }
+    }
+	
+    for(int32_t i=0; i<NUMSCRIPTWEAPONS; i++)
+    {
+        int32_t ret = write_one_ffscript(f, Header, i, &lwpnscripts[i]);
         
-        if(!p_iputw(numscreenbindings, f))
+        if(ret!=0)
         {
-            new_return(2035);
+            new_return(ret);
         }
+    }
+	
+	for(int32_t i=0; i<NUMSCRIPTWEAPONS; i++)
+    {
+        int32_t ret = write_one_ffscript(f, Header, i, &ewpnscripts[i]);
         
-        for(std::map<int32_t, script_slot_data >::iterator it = screenmap.begin(); it != screenmap.end(); it++)
+        if(ret!=0)
         {
-            if(it->second.scriptname != "")
-            {
-                if(!p_iputw(it->first,f))
-                {
-                    new_return(2036);
-                }
-                
-                if(!p_iputl((int32_t)it->second.scriptname.size(), f))
-                {
-                    new_return(2037);
-                }
-                
-                if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
-                {
-                    new_return(2038);
-                }
-            }
+            new_return(ret);
         }
-        //item sprite scripts
-	word numitemspritebindings=0;
+    }
+    
+	for(int32_t i=0; i<NUMSCRIPTSDMAP; i++)
+    {
+        int32_t ret = write_one_ffscript(f, Header, i, &dmapscripts[i]);
         
-        for(std::map<int32_t, script_slot_data >::iterator it = itemspritemap.begin(); it != itemspritemap.end(); it++)
+        if(ret!=0)
         {
-            if(it->second.scriptname != "")
-            {
-                numitemspritebindings++;
-            }
+            new_return(ret);
         }
+    }
+	
+	for(int32_t i=0; i<NUMSCRIPTSITEMSPRITE; i++)
+    {
+        int32_t ret = write_one_ffscript(f, Header, i, &itemspritescripts[i]);
         
-        if(!p_iputw(numitemspritebindings, f))
+        if(ret!=0)
         {
-            new_return(2039);
+            new_return(ret);
         }
+    }
+	
+	for(int32_t i=0; i<NUMSCRIPTSCOMBODATA; i++)
+    {
+        int32_t ret = write_one_ffscript(f, Header, i, &comboscripts[i]);
         
-        for(std::map<int32_t, script_slot_data >::iterator it = itemspritemap.begin(); it != itemspritemap.end(); it++)
+        if(ret!=0)
         {
-            if(it->second.scriptname != "")
-            {
-                if(!p_iputw(it->first,f))
-                {
-                    new_return(2040);
-                }
-                
-                if(!p_iputl((int32_t)it->second.scriptname.size(), f))
-                {
-                    new_return(2041);
-                }
-                
-                if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
-                {
-                    new_return(2042);
-                }
-            }
+            new_return(ret);
         }
-		
-		//combo scripts
-		word numcombobindings=0;
+    }
+	
+	if(!p_iputw(NUMSCRIPTSGENERIC,f))
+	{
+		new_return(2000);
+	}
+	for(int32_t i=0; i<NUMSCRIPTSGENERIC; i++)
+    {
+        int32_t ret = write_one_ffscript(f, Header, i, &genericscripts[i]);
         
-        for(std::map<int32_t, script_slot_data >::iterator it = comboscriptmap.begin(); it != comboscriptmap.end(); it++)
+        if(ret!=0)
         {
-            if(it->second.scriptname != "")
-            {
-                numcombobindings++;
-            }
+            new_return(ret);
         }
-		if(!p_iputw(numcombobindings, f))
+    }
+    
+    if(!p_iputl((int32_t)zScript.size(), f))
+    {
+        new_return(2001);
+    }
+    
+    if(!pfwrite((void *)zScript.c_str(), (int32_t)zScript.size(), f))
+    {
+        new_return(2002);
+    }
+    
+    word numffcbindings=0;
+    
+    for(std::map<int32_t, script_slot_data >::iterator it = ffcmap.begin(); it != ffcmap.end(); it++)
+    {
+        if(it->second.scriptname != "")
         {
-            new_return(2043);
+            numffcbindings++;
         }
-		
-        for(std::map<int32_t, script_slot_data >::iterator it = comboscriptmap.begin(); it != comboscriptmap.end(); it++)
+    }
+    
+    if(!p_iputw(numffcbindings, f))
+    {
+        new_return(2003);
+    }
+    
+    for(std::map<int32_t, script_slot_data >::iterator it = ffcmap.begin(); it != ffcmap.end(); it++)
+    {
+        if(it->second.scriptname != "")
         {
-            if(it->second.scriptname != "")
+            if(!p_iputw(it->first,f))
             {
-                if(!p_iputw(it->first,f))
-                {
-                    new_return(2044);
-                }
-                
-                if(!p_iputl((int32_t)it->second.scriptname.size(), f))
-                {
-                    new_return(2045);
-                }
-                
-                if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
-                {
-                    new_return(2046);
-                }
+                new_return(2004);
+            }
+            
+            if(!p_iputl((int32_t)it->second.scriptname.size(), f))
+            {
+                new_return(2005);
+            }
+            
+            if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
+            {
+                new_return(2006);
             }
         }
-		//generic scripts
-		word numgenericbindings=0;
-        
-        for(auto it = genericmap.begin(); it != genericmap.end(); it++)
+    }
+    
+    word numglobalbindings=0;
+    
+    for(std::map<int32_t, script_slot_data >::iterator it = globalmap.begin(); it != globalmap.end(); it++)
+    {
+        if(it->second.scriptname != "")
+        {
+            numglobalbindings++;
+        }
+    }
+    
+    if(!p_iputw(numglobalbindings, f))
+    {
+        new_return(2007);
+    }
+    
+    for(std::map<int32_t, script_slot_data >::iterator it = globalmap.begin(); it != globalmap.end(); it++)
+    {
+        if(it->second.scriptname != "")
         {
-            if(it->second.scriptname != "")
+            if(!p_iputw(it->first,f))
+            {
+                new_return(2008);
+            }
+            
+            if(!p_iputl((int32_t)it->second.scriptname.size(), f))
+            {
+                new_return(2009);
+            }
+            
+            if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
             {
-                numgenericbindings++;
+                new_return(2010);
             }
         }
-		if(!p_iputw(numgenericbindings, f))
+    }
+    
+    word numitembindings=0;
+    
+    for(std::map<int32_t, script_slot_data >::iterator it = itemmap.begin(); it != itemmap.end(); it++)
+    {
+        if(it->second.scriptname != "")
         {
-            new_return(2043);
+            numitembindings++;
         }
-		
-        for(auto it = genericmap.begin(); it != genericmap.end(); it++)
+    }
+    
+    if(!p_iputw(numitembindings, f))
+    {
+        new_return(2011);
+    }
+    
+    for(std::map<int32_t, script_slot_data >::iterator it = itemmap.begin(); it != itemmap.end(); it++)
+    {
+        if(it->second.scriptname != "")
         {
-            if(it->second.scriptname != "")
+            if(!p_iputw(it->first,f))
             {
-                if(!p_iputw(it->first,f))
-                {
-                    new_return(2044);
-                }
-                
-                if(!p_iputl((int32_t)it->second.scriptname.size(), f))
-                {
-                    new_return(2045);
-                }
-                
-                if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
-                {
-                    new_return(2046);
-                }
+                new_return(2012);
+            }
+            
+            if(!p_iputl((int32_t)it->second.scriptname.size(), f))
+            {
+                new_return(2013);
+            }
+            
+            if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
+            {
+                new_return(2014);
             }
         }
-        
-        if(writecycle==0)
+    }
+    
+    //new script types
+    //npc scripts
+    word numnpcbindings=0;
+    
+    for(std::map<int32_t, script_slot_data >::iterator it = npcmap.begin(); it != npcmap.end(); it++)
+    {
+        if(it->second.scriptname != "")
         {
-            section_size=writesize;
+            numnpcbindings++;
         }
     }
     
-        
+    if(!p_iputw(numnpcbindings, f))
+    {
+        new_return(2015);
+    }
     
-    if(writesize!=int32_t(section_size) && save_warn)
+    for(std::map<int32_t, script_slot_data >::iterator it = npcmap.begin(); it != npcmap.end(); it++)
     {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writeffscript()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+        if(it->second.scriptname != "")
+        {
+            if(!p_iputw(it->first,f))
+            {
+                new_return(2016);
+            }
+            
+            if(!p_iputl((int32_t)it->second.scriptname.size(), f))
+            {
+                new_return(2017);
+            }
+            
+            if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
+            {
+                new_return(2018);
+            }
+        }
     }
     
-    new_return(0);
-    //return 0;  //this is just here to stomp the compiler from whining.
-    //the irony is that it causes an "unreachable code" warning.
-}
+    //lweapon
 
-int32_t write_one_ffscript(PACKFILE *f, zquestheader *Header, int32_t i, script_data **script)
-{
-    //these are here to bypass compiler warnings about unused arguments
-    Header=Header;
-    i=i;
+word numlwpnbindings=0;
     
-    int32_t num_commands = (*script)->size();
+    for(std::map<int32_t, script_slot_data >::iterator it = lwpnmap.begin(); it != lwpnmap.end(); it++)
+    {
+        if(it->second.scriptname != "")
+        {
+            numlwpnbindings++;
+        }
+    }
     
-    if(!p_iputl(num_commands,f))
+    if(!p_iputw(numlwpnbindings, f))
     {
-        new_return(6);
+        new_return(2019);
     }
-	
-	//Metadata
-	if(!p_iputw((*script)->meta.zasm_v,f))
-	{
-		new_return(7);
-	}
-	
-	if(!p_iputw((*script)->meta.meta_v,f))
-	{
-		new_return(8);
-	}
-	
-	if(!p_iputw((*script)->meta.ffscript_v,f))
-	{
-		new_return(9);
-	}
-	
-	if(!p_putc((*script)->meta.script_type,f))
-	{
-		new_return(10);
-	}
-	
-	for(int32_t q = 0; q < 8; ++q)
-	{
-		for(int32_t c = 0; c < 33; ++c)
-		{
-			if(!p_putc((*script)->meta.run_idens[q][c],f))
-			{
-				new_return(11);
-			}
-		}
-	}
-	
-	for(int32_t q = 0; q < 8; ++q)
-	{
-		if(!p_putc((*script)->meta.run_types[q],f))
-		{
-			new_return(12);
-		}
-	}
-	
-	if(!p_putc((*script)->meta.flags,f))
-	{
-		new_return(13);
-	}
-	
-	if(!p_iputw((*script)->meta.compiler_v1,f))
-	{
-		new_return(14);
-	}
-	
-	if(!p_iputw((*script)->meta.compiler_v2,f))
-	{
-		new_return(15);
-	}
-	
-	if(!p_iputw((*script)->meta.compiler_v3,f))
-	{
-		new_return(16);
-	}
-	
-	if(!p_iputw((*script)->meta.compiler_v4,f))
-	{
-		new_return(17);
-	}
-	
-	for(int32_t c = 0; c < 33; ++c)
-	{
-		if(!p_putc((*script)->meta.script_name[c],f))
-		{
-			new_return(18);
-		}
-	}
-	
-	for(int32_t c = 0; c < 33; ++c)
-	{
-		if(!p_putc((*script)->meta.author[c],f))
-		{
-			new_return(19);
-		}
-	}
-	
-    for(int32_t j=0; j<num_commands; j++)
+    
+    for(std::map<int32_t, script_slot_data >::iterator it = lwpnmap.begin(); it != lwpnmap.end(); it++)
     {
-        
-        if(!p_iputw((*script)->zasm[j].command,f))
+        if(it->second.scriptname != "")
         {
-            new_return(20);
+            if(!p_iputw(it->first,f))
+            {
+                new_return(2020);
+            }
+            
+            if(!p_iputl((int32_t)it->second.scriptname.size(), f))
+            {
+                new_return(2021);
+            }
+            
+            if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
+            {
+                new_return(2022);
+            }
         }
-        
-        if((*script)->zasm[j].command==0xFFFF)
+    }
+
+//////
+
+//eweapon
+
+
+    word numewpnbindings=0;
+    
+    for(std::map<int32_t, script_slot_data >::iterator it = ewpnmap.begin(); it != ewpnmap.end(); it++)
+    {
+        if(it->second.scriptname != "")
         {
-            break;
+            numewpnbindings++;
         }
-        else
+    }
+    
+    if(!p_iputw(numewpnbindings, f))
+    {
+        new_return(2023);
+    }
+    
+    for(std::map<int32_t, script_slot_data >::iterator it = ewpnmap.begin(); it != ewpnmap.end(); it++)
+    {
+        if(it->second.scriptname != "")
         {
-		//al_trace("Current FFScript XCommand Being Written: %d\n", (*script)->zasm[j].command);
-            if(!p_iputl((*script)->zasm[j].arg1,f))
+            if(!p_iputw(it->first,f))
             {
-                new_return(21);
+                new_return(2024);
             }
             
-            if(!p_iputl((*script)->zasm[j].arg2,f))
+            if(!p_iputl((int32_t)it->second.scriptname.size(), f))
             {
-                new_return(22);
+                new_return(2025);
+            }
+            
+            if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
+            {
+                new_return(2026);
             }
         }
     }
-    
-    new_return(0);
-}
-
-extern SAMPLE customsfxdata[WAV_COUNT];
-extern uint8_t customsfxflag[WAV_COUNT>>3];
 
-int32_t writesfx(PACKFILE *f, zquestheader *Header)
-{
-    //these are here to bypass compiler warnings about unused arguments
-    Header=Header;
-    
-    dword section_id=ID_SFX;
-    dword section_version=V_SFX;
-    dword section_cversion=CV_SFX;
-    dword section_size=0;
+//player scripts
+word numherobindings=0;
     
-    //section id
-    if(!p_mputl(section_id,f))
+    for(std::map<int32_t, script_slot_data >::iterator it = playermap.begin(); it != playermap.end(); it++)
     {
-        new_return(1);
+        if(it->second.scriptname != "")
+        {
+            numherobindings++;
+        }
     }
     
-    //section version info
-    if(!p_iputw(section_version,f))
+    if(!p_iputw(numherobindings, f))
     {
-        new_return(2);
+        new_return(2027);
     }
     
-    if(!p_iputw(section_cversion,f))
+    for(std::map<int32_t, script_slot_data >::iterator it = playermap.begin(); it != playermap.end(); it++)
     {
-        new_return(3);
+        if(it->second.scriptname != "")
+        {
+            if(!p_iputw(it->first,f))
+            {
+                new_return(2028);
+            }
+            
+            if(!p_iputl((int32_t)it->second.scriptname.size(), f))
+            {
+                new_return(2029);
+            }
+            
+            if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
+            {
+                new_return(2030);
+            }
+        }
     }
+
+//dmap scripts
+word numdmapbindings=0;
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    for(std::map<int32_t, script_slot_data >::iterator it = dmapmap.begin(); it != dmapmap.end(); it++)
     {
-        fake_pack_writing=(writecycle==0);
-        
-        //section size
-        if(!p_iputl(section_size,f))
+        if(it->second.scriptname != "")
         {
-            new_return(4);
+            numdmapbindings++;
         }
-        
-        writesize=0;
-        
-        for(int32_t i=0; i<WAV_COUNT>>3; i++)
+    }
+    
+    if(!p_iputw(numdmapbindings, f))
+    {
+        new_return(2031);
+    }
+    
+    for(std::map<int32_t, script_slot_data >::iterator it = dmapmap.begin(); it != dmapmap.end(); it++)
+    {
+        if(it->second.scriptname != "")
         {
-            if(!p_putc(customsfxflag[i],f))
+            if(!p_iputw(it->first,f))
             {
-                new_return(5);
+                new_return(2032);
             }
-        }
-        
-        for(int32_t i=1; i<WAV_COUNT; i++)
-        {
-            if(get_bit(customsfxflag, i-1) == 0)
-                continue;
-                
-            if(!pfwrite(sfx_string[i], 36, f))
+            
+            if(!p_iputl((int32_t)it->second.scriptname.size(), f))
+            {
+                new_return(2033);
+            }
+            
+            if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
             {
-                new_return(5);
+                new_return(2034);
             }
         }
-        
-        for(int32_t i=1; i<WAV_COUNT; i++)
+    }
+
+//screen scripts
+word numscreenbindings=0;
+    
+    for(std::map<int32_t, script_slot_data >::iterator it = screenmap.begin(); it != screenmap.end(); it++)
+    {
+        if(it->second.scriptname != "")
         {
-            if(get_bit(customsfxflag, i-1) == 0)
-                continue;
-                
-            if(!p_iputl(customsfxdata[i].bits,f))
+            numscreenbindings++;
+        }
+    }
+    
+    if(!p_iputw(numscreenbindings, f))
+    {
+        new_return(2035);
+    }
+    
+    for(std::map<int32_t, script_slot_data >::iterator it = screenmap.begin(); it != screenmap.end(); it++)
+    {
+        if(it->second.scriptname != "")
+        {
+            if(!p_iputw(it->first,f))
             {
-                new_return(5);
+                new_return(2036);
             }
             
-            if(!p_iputl(customsfxdata[i].stereo,f))
+            if(!p_iputl((int32_t)it->second.scriptname.size(), f))
             {
-                new_return(6);
+                new_return(2037);
             }
             
-            if(!p_iputl(customsfxdata[i].freq,f))
+            if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
             {
-                new_return(7);
+                new_return(2038);
             }
-            
-            if(!p_iputl(customsfxdata[i].priority,f))
+        }
+    }
+    //item sprite scripts
+word numitemspritebindings=0;
+    
+    for(std::map<int32_t, script_slot_data >::iterator it = itemspritemap.begin(); it != itemspritemap.end(); it++)
+    {
+        if(it->second.scriptname != "")
+        {
+            numitemspritebindings++;
+        }
+    }
+    
+    if(!p_iputw(numitemspritebindings, f))
+    {
+        new_return(2039);
+    }
+    
+    for(std::map<int32_t, script_slot_data >::iterator it = itemspritemap.begin(); it != itemspritemap.end(); it++)
+    {
+        if(it->second.scriptname != "")
+        {
+            if(!p_iputw(it->first,f))
             {
-                new_return(8);
+                new_return(2040);
             }
             
-            if(!p_iputl(customsfxdata[i].len,f))
+            if(!p_iputl((int32_t)it->second.scriptname.size(), f))
             {
-                new_return(9);
+                new_return(2041);
             }
             
-            if(!p_iputl(customsfxdata[i].loop_start,f))
+            if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
             {
-                new_return(10);
+                new_return(2042);
             }
-            
-            if(!p_iputl(customsfxdata[i].loop_end,f))
+        }
+    }
+	
+	//combo scripts
+	word numcombobindings=0;
+    
+    for(std::map<int32_t, script_slot_data >::iterator it = comboscriptmap.begin(); it != comboscriptmap.end(); it++)
+    {
+        if(it->second.scriptname != "")
+        {
+            numcombobindings++;
+        }
+    }
+	if(!p_iputw(numcombobindings, f))
+    {
+        new_return(2043);
+    }
+	
+    for(std::map<int32_t, script_slot_data >::iterator it = comboscriptmap.begin(); it != comboscriptmap.end(); it++)
+    {
+        if(it->second.scriptname != "")
+        {
+            if(!p_iputw(it->first,f))
             {
-                new_return(11);
+                new_return(2044);
             }
             
-            if(!p_iputl(customsfxdata[i].param,f))
+            if(!p_iputl((int32_t)it->second.scriptname.size(), f))
             {
-                new_return(12);
+                new_return(2045);
             }
             
-            //de-endianfy the data
-            int32_t wordstowrite = (customsfxdata[i].bits==8?1:2)*(customsfxdata[i].stereo==0?1:2)*customsfxdata[i].len/sizeof(word);
-            
-            for(int32_t j=0; j<wordstowrite; j++)
+            if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
             {
-                if(!p_iputw(((word *)customsfxdata[i].data)[j],f))
-                {
-                    new_return(13);
-                }
+                new_return(2046);
             }
         }
-        
-        if(writecycle==0)
+    }
+	//generic scripts
+	word numgenericbindings=0;
+    
+    for(auto it = genericmap.begin(); it != genericmap.end(); it++)
+    {
+        if(it->second.scriptname != "")
         {
-            section_size=writesize;
+            numgenericbindings++;
         }
     }
-    
-    if(writesize!=int32_t(section_size) && save_warn)
+	if(!p_iputw(numgenericbindings, f))
     {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writesfx()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+        new_return(2043);
     }
-    
-    new_return(0);
-}
-
-int32_t writeinitdata(PACKFILE *f, zquestheader *Header)
-{
-	//these are here to bypass compiler warnings about unused arguments
-	Header=Header;
-	
-	dword section_id=ID_INITDATA;
-	dword section_version=V_INITDATA;
-	dword section_cversion=CV_INITDATA;
-	dword section_size = 0;
-	
-	zinit.last_map=Map.getCurrMap();
-	zinit.last_screen=Map.getCurrScr();
-	zinit.usecustomsfx=1;
-	
-	//section id
-	if(!p_mputl(section_id,f))
-	{
-		new_return(1);
-	}
-	
-	//section version info
-	if(!p_iputw(section_version,f))
-	{
-		new_return(2);
-	}
-	
-	if(!p_iputw(section_cversion,f))
-	{
-		new_return(3);
-	}
-	
-	for(int32_t writecycle=0; writecycle<2; ++writecycle)
-	{
-		fake_pack_writing=(writecycle==0);
-		
-		//section size
-		if(!p_iputl(section_size,f))
-		{
-			new_return(4);
-		}
-		
-		writesize=0;
-		
-		//finally...  section data
-		//write the new items
-		for(int32_t i=0; i<MAXITEMS; i++)
-		{
-			if(!p_putc(zinit.items[i] ? 1 : 0, f))
-			{
-				new_return(5);
-			}
-		}
-		
-		if(!p_putc(zinit.hc,f))
-		{
-			new_return(25);
-		}
-		
-		if(!p_iputw(zinit.start_heart,f))
-		{
-			new_return(26);
-		}
-		
-		if(!p_iputw(zinit.cont_heart,f))
-		{
-			new_return(27);
-		}
-		
-		if(!p_putc(zinit.hcp,f))
-		{
-			new_return(28);
-		}
-		
-		if(!p_putc(zinit.hcp_per_hc,f))
-		{
-			new_return(29);
-		}
-		
-		if(!p_putc(zinit.keys,f))
-		{
-			new_return(31);
-		}
-		
-		if(!p_iputw(zinit.rupies,f))
-		{
-			new_return(32);
-		}
-		
-		if(!p_putc(zinit.triforce,f))
-		{
-			new_return(33);
-		}
-		
-		for(int32_t i=0; i<64; i++)
-		{
-			if(!p_putc(zinit.map[i],f))
-			{
-				new_return(34);
-			}
-		}
-		
-		for(int32_t i=0; i<64; i++)
-		{
-			if(!p_putc(zinit.compass[i],f))
-			{
-				new_return(35);
-			}
-		}
-		
-		for(int32_t i=0; i<64; i++)
-		{
-			if(!p_putc(zinit.boss_key[i],f))
-			{
-				new_return(36);
-			}
-		}
-		
-		for(int32_t i=0; i<16; i++)
-		{
-			if(!p_putc(zinit.misc[i],f))
-			{
-				new_return(37);
-			}
-		}
-		
-		if(!p_putc(zinit.last_map,f))
-		{
-			new_return(38);
-		}
-		
-		if(!p_putc(zinit.last_screen,f))
-		{
-			new_return(39);
-		}
-		
-		if(!p_iputw(zinit.max_magic,f))
-		{
-			new_return(40);
-		}
-		
-		if(!p_iputw(zinit.magic,f))
-		{
-			new_return(41);
-		}
-		
-		if(!p_putc(zinit.bomb_ratio,f))
-		{
-			new_return(41);
-		}
-		
-		if(!p_putc(zinit.msg_more_x,f))
-		{
-			new_return(42);
-		}
-		
-		if(!p_putc(zinit.msg_more_y,f))
-		{
-			new_return(43);
-		}
-		
-		if(!p_putc(zinit.subscreen,f))
-		{
-			new_return(44);
-		}
-		
-		if(!p_iputw(zinit.start_dmap,f))
-		{
-			new_return(45);
-		}
-		
-		if(!p_putc(zinit.heroAnimationStyle,f))
-		{
-			new_return(46);
-		}
-		
-		for(int32_t i=0; i<MAXLEVELS; i++)
-		{
-			if(!p_putc(zinit.level_keys[i],f))
-			{
-				new_return(49);
-			}
-		}
-		
-		if(!p_iputw(zinit.ss_grid_x,f))
-		{
-			new_return(50);
-		}
-		
-		if(!p_iputw(zinit.ss_grid_y,f))
-		{
-			new_return(51);
-		}
-		
-		if(!p_iputw(zinit.ss_grid_xofs,f))
-		{
-			new_return(52);
-		}
-		
-		if(!p_iputw(zinit.ss_grid_yofs,f))
-		{
-			new_return(53);
-		}
-		
-		if(!p_iputw(zinit.ss_grid_color,f))
-		{
-			new_return(54);
-		}
-		
-		if(!p_iputw(zinit.ss_bbox_1_color,f))
-		{
-			new_return(55);
-		}
-		
-		if(!p_iputw(zinit.ss_bbox_2_color,f))
-		{
-			new_return(56);
-		}
-		
-		if(!p_iputw(zinit.ss_flags,f))
-		{
-			new_return(57);
-		}
-		
-		if(!p_putc(zinit.subscreen_style,f))
-		{
-			new_return(58);
-		}
-		
-		if(!p_putc(zinit.usecustomsfx,f))
-		{
-			new_return(59);
-		}
-		
-		if(!p_iputw(zinit.max_rupees,f))
-		{
-			new_return(60);
-		}
-		
-		if(!p_iputw(zinit.max_keys,f))
-		{
-			new_return(61);
-		}
-		
-		if(!p_putc(zinit.gravity,f))
-		{
-			new_return(62);
-		}
-		
-		if(!p_iputw(zinit.terminalv,f))
-		{
-			new_return(63);
-		}
-		
-		if(!p_putc(zinit.msg_speed,f))
-		{
-			new_return(64);
-		}
-		
-		if(!p_putc(zinit.transition_type,f))
-		{
-			new_return(65);
-		}
-		
-		if(!p_putc(zinit.jump_hero_layer_threshold,f))
-		{
-			new_return(66);
-		}
-		
-		if(!p_putc(zinit.msg_more_is_offset,f))
-		{
-			new_return(67);
-		}
 	
-		if(!p_iputw(zinit.bombs,f))
-		{
-			new_return(68);
-		}
-		if(!p_iputw(zinit.super_bombs,f))
-		{
-			new_return(69);
-		}
-		if(!p_iputw(zinit.max_bombs,f))
-		{
-			new_return(70);
-		}
-		if(!p_iputw(zinit.max_sbombs,f))
-		{
-			new_return(71);
-		}
-		if(!p_iputw(zinit.arrows,f))
-		{
-			new_return(72);
-		}
-		if(!p_iputw(zinit.max_arrows,f))
-		{
-			new_return(73);
-		}
-		if(!p_iputw(zinit.heroStep,f))
-		{
-			new_return(73);
-		}
-		if(!p_iputw(zinit.subscrSpeed,f))
-		{
-			new_return(74);
-		}
+    for(auto it = genericmap.begin(); it != genericmap.end(); it++)
+    {
+        if(it->second.scriptname != "")
+        {
+            if(!p_iputw(it->first,f))
+            {
+                new_return(2044);
+            }
+            
+            if(!p_iputl((int32_t)it->second.scriptname.size(), f))
+            {
+                new_return(2045);
+            }
+            
+            if(!pfwrite((void *)it->second.scriptname.c_str(), (int32_t)it->second.scriptname.size(),f))
+            {
+                new_return(2046);
+            }
+        }
+    }
+    
+    //section size, then the buffered section data
+    if(!section.commit())
+    {
+        new_return(5);
+    }
+    
+    new_return(0);
+    //return 0;  //this is just here to stomp the compiler from whining.
+    //the irony is that it causes an "unreachable code" warning.
+}
 
-		if(!p_putc(zinit.hp_per_heart,f))
-		{
-			new_return(75);
-		}
-		if(!p_putc(zinit.magic_per_block,f))
-		{
-			new_return(76);
-		}
-		if(!p_putc(zinit.hero_damage_multiplier,f))
-		{
-			new_return(77);
-		}
-		if(!p_putc(zinit.ene_damage_multiplier,f))
-		{
-			new_return(78);
-		}
-		for(int32_t q = 0; q < 25; ++q)
-		{
-			if(!p_iputw(zinit.scrcnt[q],f))
-			{
-				new_return(79);
-			}
-		}
-		for(int32_t q = 0; q < 25; ++q)
+int32_t write_one_ffscript(PACKFILE *f, zquestheader *Header, int32_t i, script_data **script)
+{
+    //these are here to bypass compiler warnings about unused arguments
+    Header=Header;
+    i=i;
+    
+    int32_t num_commands = (*script)->size();
+    
+    if(!p_iputl(num_commands,f))
+    {
+        new_return(6);
+    }
+	
+	//Metadata
+	if(!p_iputw((*script)->meta.zasm_v,f))
+	{
+		new_return(7);
+	}
+	
+	if(!p_iputw((*script)->meta.meta_v,f))
+	{
+		new_return(8);
+	}
+	
+	if(!p_iputw((*script)->meta.ffscript_v,f))
+	{
+		new_return(9);
+	}
+	
+	if(!p_putc((*script)->meta.script_type,f))
+	{
+		new_return(10);
+	}
+	
+	for(int32_t q = 0; q < 8; ++q)
+	{
+		for(int32_t c = 0; c < 33; ++c)
 		{
-			if(!p_iputw(zinit.scrmaxcnt[q],f))
+			if(!p_putc((*script)->meta.run_idens[q][c],f))
 			{
-				new_return(80);
+				new_return(11);
 			}
 		}
-		if(!p_putc(zinit.dither_type,f))
-		{
-			new_return(81);
-		}
-		if(!p_putc(zinit.dither_arg,f))
-		{
-			new_return(82);
-		}
-		if(!p_putc(zinit.dither_percent,f))
-		{
-			new_return(83);
-		}
-		if(!p_putc(zinit.def_lightrad,f))
-		{
-			new_return(84);
-		}
-		if(!p_putc(zinit.transdark_percent,f))
-		{
-			new_return(85);
-		}
-		
-		if(!p_putc(zinit.darkcol,f))
+	}
+	
+	for(int32_t q = 0; q < 8; ++q)
+	{
+		if(!p_putc((*script)->meta.run_types[q],f))
 		{
-			new_return(86);
+			new_return(12);
 		}
-		
-		if(!p_iputl(zinit.gravity2,f))
+	}
+	
+	if(!p_putc((*script)->meta.flags,f))
+	{
+		new_return(13);
+	}
+	
+	if(!p_iputw((*script)->meta.compiler_v1,f))
+	{
+		new_return(14);
+	}
+	
+	if(!p_iputw((*script)->meta.compiler_v2,f))
+	{
+		new_return(15);
+	}
+	
+	if(!p_iputw((*script)->meta.compiler_v3,f))
+	{
+		new_return(16);
+	}
+	
+	if(!p_iputw((*script)->meta.compiler_v4,f))
+	{
+		new_return(17);
+	}
+	
+	for(int32_t c = 0; c < 33; ++c)
+	{
+		if(!p_putc((*script)->meta.script_name[c],f))
 		{
-			new_return(86);
+			new_return(18);
 		}
-		if(!p_iputl(zinit.swimgravity,f))
+	}
+	
+	for(int32_t c = 0; c < 33; ++c)
+	{
+		if(!p_putc((*script)->meta.author[c],f))
 		{
-			new_return(87);
+			new_return(19);
 		}
-		if(!p_iputw(zinit.heroSideswimUpStep,f))
+	}
+	
+    for(int32_t j=0; j<num_commands; j++)
+    {
+        
+        if(!p_iputw((*script)->zasm[j].command,f))
+        {
+            new_return(20);
+        }
+        
+        if((*script)->zasm[j].command==0xFFFF)
+        {
+            break;
+        }
+        else
+        {
+		//al_trace("Current FFScript XCommand Being Written: %d\n", (*script)->zasm[j].command);
+            if(!p_iputl((*script)->zasm[j].arg1,f))
+            {
+                new_return(21);
+            }
+            
+            if(!p_iputl((*script)->zasm[j].arg2,f))
+            {
+                new_return(22);
+            }
+        }
+    }
+    
+    new_return(0);
+}
+
+extern SAMPLE customsfxdata[WAV_COUNT];
+extern uint8_t customsfxflag[WAV_COUNT>>3];
+
+int32_t writesfx(PACKFILE *f, zquestheader *Header)
+{
+    //these are here to bypass compiler warnings about unused arguments
+    Header=Header;
+    
+    dword section_id=ID_SFX;
+    dword section_version=V_SFX;
+    dword section_cversion=CV_SFX;
+    
+    //section id
+    if(!p_mputl(section_id,f))
+    {
+        new_return(1);
+    }
+    
+    //section version info
+    if(!p_iputw(section_version,f))
+    {
+        new_return(2);
+    }
+    
+    if(!p_iputw(section_cversion,f))
+    {
+        new_return(3);
+    }
+    
+    section_writer section(f);
+    
+    for(int32_t i=0; i<WAV_COUNT>>3; i++)
+    {
+        if(!p_putc(customsfxflag[i],f))
+        {
+            new_return(5);
+        }
+    }
+    
+    for(int32_t i=1; i<WAV_COUNT; i++)
+    {
+        if(get_bit(customsfxflag, i-1) == 0)
+            continue;
+            
+        if(!pfwrite(sfx_string[i], 36, f))
+        {
+            new_return(5);
+        }
+    }
+    
+    for(int32_t i=1; i<WAV_COUNT; i++)
+    {
+        if(get_bit(customsfxflag, i-1) == 0)
+            continue;
+            
+        if(!p_iputl(customsfxdata[i].bits,f))
+        {
+            new_return(5);
+        }
+        
+        if(!p_iputl(customsfxdata[i].stereo,f))
+        {
+            new_return(6);
+        }
+        
+        if(!p_iputl(customsfxdata[i].freq,f))
+        {
+            new_return(7);
+        }
+        
+        if(!p_iputl(customsfxdata[i].priority,f))
+        {
+            new_return(8);
+        }
+        
+        if(!p_iputl(customsfxdata[i].len,f))
+        {
+            new_return(9);
+        }
+        
+        if(!p_iputl(customsfxdata[i].loop_start,f))
+        {
+            new_return(10);
+        }
+        
+        if(!p_iputl(customsfxdata[i].loop_end,f))
+        {
+            new_return(11);
+        }
+        
+        if(!p_iputl(customsfxdata[i].param,f))
+        {
+            new_return(12);
+        }
+        
+        //de-endianfy the data
+        int32_t wordstowrite = (customsfxdata[i].bits==8?1:2)*(customsfxdata[i].stereo==0?1:2)*customsfxdata[i].len/sizeof(word);
+        
+        for(int32_t j=0; j<wordstowrite; j++)
+        {
+            if(!p_iputw(((word *)customsfxdata[i].data)[j],f))
+            {
+                new_return(13);
+            }
+        }
+    }
+    
+    //section size, then the buffered section data
+    if(!section.commit())
+    {
+        new_return(4);
+    }
+    
+    new_return(0);
+}
+
+int32_t writeinitdata(PACKFILE *f, zquestheader *Header)
+{
+	//these are here to bypass compiler warnings about unused arguments
+	Header=Header;
+	
+	dword section_id=ID_INITDATA;
+	dword section_version=V_INITDATA;
+	dword section_cversion=CV_INITDATA;
+	
+	zinit.last_map=Map.getCurrMap();
+	zinit.last_screen=Map.getCurrScr();
+	zinit.usecustomsfx=1;
+	
+	//section id
+	if(!p_mputl(section_id,f))
+	{
+		new_return(1);
+	}
+	
+	//section version info
+	if(!p_iputw(section_version,f))
+	{
+		new_return(2);
+	}
+	
+	if(!p_iputw(section_cversion,f))
+	{
+		new_return(3);
+	}
+	
+	section_writer section(f);
+	
+	//finally...  section data
+	//write the new items
+	for(int32_t i=0; i<MAXITEMS; i++)
+	{
+		if(!p_putc(zinit.items[i] ? 1 : 0, f))
 		{
-			new_return(88);
+			new_return(5);
 		}
-		if(!p_iputw(zinit.heroSideswimSideStep,f))
+	}
+	
+	if(!p_putc(zinit.hc,f))
+	{
+		new_return(25);
+	}
+	
+	if(!p_iputw(zinit.start_heart,f))
+	{
+		new_return(26);
+	}
+	
+	if(!p_iputw(zinit.cont_heart,f))
+	{
+		new_return(27);
+	}
+	
+	if(!p_putc(zinit.hcp,f))
+	{
+		new_return(28);
+	}
+	
+	if(!p_putc(zinit.hcp_per_hc,f))
+	{
+		new_return(29);
+	}
+	
+	if(!p_putc(zinit.keys,f))
+	{
+		new_return(31);
+	}
+	
+	if(!p_iputw(zinit.rupies,f))
+	{
+		new_return(32);
+	}
+	
+	if(!p_putc(zinit.triforce,f))
+	{
+		new_return(33);
+	}
+	
+	for(int32_t i=0; i<64; i++)
+	{
+		if(!p_putc(zinit.map[i],f))
 		{
-			new_return(88);
+			new_return(34);
 		}
-		if(!p_iputw(zinit.heroSideswimDownStep,f))
+	}
+	
+	for(int32_t i=0; i<64; i++)
+	{
+		if(!p_putc(zinit.compass[i],f))
 		{
-			new_return(88);
+			new_return(35);
 		}
-		if(!p_iputl(zinit.exitWaterJump,f))
+	}
+	
+	for(int32_t i=0; i<64; i++)
+	{
+		if(!p_putc(zinit.boss_key[i],f))
 		{
-			new_return(89);
+			new_return(36);
 		}
-		if(!p_iputl(zinit.bunny_ltm,f))
+	}
+	
+	for(int32_t i=0; i<16; i++)
+	{
+		if(!p_putc(zinit.misc[i],f))
 		{
-			new_return(90);
+			new_return(37);
 		}
-		if(!p_putc(zinit.switchhookstyle,f))
+	}
+	
+	if(!p_putc(zinit.last_map,f))
+	{
+		new_return(38);
+	}
+	
+	if(!p_putc(zinit.last_screen,f))
+	{
+		new_return(39);
+	}
+	
+	if(!p_iputw(zinit.max_magic,f))
+	{
+		new_return(40);
+	}
+	
+	if(!p_iputw(zinit.magic,f))
+	{
+		new_return(41);
+	}
+	
+	if(!p_putc(zinit.bomb_ratio,f))
+	{
+		new_return(41);
+	}
+	
+	if(!p_putc(zinit.msg_more_x,f))
+	{
+		new_return(42);
+	}
+	
+	if(!p_putc(zinit.msg_more_y,f))
+	{
+		new_return(43);
+	}
+	
+	if(!p_putc(zinit.subscreen,f))
+	{
+		new_return(44);
+	}
+	
+	if(!p_iputw(zinit.start_dmap,f))
+	{
+		new_return(45);
+	}
+	
+	if(!p_putc(zinit.heroAnimationStyle,f))
+	{
+		new_return(46);
+	}
+	
+	for(int32_t i=0; i<MAXLEVELS; i++)
+	{
+		if(!p_putc(zinit.level_keys[i],f))
 		{
-			new_return(91);
+			new_return(49);
 		}
-		if(!p_putc(zinit.magicdrainrate,f))
+	}
+	
+	if(!p_iputw(zinit.ss_grid_x,f))
+	{
+		new_return(50);
+	}
+	
+	if(!p_iputw(zinit.ss_grid_y,f))
+	{
+		new_return(51);
+	}
+	
+	if(!p_iputw(zinit.ss_grid_xofs,f))
+	{
+		new_return(52);
+	}
+	
+	if(!p_iputw(zinit.ss_grid_yofs,f))
+	{
+		new_return(53);
+	}
+	
+	if(!p_iputw(zinit.ss_grid_color,f))
+	{
+		new_return(54);
+	}
+	
+	if(!p_iputw(zinit.ss_bbox_1_color,f))
+	{
+		new_return(55);
+	}
+	
+	if(!p_iputw(zinit.ss_bbox_2_color,f))
+	{
+		new_return(56);
+	}
+	
+	if(!p_iputw(zinit.ss_flags,f))
+	{
+		new_return(57);
+	}
+	
+	if(!p_putc(zinit.subscreen_style,f))
+	{
+		new_return(58);
+	}
+	
+	if(!p_putc(zinit.usecustomsfx,f))
+	{
+		new_return(59);
+	}
+	
+	if(!p_iputw(zinit.max_rupees,f))
+	{
+		new_return(60);
+	}
+	
+	if(!p_iputw(zinit.max_keys,f))
+	{
+		new_return(61);
+	}
+	
+	if(!p_putc(zinit.gravity,f))
+	{
+		new_return(62);
+	}
+	
+	if(!p_iputw(zinit.terminalv,f))
+	{
+		new_return(63);
+	}
+	
+	if(!p_putc(zinit.msg_speed,f))
+	{
+		new_return(64);
+	}
+	
+	if(!p_putc(zinit.transition_type,f))
+	{
+		new_return(65);
+	}
+	
+	if(!p_putc(zinit.jump_hero_layer_threshold,f))
+	{
+		new_return(66);
+	}
+	
+	if(!p_putc(zinit.msg_more_is_offset,f))
+	{
+		new_return(67);
+	}
+
+	if(!p_iputw(zinit.bombs,f))
+	{
+		new_return(68);
+	}
+	if(!p_iputw(zinit.super_bombs,f))
+	{
+		new_return(69);
+	}
+	if(!p_iputw(zinit.max_bombs,f))
+	{
+		new_return(70);
+	}
+	if(!p_iputw(zinit.max_sbombs,f))
+	{
+		new_return(71);
+	}
+	if(!p_iputw(zinit.arrows,f))
+	{
+		new_return(72);
+	}
+	if(!p_iputw(zinit.max_arrows,f))
+	{
+		new_return(73);
+	}
+	if(!p_iputw(zinit.heroStep,f))
+	{
+		new_return(73);
+	}
+	if(!p_iputw(zinit.subscrSpeed,f))
+	{
+		new_return(74);
+	}
+
+	if(!p_putc(zinit.hp_per_heart,f))
+	{
+		new_return(75);
+	}
+	if(!p_putc(zinit.magic_per_block,f))
+	{
+		new_return(76);
+	}
+	if(!p_putc(zinit.hero_damage_multiplier,f))
+	{
+		new_return(77);
+	}
+	if(!p_putc(zinit.ene_damage_multiplier,f))
+	{
+		new_return(78);
+	}
+	for(int32_t q = 0; q < 25; ++q)
+	{
+		if(!p_iputw(zinit.scrcnt[q],f))
 		{
-			new_return(92);
+			new_return(79);
 		}
-		if(writecycle==0)
+	}
+	for(int32_t q = 0; q < 25; ++q)
+	{
+		if(!p_iputw(zinit.scrmaxcnt[q],f))
 		{
-			section_size=writesize;
+			new_return(80);
 		}
 	}
+	if(!p_putc(zinit.dither_type,f))
+	{
+		new_return(81);
+	}
+	if(!p_putc(zinit.dither_arg,f))
+	{
+		new_return(82);
+	}
+	if(!p_putc(zinit.dither_percent,f))
+	{
+		new_return(83);
+	}
+	if(!p_putc(zinit.def_lightrad,f))
+	{
+		new_return(84);
+	}
+	if(!p_putc(zinit.transdark_percent,f))
+	{
+		new_return(85);
+	}
+	
+	if(!p_putc(zinit.darkcol,f))
+	{
+		new_return(86);
+	}
+	
+	if(!p_iputl(zinit.gravity2,f))
+	{
+		new_return(86);
+	}
+	if(!p_iputl(zinit.swimgravity,f))
+	{
+		new_return(87);
+	}
+	if(!p_iputw(zinit.heroSideswimUpStep,f))
+	{
+		new_return(88);
+	}
+	if(!p_iputw(zinit.heroSideswimSideStep,f))
+	{
+		new_return(88);
+	}
+	if(!p_iputw(zinit.heroSideswimDownStep,f))
+	{
+		new_return(88);
+	}
+	if(!p_iputl(zinit.exitWaterJump,f))
+	{
+		new_return(89);
+	}
+	if(!p_iputl(zinit.bunny_ltm,f))
+	{
+		new_return(90);
+	}
+	if(!p_putc(zinit.switchhookstyle,f))
+	{
+		new_return(91);
+	}
+	if(!p_putc(zinit.magicdrainrate,f))
+	{
+		new_return(92);
+	}
 	
-	if(writesize!=int32_t(section_size) && save_warn)
+	//section size, then the buffered section data
+	if(!section.commit())
 	{
-		char ebuf[80];
-		sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-		jwin_alert("Error:  writeinitdata()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+		new_return(4);
 	}
 	
 	new_return(0);
@@ -13332,8 +12903,6 @@ int32_t writeitemdropsets(PACKFILE *f, zquestheader *Header)
     dword section_id=ID_ITEMDROPSETS;
     dword section_version=V_ITEMDROPSETS;
     dword section_cversion=CV_ITEMDROPSETS;
-    //  dword section_size=0;
-    dword section_size = 0;
     word num_item_drop_sets=count_item_drop_sets();
     
     //section id
@@ -13353,59 +12922,42 @@ int32_t writeitemdropsets(PACKFILE *f, zquestheader *Header)
         new_return(3);
     }
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    section_writer section(f);
+    
+    //finally...  section data
+    if(!p_iputw(num_item_drop_sets,f))
     {
-        fake_pack_writing=(writecycle==0);
-        
-        //section size
-        if(!p_iputl(section_size,f))
-        {
-            new_return(4);
-        }
-        
-        writesize=0;
-        
-        //finally...  section data
-        if(!p_iputw(num_item_drop_sets,f))
+        new_return(5);
+    }
+    
+    for(int32_t i=0; i<num_item_drop_sets; i++)
+    {
+        if(!pfwrite(item_drop_sets[i].name, sizeof(item_drop_sets[i].name), f))
         {
-            new_return(5);
+            new_return(6);
         }
         
-        for(int32_t i=0; i<num_item_drop_sets; i++)
+        for(int32_t j=0; j<10; ++j)
         {
-            if(!pfwrite(item_drop_sets[i].name, sizeof(item_drop_sets[i].name), f))
-            {
-                new_return(6);
-            }
-            
-            for(int32_t j=0; j<10; ++j)
-            {
-                if(!p_iputw(item_drop_sets[i].item[j],f))
-                {
-                    new_return(7);
-                }
-            }
-            
-            for(int32_t j=0; j<11; ++j)
+            if(!p_iputw(item_drop_sets[i].item[j],f))
             {
-                if(!p_iputw(item_drop_sets[i].chance[j],f))
-                {
-                    new_return(8);
-                }
+                new_return(7);
             }
         }
         
-        if(writecycle==0)
+        for(int32_t j=0; j<11; ++j)
         {
-            section_size=writesize;
+            if(!p_iputw(item_drop_sets[i].chance[j],f))
+            {
+                new_return(8);
+            }
         }
     }
     
-    if(writesize!=int32_t(section_size) && save_warn)
+    //section size, then the buffered section data
+    if(!section.commit())
     {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writeitemdropsets()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+        new_return(4);
     }
     
     new_return(0);
@@ -13416,7 +12968,6 @@ int32_t writefavorites(PACKFILE *f, zquestheader*)
     dword section_id=ID_FAVORITES;
     dword section_version=V_FAVORITES;
     dword section_cversion=CV_FAVORITES;
-    dword section_size = 0;
     
     //section id
     if(!p_mputl(section_id,f))
@@ -13435,64 +12986,46 @@ int32_t writefavorites(PACKFILE *f, zquestheader*)
         new_return(3);
     }
     
-    for(int32_t writecycle=0; writecycle<2; ++writecycle)
+    section_writer section(f);
+    
+    //finally...  section data
+    if(!p_iputw(MAXFAVORITECOMBOS,f)) // This'll probably never change, huh?
     {
-        fake_pack_writing=(writecycle==0);
-        
-        //section size
-        if(!p_iputl(section_size,f))
-        {
-            new_return(4);
-        }
-        
-        writesize=0;
-        
-        //finally...  section data
-        if(!p_iputw(MAXFAVORITECOMBOS,f)) // This'll probably never change, huh?
-        {
-            new_return(5);
-        }
-        
-        for(int32_t i=0; i<MAXFAVORITECOMBOS; i++)
-        {
-            if(!p_iputl(favorite_combos[i],f))
-            {
-                new_return(6);
-            }
-        }
-        
-        if(!p_iputw(MAXFAVORITECOMBOALIASES,f))
-        {
-            new_return(7);
-        }
-        
-        for(int32_t i=0; i<MAXFAVORITECOMBOALIASES; i++)
+        new_return(5);
+    }
+    
+    for(int32_t i=0; i<MAXFAVORITECOMBOS; i++)
+    {
+        if(!p_iputl(favorite_combos[i],f))
         {
-            if(!p_iputl(favorite_comboaliases[i],f))
-            {
-                new_return(8);
-            }
+            new_return(6);
         }
-        
-        if(writecycle==0)
+    }
+    
+    if(!p_iputw(MAXFAVORITECOMBOALIASES,f))
+    {
+        new_return(7);
+    }
+    
+    for(int32_t i=0; i<MAXFAVORITECOMBOALIASES; i++)
+    {
+        if(!p_iputl(favorite_comboaliases[i],f))
         {
-            section_size=writesize;
+            new_return(8);
         }
     }
     
-    if(writesize!=int32_t(section_size) && save_warn)
+    //section size, then the buffered section data
+    if(!section.commit())
     {
-        char ebuf[80];
-        sprintf(ebuf, "%d != %d", writesize, int32_t(section_size));
-        jwin_alert("Error:  writeitemdropsets()","writesize != section_size",ebuf,NULL,"O&K",NULL,'k',0,lfont);
+        new_return(4);
     }
     
     new_return(0);
 }
 
-int32_t save_unencoded_quest(const char *filename, bool compressed, const char *afname)
+static void prepare_quest_header()
 {
-	if(!afname) afname = filename;
 	reset_combo_animations();
 	reset_combo_animations2();
 	strcpy(header.id_str,QH_NEWIDSTR);
@@ -13508,29 +13041,161 @@ int32_t save_unencoded_quest(const char *filename, bool compressed, const char *
 	{
 		set_bit(midi_flags,i,int32_t(customtunes[i].data!=NULL));
 	}
+}
+
+static int32_t write_external_zinfo(const char *zinfofilename)
+{
+	if(!header.external_zinfo)
+		return 0;
+		
+	PACKFILE *inf = pack_fopen_password(zinfofilename, F_WRITE, "");
 	
-	char keyfilename[2048];
-	char zinfofilename[2048];
-	// word combos_used;
-	// word tiles_used;
-	replace_extension(keyfilename, filepath, "key", 2047);
-	replace_extension(zinfofilename, afname, "zinfo", 2047);
+	box_out("Writing ZInfo...");
+	if(inf)
+	{
+		int32_t ret = writezinfo(inf,ZI);
+		pack_fclose(inf);
+		
+		if(ret!=0)
+		{
+			return 2;
+		}
+		
+		box_out("okay.");
+	}
+	else box_out(" ...file failure");
+	box_eol();
+	return 0;
+}
+
+static std::vector<byte> cached_sections[qsMAX_CACHED];
+static bool cached_section_valid[qsMAX_CACHED];
+static uint64_t cached_section_hash[qsMAX_CACHED];
+
+static uint64_t hash_bytes(uint64_t h, const void *src, size_t n)
+{
+	const byte *p = (const byte*)src;
 	
+	for(; n >= 8; n -= 8, p += 8)
+	{
+		uint64_t w;
+		memcpy(&w, p, 8);
+		h = (h ^ w) * 0x100000001B3ULL;
+		h ^= h >> 29;
+	}
 	
+	for(; n; --n, ++p)
+	{
+		h = (h ^ *p) * 0x100000001B3ULL;
+	}
 	
-	box_start(1, "Saving Quest", lfont, font, true);
-	box_out("Saving Quest...");
-	box_eol();
-	box_eol();
+	return h;
+}
+
+//Tiles and combos are edited from too many places (imports, packs, the
+//tile and combo pages, scripts' default reloads) to rely on every one of
+//them calling mark_section_dirty(), so their cached bytes are also keyed
+//on a hash of the data they were serialized from.
+static uint64_t section_content_hash(int32_t section)
+{
+	uint64_t h = 0xCBF29CE484222325ULL;
 	
-	PACKFILE *f = pack_fopen_password(filename,compressed?F_WRITE_PACKED:F_WRITE, compressed ? datapwd : "");
+	switch(section)
+	{
+		case qsTILES:
+			for(int32_t i=0; i<NEWMAXTILES; ++i)
+			{
+				h = hash_bytes(h, &newtilebuf[i].format, 1);
+				
+				if(newtilebuf[i].data)
+				{
+					h = hash_bytes(h, newtilebuf[i].data, tilesize(newtilebuf[i].format));
+				}
+			}
+			break;
+			
+		case qsCOMBOS:
+			for(int32_t i=0; i<MAXCOMBOS; ++i)
+			{
+				//the animation state changes every frame while combos animate
+				newcombo c = combobuf[i];
+				c.tile = c.o_tile;
+				c.cur_frame = 0;
+				c.aclk = 0;
+				h = hash_bytes(h, &c, sizeof(newcombo));
+			}
+			break;
+	}
 	
-	if(!f)
+	return h;
+}
+
+void mark_section_dirty(int32_t section)
+{
+	cached_section_valid[section] = false;
+}
+
+void mark_all_sections_dirty()
+{
+	for(int32_t i=0; i<qsMAX_CACHED; ++i)
+	{
+		mark_section_dirty(i);
+	}
+}
+
+static int32_t write_cacheable_section(PACKFILE *f, int32_t section)
+{
+	switch(section)
+	{
+		case qsTILES:
+			return writetiles(f,header.zelda_version,header.build,0,NEWMAXTILES);
+			
+		case qsCOMBOS:
+			return writecombos(f,header.zelda_version,header.build,0,MAXCOMBOS);
+			
+		case qsSFX:
+			return writesfx(f,&header);
+			
+		case qsMIDIS:
+			return writemidis(f);
+	}
+	
+	return 1;
+}
+
+//Serializes 'section' and keeps its bytes. Timed saves pass use_cache to
+//replay those bytes instead, as long as the section was not edited since.
+static int32_t write_cached_section(PACKFILE *f, int32_t section, bool use_cache)
+{
+	std::vector<byte>& data = cached_sections[section];
+	uint64_t hash = section_content_hash(section);
+	
+	if(!use_cache || !cached_section_valid[section] || cached_section_hash[section] != hash)
+	{
+		section_writer capture(f);
+		int32_t ret = write_cacheable_section(f, section);
+		
+		if(ret!=0)
+		{
+			mark_section_dirty(section);
+			return ret;
+		}
+		
+		capture.release(data);
+		cached_section_valid[section] = true;
+		cached_section_hash[section] = hash;
+	}
+	
+	if(!data.empty() && !pfwrite(data.data(),(int32_t)data.size(),f))
 	{
-		fake_pack_writing = false;
 		return 1;
 	}
 	
+	return 0;
+}
+
+static int32_t write_quest_sections(PACKFILE *f, bool use_cache)
+{
 	box_out("Writing Header...");
 	
 	if(writeheader(f,&header)!=0)
@@ -13542,25 +13207,7 @@ int32_t save_unencoded_quest(const char *filename, bool compressed, const char *
 	box_eol();
 	
 	
-	if(header.external_zinfo)
-	{
-		PACKFILE *inf = pack_fopen_password(zinfofilename, F_WRITE, "");
-		
-		box_out("Writing ZInfo...");
-		if(inf)
-		{
-			if(writezinfo(inf,ZI)!=0)
-			{
-				new_return(2);
-			}
-			
-			pack_fclose(inf);
-			box_out("okay.");
-		}
-		else box_out(" ...file failure");
-		box_eol();
-	}
-	else
+	if(!header.external_zinfo)
 	{
 		box_out("Writing ZInfo...");
 		if(writezinfo(f,ZI)!=0)
@@ -13674,7 +13321,7 @@ int32_t save_unencoded_quest(const char *filename, bool compressed, const char *
 	
 	box_out("Writing Combos...");
 	
-	if(writecombos(f,header.zelda_version,header.build,0,MAXCOMBOS)!=0)
+	if(write_cached_section(f,qsCOMBOS,use_cache)!=0)
 	{
 		new_return(13);
 	}
@@ -13704,7 +13351,7 @@ int32_t save_unencoded_quest(const char *filename, bool compressed, const char *
 	
 	box_out("Writing Tiles...");
 	
-	if(writetiles(f,header.zelda_version,header.build,0,NEWMAXTILES)!=0)
+	if(write_cached_section(f,qsTILES,use_cache)!=0)
 	{
 		new_return(16);
 	}
@@ -13714,7 +13361,7 @@ int32_t save_unencoded_quest(const char *filename, bool compressed, const char *
 	
 	box_out("Writing MIDIs...");
 	
-	if(writemidis(f)!=0)
+	if(write_cached_section(f,qsMIDIS,use_cache)!=0)
 	{
 		new_return(17);
 	}
@@ -13784,7 +13431,7 @@ int32_t save_unencoded_quest(const char *filename, bool compressed, const char *
 	
 	box_out("Writing SFX Data...");
 	
-	if(writesfx(f,&header)!=0)
+	if(write_cached_section(f,qsSFX,use_cache)!=0)
 	{
 		new_return(24);
 	}
@@ -13812,8 +13459,12 @@ int32_t save_unencoded_quest(const char *filename, bool compressed, const char *
 	box_out("okay.");
 	box_eol();
 	
-	pack_fclose(f);
-	
+	return 0;
+}
+
+static void write_quest_keyfiles()
+{
+	char keyfilename[2048];
 	replace_extension(keyfilename, get_filename(filepath), "key", 2047);
    
 	if(header.use_keyfile&&header.dirty_password)
@@ -13893,12 +13544,174 @@ int32_t save_unencoded_quest(const char *filename, bool compressed, const char *
 		pack_fclose(fp3);
 		al_trace("Wrote ZC Player Cheats, filename: %s\n",keyfilename);
 	}
+}
+
+static int32_t save_quest_packfile(PACKFILE *f, const char *afname)
+{
+	prepare_quest_header();
 	
-	new_return(0);
+	char zinfofilename[2048];
+	replace_extension(zinfofilename, afname, "zinfo", 2047);
+	
+	box_start(1, "Saving Quest", lfont, font, true);
+	box_out("Saving Quest...");
+	box_eol();
+	box_eol();
+	
+	int32_t ret = write_external_zinfo(zinfofilename);
+	
+	if(ret==0)
+	{
+		ret = write_quest_sections(f, false);
+	}
+	
+	if(ret!=0)
+	{
+		return ret;
+	}
+	
+	write_quest_keyfiles();
+	return 0;
+}
+
+int32_t save_unencoded_quest(const char *filename, bool compressed, const char *afname)
+{
+	if(!afname) afname = filename;
+	
+	PACKFILE *f = pack_fopen_password(filename,compressed?F_WRITE_PACKED:F_WRITE, compressed ? datapwd : "");
+	
+	if(!f)
+	{
+		return 1;
+	}
+	
+	int32_t ret = save_quest_packfile(f, afname);
+	pack_fclose(f);
+	return ret;
+}
+
+//Compressed quests are packed, password-protected and 007-encoded in one pass.
+static PACKFILE *open_encoded_quest(const char *filename)
+{
+	return pack_fopen_encoded_007(filename, ((INTERNAL_VERSION + zc_oldrand()) & 0xffff) + 0x413F0000, ENC_STR, ENC_METHOD_MAX-1, true, datapwd);
+}
+
+//Quests are written to a file beside the destination, which replaces the
+//destination only once it has been written out completely.
+static void quest_temp_name(char *tmpfilename, const char *filename)
+{
+	snprintf(tmpfilename, 2048, "%s.tmp", filename);
+	tmpfilename[2047] = 0;
+}
+
+static int32_t commit_quest_file(const char *tmpfilename, const char *filename, int32_t ret, int32_t err)
+{
+	if(ret==0 && rename(tmpfilename, filename)!=0)
+	{
+		//rename() won't replace an existing file on Windows
+		if(!exists(filename) || delete_file(filename)!=0 || rename(tmpfilename, filename)!=0)
+		{
+			ret = err;
+		}
+	}
+	
+	if(ret!=0)
+	{
+		delete_file(tmpfilename);
+	}
+	
+	return ret;
+}
+
+//Timed saves snapshot the quest into memory on the editor thread, then write
+//and encode it on a worker so the editor is not blocked on disk I/O.
+static std::thread timed_save_thread;
+static std::atomic<bool> timed_save_done(true);
+static int32_t timed_save_result = 0;
+
+static void timed_save_worker(PACKFILE *f, std::vector<byte> data, bool compress, std::string tmpfilename, std::string filename)
+{
+	int32_t ret = 0;
+	int32_t err = compress ? 102 : 27;
+	
+	if(!data.empty() && pack_fwrite(data.data(),(long)data.size(),f)!=(long)data.size())
+	{
+		ret = err;
+	}
+	
+	if(pack_fclose(f)!=0 && ret==0)
+	{
+		ret = err;
+	}
+	
+	timed_save_result = commit_quest_file(tmpfilename.c_str(), filename.c_str(), ret, err);
+	timed_save_done = true;
+}
+
+static int32_t start_timed_save(const char *filename, bool compress)
+{
+	prepare_quest_header();
+	
+	char zinfofilename[2048];
+	replace_extension(zinfofilename, filename, "zinfo", 2047);
+	
+	if(write_external_zinfo(zinfofilename)!=0)
+	{
+		return 2;
+	}
+	
+	std::vector<byte> data;
+	{
+		section_writer snapshot(NULL);
+		int32_t ret = write_quest_sections(NULL, true);
+		
+		if(ret!=0)
+		{
+			return ret;
+		}
+		
+		snapshot.release(data);
+	}
+	
+	write_quest_keyfiles();
+	
+	char tmpfilename[2048];
+	quest_temp_name(tmpfilename, filename);
+	
+	//opened here rather than on the worker; allegro tracks the packfile password globally
+	PACKFILE *f = compress ? open_encoded_quest(tmpfilename) : pack_fopen_password(tmpfilename, F_WRITE, "");
+	
+	if(!f)
+	{
+		return compress ? 102 : 1;
+	}
+	
+	timed_save_done = false;
+	timed_save_thread = std::thread(timed_save_worker, f, std::move(data), compress, std::string(tmpfilename), std::string(filename));
+	return 0;
+}
+
+bool timed_save_finished()
+{
+	return timed_save_thread.joinable() && timed_save_done;
+}
+
+int32_t finish_timed_save()
+{
+	if(!timed_save_thread.joinable())
+	{
+		return 0;
+	}
+	
+	timed_save_thread.join();
+	return timed_save_result;
 }
 
 int32_t save_quest(const char *filename, bool timed_save)
 {
+	//never let two saves touch the backup chain at once
+	finish_timed_save();
+	
 	int32_t retention=timed_save?AutoSaveRetention:AutoBackupRetention;
 	bool compress=!(timed_save&&UncompressedAutoSaves);
 	char ext1[5];
@@ -13947,42 +13760,39 @@ int32_t save_quest(const char *filename, bool timed_save)
 		}
 	}
 	
-	char *tmpfilename;
-	char tempfilestr[32]; // This is stupid...
+	if(timed_save)
+	{
+		return start_timed_save(filename, compress);
+	}
+	
+	char tmpfilename[2048];
+	quest_temp_name(tmpfilename, filename);
 	
-	if(compress)
+	if(!compress)
 	{
-		temp_name(tempfilestr);
-		tmpfilename=tempfilestr;
+		return commit_quest_file(tmpfilename, filename, save_unencoded_quest(tmpfilename, false, filename), 27);
 	}
-	else
+	
+	PACKFILE *f = open_encoded_quest(tmpfilename);
+	
+	if(!f)
 	{
-		tmpfilename=(char *)filename;
+		return 102;
 	}
 	
-	int32_t ret;
-	ret  = save_unencoded_quest(tmpfilename, compress, filename);
+	int32_t ret = save_quest_packfile(f, filename);
+	
+	box_out("Encrypting...");
 	
-	if(compress)
+	if(pack_fclose(f)!=0 && ret==0)
 	{
-		if(ret == 0)
-		{
-			box_out("Encrypting...");
-			ret = encode_file_007(tmpfilename, filename,((INTERNAL_VERSION + zc_oldrand()) & 0xffff) + 0x413F0000, ENC_STR, ENC_METHOD_MAX-1);
-			
-			if(ret)
-			{
-				ret += 100;
-			}
-			
-			box_out("okay.");
-			box_eol();
-		}
-		
-		delete_file(tmpfilename);
+		ret = 102;
 	}
 	
-	return ret;
+	box_out("okay.");
+	box_eol();
+	
+	return commit_quest_file(tmpfilename, filename, ret, 102);
 }
 
 void center_zq_class_dialogs()
@@ -221,6 +221,13 @@ int32_t load_quest(const char *filename, bool compressed, bool encrypted);
 int32_t save_unencoded_quest(const char *filename, bool compressed, const char* afname = NULL);
 int32_t save_quest(const char *filename, bool timed_save);
 
+//Sections whose serialized bytes timed saves reuse until they are edited
+enum { qsTILES, qsCOMBOS, qsSFX, qsMIDIS, qsMAX_CACHED };
+void mark_section_dirty(int32_t section);
+void mark_all_sections_dirty();
+bool timed_save_finished();
+int32_t finish_timed_save();
+
 int32_t writemapscreen(PACKFILE *f, int32_t i, int32_t j);
 
 bool load_msgstrs(const char *path, int32_t startstring);
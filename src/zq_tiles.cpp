@@ -486,6 +486,9 @@ static bool nogocombos = false;
 
 void go_tiles()
 {
+	//tile moves also repoint combos
+	mark_section_dirty(qsTILES);
+	mark_section_dirty(qsCOMBOS);
 	if(nogotiles) return;
 	if(last_tile_move)
 	{
@@ -522,6 +525,8 @@ void go_tiles()
 
 void go_slide_tiles(int32_t columns, int32_t rows, int32_t top, int32_t left)
 {
+	mark_section_dirty(qsTILES);
+	
 	for(int32_t c=0; c<columns; c++)
 	{
 		for(int32_t r=0; r<rows; r++)
@@ -549,6 +554,8 @@ void go_slide_tiles(int32_t columns, int32_t rows, int32_t top, int32_t left)
 
 void comeback_tiles()
 {
+	mark_section_dirty(qsTILES);
+	mark_section_dirty(qsCOMBOS);
 	if(last_tile_move && last_tile_move->move)
 	{
 		last_tile_move->flip();
@@ -591,6 +598,7 @@ void comeback_tiles()
 
 void go_combos()
 {
+	mark_section_dirty(qsCOMBOS);
 	if(nogocombos) return;
 	if(last_combo_move)
 	{
@@ -606,6 +614,7 @@ void go_combos()
 
 void comeback_combos()
 {
+	mark_section_dirty(qsCOMBOS);
 	if(last_combo_move)
 	{
 		last_combo_move->flip();
@@ -3204,35 +3213,52 @@ int32_t grabmask=0;
 recolorState recolor=rcNone;
 PALETTE imagepal;
 
+// Where CSet 'cs' currently draws its colors from in colordata.
+// The level CSets follow the current screen's palette.
+static byte *cset_color_base(int32_t cs, int32_t level)
+{
+	if(cs==2 || cs==3 || cs==4)
+		return colordata + CSET(level * pdLEVEL + (cs-2) + pdFULL) * 3;
+	else if(cs==9)
+		return colordata + CSET(level * pdLEVEL + 3 + pdFULL) * 3;
+	else if(cs==1&&get_bit(quest_rules, qr_CSET1_LEVEL))
+		return colordata + CSET(level * pdLEVEL + poNEWCSETS) * 3;
+	else if(cs==5&&get_bit(quest_rules, qr_CSET5_LEVEL))
+		return colordata + CSET(level * pdLEVEL + poNEWCSETS + 1) * 3;
+	else if(cs==7&&get_bit(quest_rules, qr_CSET7_LEVEL))
+		return colordata + CSET(level * pdLEVEL + poNEWCSETS + 2) * 3;
+	else if(cs==8&&get_bit(quest_rules, qr_CSET8_LEVEL))
+		return colordata + CSET(level * pdLEVEL + poNEWCSETS + 3) * 3;
+	
+	return colordata + CSET(cs) * 3;
+}
+
+// Copies the RGB triplets of 'count' consecutive CSets, starting at 'first',
+// into 'dest', so the searches below don't re-resolve them per color.
+static void get_cset_colors(byte *dest, int32_t first, int32_t count)
+{
+	int32_t level=Map.CurrScr()->color;
+	
+	for(int32_t cs=first; cs<first+count; ++cs, dest+=CSET_SIZE*3)
+	{
+		memcpy(dest, cset_color_base(cs, level), CSET_SIZE*3);
+	}
+}
+
 /* bestfit_color:
-  *  Searches a palette for the color closest to the requested R, G, B value.
+  *  Searches a list of 'count' RGB triplets for the color closest to the
+  *  requested R, G, B value.
   */
-int32_t bestfit_cset_color(int32_t cs, int32_t r, int32_t g, int32_t b)
+static int32_t bestfit_color_in(byte const *colors, int32_t count, int32_t r, int32_t g, int32_t b)
 {
 	int32_t bestMatch = 0; // Color with the lowest total difference so far
 	float bestTotalDiff = 100000; // Total difference between requested color and bestMatch
 	float bestHighDiff = 100000; // Greatest difference of R, G, B between requested color and bestMatch
 	
-	for(int32_t i = 0; i < CSET_SIZE; i++)
-	{
-		byte *rgbByte;
-		
-		// This seems to be right...
-		if(cs==2 || cs==3 || cs==4)
-			rgbByte = colordata + (CSET((Map.CurrScr()->color) * pdLEVEL + (cs-2) + pdFULL) + i) * 3;
-		else if(cs==9)
-			rgbByte = colordata + (CSET((Map.CurrScr()->color) * pdLEVEL + 3 + pdFULL) + i) * 3;
-		else if(cs==1&&get_bit(quest_rules, qr_CSET1_LEVEL))
-			rgbByte = colordata + (CSET((Map.CurrScr()->color) * pdLEVEL + poNEWCSETS) + i) * 3;
-		else if(cs==5&&get_bit(quest_rules, qr_CSET5_LEVEL))
-			rgbByte = colordata + (CSET((Map.CurrScr()->color) * pdLEVEL + poNEWCSETS + 1) + i) * 3;
-		else if(cs==7&&get_bit(quest_rules, qr_CSET7_LEVEL))
-			rgbByte = colordata + (CSET((Map.CurrScr()->color) * pdLEVEL + poNEWCSETS + 2) + i) * 3;
-		else if(cs==8&&get_bit(quest_rules, qr_CSET8_LEVEL))
-			rgbByte = colordata + (CSET((Map.CurrScr()->color) * pdLEVEL + poNEWCSETS + 3) + i) * 3;
-		else
-			rgbByte = colordata + (CSET(cs)+i)*3;
-			
+	for(int32_t i = 0; i < count; i++)
+	{
+		byte const *rgbByte = colors + i*3;
+		
 		int32_t dr=r-*rgbByte;
 		int32_t dg=g-*(rgbByte+1);
 		int32_t db=b-*(rgbByte+2);
@@ -3261,71 +3287,89 @@ int32_t bestfit_cset_color(int32_t cs, int32_t r, int32_t g, int32_t b)
 	return bestMatch;
 }
 
+int32_t bestfit_cset_color(int32_t cs, int32_t r, int32_t g, int32_t b)
+{
+	byte colors[CSET_SIZE*3];
+	get_cset_colors(colors, cs, 1);
+	return bestfit_color_in(colors, CSET_SIZE, r, g, b);
+}
+
 // Same as the above, but draws from all colors in CSets 0-11.
 int32_t bestfit_cset_color_8bit(int32_t r, int32_t g, int32_t b)
 {
-	int32_t bestMatch = 0;
-	float bestTotalDiff = 100000;
-	float bestHighDiff = 100000;
-	
-	for(int32_t i = 0; i < 192; i++) // 192 colors in CSets 0-11
-	{
-		byte *rgbByte;
-		
-		int32_t cs=i>>4;
-		if(cs==2 || cs==3 || cs==4)
-			rgbByte = colordata + (CSET((Map.CurrScr()->color) * pdLEVEL + (cs-2) + pdFULL) + (i%16)) * 3;
-		else if(cs==9)
-			rgbByte = colordata + (CSET((Map.CurrScr()->color) * pdLEVEL + 3 + pdFULL) + (i%16)) * 3;
-		else if(cs==1&&get_bit(quest_rules, qr_CSET1_LEVEL))
-			rgbByte = colordata + (CSET((Map.CurrScr()->color) * pdLEVEL + poNEWCSETS) + (i%16)) * 3;
-		else if(cs==5&&get_bit(quest_rules, qr_CSET5_LEVEL))
-			rgbByte = colordata + (CSET((Map.CurrScr()->color) * pdLEVEL + poNEWCSETS + 1) + (i%16)) * 3;
-		else if(cs==7&&get_bit(quest_rules, qr_CSET7_LEVEL))
-			rgbByte = colordata + (CSET((Map.CurrScr()->color) * pdLEVEL + poNEWCSETS + 2) + (i%16)) * 3;
-		else if(cs==8&&get_bit(quest_rules, qr_CSET8_LEVEL))
-			rgbByte = colordata + (CSET((Map.CurrScr()->color) * pdLEVEL + poNEWCSETS + 3) + (i%16)) * 3;
-		else
-			rgbByte = colordata + i * 3;
-			
-		int32_t dr=r-*rgbByte;
-		int32_t dg=g-*(rgbByte+1);
-		int32_t db=b-*(rgbByte+2);
-		
-		float totalDiff = sqrt(dr*dr*0.241 + dg*dg*0.691 + db*db*0.068);
-		float highDiff = zc_max(zc_max(sqrt(dr*dr*0.241), sqrt(dg*dg*0.691)), sqrt(db*db*0.068));
-		
-		if(totalDiff==0) // Perfect match?
-			return i;
-			
-		if(totalDiff < bestTotalDiff || // Best match so far?
-		   (totalDiff == bestTotalDiff && highDiff < bestHighDiff)) // Equally good match with lower high difference?
-		{
-			bestMatch=i;
-			bestTotalDiff=totalDiff;
-			bestHighDiff=highDiff;
-		}
-	}
-	
-	return bestMatch;
+	byte colors[192*3];
+	get_cset_colors(colors, 0, 12);
+	return bestfit_color_in(colors, 192, r, g, b);
 }
 
 byte cset_reduce_table[PAL_SIZE];
 
-void calc_cset_reduce_table(PALETTE pal, int32_t cs)
+// The grab dialog recalculates the reduce table every time the CSet,
+// palette view or recolor mode changes, which means a full palette search
+// per image color each time. The last table built for each CSet (and for
+// 8-bit) is kept along with the colors it was built from, so switching back
+// and forth only costs a compare.
+struct cset_reduce_cache_entry
+{
+	bool valid;
+	RGB pal[PAL_SIZE];
+	byte colors[192*3];
+	byte table[PAL_SIZE];
+};
+
+static cset_reduce_cache_entry cset_reduce_cache[17]; // 16 CSets, then 8-bit
+
+static void build_cset_reduce_table(PALETTE pal, byte const *colors, int32_t count, byte mask, byte *dest)
 {
 	for(int32_t i=0; i<PAL_SIZE; i++)
 	{
-		cset_reduce_table[i]=(bestfit_cset_color(cs, pal[i].r, pal[i].g, pal[i].b)&0x0F);
+		// Image palettes often repeat a color (unused slots are usually
+		// black), so reuse the result for a color that was already matched.
+		int32_t j=0;
+		
+		for(; j<i; ++j)
+		{
+			if(pal[j].r==pal[i].r && pal[j].g==pal[i].g && pal[j].b==pal[i].b)
+				break;
+		}
+		
+		dest[i] = (j<i) ? dest[j] : (bestfit_color_in(colors, count, pal[i].r, pal[i].g, pal[i].b)&mask);
 	}
 }
 
-void calc_cset_reduce_table_8bit(PALETTE pal)
+static void calc_cset_reduce_table_cached(PALETTE pal, int32_t slot, byte const *colors, int32_t count, byte mask)
 {
-	for(int32_t i=0; i<PAL_SIZE; i++)
+	if(slot<0 || slot>16)
+	{
+		build_cset_reduce_table(pal, colors, count, mask, cset_reduce_table);
+		return;
+	}
+	
+	cset_reduce_cache_entry &entry = cset_reduce_cache[slot];
+	
+	if(!entry.valid || memcmp(entry.colors, colors, count*3) || memcmp(entry.pal, pal, sizeof(entry.pal)))
 	{
-		cset_reduce_table[i]=bestfit_cset_color_8bit(pal[i].r, pal[i].g, pal[i].b);
+		build_cset_reduce_table(pal, colors, count, mask, entry.table);
+		memcpy(entry.colors, colors, count*3);
+		memcpy(entry.pal, pal, sizeof(entry.pal));
+		entry.valid=true;
 	}
+	
+	memcpy(cset_reduce_table, entry.table, PAL_SIZE);
+}
+
+void calc_cset_reduce_table(PALETTE pal, int32_t cs)
+{
+	byte colors[CSET_SIZE*3];
+	get_cset_colors(colors, cs, 1);
+	calc_cset_reduce_table_cached(pal, (cs>=0 && cs<16) ? cs : -1, colors, CSET_SIZE, 0x0F);
+}
+
+void calc_cset_reduce_table_8bit(PALETTE pal)
+{
+	byte colors[192*3];
+	get_cset_colors(colors, 0, 12);
+	calc_cset_reduce_table_cached(pal, 16, colors, 192, 0xFF);
 }
 
 void puttileROM(BITMAP *dest,int32_t x,int32_t y,byte *src,int32_t cs)
@@ -3920,7 +3964,13 @@ void load_imagebuf()
 		tilecount=0;
 		create_rgb_table(&rgb_table, imagepal, NULL);
 		rgb_map = &rgb_table;
-		create_color_table(&imagepal_table, RAMpal, return_RAMpal_color, NULL);
+		
+		// Only the first row is ever read (to remap the GUI colors into the
+		// image palette), so skip building the other 255.
+		for(int32_t i=0; i<PAL_SIZE; ++i)
+		{
+			imagepal_table.data[0][i]=rgb_table.data[RAMpal[i].r>>1][RAMpal[i].g>>1][RAMpal[i].b>>1];
+		}
 		
 		if(!imagebuf)
 		{
@@ -5857,17 +5907,65 @@ int32_t tile_page_row(int32_t tile)
 
 enum {ti_none, ti_encompass, ti_broken};
 
-//striped check and striped selection
-int32_t move_intersection_ss(newcombo &cmb, int32_t selection_first, int32_t selection_last)
+// Tiles used by each combo's animation, so the used-tile table and the
+// tile move/copy checks don't have to step every combo through its
+// animation each time. An entry is checked against the fields (and
+// rules) its animation depends on before use and recomputed if any of
+// them changed, so combo edits need no explicit invalidation.
+struct combo_tile_use
 {
-	int32_t cmb_first = cmb.o_tile;
-	int32_t cmb_last = cmb.o_tile;
+	bool valid;
+	int32_t o_tile;
+	byte frames, skipanim, skipanimy;
+	bool newanim, brokenskip;
+	int32_t first, last;
+	std::vector<int32_t> tiles; //every frame's tile, first to last
+};
+
+static combo_tile_use combo_tile_uses[MAXCOMBOS];
+
+static combo_tile_use const& get_combo_tile_use(newcombo const& cmb)
+{
+	static combo_tile_use scratch;
+	int32_t cid = &cmb - combobuf;
+	combo_tile_use &use = (cid >= 0 && cid < MAXCOMBOS) ? combo_tile_uses[cid] : scratch;
+	bool newanim = get_bit(quest_rules, qr_NEW_COMBO_ANIMATION)!=0;
+	bool brokenskip = get_bit(quest_rules, qr_BROKEN_ASKIP_Y_FRAMES)!=0;
+	
+	if(use.valid && &use != &scratch && use.o_tile == cmb.o_tile && use.frames == cmb.frames
+	   && use.skipanim == cmb.skipanim && use.skipanimy == cmb.skipanimy
+	   && use.newanim == newanim && use.brokenskip == brokenskip)
+		return use;
+		
+	newcombo c = cmb;
+	reset_combo_animation(c);
+	use.tiles.clear();
+	
 	do
 	{
-		cmb_last = cmb.tile;
-		animate(cmb, true);
-	}
-	while(cmb.tile != cmb.o_tile);
+		use.tiles.push_back(c.tile);
+		animate(c, true);
+	}
+	while(c.tile != c.o_tile);
+	
+	use.valid = true;
+	use.o_tile = cmb.o_tile;
+	use.frames = cmb.frames;
+	use.skipanim = cmb.skipanim;
+	use.skipanimy = cmb.skipanimy;
+	use.newanim = newanim;
+	use.brokenskip = brokenskip;
+	use.first = cmb.o_tile;
+	use.last = use.tiles.back();
+	return use;
+}
+
+//striped check and striped selection
+int32_t move_intersection_ss(newcombo &cmb, int32_t selection_first, int32_t selection_last)
+{
+	combo_tile_use const& use = get_combo_tile_use(cmb);
+	int32_t cmb_first = use.first;
+	int32_t cmb_last = use.last;
 	reset_combo_animation(cmb);
 	
 	if(cmb_first > selection_last || cmb_last < selection_first)
@@ -5949,14 +6047,9 @@ int32_t move_intersection_sr(newcombo &cmb, int32_t selection_left, int32_t sele
 {
 	if(selection_width < TILES_PER_ROW)
 	{
-		int32_t cmb_first = cmb.o_tile;
-		int32_t cmb_last = cmb.o_tile;
-		do
-		{
-			cmb_last = cmb.tile;
-			animate(cmb, true);
-		}
-		while(cmb.tile != cmb.o_tile);
+		combo_tile_use const& use = get_combo_tile_use(cmb);
+		int32_t cmb_first = use.first;
+		int32_t cmb_last = use.last;
 		reset_combo_animation(cmb);
 		
 		if((TILEROW(cmb_first)>=selection_top) &&
@@ -6318,12 +6411,12 @@ void register_used_tiles()
 		{
 			used_tile_table[t]=true;
 		} */
-		do
+		combo_tile_use const& use = get_combo_tile_use(combobuf[u]);
+		
+		for(size_t t=0; t<use.tiles.size(); ++t)
 		{
-			used_tile_table[combobuf[u].tile] = true;
-			animate(combobuf[u], true);
+			used_tile_table[use.tiles[t]] = true;
 		}
-		while(combobuf[u].tile != combobuf[u].o_tile);
 	}
 	
 	for(int32_t u=0; u<iLast; u++)
@@ -6968,7 +7061,7 @@ bool overlay_tiles_united(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t &co
 						{
 							sprintf(temptext, "%d\n", u);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -7055,7 +7148,7 @@ bool overlay_tiles_united(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t &co
 						{
 							sprintf(temptext, "%s\n", bii[u].s);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -7227,7 +7320,7 @@ bool overlay_tiles_united(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t &co
 						{
 							sprintf(temptext, "%s\n", biw[u].s);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -7263,7 +7356,7 @@ bool overlay_tiles_united(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t &co
 						{
 							sprintf(temptext, "%s Impact (not shown in sprite list)\n", (u==3)?"Arrow":"Boomerang");
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -7346,7 +7439,7 @@ bool overlay_tiles_united(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t &co
 						{
 							sprintf(temptext, "%s\n", hero_sprite_items[u].name);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -7459,7 +7552,7 @@ bool overlay_tiles_united(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t &co
 						{
 							sprintf(temptext, "%s\n", map_styles_items[u].name);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -7549,7 +7642,7 @@ bool overlay_tiles_united(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t &co
 						{
 							sprintf(temptext, "%s\n", icon_title[u]);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -7584,7 +7677,7 @@ bool overlay_tiles_united(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t &co
 				{
 					sprintf(temptext, "Quest Sword");
 					
-					if(strlen(tile_move_list_text)<65000)
+					if(!flood && strlen(tile_move_list_text)<65000)
 					{
 						strcat(tile_move_list_text, temptext);
 					}
@@ -7674,7 +7767,7 @@ bool overlay_tiles_united(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t &co
 							{
 								sprintf(temptext, "DMap %d %s\n", t, dmap_map_items[u].name);
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -7805,7 +7898,7 @@ bool overlay_tiles_united(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t &co
 						{
 							sprintf(temptext, "%s\n", bie[u].s);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -7836,7 +7929,7 @@ bool overlay_tiles_united(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t &co
 							{
 								sprintf(temptext, "%s (broken shield)\n", bie[u].s);
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -7867,7 +7960,7 @@ bool overlay_tiles_united(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t &co
 							{
 								sprintf(temptext, "%s\n", bie[u].s);
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -7928,7 +8021,7 @@ bool overlay_tiles_united(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t &co
 							{
 								sprintf(temptext, "%s\n", bie[u].s);
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -7978,7 +8071,7 @@ bool overlay_tiles_united(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t &co
 						{
 							sprintf(temptext, "%s\n", bie[u].s);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -8023,7 +8116,7 @@ bool overlay_tiles_united(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t &co
 							{
 								sprintf(temptext, "%s (%s)\n", bie[u].s, darknut?"broken shield":"secondary tiles");
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -8607,7 +8700,7 @@ bool overlay_tile_united_mass(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t
 						{
 							sprintf(temptext, "%d\n", u);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -8694,7 +8787,7 @@ bool overlay_tile_united_mass(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t
 						{
 							sprintf(temptext, "%s\n", bii[u].s);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -8866,7 +8959,7 @@ bool overlay_tile_united_mass(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t
 						{
 							sprintf(temptext, "%s\n", biw[u].s);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -8902,7 +8995,7 @@ bool overlay_tile_united_mass(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t
 						{
 							sprintf(temptext, "%s Impact (not shown in sprite list)\n", (u==3)?"Arrow":"Boomerang");
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -8985,7 +9078,7 @@ bool overlay_tile_united_mass(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t
 						{
 							sprintf(temptext, "%s\n", hero_sprite_items[u].name);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -9098,7 +9191,7 @@ bool overlay_tile_united_mass(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t
 						{
 							sprintf(temptext, "%s\n", map_styles_items[u].name);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -9188,7 +9281,7 @@ bool overlay_tile_united_mass(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t
 						{
 							sprintf(temptext, "%s\n", icon_title[u]);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -9223,7 +9316,7 @@ bool overlay_tile_united_mass(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t
 				{
 					sprintf(temptext, "Quest Sword");
 					
-					if(strlen(tile_move_list_text)<65000)
+					if(!flood && strlen(tile_move_list_text)<65000)
 					{
 						strcat(tile_move_list_text, temptext);
 					}
@@ -9313,7 +9406,7 @@ bool overlay_tile_united_mass(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t
 							{
 								sprintf(temptext, "DMap %d %s\n", t, dmap_map_items[u].name);
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -9444,7 +9537,7 @@ bool overlay_tile_united_mass(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t
 						{
 							sprintf(temptext, "%s\n", bie[u].s);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -9475,7 +9568,7 @@ bool overlay_tile_united_mass(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t
 							{
 								sprintf(temptext, "%s (broken shield)\n", bie[u].s);
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -9506,7 +9599,7 @@ bool overlay_tile_united_mass(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t
 							{
 								sprintf(temptext, "%s\n", bie[u].s);
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -9567,7 +9660,7 @@ bool overlay_tile_united_mass(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t
 							{
 								sprintf(temptext, "%s\n", bie[u].s);
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -9617,7 +9710,7 @@ bool overlay_tile_united_mass(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t
 						{
 							sprintf(temptext, "%s\n", bie[u].s);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -9662,7 +9755,7 @@ bool overlay_tile_united_mass(int32_t &tile,int32_t &tile2,int32_t &copy,int32_t
 							{
 								sprintf(temptext, "%s (%s)\n", bie[u].s, darknut?"broken shield":"secondary tiles");
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -10068,7 +10161,7 @@ bool do_movetile_united(tile_move_data const& tmd)
 						{
 							sprintf(temptext, "%d\n", u);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -10155,7 +10248,7 @@ bool do_movetile_united(tile_move_data const& tmd)
 						{
 							sprintf(temptext, "%s\n", bii[u].s);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -10327,7 +10420,7 @@ bool do_movetile_united(tile_move_data const& tmd)
 						{
 							sprintf(temptext, "%s\n", biw[u].s);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -10363,7 +10456,7 @@ bool do_movetile_united(tile_move_data const& tmd)
 						{
 							sprintf(temptext, "%s Impact (not shown in sprite list)\n", (u==3)?"Arrow":"Boomerang");
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -10446,7 +10539,7 @@ bool do_movetile_united(tile_move_data const& tmd)
 						{
 							sprintf(temptext, "%s\n", hero_sprite_items[u].name);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -10559,7 +10652,7 @@ bool do_movetile_united(tile_move_data const& tmd)
 						{
 							sprintf(temptext, "%s\n", map_styles_items[u].name);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -10649,7 +10742,7 @@ bool do_movetile_united(tile_move_data const& tmd)
 						{
 							sprintf(temptext, "%s\n", icon_title[u]);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -10684,7 +10777,7 @@ bool do_movetile_united(tile_move_data const& tmd)
 				{
 					sprintf(temptext, "Quest Sword");
 					
-					if(strlen(tile_move_list_text)<65000)
+					if(!flood && strlen(tile_move_list_text)<65000)
 					{
 						strcat(tile_move_list_text, temptext);
 					}
@@ -10774,7 +10867,7 @@ bool do_movetile_united(tile_move_data const& tmd)
 							{
 								sprintf(temptext, "DMap %d %s\n", t, dmap_map_items[u].name);
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -10905,7 +10998,7 @@ bool do_movetile_united(tile_move_data const& tmd)
 						{
 							sprintf(temptext, "%s\n", bie[u].s);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -10936,7 +11029,7 @@ bool do_movetile_united(tile_move_data const& tmd)
 							{
 								sprintf(temptext, "%s (broken shield)\n", bie[u].s);
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -10967,7 +11060,7 @@ bool do_movetile_united(tile_move_data const& tmd)
 							{
 								sprintf(temptext, "%s\n", bie[u].s);
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -11028,7 +11121,7 @@ bool do_movetile_united(tile_move_data const& tmd)
 							{
 								sprintf(temptext, "%s\n", bie[u].s);
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -11078,7 +11171,7 @@ bool do_movetile_united(tile_move_data const& tmd)
 						{
 							sprintf(temptext, "%s\n", bie[u].s);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -11123,7 +11216,7 @@ bool do_movetile_united(tile_move_data const& tmd)
 							{
 								sprintf(temptext, "%s (%s)\n", bie[u].s, darknut?"broken shield":"secondary tiles");
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -11795,7 +11888,7 @@ bool copy_tiles_united_floodfill(int32_t &tile,int32_t &tile2,int32_t &copy,int3
 						{
 							sprintf(temptext, "%d\n", u);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -11882,7 +11975,7 @@ bool copy_tiles_united_floodfill(int32_t &tile,int32_t &tile2,int32_t &copy,int3
 						{
 							sprintf(temptext, "%s\n", bii[u].s);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -12054,7 +12147,7 @@ bool copy_tiles_united_floodfill(int32_t &tile,int32_t &tile2,int32_t &copy,int3
 						{
 							sprintf(temptext, "%s\n", biw[u].s);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -12090,7 +12183,7 @@ bool copy_tiles_united_floodfill(int32_t &tile,int32_t &tile2,int32_t &copy,int3
 						{
 							sprintf(temptext, "%s Impact (not shown in sprite list)\n", (u==3)?"Arrow":"Boomerang");
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -12173,7 +12266,7 @@ bool copy_tiles_united_floodfill(int32_t &tile,int32_t &tile2,int32_t &copy,int3
 						{
 							sprintf(temptext, "%s\n", hero_sprite_items[u].name);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -12286,7 +12379,7 @@ bool copy_tiles_united_floodfill(int32_t &tile,int32_t &tile2,int32_t &copy,int3
 						{
 							sprintf(temptext, "%s\n", map_styles_items[u].name);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -12376,7 +12469,7 @@ bool copy_tiles_united_floodfill(int32_t &tile,int32_t &tile2,int32_t &copy,int3
 						{
 							sprintf(temptext, "%s\n", icon_title[u]);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -12411,7 +12504,7 @@ bool copy_tiles_united_floodfill(int32_t &tile,int32_t &tile2,int32_t &copy,int3
 				{
 					sprintf(temptext, "Quest Sword");
 					
-					if(strlen(tile_move_list_text)<65000)
+					if(!flood && strlen(tile_move_list_text)<65000)
 					{
 						strcat(tile_move_list_text, temptext);
 					}
@@ -12501,7 +12594,7 @@ bool copy_tiles_united_floodfill(int32_t &tile,int32_t &tile2,int32_t &copy,int3
 							{
 								sprintf(temptext, "DMap %d %s\n", t, dmap_map_items[u].name);
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -12632,7 +12725,7 @@ bool copy_tiles_united_floodfill(int32_t &tile,int32_t &tile2,int32_t &copy,int3
 						{
 							sprintf(temptext, "%s\n", bie[u].s);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -12663,7 +12756,7 @@ bool copy_tiles_united_floodfill(int32_t &tile,int32_t &tile2,int32_t &copy,int3
 							{
 								sprintf(temptext, "%s (broken shield)\n", bie[u].s);
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -12694,7 +12787,7 @@ bool copy_tiles_united_floodfill(int32_t &tile,int32_t &tile2,int32_t &copy,int3
 							{
 								sprintf(temptext, "%s\n", bie[u].s);
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -12755,7 +12848,7 @@ bool copy_tiles_united_floodfill(int32_t &tile,int32_t &tile2,int32_t &copy,int3
 							{
 								sprintf(temptext, "%s\n", bie[u].s);
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -12805,7 +12898,7 @@ bool copy_tiles_united_floodfill(int32_t &tile,int32_t &tile2,int32_t &copy,int3
 						{
 							sprintf(temptext, "%s\n", bie[u].s);
 							
-							if(strlen(tile_move_list_text)<65000)
+							if(!flood && strlen(tile_move_list_text)<65000)
 							{
 								strcat(tile_move_list_text, temptext);
 							}
@@ -12850,7 +12943,7 @@ bool copy_tiles_united_floodfill(int32_t &tile,int32_t &tile2,int32_t &copy,int3
 							{
 								sprintf(temptext, "%s (%s)\n", bie[u].s, darknut?"broken shield":"secondary tiles");
 								
-								if(strlen(tile_move_list_text)<65000)
+								if(!flood && strlen(tile_move_list_text)<65000)
 								{
 									strcat(tile_move_list_text, temptext);
 								}
@@ -13090,7 +13183,7 @@ bool scale_tiles(int32_t &tile, int32_t &tile2, int32_t &cs)
 			{
 				sprintf(temptext, "%d\n", u);
 				
-				if(strlen(tile_move_list_text)<65000)
+				if(!flood && strlen(tile_move_list_text)<65000)
 				{
 					strcat(tile_move_list_text, temptext);
 				}
@@ -13152,7 +13245,7 @@ bool scale_tiles(int32_t &tile, int32_t &tile2, int32_t &cs)
 			{
 				sprintf(temptext, "%s\n", bii[u].s);
 				
-				if(strlen(tile_move_list_text)<65000)
+				if(!flood && strlen(tile_move_list_text)<65000)
 				{
 					strcat(tile_move_list_text, temptext);
 				}
@@ -13300,7 +13393,7 @@ bool scale_tiles(int32_t &tile, int32_t &tile2, int32_t &cs)
 			{
 				sprintf(temptext, "%s\n", biw[u].s);
 					
-				if(strlen(tile_move_list_text)<65000)
+				if(!flood && strlen(tile_move_list_text)<65000)
 				{
 					strcat(tile_move_list_text, temptext);
 				}
@@ -13324,7 +13417,7 @@ bool scale_tiles(int32_t &tile, int32_t &tile2, int32_t &cs)
 				{
 					sprintf(temptext, "%s Impact (not shown in sprite list)\n", (u==3)?"Arrow":"Boomerang");
 					
-					if(strlen(tile_move_list_text)<65000)
+					if(!flood && strlen(tile_move_list_text)<65000)
 					{
 						strcat(tile_move_list_text, temptext);
 					}
@@ -13387,7 +13480,7 @@ bool scale_tiles(int32_t &tile, int32_t &tile2, int32_t &cs)
 			{
 				sprintf(temptext, "%s\n", hero_sprite_items[u].name);
 				
-				if(strlen(tile_move_list_text)<65000)
+				if(!flood && strlen(tile_move_list_text)<65000)
 				{
 					strcat(tile_move_list_text, temptext);
 				}
@@ -13460,7 +13553,7 @@ bool scale_tiles(int32_t &tile, int32_t &tile2, int32_t &cs)
 			{
 				sprintf(temptext, "%s\n", map_styles_items[u].name);
 				
-				if(strlen(tile_move_list_text)<65000)
+				if(!flood && strlen(tile_move_list_text)<65000)
 				{
 					strcat(tile_move_list_text, temptext);
 				}
@@ -13525,7 +13618,7 @@ bool scale_tiles(int32_t &tile, int32_t &tile2, int32_t &cs)
 			{
 				sprintf(temptext, "%s\n", icon_title[u]);
 				
-				if(strlen(tile_move_list_text)<65000)
+				if(!flood && strlen(tile_move_list_text)<65000)
 				{
 					strcat(tile_move_list_text, temptext);
 				}
@@ -13548,7 +13641,7 @@ bool scale_tiles(int32_t &tile, int32_t &tile2, int32_t &cs)
 		{
 			sprintf(temptext, "Quest Sword");
 			
-			if(strlen(tile_move_list_text)<65000)
+			if(!flood && strlen(tile_move_list_text)<65000)
 			{
 				strcat(tile_move_list_text, temptext);
 			}
@@ -13618,7 +13711,7 @@ bool scale_tiles(int32_t &tile, int32_t &tile2, int32_t &cs)
 				{
 					sprintf(temptext, "DMap %d %s\n", t, dmap_map_items[u].name);
 					
-					if(strlen(tile_move_list_text)<65000)
+					if(!flood && strlen(tile_move_list_text)<65000)
 					{
 						strcat(tile_move_list_text, temptext);
 					}
@@ -13721,7 +13814,7 @@ bool scale_tiles(int32_t &tile, int32_t &tile2, int32_t &cs)
 				{
 					sprintf(temptext, "%s\n", bie[u].s);
 					
-					if(strlen(tile_move_list_text)<65000)
+					if(!flood && strlen(tile_move_list_text)<65000)
 					{
 						strcat(tile_move_list_text, temptext);
 					}
@@ -13745,7 +13838,7 @@ bool scale_tiles(int32_t &tile, int32_t &tile2, int32_t &cs)
 					{
 						sprintf(temptext, "%s (broken shield)\n", bie[u].s);
 						
-						if(strlen(tile_move_list_text)<65000)
+						if(!flood && strlen(tile_move_list_text)<65000)
 						{
 							strcat(tile_move_list_text, temptext);
 						}
@@ -13769,7 +13862,7 @@ bool scale_tiles(int32_t &tile, int32_t &tile2, int32_t &cs)
 					{
 						sprintf(temptext, "%s\n", bie[u].s);
 						
-						if(strlen(tile_move_list_text)<65000)
+						if(!flood && strlen(tile_move_list_text)<65000)
 						{
 							strcat(tile_move_list_text, temptext);
 						}
@@ -13809,7 +13902,7 @@ bool scale_tiles(int32_t &tile, int32_t &tile2, int32_t &cs)
 					{
 						sprintf(temptext, "%s\n", bie[u].s);
 						
-						if(strlen(tile_move_list_text)<65000)
+						if(!flood && strlen(tile_move_list_text)<65000)
 						{
 							strcat(tile_move_list_text, temptext);
 						}
@@ -13845,7 +13938,7 @@ bool scale_tiles(int32_t &tile, int32_t &tile2, int32_t &cs)
 				{
 					sprintf(temptext, "%s\n", bie[u].s);
 					
-					if(strlen(tile_move_list_text)<65000)
+					if(!flood && strlen(tile_move_list_text)<65000)
 					{
 						strcat(tile_move_list_text, temptext);
 					}
@@ -13876,7 +13969,7 @@ bool scale_tiles(int32_t &tile, int32_t &tile2, int32_t &cs)
 					{
 						sprintf(temptext, "%s (%s)\n", bie[u].s, darknut?"broken shield":"secondary tiles");
 						
-						if(strlen(tile_move_list_text)<65000)
+						if(!flood && strlen(tile_move_list_text)<65000)
 						{
 							strcat(tile_move_list_text, temptext);
 						}
@@ -18062,6 +18155,11 @@ bool edit_combo(int32_t c,bool freshen,int32_t cs)
 	bool edited = call_combo_editor(c);
 	font = ofont;
 	
+	if(edited)
+	{
+		mark_section_dirty(qsCOMBOS);
+	}
+	
 	if(freshen)
 	{
 		refresh(rALL);
@@ -291,7 +291,6 @@ int32_t mouse_scroll_h;
 
 
 int32_t readsize, writesize;
-bool fake_pack_writing=false;
 
 int32_t showxypos_x;
 int32_t showxypos_y;
@@ -3575,6 +3574,7 @@ int32_t onDefault_SFX()
 	if(jwin_alert("Confirm Reset","Reset all sound effects?", NULL, NULL, "Yes", "Cancel", 'y', 27,lfont) == 1)
 	{
 		saved=false;
+		mark_section_dirty(qsSFX);
 		SAMPLE *temp_sample;
 		
 		for(int32_t i=1; i<WAV_COUNT; i++)
@@ -5205,6 +5205,24 @@ static DIALOG loadmap_dlg[] =
     {  NULL,                   0,     0,      0,      0,    0,          0,          0,    0,          0,    0,  NULL,                                NULL,   NULL  }
 };
 
+// Full size render of every screen in the map, kept while the map viewer is
+// open so that picking another resolution only has to rescale it. Nothing can
+// edit the map while the viewer is up.
+static BITMAP *bmap_screens=NULL;
+static int32_t bmap_screens_flags=-1, bmap_screens_map=-1;
+
+static void clear_bmap_screens()
+{
+    if(bmap_screens)
+    {
+        destroy_bitmap(bmap_screens);
+        bmap_screens=NULL;
+    }
+    
+    bmap_screens_flags=-1;
+    bmap_screens_map=-1;
+}
+
 int32_t load_the_map()
 {
     static int32_t res = 1;
@@ -5258,13 +5276,39 @@ int32_t load_the_map()
         return 2;
     }
     
-    for(int32_t y=0; y<8; y++)
+    if(!bmap_screens || bmap_screens_flags!=flags || bmap_screens_map!=Map.getCurrMap())
     {
-        for(int32_t x=0; x<16; x++)
+        if(!bmap_screens)
+            bmap_screens = create_bitmap_ex(8,256*16,176*8);
+            
+        bmap_screens_flags = flags;
+        bmap_screens_map = Map.getCurrMap();
+        
+        for(int32_t y=0; y<8; y++)
         {
-            Map.draw(screen2, 0, 0, flags, -1, y*16+x);
-            stretch_blit(screen2, bmap, 0, 0, 256, 176, x<<(8-res), (y*176)>>res, 256>>res,176>>res);
+            for(int32_t x=0; x<16; x++)
+            {
+                Map.draw(screen2, 0, 0, flags, -1, y*16+x);
+                
+                if(bmap_screens)
+                    blit(screen2, bmap_screens, 0, 0, x<<8, y*176, 256, 176);
+                else
+                    stretch_blit(screen2, bmap, 0, 0, 256, 176, x<<(8-res), (y*176)>>res, 256>>res,176>>res);
+            }
         }
+        
+        if(!bmap_screens)
+            bmap_screens_flags = -1;
+    }
+    
+    if(bmap_screens)
+    {
+        // the scale is a power of two, so one stretch samples the same
+        // pixels as stretching each screen on its own
+        if(res==0)
+            blit(bmap_screens, bmap, 0, 0, 0, 0, bmap->w, bmap->h);
+        else
+            stretch_blit(bmap_screens, bmap, 0, 0, bmap_screens->w, bmap_screens->h, 0, 0, bmap->w, bmap->h);
     }
     
     memcpy(mappal,RAMpal,sizeof(RAMpal));
@@ -5285,7 +5329,9 @@ int32_t onViewMap()
     ShowMisalignments=0;
     //if(load_the_map()==0)
     //{
+    clear_bmap_screens();
     launchPicViewer(&bmap,mappal,&mapx, &mapy, &mapscale,true);
+    clear_bmap_screens();
     //}
     ShowMisalignments=temp_aligns;
     return D_O_K;
@@ -5836,6 +5882,147 @@ bool isFavCmdSelected(int32_t cmd)
 	return false;
 }
 
+// While the mouse is held down in draw(), only the screen being painted and
+// its layers can change. Unless a neighbouring screen draws from one of those,
+// its preview around the edges is kept from the first refresh of the stroke
+// instead of being redrawn combo by combo every frame.
+struct edge_preview_key
+{
+	BITMAP *bmp;
+	int32_t map, scr, flags, layer;
+	int32_t layermask[7];
+	std::vector<int32_t> anim_tiles;
+	
+	bool operator==(edge_preview_key const& other) const
+	{
+		return bmp==other.bmp && map==other.map && scr==other.scr
+		       && flags==other.flags && layer==other.layer
+		       && !memcmp(layermask, other.layermask, sizeof(layermask))
+		       && anim_tiles==other.anim_tiles;
+	}
+};
+
+static BITMAP *edge_preview_bmp = NULL;
+static edge_preview_key edge_preview_cached;
+static bool edge_preview_hold = false;
+static bool edge_preview_valid = false;
+
+static void get_edge_preview_key(edge_preview_key &k)
+{
+	k.bmp=mapscreenbmp;
+	k.map=Map.getCurrMap();
+	k.scr=Map.getCurrScr();
+	k.flags=Flags;
+	k.layer=CurrentLayer;
+	memcpy(k.layermask, LayerMaskInt, sizeof(k.layermask));
+	
+	// Animated combos change their tile in place
+	k.anim_tiles.clear();
+	
+	for(word i=0; i<animated_combos; ++i)
+		k.anim_tiles.push_back(combobuf[animated_combo_table4[i][0]].tile);
+		
+	for(word i=0; i<animated_combos2; ++i)
+		k.anim_tiles.push_back(combobuf[animated_combo_table24[i][0]].tile);
+}
+
+static void blit_edge_previews(BITMAP *src, BITMAP *dest)
+{
+	blit(src, dest, 0, 0, 0, 0, 288, 16);
+	blit(src, dest, 0, 192, 0, 192, 288, 16);
+	blit(src, dest, 0, 16, 0, 16, 16, 176);
+	blit(src, dest, 272, 16, 272, 16, 16, 176);
+}
+
+static bool edge_previews_reusable()
+{
+	// Misalignment arrows compare against the screen being painted, and
+	// the static drawn past the map edges is animated.
+	if(!edge_preview_hold || !edge_preview_valid || CycleOn || ShowMisalignments || InvalidStatic)
+		return false;
+		
+	edge_preview_key k;
+	get_edge_preview_key(k);
+	return k==edge_preview_cached;
+}
+
+static void store_edge_previews()
+{
+	edge_preview_valid=false;
+	
+	if(!edge_preview_hold)
+		return;
+		
+	if(edge_preview_bmp && (edge_preview_bmp->w!=mapscreenbmp->w || edge_preview_bmp->h!=mapscreenbmp->h))
+	{
+		destroy_bitmap(edge_preview_bmp);
+		edge_preview_bmp=NULL;
+	}
+	
+	if(!edge_preview_bmp)
+		edge_preview_bmp=create_bitmap_ex(8,mapscreenbmp->w,mapscreenbmp->h);
+		
+	if(!edge_preview_bmp)
+		return;
+		
+	blit_edge_previews(mapscreenbmp, edge_preview_bmp);
+	get_edge_preview_key(edge_preview_cached);
+	edge_preview_valid=true;
+}
+
+// Does the preview of any screen around the current one draw from a screen
+// that painting on the current screen (or one of its layers) can change?
+static bool edge_previews_show_current()
+{
+	int32_t targets[7];
+	int32_t currscr=Map.getCurrScr();
+	targets[0]=Map.getCurrMap()*MAPSCRS+currscr;
+	
+	for(int32_t k=0; k<6; ++k)
+	{
+		targets[k+1]=(Map.CurrScr()->layermap[k]-1)*MAPSCRS+Map.CurrScr()->layerscreen[k];
+	}
+	
+	static const int32_t offsets[8]={-17,-16,-15,-1,1,15,16,17};
+	
+	for(int32_t i=0; i<8; ++i)
+	{
+		int32_t scr=currscr+offsets[i];
+		
+		if(scr<0 || scr>=128)
+			continue;
+			
+		mapscr *s=Map.AbsoluteScr(Map.getCurrMap(), scr);
+		int32_t refs[7];
+		refs[0]=Map.getCurrMap()*MAPSCRS+scr;
+		
+		for(int32_t k=0; k<6; ++k)
+		{
+			refs[k+1]=(s->layermap[k]>0) ? (s->layermap[k]-1)*MAPSCRS+s->layerscreen[k] : -1;
+		}
+		
+		for(int32_t r=0; r<7; ++r)
+		{
+			if(refs[r]<0)
+				continue;
+				
+			for(int32_t t=0; t<7; ++t)
+			{
+				if(refs[r]==targets[t])
+					return true;
+			}
+		}
+	}
+	
+	return false;
+}
+
+static void hold_edge_previews(bool hold)
+{
+	edge_preview_hold=hold;
+	edge_preview_valid=false;
+}
+
 void refresh(int32_t flags)
 {
     // CPage = Map.CurrScr()->cpage;
@@ -5858,84 +6045,93 @@ void refresh(int32_t flags)
         {
             if(Map.getCurrScr()<128)
             {
-                //not the first row of screens
-                if(Map.getCurrScr()>15 && !NoScreenPreview)
+                if(edge_previews_reusable())
                 {
-                    Map.drawrow(mapscreenbmp, 16, 0, Flags, 160, -1, Map.getCurrScr()-16);
+                    blit_edge_previews(edge_preview_bmp, mapscreenbmp);
                 }
                 else
                 {
-                    Map.drawstaticrow(mapscreenbmp, 16, 0);
-                }
+                    //not the first row of screens
+                    if(Map.getCurrScr()>15 && !NoScreenPreview)
+                    {
+                        Map.drawrow(mapscreenbmp, 16, 0, Flags, 160, -1, Map.getCurrScr()-16);
+                    }
+                    else
+                    {
+                        Map.drawstaticrow(mapscreenbmp, 16, 0);
+                    }
                 
-                //not the last row of screens
-                if(Map.getCurrScr()<112 && !NoScreenPreview)
-                {
-                    Map.drawrow(mapscreenbmp, 16, 192, Flags, 0, -1, Map.getCurrScr()+16);
-                }
-                else
-                {
-                    Map.drawstaticrow(mapscreenbmp, 16, 192);
-                }
+                    //not the last row of screens
+                    if(Map.getCurrScr()<112 && !NoScreenPreview)
+                    {
+                        Map.drawrow(mapscreenbmp, 16, 192, Flags, 0, -1, Map.getCurrScr()+16);
+                    }
+                    else
+                    {
+                        Map.drawstaticrow(mapscreenbmp, 16, 192);
+                    }
                 
-                //not the first column of screens
-                if(Map.getCurrScr()&0x0F && !NoScreenPreview)
-                {
-                    Map.drawcolumn(mapscreenbmp, 0, 16, Flags, 15, -1, Map.getCurrScr()-1);
-                }
-                else
-                {
-                    Map.drawstaticcolumn(mapscreenbmp, 0, 16);
-                }
+                    //not the first column of screens
+                    if(Map.getCurrScr()&0x0F && !NoScreenPreview)
+                    {
+                        Map.drawcolumn(mapscreenbmp, 0, 16, Flags, 15, -1, Map.getCurrScr()-1);
+                    }
+                    else
+                    {
+                        Map.drawstaticcolumn(mapscreenbmp, 0, 16);
+                    }
                 
-                //not the last column of screens
-                if((Map.getCurrScr()&0x0F)<15 && !NoScreenPreview)
-                {
-                    Map.drawcolumn(mapscreenbmp, 272, 16, Flags, 0, -1, Map.getCurrScr()+1);
-                }
-                else
-                {
-                    Map.drawstaticcolumn(mapscreenbmp, 272, 16);
-                }
+                    //not the last column of screens
+                    if((Map.getCurrScr()&0x0F)<15 && !NoScreenPreview)
+                    {
+                        Map.drawcolumn(mapscreenbmp, 272, 16, Flags, 0, -1, Map.getCurrScr()+1);
+                    }
+                    else
+                    {
+                        Map.drawstaticcolumn(mapscreenbmp, 272, 16);
+                    }
                 
-                //not the first row or first column of screens
-                if((Map.getCurrScr()>15)&&(Map.getCurrScr()&0x0F) && !NoScreenPreview)
-                {
-                    Map.drawblock(mapscreenbmp, 0, 0, Flags, 175, -1, Map.getCurrScr()-17);
-                }
-                else
-                {
-                    Map.drawstaticblock(mapscreenbmp, 0, 0);
-                }
+                    //not the first row or first column of screens
+                    if((Map.getCurrScr()>15)&&(Map.getCurrScr()&0x0F) && !NoScreenPreview)
+                    {
+                        Map.drawblock(mapscreenbmp, 0, 0, Flags, 175, -1, Map.getCurrScr()-17);
+                    }
+                    else
+                    {
+                        Map.drawstaticblock(mapscreenbmp, 0, 0);
+                    }
                 
-                //not the first row or last column of screens
-                if((Map.getCurrScr()>15)&&((Map.getCurrScr()&0x0F)<15) && !NoScreenPreview)
-                {
-                    Map.drawblock(mapscreenbmp, 272, 0, Flags, 160, -1, Map.getCurrScr()-15);
-                }
-                else
-                {
-                    Map.drawstaticblock(mapscreenbmp, 272, 0);
-                }
+                    //not the first row or last column of screens
+                    if((Map.getCurrScr()>15)&&((Map.getCurrScr()&0x0F)<15) && !NoScreenPreview)
+                    {
+                        Map.drawblock(mapscreenbmp, 272, 0, Flags, 160, -1, Map.getCurrScr()-15);
+                    }
+                    else
+                    {
+                        Map.drawstaticblock(mapscreenbmp, 272, 0);
+                    }
                 
-                //not the last row or first column of screens
-                if((Map.getCurrScr()<112)&&(Map.getCurrScr()&0x0F) && !NoScreenPreview)
-                {
-                    Map.drawblock(mapscreenbmp, 0, 192, Flags, 15, -1, Map.getCurrScr()+15);
-                }
-                else
-                {
-                    Map.drawstaticblock(mapscreenbmp, 0, 192);
-                }
+                    //not the last row or first column of screens
+                    if((Map.getCurrScr()<112)&&(Map.getCurrScr()&0x0F) && !NoScreenPreview)
+                    {
+                        Map.drawblock(mapscreenbmp, 0, 192, Flags, 15, -1, Map.getCurrScr()+15);
+                    }
+                    else
+                    {
+                        Map.drawstaticblock(mapscreenbmp, 0, 192);
+                    }
                 
-                //not the last row or last column of screens
-                if((Map.getCurrScr()<112)&&((Map.getCurrScr()&0x0F)<15) && !NoScreenPreview)
-                {
-                    Map.drawblock(mapscreenbmp, 272, 192, Flags, 0, -1, Map.getCurrScr()+17);
-                }
-                else
-                {
-                    Map.drawstaticblock(mapscreenbmp, 272, 192);
+                    //not the last row or last column of screens
+                    if((Map.getCurrScr()<112)&&((Map.getCurrScr()&0x0F)<15) && !NoScreenPreview)
+                    {
+                        Map.drawblock(mapscreenbmp, 272, 192, Flags, 0, -1, Map.getCurrScr()+17);
+                    }
+                    else
+                    {
+                        Map.drawstaticblock(mapscreenbmp, 272, 192);
+                    }
+                    
+                    store_edge_previews();
                 }
             }
         }
@@ -7671,6 +7867,7 @@ void draw(bool justcset)
         Map.setcolor(Color);
     }
     
+    hold_edge_previews(!edge_previews_show_current());
     refresh(rMAP+rSCRMAP);
     
     while(gui_mouse_b())
@@ -8023,6 +8220,8 @@ void draw(bool justcset)
         do_animations();
         refresh(rALL);
     }
+    
+    hold_edge_previews(false);
 }
 
 
@@ -17961,6 +18160,7 @@ void edit_tune(int32_t i)
         }
         
         saved=false;
+        mark_section_dirty(qsMIDIS);
     }
     
     if((ret==28||ret==0) && data!=customtunes[i].data)
@@ -18046,6 +18246,7 @@ int32_t onMidis()
             {
                 customtunes[d].reset(); // reset_midi(customMIDIs+d);
                 saved=false;
+                mark_section_dirty(qsMIDIS);
             }
         }
         else
@@ -28345,6 +28546,7 @@ int32_t onEditSFX(int32_t index)
 		{
 			case 1:
 				saved= false;
+				mark_section_dirty(qsSFX);
 				kill_sfx();
 				change_sfx(&customsfxdata[index],&templist[index]);
 				set_bit(customsfxflag,index-1,tempflag);
@@ -31756,6 +31958,7 @@ void destroy_bitmaps_on_exit()
 
 void quit_game()
 {
+    finish_timed_save();
     deallocate_biic_list();
     
     
@@ -31763,6 +31966,15 @@ void quit_game()
     save_config_file();
     set_palette(black_palette);
     stop_midi();
+    
+    if(zcmusic != NULL)
+    {
+        zcmusic_stop(zcmusic);
+        zcmusic_unload_file(zcmusic);
+        zcmusic = NULL;
+    }
+    
+    zcmusic_exit();
     //if(scrtmp) {destroy_bitmap(screen); screen = hw_screen;}
     
     remove_locked_params_on_exit();
@@ -31942,6 +32154,7 @@ void quit_game()
 
 void quit_game2()
 {
+    finish_timed_save();
     deallocate_biic_list();
     
     
@@ -31949,6 +32162,15 @@ void quit_game2()
     save_config_file();
     set_palette(black_palette);
     stop_midi();
+    
+    if(zcmusic != NULL)
+    {
+        zcmusic_stop(zcmusic);
+        zcmusic_unload_file(zcmusic);
+        zcmusic = NULL;
+    }
+    
+    zcmusic_exit();
     //if(scrtmp) {destroy_bitmap(screen); screen = hw_screen;}
     
     remove_locked_params_on_exit();
@@ -32887,6 +33109,13 @@ int32_t d_timer_proc(int32_t msg, DIALOG *d, int32_t c)
 
 void check_autosave()
 {
+    if(timed_save_finished() && finish_timed_save()!=0)
+    {
+        jwin_alert("Error","Timed save did not complete successfully.",NULL,NULL,"O&K",NULL,'k',0,lfont);
+        last_timed_save[0]=0;
+        save_config_file();
+    }
+    
     if(AutoSaveInterval>0)
     {
         time(&auto_save_time_current);
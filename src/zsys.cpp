@@ -494,26 +494,31 @@ static int32_t enc_mask[ENC_METHOD_MAX]= {(int32_t)0x4C358938,(int32_t)0x91B2A2D
 static int32_t pvalue[ENC_METHOD_MAX]= {0x62E9,0x7D14,0x1A82,0x02BB,0xE09C};
 static int32_t qvalue[ENC_METHOD_MAX]= {0x3619,0xA26B,0xF03C,0x7B12,0x4E8F};
 
-static int32_t rand_007(int32_t method)
+static int32_t rand_007(int32_t &seed, int32_t method)
 {
-    int16_t BX = enc_seed >> 8;
-    int16_t CX = (enc_seed & 0xFF) << 8;
-    signed char AL = enc_seed >> 24;
+    int16_t BX = seed >> 8;
+    int16_t CX = (seed & 0xFF) << 8;
+    signed char AL = seed >> 24;
     signed char C = AL >> 7;
     signed char D = BX >> 15;
     AL <<= 1;
     BX = (BX << 1) | C;
     CX = (CX << 1) | D;
-    CX += enc_seed & 0xFFFF;
-    BX += (enc_seed >> 16) + C;
+    CX += seed & 0xFFFF;
+    BX += (seed >> 16) + C;
     //  CX += 0x62E9;
     //  BX += 0x3619 + D;
     CX += pvalue[method];
     BX += qvalue[method] + D;
-    enc_seed = (BX << 16) + CX;
+    seed = (BX << 16) + CX;
     return (CX << 16) + BX;
 }
 
+static int32_t rand_007(int32_t method)
+{
+    return rand_007(enc_seed, method);
+}
+
 void encode_007(byte *buf, dword size, dword key2, word *check1, word *check2, int32_t method)
 {
     dword i;
@@ -656,6 +661,290 @@ int32_t encode_file_007(const char *srcfile, const char *destfile, int32_t key2,
     return 0;
 }
 
+/**********  Streaming 007 encoder  *****************/
+
+// State shared by the two halves of a pack_fopen_encoded_007 stream: the
+// optional LZSS packer the caller writes into, and the encoder that applies
+// the packfile password and the 007 cipher on the way to the destination.
+struct encode_007_stream
+{
+    FILE *dest;
+    int32_t seed;
+    int32_t method;
+    int32_t tog, r;
+    int16_t c1, c2;
+    char password[256];
+    int32_t passpos;
+    bool error;
+    
+    LZSS_PACK_DATA *pack_data;
+    PACKFILE *encoder;
+    byte buf[F_BUF_SIZE];
+    int32_t buf_size;
+};
+
+// Mirrors allegro's encrypt_id(), which is private to file.c.
+static int32_t packfile_magic_id(int32_t x, const char *password)
+{
+    int32_t mask = 0;
+    
+    if(password[0])
+    {
+        for(int32_t i=0; password[i]; i++)
+            mask ^= ((int32_t)password[i] << ((i&3) * 8));
+            
+        for(int32_t i=0, pos=0; i<4; i++)
+        {
+            mask ^= (int32_t)password[pos++] << (24-i*8);
+            
+            if(!password[pos])
+                pos = 0;
+        }
+        
+        mask ^= 42;
+    }
+    
+    return x ^ mask;
+}
+
+static int enc007_putc(int c, void *userdata)
+{
+    encode_007_stream *st = (encode_007_stream *)userdata;
+    int32_t b = c & 255;
+    
+    if(st->password[0])
+    {
+        b ^= (byte)st->password[st->passpos++];
+        
+        if(!st->password[st->passpos])
+            st->passpos = 0;
+    }
+    
+    st->c1 += b;
+    st->c2 = (st->c2 << 4) + (st->c2 >> 12) + b;
+    
+    if(st->tog)
+        b += st->r;
+    else
+    {
+        st->r = rand_007(st->seed, st->method);
+        b ^= st->r;
+    }
+    
+    st->tog ^= 1;
+    
+    if(fputc(b, st->dest) == EOF)
+    {
+        st->error = true;
+        return EOF;
+    }
+    
+    return c;
+}
+
+static long enc007_fwrite(const void *p, long n, void *userdata)
+{
+    const byte *cp = (const byte *)p;
+    long i;
+    
+    for(i=0; i<n; i++)
+    {
+        if(enc007_putc(*cp++, userdata) == EOF)
+            break;
+    }
+    
+    return i;
+}
+
+static int enc007_fclose(void *userdata)
+{
+    encode_007_stream *st = (encode_007_stream *)userdata;
+    
+    // write the checksums
+    int32_t r = rand_007(st->seed, st->method);
+    st->c1 ^= r;
+    st->c2 += r;
+    fputc(st->c1>>8, st->dest);
+    fputc(st->c1&255, st->dest);
+    fputc(st->c2>>8, st->dest);
+    fputc(st->c2&255, st->dest);
+    
+    bool failed = st->error || ferror(st->dest);
+    failed = (fclose(st->dest) != 0) || failed;
+    delete st;
+    return failed ? EOF : 0;
+}
+
+static int enc007_flush_packed(encode_007_stream *st, int32_t last)
+{
+    if(st->buf_size > 0)
+    {
+        if(lzss_write(st->encoder, st->pack_data, st->buf_size, st->buf, last))
+        {
+            st->error = true;
+            return EOF;
+        }
+        
+        st->buf_size = 0;
+    }
+    
+    return 0;
+}
+
+static int pack007_putc(int c, void *userdata)
+{
+    encode_007_stream *st = (encode_007_stream *)userdata;
+    
+    // flush before the buffer fills, as allegro does, so the final
+    // lzss_write() with last set is never empty
+    if(st->buf_size + 1 >= F_BUF_SIZE && enc007_flush_packed(st, FALSE))
+        return EOF;
+        
+    st->buf[st->buf_size++] = c;
+    return c;
+}
+
+static long pack007_fwrite(const void *p, long n, void *userdata)
+{
+    const byte *cp = (const byte *)p;
+    long i;
+    
+    for(i=0; i<n; i++)
+    {
+        if(pack007_putc(*cp++, userdata) == EOF)
+            break;
+    }
+    
+    return i;
+}
+
+static int pack007_fclose(void *userdata)
+{
+    encode_007_stream *st = (encode_007_stream *)userdata;
+    int ret = enc007_flush_packed(st, TRUE);
+    free_lzss_pack_data(st->pack_data);
+    
+    // closing the encoder finishes the file and frees st
+    if(pack_fclose(st->encoder) != 0)
+        ret = EOF;
+        
+    return ret;
+}
+
+static int enc007_getc(void *)
+{
+    return EOF;
+}
+
+static int enc007_ungetc(int, void *)
+{
+    return EOF;
+}
+
+static long enc007_fread(void *, long, void *)
+{
+    return 0;
+}
+
+static int enc007_fseek(void *, int)
+{
+    return -1;
+}
+
+static int enc007_feof(void *)
+{
+    return 0;
+}
+
+static int enc007_ferror(void *userdata)
+{
+    return ((encode_007_stream *)userdata)->error;
+}
+
+static PACKFILE_VTABLE enc007_vtable =
+{
+    enc007_fclose, enc007_getc, enc007_ungetc, enc007_fread, enc007_putc,
+    enc007_fwrite, enc007_fseek, enc007_feof, enc007_ferror
+};
+
+static PACKFILE_VTABLE pack007_vtable =
+{
+    pack007_fclose, enc007_getc, enc007_ungetc, enc007_fread, pack007_putc,
+    pack007_fwrite, enc007_fseek, enc007_feof, enc007_ferror
+};
+
+//
+// Opens destfile for writing and returns a write-only PACKFILE. Everything
+// written to it lands in destfile exactly as if it had been written to a
+// temp file opened with pack_fopen_password(packed ? F_WRITE_PACKED :
+// F_WRITE, password) and then passed through encode_file_007(), but in a
+// single pass with the checksums computed on the fly. pack_fclose()
+// writes the checksums and returns nonzero if any write failed.
+//
+PACKFILE *pack_fopen_encoded_007(const char *destfile, int32_t key2, const char *header, int32_t method, bool packed, const char *password)
+{
+    FILE *dest = fopen(destfile, "wb");
+    
+    if(!dest)
+        return NULL;
+        
+    encode_007_stream *st = new encode_007_stream;
+    st->dest = dest;
+    st->seed = key2;
+    st->method = method;
+    st->tog = 0;
+    st->r = 0;
+    st->c1 = 0;
+    st->c2 = 0;
+    st->passpos = 0;
+    st->error = false;
+    st->pack_data = NULL;
+    st->buf_size = 0;
+    strncpy(st->password, password ? password : "", sizeof(st->password)-1);
+    st->password[sizeof(st->password)-1] = 0;
+    
+    // write the header
+    if(header)
+    {
+        for(int32_t c=0; header[c]; c++)
+            fputc(header[c], dest);
+    }
+    
+    // write the key, XORed with MASK
+    key2 ^= enc_mask[method];
+    fputc(key2>>24, dest);
+    fputc((key2>>16)&255, dest);
+    fputc((key2>>8)&255, dest);
+    fputc(key2&255, dest);
+    
+    st->encoder = pack_fopen_vtable(&enc007_vtable, st);
+    
+    if(!st->encoder)
+    {
+        fclose(dest);
+        delete st;
+        return NULL;
+    }
+    
+    if(!packed)
+        return st->encoder;
+        
+    st->pack_data = create_lzss_pack_data();
+    PACKFILE *f = st->pack_data ? pack_fopen_vtable(&pack007_vtable, st) : NULL;
+    
+    if(!f)
+    {
+        if(st->pack_data)
+            free_lzss_pack_data(st->pack_data);
+            
+        pack_fclose(st->encoder);
+        return NULL;
+    }
+    
+    pack_mputl(packfile_magic_id(F_PACK_MAGIC, st->password), st->encoder);
+    return f;
+}
+
 //
 // RETURNS:
 //   0 - OK
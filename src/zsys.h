@@ -51,6 +51,7 @@ void resolve_password(char *pwd);
 bool decode_007(byte *buf, dword size, dword key, word check1, word check2, int32_t method);
 void encode_007(byte *buf, dword size, dword key, word *check1, word *check2, int32_t method);
 int32_t encode_file_007(const char *srcfile, const char *destfile, int32_t key, const char *header, int32_t method);
+PACKFILE *pack_fopen_encoded_007(const char *destfile, int32_t key, const char *header, int32_t method, bool packed, const char *password);
 int32_t decode_file_007(const char *srcfile, const char *destfile, const char *header, int32_t method, bool packed, const char *password);
 void copy_file(const char *src, const char *dest);
 
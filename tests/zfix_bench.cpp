@@ -0,0 +1,219 @@
+//Checks that zfix still gives bit-identical results to the formulas it used
+//before it was made constexpr, then times its hot operations against those
+//formulas. Built when BUILD_ZFIX_BENCH is on; "ctest -R zfix" runs it.
+//
+//It prints the first mismatch and returns 1. Otherwise it prints the timings
+//and returns 0; the timings are for reading, and never fail the run.
+
+#include "zfix.h"
+#include <cstdio>
+#include <cstdlib>
+#include <climits>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <type_traits>
+
+static_assert(std::is_trivially_copyable<zfix>::value, "zfix must stay trivially copyable");
+static_assert((zfix(3)*zfix(1.5) + 2).getZLong() == 65000, "zfix arithmetic must be usable in constant expressions");
+static_assert(zfix(-2.5).getInt() == -3 && zfix(2.5).getInt() == 3, "getInt rounds half away from zero");
+static_assert(abs(zfix(-7)).getZLong() == 70000, "abs");
+
+//The formulas zfix used before it was made constexpr
+namespace ref
+{
+	static int32_t vbound(ZLong x, int32_t low, int32_t high)
+	{
+		if(x<low) return low;
+		if(x>high) return high;
+		return x;
+	}
+
+	static int32_t getInt(ZLong val)
+	{
+		return val/10000L + vbound((val%10000L)/5000L, (val < 0 ? -1 : 0),(val<0 ? 0 : 1));
+	}
+
+	static ZLong mul(ZLong a, ZLong b)
+	{
+		zint64 c = int64_t(a)*b;
+		return (int32_t)(c/10000L);
+	}
+
+	static ZLong div(ZLong a, ZLong b)
+	{
+		if(b == 0) return 0;
+		zint64 c = int64_t(a)*10000L;
+		return (int32_t)(c/b);
+	}
+
+	static ZLong fromDouble(double d)
+	{
+		return ZLong(d*10000L);
+	}
+}
+
+static bool fail(char const* op, ZLong a, ZLong b, ZLong got, ZLong want)
+{
+	printf("%s(%d, %d): %d, was %d\n", op, a, b, got, want);
+	return false;
+}
+
+//Every hot operation on one pair of raw values
+static bool check(ZLong a, ZLong b)
+{
+	zfix x = zslongToFix(a), y = zslongToFix(b);
+
+	if(x.getInt() != ref::getInt(a) || int32_t(x) != ref::getInt(a))
+		return fail("getInt", a, 0, x.getInt(), ref::getInt(a));
+
+	if(a != INT_MIN && abs(x).getZLong() != std::abs(a))
+		return fail("abs", a, 0, abs(x).getZLong(), std::abs(a));
+
+	if((x*y).getZLong() != ref::mul(a, b))
+		return fail("mul", a, b, (x*y).getZLong(), ref::mul(a, b));
+
+	//a zero divisor gives 0, as FIX_NAN is 0
+	if((x/y).getZLong() != ref::div(a, b))
+		return fail("div", a, b, (x/y).getZLong(), ref::div(a, b));
+
+	if((x<y) != (a<b) || (x>y) != (a>b) || (x<=y) != (a<=b) || (x>=y) != (a>=b)
+		|| (x==y) != (a==b) || (x!=y) != (a!=b))
+		return fail("compare", a, b, 0, 0);
+
+	//keep sums inside int32_t, where the old and new code are both defined
+	if(a > INT_MIN/2 && a < INT_MAX/2 && b > INT_MIN/2 && b < INT_MAX/2)
+	{
+		if((x+y).getZLong() != a+b || (x-y).getZLong() != a-b || (-x).getZLong() != -a)
+			return fail("arith", a, b, (x+y).getZLong(), a+b);
+	}
+
+	//int and double operands, as scripts and movement code use them
+	int32_t n = b % 50000;
+	if(a > INT_MIN/2 && a < INT_MAX/2)
+	{
+		if((x+n).getZLong() != a+n*10000)
+			return fail("add int", a, n, (x+n).getZLong(), a+n*10000);
+
+		if((x<n) != (a < n*10000) || (x>n) != (a > n*10000) || (x==n) != (a == n*10000))
+			return fail("compare int", a, n, 0, 0);
+	}
+
+	int32_t m = b % 1000;
+	if(zint64(a)*m >= INT_MIN && zint64(a)*m <= INT_MAX)
+	{
+		if((x*m).getZLong() != a*m)
+			return fail("mul int", a, m, (x*m).getZLong(), a*m);
+	}
+
+	if(m != 0 && !(a == INT_MIN && m == -1) && (x/m).getZLong() != a/m)
+		return fail("div int", a, m, (x/m).getZLong(), a/m);
+
+	double d = b / 10000.0;
+	if(d > -200000 && d < 200000)
+	{
+		if(zfix(d).getZLong() != ref::fromDouble(d))
+			return fail("from double", b, 0, zfix(d).getZLong(), ref::fromDouble(d));
+
+		if((x*d).getZLong() != ref::mul(a, ref::fromDouble(d)))
+			return fail("mul double", a, b, (x*d).getZLong(), ref::mul(a, ref::fromDouble(d)));
+	}
+
+	return true;
+}
+
+static bool check_all()
+{
+	//every value within +-1000 of each multiple of 5000 up to +-10^6, where
+	//getInt's rounding changes
+	for(ZLong base = -1000000; base <= 1000000; base += 5000)
+	{
+		for(ZLong v = base-1000; v <= base+1000; ++v)
+		{
+			if(!check(v, base)) return false;
+		}
+	}
+
+	const ZLong edges[] =
+	{
+		0, 1, -1, 4999, 5000, 5001, -4999, -5000, -5001, 9999, 10000, -10000,
+		214748, -214748, 2147483, -2147483, INT_MAX, INT_MIN+1, INT_MIN
+	};
+
+	for(ZLong a : edges)
+	{
+		for(ZLong b : edges)
+		{
+			if(!check(a, b)) return false;
+		}
+	}
+
+	std::mt19937 rng(1);
+
+	for(int32_t i = 0; i < 2000000; ++i)
+	{
+		//whole range, then the range sprite positions and speeds live in
+		ZLong a = ZLong(rng()), b = ZLong(rng());
+		if(!check(a, b)) return false;
+		if(!check(a%(1024*10000), b%(16*10000))) return false;
+	}
+
+	return true;
+}
+
+typedef std::chrono::steady_clock bench_clock;
+
+static volatile int32_t bench_sink;
+
+//Runs 'op' over every pair of values 'reps' times; prints ns per operation
+template<typename Op>
+static void bench(char const* name, std::vector<zfix> const& xs, std::vector<zfix> const& ys, Op op)
+{
+	const int32_t reps = 40;
+	int32_t acc = 0;
+	bench_clock::time_point start = bench_clock::now();
+
+	for(int32_t r = 0; r < reps; ++r)
+	{
+		for(size_t i = 0; i < xs.size(); ++i)
+			acc += op(xs[i], ys[i]);
+	}
+
+	double ns = std::chrono::duration<double, std::nano>(bench_clock::now()-start).count();
+	bench_sink = acc;
+	printf("  %-14s %6.2f ns/op\n", name, ns / (double(reps)*xs.size()));
+}
+
+static void bench_all()
+{
+	std::mt19937 rng(2);
+	std::vector<zfix> xs(1<<16), ys(1<<16);
+
+	for(size_t i = 0; i < xs.size(); ++i)
+	{
+		xs[i] = zslongToFix(ZLong(rng()%(2048*10000)) - 1024*10000);
+		ys[i] = zslongToFix(ZLong(rng()%(32*10000)) - 16*10000);
+		if(!ys[i]) ys[i] = 1;
+	}
+
+	printf("zfix, against the old formulas:\n");
+	bench("mul", xs, ys, [](zfix a, zfix b) { return (a*b).getZLong(); });
+	bench("mul (old)", xs, ys, [](zfix a, zfix b) { return ref::mul(a.getZLong(), b.getZLong()); });
+	bench("div", xs, ys, [](zfix a, zfix b) { return (a/b).getZLong(); });
+	bench("div (old)", xs, ys, [](zfix a, zfix b) { return ref::div(a.getZLong(), b.getZLong()); });
+	bench("add/sub", xs, ys, [](zfix a, zfix b) { return (a+b-(b>>1)).getZLong(); });
+	bench("mul double", xs, ys, [](zfix a, zfix b) { return (a*(b.getZLong()*0.0001)).getZLong(); });
+	bench("compare", xs, ys, [](zfix a, zfix b) { return (a<b) + (a>=8) + (a==b); });
+	bench("getInt", xs, ys, [](zfix a, zfix b) { return a.getInt() + b.getInt(); });
+	bench("getInt (old)", xs, ys, [](zfix a, zfix b) { return ref::getInt(a.getZLong()) + ref::getInt(b.getZLong()); });
+}
+
+int main()
+{
+	if(!check_all())
+		return 1;
+
+	printf("ok\n");
+	bench_all();
+	return 0;
+}